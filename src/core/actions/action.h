@@ -36,15 +36,13 @@ struct Action
 {
 	ID        id = 0; // Invalid
 	ID        channelId;
-	Frame     frame;
+	Frame     frame; // Derived from 'tick' when read through Actions
 	MidiEvent event;
 	ID        pluginId    = -1;
 	int       pluginParam = -1;
 	ID        prevId      = 0;
 	ID        nextId      = 0;
-
-	const Action* prev = nullptr;
-	const Action* next = nullptr;
+	Tick      tick        = 0; // Actual position, in musical time
 
 	bool isValid() const
 	{
@@ -0,0 +1,96 @@
+/* -----------------------------------------------------------------------------
+ *
+ * Giada - Your Hardcore Loopmachine
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2022 Giovanni A. Zuliani | Monocasual Laboratories
+ *
+ * This file is part of Giada - Your Hardcore Loopmachine.
+ *
+ * Giada - Your Hardcore Loopmachine is free software: you can
+ * redistribute it and/or modify it under the terms of the GNU General
+ * Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * Giada - Your Hardcore Loopmachine is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Giada - Your Hardcore Loopmachine. If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------- */
+
+
+#include "core/actions/actionBuckets.h"
+#include <algorithm>
+#include <cassert>
+
+namespace giada::m
+{
+ActionBuckets::ActionBuckets(std::size_t capacity)
+: m_actions(nullptr)
+, m_flat(false)
+{
+	m_buckets.reserve(capacity);
+}
+
+/* -------------------------------------------------------------------------- */
+
+void ActionBuckets::clear(const ActionMap& actions, std::size_t ranges)
+{
+	/* The number of channels with actions is an upper bound for the buckets of
+	a single range. */
+
+	m_actions = &actions;
+	m_flat    = actions.countChannels() * ranges > m_buckets.capacity();
+	m_buckets.clear();
+
+	assert(ranges <= m_buckets.capacity());
+}
+
+/* -------------------------------------------------------------------------- */
+
+void ActionBuckets::add(Tick a, Tick b, Frame begin, Frame delta)
+{
+	assert(m_actions != nullptr);
+
+	if (m_flat)
+	{
+		if (const ActionMap::View view = m_actions->getActionsInRange(a, b); !view.empty())
+			m_buckets.push_back({0, begin, delta, view});
+		return;
+	}
+
+	m_actions->forEachChannelInRange(a, b, [this, begin, delta](ID channelId, ActionMap::View view) {
+		m_buckets.push_back({channelId, begin, delta, view});
+	});
+}
+
+/* -------------------------------------------------------------------------- */
+
+void ActionBuckets::sort()
+{
+	std::sort(m_buckets.begin(), m_buckets.end(), [](const Bucket& a, const Bucket& b) {
+		return a.channelId != b.channelId ? a.channelId < b.channelId : a.delta < b.delta;
+	});
+}
+
+/* -------------------------------------------------------------------------- */
+
+std::pair<ActionBuckets::const_iterator, ActionBuckets::const_iterator> ActionBuckets::get(ID channelId) const
+{
+	if (m_flat)
+		return {m_buckets.begin(), m_buckets.end()};
+	return std::equal_range(m_buckets.begin(), m_buckets.end(), Bucket{channelId},
+	    [](const Bucket& a, const Bucket& b) { return a.channelId < b.channelId; });
+}
+
+/* -------------------------------------------------------------------------- */
+
+bool        ActionBuckets::isFlat() const { return m_flat; }
+std::size_t ActionBuckets::size() const { return m_buckets.size(); }
+} // namespace giada::m
@@ -0,0 +1,101 @@
+/* -----------------------------------------------------------------------------
+ *
+ * Giada - Your Hardcore Loopmachine
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2022 Giovanni A. Zuliani | Monocasual Laboratories
+ *
+ * This file is part of Giada - Your Hardcore Loopmachine.
+ *
+ * Giada - Your Hardcore Loopmachine is free software: you can
+ * redistribute it and/or modify it under the terms of the GNU General
+ * Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * Giada - Your Hardcore Loopmachine is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Giada - Your Hardcore Loopmachine. If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------- */
+
+
+#ifndef G_ACTION_BUCKETS_H
+#define G_ACTION_BUCKETS_H
+
+#include "core/actions/actionMap.h"
+#include "core/types.h"
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+namespace giada::m
+{
+/* ActionBuckets
+Actions found in an audio block, bucketed by channel so that each channel only
+visits its own. A block is made of one or more ranges, split where it wraps 
+around the loop. Storage is preallocated: if the buckets of a block might not 
+fit, the whole block falls back to one flat bucket per range, holding the 
+actions of all channels. Channels filter actions by ID anyway, so nothing is 
+ever dropped: it's just slower. */
+
+class ActionBuckets
+{
+public:
+	/* Bucket
+	Actions of a single channel (or of all channels, if flat) in a range of the
+	block, sorted by tick. Action 'a' falls on the local frame 
+	'delta + toFrame(a.tick) - begin'. */
+
+	struct Bucket
+	{
+		ID              channelId = 0; // 0 = all channels
+		Frame           begin     = 0;
+		Frame           delta     = 0;
+		ActionMap::View actions;
+	};
+
+	using const_iterator = std::vector<Bucket>::const_iterator;
+
+	ActionBuckets(std::size_t capacity);
+
+	/* clear
+	Prepares for a new block made of 'ranges' ranges over 'actions', and 
+	decides whether the block can be bucketed by channel. Real-time safe. */
+
+	void clear(const ActionMap& actions, std::size_t ranges);
+
+	/* add
+	Buckets the actions in ticks [a, b), found in the range of the block that
+	starts on frame 'begin', 'delta' frames from the block start. Real-time 
+	safe. */
+
+	void add(Tick a, Tick b, Frame begin, Frame delta);
+
+	/* sort
+	Sorts buckets by channel ID, then by delta. Call it once all the ranges 
+	have been added. */
+
+	void sort();
+
+	/* get
+	Returns the buckets for channel 'channelId', sorted by delta. O(log n). */
+
+	std::pair<const_iterator, const_iterator> get(ID channelId) const;
+
+	bool        isFlat() const;
+	std::size_t size() const;
+
+private:
+	const ActionMap*    m_actions;
+	std::vector<Bucket> m_buckets;
+	bool                m_flat;
+};
+} // namespace giada::m
+
+#endif
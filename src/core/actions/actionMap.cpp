@@ -0,0 +1,378 @@
+/* -----------------------------------------------------------------------------
+ *
+ * Giada - Your Hardcore Loopmachine
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2022 Giovanni A. Zuliani | Monocasual Laboratories
+ *
+ * This file is part of Giada - Your Hardcore Loopmachine.
+ *
+ * Giada - Your Hardcore Loopmachine is free software: you can
+ * redistribute it and/or modify it under the terms of the GNU General
+ * Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * Giada - Your Hardcore Loopmachine is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Giada - Your Hardcore Loopmachine. If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------- */
+
+
+#include "core/actions/actionMap.h"
+#include <algorithm>
+#include <cassert>
+#include <utility>
+
+namespace giada::m
+{
+ActionMap::View::Iterator::Iterator(const Action* arena, const Handle* handle)
+: m_arena(arena)
+, m_handle(handle)
+{
+}
+
+/* -------------------------------------------------------------------------- */
+
+const Action& ActionMap::View::Iterator::operator*() const { return m_arena[*m_handle]; }
+const Action* ActionMap::View::Iterator::operator->() const { return &m_arena[*m_handle]; }
+
+/* -------------------------------------------------------------------------- */
+
+ActionMap::View::Iterator& ActionMap::View::Iterator::operator++()
+{
+	++m_handle;
+	return *this;
+}
+
+/* -------------------------------------------------------------------------- */
+
+bool ActionMap::View::Iterator::operator==(const Iterator& o) const { return m_handle == o.m_handle; }
+bool ActionMap::View::Iterator::operator!=(const Iterator& o) const { return m_handle != o.m_handle; }
+
+/* -------------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------- */
+
+ActionMap::View::View(const Action* arena, const Handle* begin, const Handle* end)
+: m_arena(arena)
+, m_begin(begin)
+, m_end(end)
+{
+}
+
+/* -------------------------------------------------------------------------- */
+
+ActionMap::View::Iterator ActionMap::View::begin() const { return {m_arena, m_begin}; }
+ActionMap::View::Iterator ActionMap::View::end() const { return {m_arena, m_end}; }
+std::size_t               ActionMap::View::size() const { return m_end - m_begin; }
+bool                      ActionMap::View::empty() const { return m_begin == m_end; }
+
+/* -------------------------------------------------------------------------- */
+
+std::pair<ActionMap::View, ActionMap::View> ActionMap::View::splitFirstTick() const
+{
+	const Handle* split = m_begin;
+	while (split != m_end && m_arena[*split].tick == m_arena[*m_begin].tick)
+		split++;
+	return {View(m_arena, m_begin, split), View(m_arena, split, m_end)};
+}
+
+/* -------------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------- */
+
+ActionMap::TickIterator::TickIterator(const ActionMap& map, std::size_t pos)
+: m_map(&map)
+, m_pos(pos)
+, m_end(findGroupEnd(pos))
+{
+}
+
+/* -------------------------------------------------------------------------- */
+
+Tick ActionMap::TickIterator::getTick() const
+{
+	assert(m_pos < m_map->m_ticks.size());
+	return m_map->m_ticks[m_pos];
+}
+
+/* -------------------------------------------------------------------------- */
+
+ActionMap::View ActionMap::TickIterator::getActions() const
+{
+	const Handle* handles = m_map->m_handles.data();
+	return {m_map->m_arena.data(), handles + m_pos, handles + m_end};
+}
+
+/* -------------------------------------------------------------------------- */
+
+ActionMap::TickIterator& ActionMap::TickIterator::operator++()
+{
+	m_pos = m_end;
+	m_end = findGroupEnd(m_pos);
+	return *this;
+}
+
+/* -------------------------------------------------------------------------- */
+
+bool ActionMap::TickIterator::operator==(const TickIterator& o) const { return m_pos == o.m_pos; }
+bool ActionMap::TickIterator::operator!=(const TickIterator& o) const { return m_pos != o.m_pos; }
+
+/* -------------------------------------------------------------------------- */
+
+std::size_t ActionMap::TickIterator::findGroupEnd(std::size_t pos) const
+{
+	/* Groups are usually tiny: a linear scan beats a binary search here. */
+
+	const std::vector<Tick>& ticks = m_map->m_ticks;
+	std::size_t              end   = pos;
+	while (end < ticks.size() && ticks[end] == ticks[pos])
+		end++;
+	return end;
+}
+
+/* -------------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------- */
+
+std::size_t ActionMap::size() const { return m_handles.size(); }
+bool        ActionMap::empty() const { return m_handles.empty(); }
+std::size_t ActionMap::countChannels() const { return m_channels.size(); }
+
+/* -------------------------------------------------------------------------- */
+
+const Action* ActionMap::find(ID id) const
+{
+	const Handle h = lookup(id);
+	return h != NO_HANDLE ? &m_arena[h] : nullptr;
+}
+
+Action* ActionMap::find(ID id)
+{
+	return const_cast<Action*>(std::as_const(*this).find(id));
+}
+
+/* -------------------------------------------------------------------------- */
+
+ActionMap::View ActionMap::getActionsOnTick(Tick t) const
+{
+	const auto [first, last] = std::equal_range(m_ticks.begin(), m_ticks.end(), t);
+	const Handle* handles    = m_handles.data();
+	return {m_arena.data(), handles + (first - m_ticks.begin()), handles + (last - m_ticks.begin())};
+}
+
+/* -------------------------------------------------------------------------- */
+
+ActionMap::View ActionMap::getActionsOnChannel(ID channelId) const
+{
+	const ChannelIndex* index = getChannelIndex(channelId);
+	if (index == nullptr)
+		return {};
+	const Handle* handles = index->handles.data();
+	return {m_arena.data(), handles, handles + index->handles.size()};
+}
+
+/* -------------------------------------------------------------------------- */
+
+ActionMap::View ActionMap::getActionsInRange(Tick a, Tick b) const
+{
+	const auto    first   = std::lower_bound(m_ticks.begin(), m_ticks.end(), a);
+	const auto    last    = std::lower_bound(first, m_ticks.end(), b);
+	const Handle* handles = m_handles.data();
+	return {m_arena.data(), handles + (first - m_ticks.begin()), handles + (last - m_ticks.begin())};
+}
+
+/* -------------------------------------------------------------------------- */
+
+ActionMap::TickIterator ActionMap::lowerBound(Tick t) const
+{
+	const auto it = std::lower_bound(m_ticks.begin(), m_ticks.end(), t);
+	return {*this, static_cast<std::size_t>(it - m_ticks.begin())};
+}
+
+ActionMap::TickIterator ActionMap::begin() const { return {*this, 0}; }
+ActionMap::TickIterator ActionMap::end() const { return {*this, m_ticks.size()}; }
+
+/* -------------------------------------------------------------------------- */
+
+ActionMap::Handle ActionMap::insert(const Action& a)
+{
+	assert(a.isValid());
+
+	Handle h;
+	if (m_free.empty())
+	{
+		h = static_cast<Handle>(m_arena.size());
+		m_arena.push_back(a);
+	}
+	else
+	{
+		h = m_free.back();
+		m_free.pop_back();
+		m_arena[h] = a;
+	}
+
+	const auto pos = std::upper_bound(m_ticks.begin(), m_ticks.end(), a.tick) - m_ticks.begin();
+	m_ticks.insert(m_ticks.begin() + pos, a.tick);
+	m_handles.insert(m_handles.begin() + pos, h);
+
+	std::vector<Handle>& handles = getOrMakeChannelIndex(a.channelId).handles;
+	const auto           it      = std::upper_bound(handles.begin(), handles.end(), a.tick,
+	    [this](Tick t, Handle other) { return t < m_arena[other].tick; });
+	handles.insert(it, h);
+
+	m_ids.set(a.id, static_cast<int>(h));
+
+	return h;
+}
+
+/* -------------------------------------------------------------------------- */
+
+bool ActionMap::erase(ID id)
+{
+	const Handle h = lookup(id);
+	if (h == NO_HANDLE)
+		return false;
+
+	const std::size_t pos = findPosition(h);
+	m_ticks.erase(m_ticks.begin() + pos);
+	m_handles.erase(m_handles.begin() + pos);
+
+	/* Actions on the same tick are a few at most: binary search for the tick,
+	then scan. */
+
+	ChannelIndex& index = getOrMakeChannelIndex(m_arena[h].channelId);
+	const auto    first = std::lower_bound(index.handles.begin(), index.handles.end(), m_arena[h].tick,
+	    [this](Handle other, Tick t) { return m_arena[other].tick < t; });
+	index.handles.erase(std::find(first, index.handles.end(), h));
+	if (index.handles.empty())
+		m_channels.erase(m_channels.begin() + (&index - m_channels.data()));
+
+	m_ids.set(id, model::IdIndex::NONE);
+	m_arena[h] = {};
+	m_free.push_back(h);
+
+	return true;
+}
+
+/* -------------------------------------------------------------------------- */
+
+void ActionMap::removeIf(std::function<bool(const Action&)> f)
+{
+	/* First mark the doomed actions as invalid in the arena, then compact the
+	indexes by dropping handles that point to invalid actions. */
+
+	bool removed = false;
+	for (Handle h : m_handles)
+	{
+		Action& a = m_arena[h];
+		if (!f(a))
+			continue;
+		m_ids.set(a.id, model::IdIndex::NONE);
+		a = {};
+		m_free.push_back(h);
+		removed = true;
+	}
+
+	if (!removed)
+		return;
+
+	std::size_t j = 0;
+	for (std::size_t i = 0; i < m_handles.size(); i++)
+	{
+		if (!m_arena[m_handles[i]].isValid())
+			continue;
+		m_ticks[j]   = m_ticks[i];
+		m_handles[j] = m_handles[i];
+		j++;
+	}
+	m_ticks.resize(j);
+	m_handles.resize(j);
+
+	for (ChannelIndex& index : m_channels)
+		index.handles.erase(std::remove_if(index.handles.begin(), index.handles.end(),
+		                        [this](Handle h) { return !m_arena[h].isValid(); }),
+		    index.handles.end());
+
+	m_channels.erase(std::remove_if(m_channels.begin(), m_channels.end(),
+	                     [](const ChannelIndex& index) { return index.handles.empty(); }),
+	    m_channels.end());
+}
+
+/* -------------------------------------------------------------------------- */
+
+void ActionMap::clear()
+{
+	*this = {};
+}
+
+/* -------------------------------------------------------------------------- */
+
+ActionMap::Handle ActionMap::lookup(ID id) const
+{
+	if (id == 0)
+		return NO_HANDLE;
+
+	/* The index is always kept in sync with the arena (see insert() and 
+	erase()), so no fallback scan is needed. */
+
+	const int pos = m_ids.get(id);
+	if (pos != model::IdIndex::NONE && static_cast<std::size_t>(pos) < m_arena.size() && m_arena[pos].id == id)
+		return static_cast<Handle>(pos);
+	return NO_HANDLE;
+}
+
+/* -------------------------------------------------------------------------- */
+
+std::size_t ActionMap::findPosition(Handle h) const
+{
+	const Tick tick = m_arena[h].tick;
+	const auto first = std::lower_bound(m_ticks.begin(), m_ticks.end(), tick) - m_ticks.begin();
+
+	for (std::size_t i = first; i < m_handles.size(); i++)
+		if (m_handles[i] == h)
+			return i;
+
+	assert(false);
+	return m_handles.size();
+}
+
+/* -------------------------------------------------------------------------- */
+
+ActionMap::View ActionMap::getRange(const ChannelIndex& index, Tick a, Tick b) const
+{
+	const auto byTick = [this](Handle h, Tick t) { return m_arena[h].tick < t; };
+
+	const Handle* handles = index.handles.data();
+	const Handle* first   = std::lower_bound(handles, handles + index.handles.size(), a, byTick);
+	const Handle* last    = std::lower_bound(first, handles + index.handles.size(), b, byTick);
+	return {m_arena.data(), first, last};
+}
+
+/* -------------------------------------------------------------------------- */
+
+const ActionMap::ChannelIndex* ActionMap::getChannelIndex(ID channelId) const
+{
+	for (const ChannelIndex& index : m_channels)
+		if (index.channelId == channelId)
+			return &index;
+	return nullptr;
+}
+
+/* -------------------------------------------------------------------------- */
+
+ActionMap::ChannelIndex& ActionMap::getOrMakeChannelIndex(ID channelId)
+{
+	for (ChannelIndex& index : m_channels)
+		if (index.channelId == channelId)
+			return index;
+	return m_channels.emplace_back(ChannelIndex{channelId, {}});
+}
+} // namespace giada::m
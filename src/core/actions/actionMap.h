@@ -0,0 +1,264 @@
+/* -----------------------------------------------------------------------------
+ *
+ * Giada - Your Hardcore Loopmachine
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2022 Giovanni A. Zuliani | Monocasual Laboratories
+ *
+ * This file is part of Giada - Your Hardcore Loopmachine.
+ *
+ * Giada - Your Hardcore Loopmachine is free software: you can
+ * redistribute it and/or modify it under the terms of the GNU General
+ * Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * Giada - Your Hardcore Loopmachine is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Giada - Your Hardcore Loopmachine. If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------- */
+
+
+#ifndef G_ACTION_MAP_H
+#define G_ACTION_MAP_H
+
+#include "core/actions/action.h"
+#include "core/model/idIndex.h"
+#include "core/types.h"
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <utility>
+#include <vector>
+
+namespace giada::m
+{
+/* ActionMap
+Flat storage for recorded actions. Actions live in an arena and never move 
+while alive, so their Handle (i.e. the arena slot) survives inserts and 
+deletes of other actions, and copies of the whole map. The arena is indexed by:
+	- two parallel arrays (ticks, handles) sorted by tick, used for range 
+	  queries. Actions on the same tick keep their insertion order;
+	- an ID -> Handle table, for constant-time lookups by action ID;
+	- a list of handles per channel, sorted by tick.
+Everything is made of a handful of vectors, so copying the map (see 
+Actions::edit) is a few bulk copies rather than one allocation per tick. */
+
+class ActionMap
+{
+public:
+	using Handle = uint32_t;
+
+	/* View
+	Read-only sequence of actions, e.g. all actions on a tick or on a channel.
+	Valid as long as the ActionMap it comes from is alive and unchanged. */
+
+	class View
+	{
+	public:
+		class Iterator
+		{
+		public:
+			using iterator_category = std::forward_iterator_tag;
+			using value_type        = Action;
+			using difference_type   = std::ptrdiff_t;
+			using pointer           = const Action*;
+			using reference         = const Action&;
+
+			Iterator(const Action* arena, const Handle* handle);
+
+			const Action& operator*() const;
+			const Action* operator->() const;
+			Iterator&     operator++();
+			bool          operator==(const Iterator& o) const;
+			bool          operator!=(const Iterator& o) const;
+
+		private:
+			const Action* m_arena;
+			const Handle* m_handle;
+		};
+
+		View() = default;
+		View(const Action* arena, const Handle* begin, const Handle* end);
+
+		Iterator    begin() const;
+		Iterator    end() const;
+		std::size_t size() const;
+		bool        empty() const;
+
+		/* splitFirstTick
+		Returns the leading actions that share the same tick, and the rest. 
+		Meant for Views sorted by tick. */
+
+		std::pair<View, View> splitFirstTick() const;
+
+	private:
+		const Action* m_arena = nullptr;
+		const Handle* m_begin = nullptr;
+		const Handle* m_end   = nullptr;
+	};
+
+	/* TickIterator
+	Walks the ticks that have actions in ascending order, one group of actions
+	sharing the same tick at a time. */
+
+	class TickIterator
+	{
+	public:
+		TickIterator(const ActionMap&, std::size_t pos);
+
+		Tick getTick() const;
+		View  getActions() const;
+
+		TickIterator& operator++();
+		bool           operator==(const TickIterator& o) const;
+		bool           operator!=(const TickIterator& o) const;
+
+	private:
+		std::size_t findGroupEnd(std::size_t pos) const;
+
+		const ActionMap* m_map;
+		std::size_t      m_pos;
+		std::size_t      m_end;
+	};
+
+	/* size
+	Returns the number of actions stored. */
+
+	std::size_t size() const;
+	bool        empty() const;
+
+	/* countChannels
+	Returns the number of channels that have at least one action. */
+
+	std::size_t countChannels() const;
+
+	/* find
+	Returns the action with the given ID, or nullptr if not found. Constant 
+	time. The non-const version allows to change the event and the prev/next 
+	IDs only: tick and channel are part of the indexes and must not be 
+	touched. */
+
+	const Action* find(ID id) const;
+	Action*       find(ID id);
+
+	/* getActionsOnTick
+	Returns the actions recorded on tick 't'. O(log n). */
+
+	View getActionsOnTick(Tick t) const;
+
+	/* getActionsOnChannel
+	Returns the actions belonging to channel 'channelId', sorted by tick. */
+
+	View getActionsOnChannel(ID channelId) const;
+
+	/* getActionsInRange
+	Returns the actions of all channels in ticks [a, b), sorted by tick. 
+	O(log n). */
+
+	View getActionsInRange(Tick a, Tick b) const;
+
+	/* forEachChannelInRange
+	Calls 'f(channelId, view)' for each channel that has actions in ticks 
+	[a, b). Views are sorted by tick. O(channels * log n), no allocations. */
+
+	template <typename F>
+	void forEachChannelInRange(Tick a, Tick b, F&& f) const
+	{
+		for (const ChannelIndex& index : m_channels)
+			if (const View view = getRange(index, a, b); !view.empty())
+				f(index.channelId, view);
+	}
+
+	/* lowerBound
+	Returns an iterator to the first tick >= 't' that has actions. O(log n). */
+
+	TickIterator lowerBound(Tick t) const;
+
+	TickIterator begin() const;
+	TickIterator end() const;
+
+	/* forEach
+	Applies 'f' to each action, sorted by tick. */
+
+	template <typename F>
+	void forEach(F&& f) const
+	{
+		for (Handle h : m_handles)
+			f(m_arena[h]);
+	}
+
+	/* insert
+	Adds a valid action, after any other action on the same tick. Finding the 
+	position is O(log n); making room for it shifts handles and ticks only, 
+	never actions. Returns its handle. */
+
+	Handle insert(const Action&);
+
+	/* erase
+	Removes the action with the given ID. Returns false if not found. */
+
+	bool erase(ID id);
+
+	/* removeIf
+	Removes all actions that satisfy 'f', in a single linear pass. */
+
+	void removeIf(std::function<bool(const Action&)> f);
+
+	void clear();
+
+private:
+	struct ChannelIndex
+	{
+		ID                  channelId;
+		std::vector<Handle> handles;
+	};
+
+	static constexpr Handle NO_HANDLE = UINT32_MAX;
+
+	/* lookup
+	Returns the handle of the action with the given ID, or NO_HANDLE. */
+
+	Handle lookup(ID id) const;
+
+	/* findPosition
+	Returns the position of handle 'h' in the sorted arrays. */
+
+	std::size_t findPosition(Handle h) const;
+
+	/* getRange
+	Returns the actions of a channel in ticks [a, b). */
+
+	View getRange(const ChannelIndex&, Tick a, Tick b) const;
+
+	const ChannelIndex* getChannelIndex(ID channelId) const;
+	ChannelIndex&       getOrMakeChannelIndex(ID channelId);
+
+	/* m_arena
+	Action storage. Erased slots are marked with an invalid action and recycled
+	through 'm_free'. */
+
+	std::vector<Action> m_arena;
+	std::vector<Handle> m_free;
+
+	/* m_ticks, m_handles
+	Sorted index. m_ticks[i] is the tick of action m_arena[m_handles[i]]: 
+	ticks are duplicated here so that binary searches don't jump around the
+	arena. */
+
+	std::vector<Tick>   m_ticks;
+	std::vector<Handle> m_handles;
+
+	std::vector<ChannelIndex> m_channels;
+	model::IdIndex            m_ids;
+};
+} // namespace giada::m
+
+#endif
@@ -34,7 +34,6 @@
 #include "utils/ver.h"
 #include <algorithm>
 #include <cassert>
-#include <cmath>
 #include <cstddef>
 #include <unordered_map>
 
@@ -68,44 +67,11 @@ void ActionRecorder::reset()
 
 bool ActionRecorder::isBoundaryEnvelopeAction(const Action& a) const
 {
-	assert(a.prev != nullptr);
-	assert(a.next != nullptr);
-	return a.prev->frame > a.frame || a.next->frame < a.frame;
-}
-
-/* -------------------------------------------------------------------------- */
-
-void ActionRecorder::updateBpm(float ratio, int quantizerStep)
-{
-	if (ratio == 1.0f)
-		return;
-
-	m_actions.updateKeyFrames([=](Frame old) {
-		/* The division here cannot be precise. A new frame can be 44099 and the 
-		quantizer set to 44100. That would mean two recs completely useless. So we 
-		compute a reject value ('delta'): if it's lower than 6 frames the new frame 
-		is collapsed with a quantized frame. FIXME - maybe 6 frames are too low. */
-		Frame frame = static_cast<Frame>(old * ratio);
-		if (frame != 0)
-		{
-			Frame delta = quantizerStep % frame;
-			if (delta > 0 && delta <= 6)
-				frame = frame + delta;
-		}
-		return frame;
-	});
-}
-
-/* -------------------------------------------------------------------------- */
-
-void ActionRecorder::updateSamplerate(int systemRate, int patchRate)
-{
-	if (systemRate == patchRate)
-		return;
-
-	float ratio = systemRate / (float)patchRate;
-
-	m_actions.updateKeyFrames([=](Frame old) { return floorf(old * ratio); });
+	const Action prev = m_actions.getAction(a.prevId);
+	const Action next = m_actions.getAction(a.nextId);
+	assert(prev.isValid());
+	assert(next.isValid());
+	return prev.frame > a.frame || next.frame < a.frame;
 }
 
 /* -------------------------------------------------------------------------- */
@@ -167,6 +133,12 @@ std::unordered_set<ID> ActionRecorder::consolidate()
 	for (auto it = m_liveActions.begin(); it != m_liveActions.end(); ++it)
 		consolidate(*it, it - m_liveActions.begin()); // Pass current index
 
+	/* Live actions come from the audio thread with their frame only. */
+
+	const TempoMap tempoMap = m_model.get().sequencer.getTempoMap();
+	for (Action& a : m_liveActions)
+		a.tick = tempoMap.toTick(a.frame);
+
 	m_actions.rec(m_liveActions);
 
 	std::unordered_set<ID> out;
@@ -181,8 +153,9 @@ std::unordered_set<ID> ActionRecorder::consolidate()
 
 void ActionRecorder::clearAllActions()
 {
-	for (Channel& ch : m_model.get().channels)
-		ch.hasActions = false;
+	m_model.get().channels.editIf(
+	    [](const Channel& ch) { return ch.hasActions; },
+	    [](Channel& ch) { ch.hasActions = false; });
 	m_model.swap(model::SwapType::HARD);
 
 	m_actions.clearAll();
@@ -190,75 +163,38 @@ void ActionRecorder::clearAllActions()
 
 /* -------------------------------------------------------------------------- */
 
-Actions::Map ActionRecorder::deserializeActions(const std::vector<Patch::Action>& pactions)
+Actions::Map ActionRecorder::deserializeActions(const std::vector<Patch::Action>& pactions, const TempoMap& tempoMap)
 {
-	Actions::Map out;
-
-	/* First pass: add actions with no relationship, that is with no prev/next
-	pointers filled in. */
-
-	for (const Patch::Action& paction : pactions)
-		out[paction.frame].push_back(m_actions.makeAction(paction));
-
-	/* Second pass: fill in previous and next actions, if any. Is this the
-	fastest/smartest way to do it? Maybe not. Optimizations are welcome. */
+	/* Relationships between actions are stored as IDs, so there's nothing to
+	fix up after the insertion. */
 
+	Actions::Map out;
 	for (const Patch::Action& paction : pactions)
-	{
-		if (paction.nextId == 0 && paction.prevId == 0)
-			continue;
-		Action* curr = const_cast<Action*>(getActionPtrById(paction.id, out));
-		assert(curr != nullptr);
-		if (paction.nextId != 0)
-		{
-			curr->next = getActionPtrById(paction.nextId, out);
-			assert(curr->next != nullptr);
-		}
-		if (paction.prevId != 0)
-		{
-			curr->prev = getActionPtrById(paction.prevId, out);
-			assert(curr->prev != nullptr);
-		}
-	}
-
+		out.insert(m_actions.makeAction(paction, tempoMap));
 	return out;
 }
 
 /* -------------------------------------------------------------------------- */
 
-std::vector<Patch::Action> ActionRecorder::serializeActions(const Actions::Map& actions)
+std::vector<Patch::Action> ActionRecorder::serializeActions(const Actions::Map& actions, const TempoMap& tempoMap)
 {
 	std::vector<Patch::Action> out;
-	for (const auto& kv : actions)
-	{
-		for (const Action& a : kv.second)
-		{
-			out.push_back({
-			    a.id,
-			    a.channelId,
-			    a.frame,
-			    a.event.getRaw(),
-			    a.prevId,
-			    a.nextId,
-			});
-		}
-	}
+	out.reserve(actions.size());
+	actions.forEach([&out, &tempoMap](const Action& a) {
+		out.push_back({
+		    a.id,
+		    a.channelId,
+		    tempoMap.toFrame(a.tick),
+		    a.event.getRaw(),
+		    a.prevId,
+		    a.nextId,
+		});
+	});
 	return out;
 }
 
 /* -------------------------------------------------------------------------- */
 
-const Action* ActionRecorder::getActionPtrById(int id, const Actions::Map& source)
-{
-	for (const auto& [_, actions] : source)
-		for (const Action& action : actions)
-			if (action.id == id)
-				return &action;
-	return nullptr;
-}
-
-/* -------------------------------------------------------------------------- */
-
 bool ActionRecorder::areComposite(const Action& a1, const Action& a2) const
 {
 	return a1.event.getStatus() == MidiEvent::NOTE_ON &&
@@ -293,9 +229,9 @@ void ActionRecorder::consolidate(const Action& a1, std::size_t i)
 
 /* -------------------------------------------------------------------------- */
 
-const std::vector<Action>* ActionRecorder::getActionsOnFrame(Frame f) const
+const Actions::Map& ActionRecorder::getAll() const
 {
-	return m_actions.getActionsOnFrame(f);
+	return m_actions.getAll();
 }
 
 bool ActionRecorder::hasActions(ID channelId, int type) const
@@ -303,6 +239,11 @@ bool ActionRecorder::hasActions(ID channelId, int type) const
 	return m_actions.hasActions(channelId, type);
 }
 
+Action ActionRecorder::getAction(ID id) const
+{
+	return m_actions.getAction(id);
+}
+
 Action ActionRecorder::getClosestAction(ID channelId, Frame f, int type) const
 {
 	return m_actions.getClosestAction(channelId, f, type);
@@ -29,6 +29,7 @@
 
 #include "core/actions/actions.h"
 #include "core/midiEvent.h"
+#include "core/tempoMap.h"
 #include "core/types.h"
 #include <cstddef>
 #include <unordered_set>
@@ -53,18 +54,6 @@ public:
 
 	bool isBoundaryEnvelopeAction(const Action& a) const;
 
-	/* updateBpm
-    Changes actions position by calculating the new bpm value. */
-
-	void updateBpm(float ratio, int quantizerStep);
-
-	/* updateSamplerate
-    Changes actions position by taking in account the new samplerate. If 
-    f_system == f_patch nothing will change, otherwise the conversion is 
-    mandatory. */
-
-	void updateSamplerate(int systemRate, int patchRate);
-
 	/* cloneActions
     Clones actions in channel 'channelId', giving them a new channel ID. Returns
     whether any action has been cloned. */
@@ -88,25 +77,27 @@ public:
 	void clearAllActions();
 
 	/* (de)serializeActions
-    Creates new Actions given the patch raw data and vice versa. */
+    Creates new Actions given the patch raw data and vice versa. Patches store
+	frames: 'tempoMap' converts them from and to ticks. */
 
-	Actions::Map               deserializeActions(const std::vector<Patch::Action>& as);
-	std::vector<Patch::Action> serializeActions(const Actions::Map& as);
+	Actions::Map               deserializeActions(const std::vector<Patch::Action>& as, const TempoMap& tempoMap);
+	std::vector<Patch::Action> serializeActions(const Actions::Map& as, const TempoMap& tempoMap);
 
 	/* Pass-thru functions. See Actions.h */
 
-	const std::vector<Action>* getActionsOnFrame(Frame f) const;
-	bool                       hasActions(ID channelId, int type = 0) const;
-	Action                     getClosestAction(ID channelId, Frame f, int type) const;
-	std::vector<Action>        getActionsOnChannel(ID channelId) const;
-	void                       clearChannel(ID channelId);
-	void                       clearActions(ID channelId, int type);
-	Action                     rec(ID channelId, Frame frame, MidiEvent e);
-	void                       rec(ID channelId, Frame f1, Frame f2, MidiEvent e1, MidiEvent e2);
-	void                       updateSiblings(ID id, ID prevId, ID nextId);
-	void                       deleteAction(ID id);
-	void                       deleteAction(ID currId, ID nextId);
-	void                       updateEvent(ID id, MidiEvent e);
+	const Actions::Map&   getAll() const;
+	bool                  hasActions(ID channelId, int type = 0) const;
+	Action                getAction(ID id) const;
+	Action                getClosestAction(ID channelId, Frame f, int type) const;
+	std::vector<Action>   getActionsOnChannel(ID channelId) const;
+	void                  clearChannel(ID channelId);
+	void                  clearActions(ID channelId, int type);
+	Action                rec(ID channelId, Frame frame, MidiEvent e);
+	void                  rec(ID channelId, Frame f1, Frame f2, MidiEvent e1, MidiEvent e2);
+	void                  updateSiblings(ID id, ID prevId, ID nextId);
+	void                  deleteAction(ID id);
+	void                  deleteAction(ID currId, ID nextId);
+	void                  updateEvent(ID id, MidiEvent e);
 
 private:
 	/* areComposite
@@ -114,8 +105,6 @@ private:
 
 	bool areComposite(const Action& a1, const Action& a2) const;
 
-	const Action* getActionPtrById(int id, const Actions::Map& source);
-
 	/* consolidate
     Given an action 'a1' tries to find the matching NOTE_OFF and updates the
     action accordingly. */
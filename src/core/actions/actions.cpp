@@ -29,7 +29,6 @@
 #include "core/idManager.h"
 #include "core/model/model.h"
 #include "utils/log.h"
-#include <algorithm>
 #include <cassert>
 #include <memory>
 
@@ -52,8 +51,7 @@ void Actions::reset()
 
 void Actions::clearAll()
 {
-	model::DataLock lock = m_model.lockData();
-	m_model.getAllShared<Map>().clear();
+	publish({});
 }
 
 /* -------------------------------------------------------------------------- */
@@ -76,85 +74,50 @@ void Actions::clearActions(ID channelId, int type)
 
 void Actions::deleteAction(ID id)
 {
-	removeIf([=](const Action& a) { return a.id == id; });
+	edit([id](Map& map) { map.erase(id); });
 }
 
 void Actions::deleteAction(ID currId, ID nextId)
 {
-	removeIf([=](const Action& a) { return a.id == currId || a.id == nextId; });
-}
-
-/* -------------------------------------------------------------------------- */
-
-void Actions::updateKeyFrames(std::function<Frame(Frame old)> f)
-{
-	Map temp;
-
-	/* Copy all existing actions in local map by cloning them, with just a
-	difference: they have a new frame value. */
-
-	for (const auto& [oldFrame, actions] : m_model.getAllShared<Map>())
-	{
-		Frame newFrame = f(oldFrame);
-		for (const Action& a : actions)
-		{
-			Action copy = a;
-			copy.frame  = newFrame;
-			temp[newFrame].push_back(copy);
-		}
-		G_DEBUG(oldFrame << " -> " << newFrame);
-	}
-
-	updateMapPointers(temp);
-
-	model::DataLock lock  = m_model.lockData();
-	m_model.getAllShared<Map>() = std::move(temp);
+	edit([currId, nextId](Map& map) {
+		map.erase(currId);
+		map.erase(nextId);
+	});
 }
 
 /* -------------------------------------------------------------------------- */
 
 void Actions::updateEvent(ID id, MidiEvent e)
 {
-	model::DataLock lock = m_model.lockData();
-
-	findAction(m_model.getAllShared<Map>(), id)->event = e;
+	edit([this, id, e](Map& map) { findAction(map, id)->event = e; });
 }
 
 /* -------------------------------------------------------------------------- */
 
 void Actions::updateSiblings(ID id, ID prevId, ID nextId)
 {
-	model::DataLock lock = m_model.lockData();
-
-	Action* pcurr = findAction(m_model.getAllShared<Map>(), id);
-	Action* pprev = findAction(m_model.getAllShared<Map>(), prevId);
-	Action* pnext = findAction(m_model.getAllShared<Map>(), nextId);
-
-	pcurr->prev   = pprev;
-	pcurr->prevId = pprev->id;
-	pcurr->next   = pnext;
-	pcurr->nextId = pnext->id;
-
-	if (pprev != nullptr)
-	{
-		pprev->next   = pcurr;
-		pprev->nextId = pcurr->id;
-	}
-	if (pnext != nullptr)
-	{
-		pnext->prev   = pcurr;
-		pnext->prevId = pcurr->id;
-	}
+	edit([this, id, prevId, nextId](Map& map) {
+		Action* pcurr = findAction(map, id);
+		Action* pprev = findAction(map, prevId);
+		Action* pnext = findAction(map, nextId);
+
+		pcurr->prevId = pprev->id;
+		pcurr->nextId = pnext->id;
+
+		if (pprev != nullptr)
+			pprev->nextId = pcurr->id;
+		if (pnext != nullptr)
+			pnext->prevId = pcurr->id;
+	});
 }
 
 /* -------------------------------------------------------------------------- */
 
 bool Actions::hasActions(ID channelId, int type) const
 {
-	for (const auto& [frame, actions] : m_model.getAllShared<Map>())
-		for (const Action& a : actions)
-			if (a.channelId == channelId && (type == 0 || type == a.event.getStatus()))
-				return true;
+	for (const Action& a : m_model.getAllShared<Map>().getActionsOnChannel(channelId))
+		if (type == 0 || type == a.event.getStatus())
+			return true;
 	return false;
 }
 
@@ -167,31 +130,28 @@ Action Actions::makeAction(ID id, ID channelId, Frame frame, MidiEvent e)
 	return out;
 }
 
-Action Actions::makeAction(const Patch::Action& a)
+Action Actions::makeAction(const Patch::Action& a, const TempoMap& tempoMap)
 {
 	m_actionId.set(a.id);
 	return Action{a.id, a.channelId, a.frame, a.event, -1, -1, a.prevId,
-	    a.nextId};
+	    a.nextId, tempoMap.toTick(a.frame)};
 }
 
 /* -------------------------------------------------------------------------- */
 
 Action Actions::rec(ID channelId, Frame frame, MidiEvent event)
 {
+	Action a = makeAction(0, channelId, frame, event);
+	a.tick   = getTempoMap().toTick(frame);
+
 	/* Skip duplicates. */
 
-	if (exists(channelId, frame, event))
+	if (exists(channelId, a.tick, event))
 		return {};
 
-	Action a = makeAction(0, channelId, frame, event);
-
-	/* If key frame doesn't exist yet, the [] operator in std::map is smart 
-	enough to insert a new item first. No plug-in data for now. */
-
-	model::DataLock lock = m_model.lockData();
+	/* No plug-in data for now. */
 
-	m_model.getAllShared<Map>()[frame].push_back(a);
-	updateMapPointers(m_model.getAllShared<Map>());
+	edit([&a](Map& map) { map.insert(a); });
 
 	return a;
 }
@@ -203,67 +163,76 @@ void Actions::rec(std::vector<Action>& actions)
 	if (actions.size() == 0)
 		return;
 
-	model::DataLock lock = m_model.lockData();
-
-	Map& map = m_model.getAllShared<Map>();
-
-	for (const Action& a : actions)
-		if (!exists(a.channelId, a.frame, a.event, map))
-			map[a.frame].push_back(a);
-	updateMapPointers(map);
+	edit([this, &actions](Map& map) {
+		for (const Action& a : actions)
+			if (!exists(a.channelId, a.tick, a.event, map))
+				map.insert(a);
+	});
 }
 
 /* -------------------------------------------------------------------------- */
 
 void Actions::rec(ID channelId, Frame f1, Frame f2, MidiEvent e1, MidiEvent e2)
 {
-	model::DataLock lock = m_model.lockData();
-
-	Map& map = m_model.getAllShared<Map>();
-
-	map[f1].push_back(makeAction(0, channelId, f1, e1));
-	map[f2].push_back(makeAction(0, channelId, f2, e2));
+	const TempoMap tempoMap = getTempoMap();
+
+	edit([this, channelId, f1, f2, e1, e2, &tempoMap](Map& map) {
+		Action a1 = makeAction(0, channelId, f1, e1);
+		Action a2 = makeAction(0, channelId, f2, e2);
+		a1.tick   = tempoMap.toTick(f1);
+		a2.tick   = tempoMap.toTick(f2);
+		a1.nextId = a2.id;
+		a2.prevId = a1.id;
+
+		map.insert(a1);
+		map.insert(a2);
+	});
+}
 
-	Action* a1 = findAction(map, map[f1].back().id);
-	Action* a2 = findAction(map, map[f2].back().id);
-	a1->nextId = a2->id;
-	a2->prevId = a1->id;
+/* -------------------------------------------------------------------------- */
 
-	updateMapPointers(map);
+const Actions::Map& Actions::getAll() const
+{
+	return m_model.getAllShared<Map>();
 }
 
 /* -------------------------------------------------------------------------- */
 
-const std::vector<Action>* Actions::getActionsOnFrame(Frame frame) const
+Action Actions::getAction(ID id) const
 {
-	if (m_model.getAllShared<Map>().count(frame) == 0)
-		return nullptr;
-	return &m_model.getAllShared<Map>().at(frame);
+	const Action* a = m_model.getAllShared<Map>().find(id);
+	return a != nullptr ? withFrame(*a, getTempoMap()) : Action{};
 }
 
 /* -------------------------------------------------------------------------- */
 
 Action Actions::getClosestAction(ID channelId, Frame f, int type) const
 {
+	const TempoMap tempoMap = getTempoMap();
+	const Tick     t        = tempoMap.toTick(f);
+
+	/* A tick is finer than a frame: 'a.tick <= t' means that the action falls
+	on frame 'f' or before it. */
+
 	Action out = {};
-	forEachAction([&](const Action& a) {
-		if (a.event.getStatus() != type || a.channelId != channelId)
-			return;
-		if (!out.isValid() || (a.frame <= f && a.frame > out.frame))
+	for (const Action& a : m_model.getAllShared<Map>().getActionsOnChannel(channelId))
+	{
+		if (a.event.getStatus() != type)
+			continue;
+		if (!out.isValid() || (a.tick <= t && a.tick > out.tick))
 			out = a;
-	});
-	return out;
+	}
+	return out.isValid() ? withFrame(out, tempoMap) : out;
 }
 
 /* -------------------------------------------------------------------------- */
 
 std::vector<Action> Actions::getActionsOnChannel(ID channelId) const
 {
+	const TempoMap      tempoMap = getTempoMap();
 	std::vector<Action> out;
-	forEachAction([&](const Action& a) {
-		if (a.channelId == channelId)
-			out.push_back(a);
-	});
+	for (const Action& a : m_model.getAllShared<Map>().getActionsOnChannel(channelId))
+		out.push_back(withFrame(a, tempoMap));
 	return out;
 }
 
@@ -271,9 +240,10 @@ std::vector<Action> Actions::getActionsOnChannel(ID channelId) const
 
 void Actions::forEachAction(std::function<void(const Action&)> f) const
 {
-	for (auto& [_, actions] : m_model.getAllShared<Map>())
-		for (const Action& action : actions)
-			f(action);
+	const TempoMap tempoMap = getTempoMap();
+	m_model.getAllShared<Map>().forEach([this, &f, &tempoMap](const Action& a) {
+		f(withFrame(a, tempoMap));
+	});
 }
 
 /* -------------------------------------------------------------------------- */
@@ -287,66 +257,65 @@ ID Actions::getNewActionId()
 
 Action* Actions::findAction(Map& src, ID id)
 {
-	for (auto& [frame, actions] : src)
-		for (Action& a : actions)
-			if (a.id == id)
-				return &a;
-	assert(false);
-	return nullptr;
+	Action* a = src.find(id);
+	assert(a != nullptr);
+	return a;
+}
+
+/* -------------------------------------------------------------------------- */
+
+void Actions::removeIf(std::function<bool(const Action&)> f)
+{
+	edit([&f](Map& map) { map.removeIf(f); });
 }
 
 /* -------------------------------------------------------------------------- */
 
-void Actions::updateMapPointers(Map& src)
+void Actions::edit(std::function<void(Map&)> f)
 {
-	for (auto& kv : src)
-	{
-		for (Action& action : kv.second)
-		{
-			if (action.nextId != 0)
-				action.next = findAction(src, action.nextId);
-			if (action.prevId != 0)
-				action.prev = findAction(src, action.prevId);
-		}
-	}
+	Map map = m_model.getAllShared<Map>();
+	f(map);
+	publish(std::move(map));
 }
 
 /* -------------------------------------------------------------------------- */
 
-void Actions::optimize(Map& map)
+void Actions::publish(Map&& map)
 {
-	for (auto it = map.cbegin(); it != map.cend();)
-		it->second.size() == 0 ? it = map.erase(it) : ++it;
+	std::unique_ptr<Map> old = m_model.replaceShared(std::make_unique<Map>(std::move(map)));
+	m_model.swap(model::SwapType::HARD);
+	m_model.retire(std::move(old));
 }
 
 /* -------------------------------------------------------------------------- */
 
-void Actions::removeIf(std::function<bool(const Action&)> f)
+bool Actions::exists(ID channelId, Tick tick, const MidiEvent& event, const Map& target) const
 {
-	model::DataLock lock = m_model.lockData();
+	for (const Action& a : target.getActionsOnTick(tick))
+		if (a.channelId == channelId && a.event.getRaw() == event.getRaw())
+			return true;
+	return false;
+}
+
+/* -------------------------------------------------------------------------- */
 
-	Map& map = m_model.getAllShared<Map>();
-	for (auto& [frame, actions] : map)
-		actions.erase(std::remove_if(actions.begin(), actions.end(), f), actions.end());
-	optimize(map);
-	updateMapPointers(map);
+bool Actions::exists(ID channelId, Tick tick, const MidiEvent& event) const
+{
+	return exists(channelId, tick, event, m_model.getAllShared<Map>());
 }
 
 /* -------------------------------------------------------------------------- */
 
-bool Actions::exists(ID channelId, Frame frame, const MidiEvent& event, const Map& target) const
+TempoMap Actions::getTempoMap() const
 {
-	for (const auto& [_, actions] : target)
-		for (const Action& a : actions)
-			if (a.channelId == channelId && a.frame == frame && a.event.getRaw() == event.getRaw())
-				return true;
-	return false;
+	return m_model.get().sequencer.getTempoMap();
 }
 
 /* -------------------------------------------------------------------------- */
 
-bool Actions::exists(ID channelId, Frame frame, const MidiEvent& event) const
+Action Actions::withFrame(Action a, const TempoMap& tempoMap) const
 {
-	return exists(channelId, frame, event, m_model.getAllShared<Map>());
+	a.frame = tempoMap.toFrame(a.tick);
+	return a;
 }
 } // namespace giada::m
@@ -28,13 +28,15 @@
 #define G_ACTIONS_H
 
 #include "action.h"
+#include "core/actions/actionMap.h"
 #include "core/idManager.h"
 #include "core/midiEvent.h"
 #include "core/patch.h"
+#include "core/tempoMap.h"
 #include "core/types.h"
 #include <functional>
-#include <map>
 #include <memory>
+#include <utility>
 #include <vector>
 
 namespace giada::m::model
@@ -47,13 +49,16 @@ namespace giada::m
 class Actions
 {
 public:
-	using Map = std::map<Frame, std::vector<Action>>;
+	using Map = ActionMap;
 
 	Actions(model::Model& model);
 
 	/* forEachAction
     Applies a read-only callback on each action recorded. NEVER do anything
-    inside the callback that might alter the ActionMap. */
+    inside the callback that might alter the ActionMap. 
+
+	Actions are stored in ticks: all the getters below return copies with the 
+	'frame' field computed from the current tempo. */
 
 	void forEachAction(std::function<void(const Action&)> f) const;
 
@@ -62,16 +67,23 @@ public:
 
 	std::vector<Action> getActionsOnChannel(ID channelId) const;
 
+	/* getAction
+	Returns the action with the given ID, or an invalid action if not found. 
+	Constant time. */
+
+	Action getAction(ID id) const;
+
 	/* getClosestAction
     Given a frame 'f' returns the closest action. */
 
 	Action getClosestAction(ID channelId, Frame f, int type) const;
 
-	/* getActionsOnFrame
-    Returns a pointer to a vector of actions recorded on frame 'f', or nullptr 
-    if the frame has no actions. */
+	/* getAll
+	Returns the current Map. Called by the audio thread: fetch it once per 
+	block, as another thread might publish a new one in the meantime. Valid as
+	long as the caller holds the realtime Layout lock. */
 
-	const std::vector<Action>* getActionsOnFrame(Frame f) const;
+	const Map& getAll() const;
 
 	/* hasActions
     Checks if the channel has at least one action recorded. */
@@ -79,11 +91,12 @@ public:
 	bool hasActions(ID channelId, int type = 0) const;
 
 	/* makeAction
-    Makes a new action given some data. */
+    Makes a new action given some data. The first one leaves 'tick' empty, as it
+	might be called by the audio thread: see ActionRecorder::consolidate(). */
 	//TODO - move to actionManager
 
 	Action makeAction(ID id, ID channelId, Frame frame, MidiEvent e);
-	Action makeAction(const Patch::Action& a);
+	Action makeAction(const Patch::Action& a, const TempoMap&);
 
 	/* reset
 	Brings everything back to the initial state. */
@@ -115,12 +128,6 @@ public:
 
 	void deleteAction(ID currId, ID nextId);
 
-	/* updateKeyFrames
-    Update all the key frames in the internal map of actions, according to a 
-    lambda function 'f'. */
-
-	void updateKeyFrames(std::function<Frame(Frame old)> f);
-
 	/* updateEvent
     Changes the event in action 'a'. */
 
@@ -139,7 +146,8 @@ public:
 
 	/* rec (2)
     Transfer a vector of actions into the current ActionMap. This is called by 
-    recordHandler when a live session is over and consolidation is required. */
+    recordHandler when a live session is over and consolidation is required. 
+	Actions must have a valid 'tick'. */
 
 	void rec(std::vector<Action>& actions);
 
@@ -156,25 +164,35 @@ public:
 	ID getNewActionId();
 
 private:
-	bool exists(ID channelId, Frame frame, const MidiEvent& event, const Map& target) const;
-	bool exists(ID channelId, Frame frame, const MidiEvent& event) const;
+	bool exists(ID channelId, Tick tick, const MidiEvent& event, const Map& target) const;
+	bool exists(ID channelId, Tick tick, const MidiEvent& event) const;
 
-	Action* findAction(Map& src, ID id);
+	/* getTempoMap
+	Returns the TempoMap of the current sequencer, for converting frames from 
+	and to ticks. */
 
-	/* updateMapPointers
-    Updates all prev/next actions pointers into the action map. This is required
-    after an action has been recorded, since pushing back new actions in a Action 
-    vector makes it reallocating the existing ones. */
+	TempoMap getTempoMap() const;
 
-	void updateMapPointers(Map& src);
+	/* withFrame
+	Returns a copy of 'a' with the 'frame' field computed from its tick. */
 
-	/* optimize
-    Removes frames without actions. */
+	Action withFrame(Action a, const TempoMap&) const;
 
-	void optimize(Map& map);
+	Action* findAction(Map& src, ID id);
 
 	void removeIf(std::function<bool(const Action&)> f);
 
+	/* edit
+	Applies 'f' to a copy of the current Map, then publishes the copy. */
+
+	void edit(std::function<void(Map&)> f);
+
+	/* publish
+	Replaces the current Map with 'map'. The old one is retired, as the audio 
+	thread might still be reading it. */
+
+	void publish(Map&& map);
+
 	model::Model& m_model;
 
 	//TODO - move to actionManager
@@ -28,12 +28,14 @@
 #include "core/actions/actionRecorder.h"
 #include "core/channels/sampleAdvancer.h"
 #include "core/conf.h"
+#include "core/dsp/kernels.h"
 #include "core/engine.h"
 #include "core/midiMapper.h"
 #include "core/model/model.h"
 #include "core/plugins/pluginHost.h"
 #include "core/plugins/pluginManager.h"
 #include "core/recorder.h"
+#include <algorithm>
 #include <cassert>
 
 extern giada::m::Engine g_engine;
@@ -53,6 +55,16 @@ mcl::AudioBuffer::Pan calcPanning_(float pan)
 		return {1.0f, 1.0f};
 	return {1.0f - pan, pan};
 }
+
+/* -------------------------------------------------------------------------- */
+
+/* getIdleHoldFrames_
+Returns the idle hold time at the current sample rate. */
+
+Frame getIdleHoldFrames_()
+{
+	return ChannelShared::getIdleHoldFrames(g_engine.kernelAudio.getSampleRate());
+}
 } // namespace
 
 /* -------------------------------------------------------------------------- */
@@ -65,9 +77,7 @@ Channel::Channel(ChannelType type, ID id, ID columnId, int position, ChannelShar
 , type(type)
 , columnId(columnId)
 , position(position)
-, volume(G_DEFAULT_VOL)
 , volume_i(G_DEFAULT_VOL)
-, pan(G_DEFAULT_PAN)
 , armed(false)
 , key(0)
 , hasActions(false)
@@ -113,9 +123,7 @@ Channel::Channel(const Patch::Channel& p, ChannelShared& s, float samplerateRati
 , type(p.type)
 , columnId(p.columnId)
 , position(p.position)
-, volume(p.volume)
 , volume_i(G_DEFAULT_VOL)
-, pan(p.pan)
 , armed(p.armed)
 , key(p.key)
 , hasActions(p.hasActions)
@@ -129,6 +137,9 @@ Channel::Channel(const Patch::Channel& p, ChannelShared& s, float samplerateRati
 {
 	shared->readActions.store(p.readActions);
 	shared->recStatus.store(p.readActions ? ChannelStatus::PLAY : ChannelStatus::OFF);
+	shared->volume.store(p.volume);
+	shared->pan.store(p.pan);
+	shared->pitch.store(p.pitch);
 
 	switch (type)
 	{
@@ -179,9 +190,7 @@ Channel& Channel::operator=(const Channel& other)
 	type       = other.type;
 	columnId   = other.columnId;
 	position   = other.position;
-	volume     = other.volume;
 	volume_i   = other.volume_i;
-	pan        = other.pan;
 	m_mute     = other.m_mute;
 	m_solo     = other.m_solo;
 	armed      = other.armed;
@@ -296,13 +305,12 @@ void Channel::initCallbacks()
 
 /* -------------------------------------------------------------------------- */
 
-void Channel::advance(const Sequencer::EventBuffer& events, Range<Frame> block, Frame quantizerStep) const
+void Channel::advance(const Sequencer::ChannelEvents& events, Range<Frame> block, Frame quantizerStep) const
 {
 	if (shared->quantizer)
 		shared->quantizer->advance(block, quantizerStep);
 
-	for (const Sequencer::Event& e : events)
-	{
+	events.forEach([this](const Sequencer::Event& e) {
 		if (midiController)
 			midiController->advance(shared->playStatus, e);
 
@@ -314,18 +322,14 @@ void Channel::advance(const Sequencer::EventBuffer& events, Range<Frame> block,
 
 		if (midiReceiver && isPlaying())
 			midiReceiver->advance(id, shared->midiQueue, e);
-	}
+	});
 }
 
 /* -------------------------------------------------------------------------- */
 
-void Channel::react(const EventDispatcher::EventBuffer& events)
+void Channel::react(const EventDispatcher::EventRouter& router)
 {
-	for (const EventDispatcher::Event& e : events)
-	{
-		if (e.channelId > 0 && e.channelId != id)
-			continue;
-
+	router.forEachEventFor(id, [this](const EventDispatcher::Event& e) {
 		react(e);
 
 		if (midiController)
@@ -334,9 +338,6 @@ void Channel::react(const EventDispatcher::EventBuffer& events)
 		if (midiSender && isPlaying() && !isMuted())
 			midiSender->react(e);
 
-		if (samplePlayer)
-			samplePlayer->react(e);
-
 		if (midiActionRecorder && g_engine.recorder.canRecordActions())
 			midiActionRecorder->react(id, e, g_engine.sequencer.getCurrentFrameQuantized(), hasActions);
 
@@ -360,7 +361,7 @@ void Channel::react(const EventDispatcher::EventBuffer& events)
 
 		if (midiReceiver)
 			midiReceiver->react(shared->midiQueue, e);
-	}
+	});
 }
 
 /* -------------------------------------------------------------------------- */
@@ -369,14 +370,6 @@ void Channel::react(const EventDispatcher::Event& e)
 {
 	switch (e.type)
 	{
-	case EventDispatcher::EventType::CHANNEL_VOLUME:
-		volume = std::get<float>(e.data);
-		break;
-
-	case EventDispatcher::EventType::CHANNEL_PAN:
-		pan = std::get<float>(e.data);
-		break;
-
 	case EventDispatcher::EventType::CHANNEL_MUTE:
 		setMute(!isMuted());
 		break;
@@ -414,7 +407,8 @@ void Channel::renderMasterOut(mcl::AudioBuffer& out) const
 	shared->audioBuffer.set(out, /*gain=*/1.0f);
 	if (plugins.size() > 0)
 		g_engine.pluginHost.processStack(shared->audioBuffer, plugins, nullptr);
-	out.set(shared->audioBuffer, volume);
+	out.set(shared->audioBuffer, shared->volume.load());
+	shared->updateSilence(getIdleHoldFrames_());
 }
 
 /* -------------------------------------------------------------------------- */
@@ -429,6 +423,28 @@ void Channel::renderMasterIn(mcl::AudioBuffer& in) const
 
 void Channel::renderChannel(mcl::AudioBuffer& out, mcl::AudioBuffer& in, bool audible) const
 {
+	renderIsolated(in);
+	mix(out, audible);
+}
+
+/* -------------------------------------------------------------------------- */
+
+void Channel::renderIsolated(const mcl::AudioBuffer& in) const
+{
+	/* Skip idle channels entirely. The decision is stored in the shared state,
+	so that mix() agrees with it even if the play status changes in the 
+	meantime. The buffer is silenced once, when the channel goes idle: nothing
+	renders into it afterwards, but readers other than mix() (e.g. the offline
+	renderer's stems) would still see the last block. */
+
+	const bool wasIdle = shared->updateIdle(isIdle());
+	if (shared->idle)
+	{
+		if (!wasIdle)
+			shared->audioBuffer.clear();
+		return;
+	}
+
 	shared->audioBuffer.clear();
 
 	if (samplePlayer && isPlaying())
@@ -451,7 +467,31 @@ void Channel::renderChannel(mcl::AudioBuffer& out, mcl::AudioBuffer& in, bool au
 	else if (plugins.size() > 0)
 		g_engine.pluginHost.processStack(shared->audioBuffer, plugins, nullptr);
 
-	if (audible)
-		out.sum(shared->audioBuffer, volume * volume_i, calcPanning_(pan));
+	shared->updateSilence(getIdleHoldFrames_());
+}
+
+/* -------------------------------------------------------------------------- */
+
+bool Channel::isIdle() const
+{
+	if (!shared->isSilent(getIdleHoldFrames_()))
+		return false;
+	if (samplePlayer && isPlaying())
+		return false;
+	if (audioReceiver && armed && audioReceiver->inputMonitor)
+		return false;
+	if (midiReceiver && !shared->midiQueue.isEmpty())
+		return false;
+	return true;
+}
+
+/* -------------------------------------------------------------------------- */
+
+void Channel::mix(mcl::AudioBuffer& out, bool audible) const
+{
+	if (!audible || shared->idle)
+		return;
+	const mcl::AudioBuffer::Pan panning = calcPanning_(shared->pan.load());
+	dsp::sum(out, shared->audioBuffer, shared->volume.load() * volume_i, panning[0], panning[1]);
 }
 } // namespace giada::m
\ No newline at end of file
@@ -69,18 +69,34 @@ public:
 	Advances internal state by processing static events (e.g. pre-recorded 
 	actions or sequencer events) in the current block. */
 
-	void advance(const Sequencer::EventBuffer&, Range<Frame>, Frame quantizerStep) const;
+	void advance(const Sequencer::ChannelEvents&, Range<Frame>, Frame quantizerStep) const;
 
 	/* render
 	Renders audio data to I/O buffers. */
 
 	void render(mcl::AudioBuffer* out, mcl::AudioBuffer* in, bool audible) const;
 
+	/* renderIsolated, mix
+	Same as render() above for regular channels, split in two steps for the 
+	parallel renderer. renderIsolated() renders the channel into its own shared
+	audio buffer and can be called concurrently for different channels; mix() 
+	sums that buffer into 'out' and must be called serially. */
+
+	void renderIsolated(const mcl::AudioBuffer& in) const;
+	void mix(mcl::AudioBuffer& out, bool audible) const;
+
+	/* isIdle
+	True if the channel has been silent long enough and nothing can produce 
+	new sound in it: no sample playing, no input monitoring, no pending MIDI 
+	events. Idle channels are skipped by the renderer. */
+
+	bool isIdle() const;
+
 	/* react
 	Reacts to live events coming from the EventDispatcher (human events) and
 	updates itself accordingly. */
 
-	void react(const EventDispatcher::EventBuffer& e);
+	void react(const EventDispatcher::EventRouter&);
 
 	bool isPlaying() const;
 	bool isInternal() const;
@@ -98,9 +114,7 @@ public:
 	ChannelType          type;
 	ID                   columnId;
 	int                  position;
-	float                volume;
 	float                volume_i; // Internal volume used for velocity-drives-volume mode on Sample Channels
-	float                pan;
 	bool                 armed;
 	int                  key;
 	bool                 hasActions;
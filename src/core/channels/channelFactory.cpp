@@ -64,8 +64,8 @@ void ChannelFactory::reset()
 
 Channel ChannelFactory::create(ID channelId, ChannelType type, ID columnId, int position, int bufferSize)
 {
-	Channel out = Channel(type, m_channelId.generate(channelId), columnId, position,
-	    makeShared(type, bufferSize));
+	const ID id  = m_channelId.generate(channelId);
+	Channel  out = Channel(type, id, columnId, position, makeShared(id, type, bufferSize));
 
 	if (out.audioReceiver)
 		out.audioReceiver->overdubProtection = m_conf.overdubProtectionDefaultOn;
@@ -82,7 +82,11 @@ Channel ChannelFactory::create(const Channel& o, int bufferSize)
 	Channel out = Channel(o);
 
 	out.id     = m_channelId.generate();
-	out.shared = &makeShared(o.type, bufferSize);
+	out.shared = &makeShared(out.id, o.type, bufferSize);
+
+	out.shared->volume.store(o.shared->volume.load());
+	out.shared->pan.store(o.shared->pan.load());
+	out.shared->pitch.store(o.shared->pitch.load());
 
 	c::channel::setCallbacks(out); // UI callbacks
 
@@ -95,7 +99,7 @@ Channel ChannelFactory::deserializeChannel(const Patch::Channel& pch, float samp
 {
 	m_channelId.set(pch.id);
 
-	Channel out = Channel(pch, makeShared(pch.type, bufferSize), samplerateRatio, m_model.findShared<Wave>(pch.waveId));
+	Channel out = Channel(pch, makeShared(pch.id, pch.type, bufferSize), samplerateRatio, m_model.findShared<Wave>(pch.waveId));
 	c::channel::setCallbacks(out); // UI callbacks
 
 	return out;
@@ -119,13 +123,14 @@ const Patch::Channel ChannelFactory::serializeChannel(const Channel& c)
 	pc.key               = c.key;
 	pc.mute              = c.isMuted();
 	pc.solo              = c.isSoloed();
-	pc.volume            = c.volume;
-	pc.pan               = c.pan;
+	pc.volume            = c.shared->volume.load();
+	pc.pan               = c.shared->pan.load();
 	pc.hasActions        = c.hasActions;
 	pc.readActions       = c.shared->readActions.load();
 	pc.armed             = c.armed;
 	pc.midiIn            = c.midiLearner.enabled;
 	pc.midiInFilter      = c.midiLearner.filter;
+	pc.midiInDevice      = c.midiLearner.device;
 	pc.midiInKeyPress    = c.midiLearner.keyPress.getValue();
 	pc.midiInKeyRel      = c.midiLearner.keyRelease.getValue();
 	pc.midiInKill        = c.midiLearner.kill.getValue();
@@ -146,7 +151,7 @@ const Patch::Channel ChannelFactory::serializeChannel(const Channel& c)
 		pc.mode              = c.samplePlayer->mode;
 		pc.begin             = c.samplePlayer->begin;
 		pc.end               = c.samplePlayer->end;
-		pc.pitch             = c.samplePlayer->pitch;
+		pc.pitch             = c.shared->pitch.load();
 		pc.shift             = c.samplePlayer->shift;
 		pc.midiInVeloAsVol   = c.samplePlayer->velocityAsVol;
 		pc.inputMonitor      = c.audioReceiver->inputMonitor;
@@ -154,8 +159,9 @@ const Patch::Channel ChannelFactory::serializeChannel(const Channel& c)
 	}
 	else if (c.type == ChannelType::MIDI)
 	{
-		pc.midiOut     = c.midiSender->enabled;
-		pc.midiOutChan = c.midiSender->filter;
+		pc.midiOut       = c.midiSender->enabled;
+		pc.midiOutChan   = c.midiSender->filter;
+		pc.midiOutDevice = c.midiSender->device;
 	}
 
 	return pc;
@@ -163,9 +169,9 @@ const Patch::Channel ChannelFactory::serializeChannel(const Channel& c)
 
 /* -------------------------------------------------------------------------- */
 
-ChannelShared& ChannelFactory::makeShared(ChannelType type, int bufferSize)
+ChannelShared& ChannelFactory::makeShared(ID channelId, ChannelType type, int bufferSize)
 {
-	std::unique_ptr<ChannelShared> shared = std::make_unique<ChannelShared>(bufferSize);
+	std::unique_ptr<ChannelShared> shared = std::make_unique<ChannelShared>(channelId, bufferSize);
 
 	if (type == ChannelType::SAMPLE || type == ChannelType::PREVIEW)
 	{
@@ -74,7 +74,7 @@ public:
 	const Patch::Channel serializeChannel(const Channel& c);
 
 private:
-	ChannelShared& makeShared(ChannelType type, int bufferSize);
+	ChannelShared& makeShared(ID channelId, ChannelType type, int bufferSize);
 
 	IdManager m_channelId;
 
@@ -27,9 +27,11 @@
 #include "core/channels/channelManager.h"
 #include "core/channels/channel.h"
 #include "core/channels/channelFactory.h"
+#include "core/inputRecBuffer.h"
 #include "core/model/model.h"
 #include "core/waveFactory.h"
 #include "deps/mcl-audio-buffer/src/audioBuffer.hpp"
+#include <utility>
 
 namespace giada::m
 {
@@ -63,7 +65,8 @@ Channel& ChannelManager::addChannel(ChannelType type, ID columnId, int position,
 	m_model.get().channels.push_back(m_channelFactory.create(/*id=*/0, type, columnId, position, bufferSize));
 	m_model.swap(model::SwapType::HARD);
 
-	return m_model.get().channels.back();
+	model::Channels& channels = m_model.get().channels;
+	return channels.edit(channels.size() - 1);
 }
 
 /* -------------------------------------------------------------------------- */
@@ -111,7 +114,7 @@ void ChannelManager::addAndLoadSampleChannel(int bufferSize, std::unique_ptr<Wav
 
 void ChannelManager::cloneChannel(ID channelId, int bufferSize, const std::vector<Plugin*>& plugins)
 {
-	const Channel& oldChannel = m_model.get().getChannel(channelId);
+	const Channel& oldChannel = std::as_const(m_model).get().getChannel(channelId);
 	Channel        newChannel = m_channelFactory.create(oldChannel, bufferSize);
 
 	/* Clone Wave first, if any. */
@@ -158,9 +161,9 @@ void ChannelManager::freeAllSampleChannels()
 {
 	assert(onChannelsAltered != nullptr);
 
-	for (Channel& ch : m_model.get().channels)
-		if (ch.samplePlayer)
-			loadSampleChannel(ch, nullptr);
+	m_model.get().channels.editIf(
+	    [](const Channel& ch) { return ch.samplePlayer.has_value(); },
+	    [this](Channel& ch) { loadSampleChannel(ch, nullptr); });
 
 	m_model.swap(model::SwapType::HARD);
 	m_model.clearShared<model::WavePtrs>();
@@ -174,16 +177,18 @@ void ChannelManager::deleteChannel(ID channelId)
 {
 	assert(onChannelsAltered != nullptr);
 
-	const Channel& ch   = m_model.get().getChannel(channelId);
-	const Wave*    wave = ch.samplePlayer ? ch.samplePlayer->getWave() : nullptr;
+	const Channel&       ch     = std::as_const(m_model).get().getChannel(channelId);
+	const Wave*          wave   = ch.samplePlayer ? ch.samplePlayer->getWave() : nullptr;
+	const ChannelShared* shared = ch.shared;
 
-	u::vector::removeIf(m_model.get().channels, [channelId](const Channel& c) {
+	m_model.get().channels.removeIf([channelId](const Channel& c) {
 		return c.id == channelId;
 	});
 	m_model.swap(model::SwapType::HARD);
 
 	if (wave != nullptr)
 		m_model.removeShared<Wave>(*wave);
+	m_model.removeShared<ChannelShared>(*shared);
 
 	onChannelsAltered();
 }
@@ -202,9 +207,9 @@ void ChannelManager::moveChannel(ID channelId, ID newColumnId, int newPosition)
 {
 	/* Make room in the destination column for the new channel. */
 
-	for (Channel& ch : m_model.get().channels)
-		if (ch.columnId == newColumnId && ch.position >= newPosition)
-			ch.position++;
+	m_model.get().channels.editIf(
+	    [newColumnId, newPosition](const Channel& ch) { return ch.columnId == newColumnId && ch.position >= newPosition; },
+	    [](Channel& ch) { ch.position++; });
 
 	Channel& channel = m_model.get().getChannel(channelId);
 	channel.columnId = newColumnId;
@@ -217,12 +222,35 @@ void ChannelManager::moveChannel(ID channelId, ID newColumnId, int newPosition)
 
 float ChannelManager::getMasterInVol() const
 {
-	return m_model.get().getChannel(Mixer::MASTER_IN_CHANNEL_ID).volume;
+	return getShared(Mixer::MASTER_IN_CHANNEL_ID)->volume.load();
 }
 
 float ChannelManager::getMasterOutVol() const
 {
-	return m_model.get().getChannel(Mixer::MASTER_OUT_CHANNEL_ID).volume;
+	return getShared(Mixer::MASTER_OUT_CHANNEL_ID)->volume.load();
+}
+
+/* -------------------------------------------------------------------------- */
+
+void ChannelManager::setVolume(ID channelId, float v)
+{
+	const model::Reclaimer::ReadScope scope = m_model.read();
+	if (ChannelShared* shared = getShared(channelId); shared != nullptr)
+		shared->volume.store(v);
+}
+
+void ChannelManager::setPan(ID channelId, float v)
+{
+	const model::Reclaimer::ReadScope scope = m_model.read();
+	if (ChannelShared* shared = getShared(channelId); shared != nullptr)
+		shared->pan.store(v);
+}
+
+void ChannelManager::setPitch(ID channelId, float v)
+{
+	const model::Reclaimer::ReadScope scope = m_model.read();
+	if (ChannelShared* shared = getShared(channelId); shared != nullptr)
+		shared->pitch.store(v);
 }
 
 /* -------------------------------------------------------------------------- */
@@ -247,14 +275,25 @@ std::vector<const Channel*> ChannelManager::getColumn(ID columnId) const
 
 /* -------------------------------------------------------------------------- */
 
-void ChannelManager::finalizeInputRec(const mcl::AudioBuffer& buffer, Frame recordedFrames, Frame currentFrame)
+void ChannelManager::finalizeInputRec(const InputRecBuffer& buffer, Frame recordedFrames, Frame currentFrame)
 {
 	assert(onChannelsAltered != nullptr);
 
+	std::vector<std::unique_ptr<Wave>> oldWaves;
+
 	for (Channel* ch : getRecordableChannels())
 		recordChannel(*ch, buffer, recordedFrames, currentFrame);
 	for (Channel* ch : getOverdubbableChannels())
-		overdubChannel(*ch, buffer, currentFrame);
+		oldWaves.push_back(overdubChannel(*ch, buffer, currentFrame));
+
+	/* Swap once, when all channels are done: the Channel pointers above refer
+	to the non-realtime layout, which a swap would share again with the audio
+	thread. */
+
+	m_model.swap(model::SwapType::HARD);
+
+	for (std::unique_ptr<Wave>& wave : oldWaves)
+		m_model.retire(std::move(wave));
 
 	onChannelsAltered();
 }
@@ -302,12 +341,17 @@ void ChannelManager::loadSampleChannel(Channel& ch, Wave* w) const
 
 /* -------------------------------------------------------------------------- */
 
+ChannelShared* ChannelManager::getShared(ID channelId) const
+{
+	return m_model.findChannelShared(channelId);
+}
+
+/* -------------------------------------------------------------------------- */
+
 std::vector<Channel*> ChannelManager::getChannelsIf(std::function<bool(const Channel&)> f)
 {
 	std::vector<Channel*> out;
-	for (Channel& ch : m_model.get().channels)
-		if (f(ch))
-			out.push_back(&ch);
+	m_model.get().channels.editIf(f, [&out](Channel& ch) { out.push_back(&ch); });
 	return out;
 }
 
@@ -323,6 +367,39 @@ std::vector<Channel*> ChannelManager::getOverdubbableChannels()
 
 /* -------------------------------------------------------------------------- */
 
+void ChannelManager::editWave(ID channelId, std::function<void(Wave&)> f)
+{
+	const Wave* wave = std::as_const(m_model).get().getChannel(channelId).samplePlayer->getWave();
+
+	assert(wave != nullptr);
+
+	std::unique_ptr<Wave> oldWave = replaceWave(*wave, f);
+	m_model.swap(model::SwapType::HARD);
+	m_model.retire(std::move(oldWave));
+}
+
+/* -------------------------------------------------------------------------- */
+
+std::unique_ptr<Wave> ChannelManager::replaceWave(const Wave& w, std::function<void(Wave&)> f)
+{
+	std::unique_ptr<Wave> newWave = std::make_unique<Wave>(w);
+	newWave->setLogical(w.isLogical());
+	newWave->setEdited(w.isEdited());
+
+	f(*newWave);
+
+	/* Other channels (e.g. the preview one) might be reading the same Wave. */
+
+	Wave* wave = newWave.get();
+	m_model.get().channels.editIf(
+	    [&w](const Channel& ch) { return ch.samplePlayer && ch.samplePlayer->getWave() == &w; },
+	    [wave](Channel& ch) { ch.samplePlayer->setWave(wave, 1.0f); });
+
+	return m_model.replaceShared(std::move(newWave));
+}
+
+/* -------------------------------------------------------------------------- */
+
 void ChannelManager::setupChannelPostRecording(Channel& ch, Frame currentFrame)
 {
 	/* Start sample channels in loop mode right away. */
@@ -335,7 +412,7 @@ void ChannelManager::setupChannelPostRecording(Channel& ch, Frame currentFrame)
 
 /* -------------------------------------------------------------------------- */
 
-void ChannelManager::recordChannel(Channel& ch, const mcl::AudioBuffer& buffer, Frame recordedFrames, Frame currentFrame)
+void ChannelManager::recordChannel(Channel& ch, const InputRecBuffer& buffer, Frame recordedFrames, Frame currentFrame)
 {
 	assert(onChannelRecorded != nullptr);
 
@@ -343,33 +420,28 @@ void ChannelManager::recordChannel(Channel& ch, const mcl::AudioBuffer& buffer,
 
 	G_DEBUG("Created new Wave, size=" << wave->getBuffer().countFrames());
 
-	/* Copy up to wave.getSize() from the mixer's input buffer into wave's. */
+	/* Copy up to wave.getSize() from the mixer's rec chunks into wave's. */
 
-	wave->getBuffer().set(buffer, wave->getBuffer().countFrames());
+	buffer.copyTo(wave->getBuffer(), wave->getBuffer().countFrames());
 
 	/* Update channel with the new Wave. */
 
 	m_model.addShared(std::move(wave));
 	loadSampleChannel(ch, &m_model.backShared<Wave>());
 	setupChannelPostRecording(ch, currentFrame);
-
-	m_model.swap(model::SwapType::HARD);
 }
 
 /* -------------------------------------------------------------------------- */
 
-void ChannelManager::overdubChannel(Channel& ch, const mcl::AudioBuffer& buffer, Frame currentFrame)
+std::unique_ptr<Wave> ChannelManager::overdubChannel(Channel& ch, const InputRecBuffer& buffer, Frame currentFrame)
 {
-	Wave* wave = ch.samplePlayer->getWave();
-
-	/* Need model::DataLock here, as data might be being read by the audio
-	thread at the same time. */
-
-	model::DataLock lock = m_model.lockData();
-
-	wave->getBuffer().sum(buffer, /*gain=*/1.0f);
-	wave->setLogical(true);
+	std::unique_ptr<Wave> oldWave = replaceWave(*ch.samplePlayer->getWave(), [&buffer](Wave& w) {
+		buffer.sumTo(w.getBuffer());
+		w.setLogical(true);
+	});
 
 	setupChannelPostRecording(ch, currentFrame);
+
+	return oldWave;
 }
 } // namespace giada::m
@@ -32,11 +32,6 @@
 #include <map>
 #include <memory>
 
-namespace mcl
-{
-class AudioBuffer;
-}
-
 namespace giada::m::model
 {
 class Model;
@@ -45,10 +40,12 @@ class Model;
 namespace giada::m
 {
 class Channel;
+struct ChannelShared;
 class ChannelFactory;
 class WaveFactory;
 class Wave;
 class Plugin;
+class InputRecBuffer;
 class ChannelManager final
 {
 public:
@@ -77,6 +74,15 @@ public:
 	float getMasterInVol() const;
 	float getMasterOutVol() const;
 
+	/* setVolume, setPan, setPitch
+	Store a continuous parameter straight into the channel's shared state. No
+	event and no Layout swap: safe to call on every knob or fader move, from
+	the main or the MIDI thread. */
+
+	void setVolume(ID channelId, float v);
+	void setPan(ID channelId, float v);
+	void setPitch(ID channelId, float v);
+
 	/* getLastChannelPosition
 	Returns the position of the last channel located in column 'columnId'. */
 
@@ -123,11 +129,18 @@ public:
 
 	void cloneChannel(ID channelId, int bufferSize, const std::vector<Plugin*>&);
 
+	/* editWave
+	Applies 'f' to a copy of the Wave loaded in channel 'channelId', then 
+	publishes the copy. The audio thread keeps playing the original until the
+	next swap, after which the original is retired. */
+
+	void editWave(ID channelId, std::function<void(Wave&)> f);
+
 	/* finalizeInputRec
     Fills armed Sample channel with audio data coming from an input recording
     session. */
 
-	void finalizeInputRec(const mcl::AudioBuffer&, Frame recordedFrames, Frame currentFrame);
+	void finalizeInputRec(const InputRecBuffer&, Frame recordedFrames, Frame currentFrame);
 
 	/* onChannelsAltered
 	Fired when something is done on channels (added, removed, loaded, ...). */
@@ -144,6 +157,14 @@ public:
 private:
 	void loadSampleChannel(Channel&, Wave*) const;
 
+	/* getShared
+	Returns the shared state of channel 'channelId', or nullptr if the channel
+	is gone. Doesn't go through the Layout, so it can be called from the MIDI
+	and Event Dispatcher threads: keep a model read scope around while using 
+	the result (see Model::findChannelShared()). */
+
+	ChannelShared* getShared(ID channelId) const;
+
 	/* getColumn
 	Returns all channels that belongs to column 'columnId'. Read-only. */
 
@@ -158,16 +179,23 @@ private:
 
 	void setupChannelPostRecording(Channel&, Frame currentFrame);
 
+	/* replaceWave
+	Applies 'f' to a copy of Wave 'w' and points all channels using 'w' to the
+	copy. Returns the original, to be retired after the next swap. */
+
+	std::unique_ptr<Wave> replaceWave(const Wave& w, std::function<void(Wave&)> f);
+
 	/* recordChannel
 	Records the current Mixer audio input data into an empty channel. */
 
-	void recordChannel(Channel&, const mcl::AudioBuffer&, Frame recordedFrames, Frame currentFrame);
+	void recordChannel(Channel&, const InputRecBuffer&, Frame recordedFrames, Frame currentFrame);
 
 	/* overdubChannel
 	Records the current Mixer audio input data into a channel with an existing
-	Wave, overdub mode. */
+	Wave, overdub mode. Returns the old Wave, to be retired after the next 
+	swap. */
 
-	void overdubChannel(Channel&, const mcl::AudioBuffer&, Frame currentFrame);
+	std::unique_ptr<Wave> overdubChannel(Channel&, const InputRecBuffer&, Frame currentFrame);
 
 	model::Model&   m_model;
 	ChannelFactory& m_channelFactory;
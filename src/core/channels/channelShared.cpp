@@ -25,11 +25,14 @@
  * -------------------------------------------------------------------------- */
 
 #include "core/channels/channelShared.h"
+#include "core/dsp/kernels.h"
+#include <algorithm>
 
 namespace giada::m
 {
-ChannelShared::ChannelShared(Frame bufferSize)
-: audioBuffer(bufferSize, G_MAX_IO_CHANS)
+ChannelShared::ChannelShared(ID channelId, Frame bufferSize)
+: id(channelId)
+, audioBuffer(bufferSize, G_MAX_IO_CHANS)
 {
 }
 
@@ -41,4 +44,40 @@ bool ChannelShared::isReadingActions() const
 	const bool          read   = readActions.load();
 	return read && (status == ChannelStatus::PLAY || status == ChannelStatus::ENDING);
 }
-} // namespace giada::m
\ No newline at end of file
+
+/* -------------------------------------------------------------------------- */
+
+Frame ChannelShared::getIdleHoldFrames(int sampleRate)
+{
+	return static_cast<Frame>(G_IDLE_HOLD_SECONDS * sampleRate);
+}
+
+/* -------------------------------------------------------------------------- */
+
+bool ChannelShared::isSilent(Frame holdFrames) const
+{
+	return silentFrames >= holdFrames;
+}
+
+/* -------------------------------------------------------------------------- */
+
+bool ChannelShared::updateIdle(bool isIdle)
+{
+	const bool wasIdle = idle;
+	if (wasIdle && !isIdle)
+		silentFrames = 0;
+	idle = isIdle;
+	return wasIdle;
+}
+
+/* -------------------------------------------------------------------------- */
+
+void ChannelShared::updateSilence(Frame holdFrames)
+{
+	const float peak = dsp::peak(audioBuffer[0], audioBuffer.countFrames() * audioBuffer.countChannels());
+	if (peak > G_SILENCE_THRESHOLD)
+		silentFrames = 0;
+	else
+		silentFrames = std::min(silentFrames + audioBuffer.countFrames(), holdFrames);
+}
+} // namespace giada::m
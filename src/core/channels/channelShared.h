@@ -30,6 +30,8 @@
 #include "core/channels/samplePlayer.h"
 #include "core/const.h"
 #include "core/midiEvent.h"
+#include "core/mpscQueue.h"
+#include "core/profiler.h"
 #include "core/queue.h"
 #include "core/resampler.h"
 #include "deps/mcl-audio-buffer/src/audioBuffer.hpp"
@@ -40,13 +42,46 @@ namespace giada::m
 {
 struct ChannelShared final
 {
-	using MidiQueue   = Queue<MidiEvent, 32>;
+	/* MidiQueue
+	Events for the plug-ins, filled by the Event Dispatcher, the sequencer and
+	the MIDI input thread (see MidiDispatcher's direct path), read by 
+	MidiReceiver on each block. */
+
+	using MidiQueue   = MpscQueue<MidiEvent, 64>;
 	using RenderQueue = Queue<SamplePlayer::Render, 2>;
 
-	ChannelShared(Frame bufferSize);
+	ChannelShared(ID channelId, Frame bufferSize);
 
 	bool isReadingActions() const;
 
+	/* getIdleHoldFrames
+	Returns G_IDLE_HOLD_SECONDS in frames at 'sampleRate'. */
+
+	static Frame getIdleHoldFrames(int sampleRate);
+
+	/* isSilent
+	True if the last 'holdFrames' frames rendered were all silent. */
+
+	bool isSilent(Frame holdFrames) const;
+
+	/* updateIdle
+	Sets whether the channel is idle in the current block and returns the 
+	previous state. Waking up starts the silence count over, so that the whole
+	hold applies after every wake (e.g. a note-on with a slow attack). */
+
+	bool updateIdle(bool idle);
+
+	/* updateSilence
+	Counts the consecutive frames rendered below G_SILENCE_THRESHOLD, given the
+	freshly rendered audioBuffer, up to 'holdFrames'. */
+
+	void updateSilence(Frame holdFrames);
+
+	/* id
+	ID of the channel this state belongs to. */
+
+	ID id;
+
 	mcl::AudioBuffer audioBuffer;
 	juce::MidiBuffer midiBuffer;
 	MidiQueue        midiQueue;
@@ -56,8 +91,33 @@ struct ChannelShared final
 	WeakAtomic<ChannelStatus> recStatus   = ChannelStatus::OFF;
 	WeakAtomic<bool>          readActions = false;
 
+	/* volume, pan, pitch
+	Continuous parameters. Written in place by the UI and the MIDI thread, read
+	by the audio thread on each block: the last value wins and a knob drag 
+	doesn't go through the Event Dispatcher nor swap the Layout. They live here
+	rather than in Channel, so the Patch reads them on serialization. */
+
+	WeakAtomic<float> volume = G_DEFAULT_VOL;
+	WeakAtomic<float> pan    = G_DEFAULT_PAN;
+	WeakAtomic<float> pitch  = G_DEFAULT_PITCH;
+
 	std::optional<Quantizer> quantizer;
 
+	/* profile
+	CPU usage of this channel, plug-ins included. Filled by the Mixer only when
+	the Profiler is enabled. */
+
+	Profiler::Stats profile;
+
+	/* silentFrames, idle
+	Idle-channel detection, touched by the audio thread only. 'silentFrames' 
+	counts consecutive frames rendered below the silence threshold since the 
+	last wake; 'idle' is true if the channel has been skipped in the current
+	block. See Channel::isIdle(). */
+
+	Frame silentFrames = 0;
+	bool  idle         = false;
+
 	/* Optional render queue for sample-based channels. Used by SampleReactor
 	and SampleAdvancer to instruct SamplePlayer how to render audio. */
 
@@ -41,7 +41,7 @@ MidiActionRecorder::MidiActionRecorder(ActionRecorder& a)
 void MidiActionRecorder::react(ID channelId, const EventDispatcher::Event& e,
     Frame currentFrameQuantized, bool& hasActions)
 {
-	if (e.type == EventDispatcher::EventType::MIDI)
+	if (e.type == EventDispatcher::EventType::MIDI || e.type == EventDispatcher::EventType::MIDI_DIRECT)
 	{
 		MidiEvent flat(std::get<Action>(e.data).event);
 		flat.setChannel(0);
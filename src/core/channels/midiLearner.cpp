@@ -32,6 +32,7 @@ namespace giada::m
 MidiLearner::MidiLearner()
 : enabled(false)
 , filter(-1)
+, device(-1)
 {
 }
 
@@ -40,6 +41,7 @@ MidiLearner::MidiLearner()
 MidiLearner::MidiLearner(const Patch::Channel& p)
 : enabled(p.midiIn)
 , filter(p.midiInFilter)
+, device(p.midiInDevice)
 , keyPress(p.midiInKeyPress)
 , keyRelease(p.midiInKeyRel)
 , kill(p.midiInKill)
@@ -54,8 +56,8 @@ MidiLearner::MidiLearner(const Patch::Channel& p)
 
 /* -------------------------------------------------------------------------- */
 
-bool MidiLearner::isAllowed(int c) const
+bool MidiLearner::isAllowed(int c, int d) const
 {
-	return enabled && (filter == -1 || filter == c);
+	return enabled && (filter == -1 || filter == c) && (device == -1 || device == d);
 }
 } // namespace giada::m
\ No newline at end of file
@@ -40,9 +40,10 @@ public:
 	MidiLearner(const MidiLearner&) = default;
 
 	/* isAllowed
-    Tells whether the MIDI channel 'c' is enabled to receive MIDI data. */
+    Tells whether the MIDI channel 'c' of input device 'device' is enabled to 
+	receive MIDI data. */
 
-	bool isAllowed(int c) const;
+	bool isAllowed(int c, int device) const;
 
 	/* enabled
     Tells whether MIDI learning is enabled for the current channel. */
@@ -55,6 +56,11 @@ public:
 
 	int filter;
 
+	/* device
+	Which MIDI input device messages are accepted from. If -1 means 'all'. */
+
+	int device;
+
 	/* MIDI learning fields. */
 
 	MidiLearnParam keyPress;
@@ -41,7 +41,7 @@ void MidiReceiver::react(ChannelShared::MidiQueue& midiQueue, const EventDispatc
 	case EventDispatcher::EventType::KEY_KILL:
 	case EventDispatcher::EventType::SEQUENCER_STOP:
 	case EventDispatcher::EventType::SEQUENCER_REWIND:
-		sendToPlugins(midiQueue, MidiEvent(G_MIDI_ALL_NOTES_OFF), 0);
+		sendToPlugins(midiQueue, MidiEvent(G_MIDI_ALL_NOTES_OFF), e.delta);
 		break;
 
 	default:
@@ -55,7 +55,7 @@ void MidiReceiver::advance(ID channelId, ChannelShared::MidiQueue& midiQueue, co
 {
 	if (e.type != Sequencer::EventType::ACTIONS)
 		return;
-	for (const Action& action : *e.actions)
+	for (const Action& action : e.actions)
 		if (action.channelId == channelId)
 			sendToPlugins(midiQueue, action.event, e.delta);
 }
@@ -96,6 +96,6 @@ void MidiReceiver::parseMidi(ChannelShared::MidiQueue& midiQueue, const MidiEven
 
 	MidiEvent flat(e);
 	flat.setChannel(0);
-	sendToPlugins(midiQueue, flat, /*delta=*/0);
+	sendToPlugins(midiQueue, flat, flat.getDelta());
 }
 } // namespace giada::m
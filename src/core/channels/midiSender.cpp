@@ -34,6 +34,7 @@ MidiSender::MidiSender(KernelMidi& k)
 : kernelMidi(&k)
 , enabled(false)
 , filter(0)
+, device(-1)
 , onSend(nullptr)
 {
 }
@@ -44,6 +45,7 @@ MidiSender::MidiSender(const Patch::Channel& p, KernelMidi& k)
 : kernelMidi(&k)
 , enabled(p.midiOut)
 , filter(p.midiOutChan)
+, device(p.midiOutDevice)
 {
 }
 
@@ -56,7 +58,7 @@ void MidiSender::react(const EventDispatcher::Event& e)
 
 	if (e.type == EventDispatcher::EventType::KEY_KILL ||
 	    e.type == EventDispatcher::EventType::SEQUENCER_STOP)
-		send(MidiEvent(G_MIDI_ALL_NOTES_OFF));
+		send(MidiEvent(G_MIDI_ALL_NOTES_OFF), /*delta=*/0);
 }
 
 /* -------------------------------------------------------------------------- */
@@ -66,26 +68,26 @@ void MidiSender::advance(ID channelId, const Sequencer::Event& e) const
 	if (!enabled)
 		return;
 	if (e.type == Sequencer::EventType::ACTIONS)
-		parseActions(channelId, *e.actions);
+		parseActions(channelId, e.actions, e.delta);
 }
 
 /* -------------------------------------------------------------------------- */
 
-void MidiSender::send(MidiEvent e) const
+void MidiSender::send(MidiEvent e, Frame delta) const
 {
 	assert(onSend != nullptr);
 
 	e.setChannel(filter);
-	kernelMidi->send(e.getRaw());
+	kernelMidi->schedule(e.getRaw(), 3, delta, device);
 	onSend();
 }
 
 /* -------------------------------------------------------------------------- */
 
-void MidiSender::parseActions(ID channelId, const std::vector<Action>& as) const
+void MidiSender::parseActions(ID channelId, const ActionMap::View& as, Frame delta) const
 {
 	for (const Action& a : as)
 		if (a.channelId == channelId)
-			send(a.event);
+			send(a.event, delta);
 }
 } // namespace giada::m
\ No newline at end of file
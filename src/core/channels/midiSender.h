@@ -55,14 +55,23 @@ public:
 
 	int filter;
 
+	/* device
+	Which MIDI output device data should be sent to. If -1 means 'all'. */
+
+	int device;
+
 	/* onSend
 	Callback fired when a MIDI signal has been sent. */
 
 	std::function<void()> onSend;
 
 private:
-	void send(MidiEvent e) const;
-	void parseActions(ID channelId, const std::vector<Action>& as) const;
+	/* send
+	Schedules event 'e' to go out when frame 'delta' of the current block 
+	reaches the audio output. */
+
+	void send(MidiEvent e, Frame delta) const;
+	void parseActions(ID channelId, const ActionMap::View& as, Frame delta) const;
 };
 } // namespace giada::m
 
@@ -36,8 +36,7 @@ using namespace mcl;
 namespace giada::m
 {
 SamplePlayer::SamplePlayer(Resampler* r)
-: pitch(G_DEFAULT_PITCH)
-, mode(SamplePlayerMode::SINGLE_BASIC)
+: mode(SamplePlayerMode::SINGLE_BASIC)
 , shift(0)
 , begin(0)
 , end(0)
@@ -49,8 +48,7 @@ SamplePlayer::SamplePlayer(Resampler* r)
 /* -------------------------------------------------------------------------- */
 
 SamplePlayer::SamplePlayer(const Patch::Channel& p, float samplerateRatio, Resampler* r, Wave* w)
-: pitch(p.pitch)
-, mode(p.mode)
+: mode(p.mode)
 , shift(p.shift)
 , begin(p.begin)
 , end(p.end)
@@ -100,14 +98,6 @@ Frame SamplePlayer::getWaveSize() const
 
 /* -------------------------------------------------------------------------- */
 
-void SamplePlayer::react(const EventDispatcher::Event& e)
-{
-	if (e.type == EventDispatcher::EventType::CHANNEL_PITCH)
-		pitch = std::get<float>(e.data);
-}
-
-/* -------------------------------------------------------------------------- */
-
 void SamplePlayer::render(ChannelShared& shared, Render renderInfo) const
 {
 	if (waveReader.wave == nullptr)
@@ -116,10 +106,11 @@ void SamplePlayer::render(ChannelShared& shared, Render renderInfo) const
 	AudioBuffer&        buf     = shared.audioBuffer;
 	Frame               tracker = std::clamp(shared.tracker.load(), begin, end); /* Make sure tracker stays within begin-end range. */
 	const ChannelStatus status  = shared.playStatus.load();
+	const float         pitch   = shared.pitch.load();
 
 	if (renderInfo.mode == Render::Mode::NORMAL)
 	{
-		tracker = render(buf, tracker, renderInfo.offset, status);
+		tracker = render(buf, tracker, renderInfo.offset, status, pitch);
 	}
 	else
 	{
@@ -129,14 +120,14 @@ void SamplePlayer::render(ChannelShared& shared, Render renderInfo) const
 		might stop the rendering): fillBuffer() is just enough. Just notify 
 		waveReader this is the last read before rewind. */
 
-		tracker = fillBuffer(buf, tracker, 0).used;
+		tracker = fillBuffer(buf, tracker, 0, pitch).used;
 		waveReader.last();
 
 		/* Mode::REWIND: 2nd = [abcdefghi|abcdfefg]
 		   Mode::STOP:   2nd = [abcdefghi|--------] */
 
 		if (renderInfo.mode == Render::Mode::REWIND)
-			tracker = render(buf, begin, renderInfo.offset, status);
+			tracker = render(buf, begin, renderInfo.offset, status, pitch);
 		else
 			tracker = stop(buf, renderInfo.offset);
 	}
@@ -146,11 +137,11 @@ void SamplePlayer::render(ChannelShared& shared, Render renderInfo) const
 
 /* -------------------------------------------------------------------------- */
 
-Frame SamplePlayer::render(AudioBuffer& buf, Frame tracker, Frame offset, ChannelStatus status) const
+Frame SamplePlayer::render(AudioBuffer& buf, Frame tracker, Frame offset, ChannelStatus status, float pitch) const
 {
 	/* First pass rendering. */
 
-	WaveReader::Result res = fillBuffer(buf, tracker, offset);
+	WaveReader::Result res = fillBuffer(buf, tracker, offset, pitch);
 	tracker += res.used;
 
 	/* Second pass rendering: if tracker has looped, special care is needed. If 
@@ -166,7 +157,7 @@ Frame SamplePlayer::render(AudioBuffer& buf, Frame tracker, Frame offset, Channe
 		onLastFrame(/*natural=*/true);
 
 		if (shouldLoop(status) && res.generated < buf.countFrames())
-			tracker += fillBuffer(buf, tracker, res.generated).used;
+			tracker += fillBuffer(buf, tracker, res.generated, pitch).used;
 	}
 
 	return tracker;
@@ -229,7 +220,7 @@ void SamplePlayer::kickIn(ChannelShared& shared, Frame f)
 
 /* -------------------------------------------------------------------------- */
 
-WaveReader::Result SamplePlayer::fillBuffer(AudioBuffer& buf, Frame start, Frame offset) const
+WaveReader::Result SamplePlayer::fillBuffer(AudioBuffer& buf, Frame start, Frame offset, float pitch) const
 {
 	return waveReader.fill(buf, start, end, offset, pitch);
 }
@@ -29,7 +29,6 @@
 
 #include "core/channels/waveReader.h"
 #include "core/const.h"
-#include "core/eventDispatcher.h"
 #include "core/patch.h"
 #include "core/sequencer.h"
 #include "core/types.h"
@@ -75,8 +74,6 @@ public:
 	Wave* getWave() const;
 	void  render(ChannelShared&, Render) const;
 
-	void react(const EventDispatcher::Event& e);
-
 	/* loadWave
 	Loads Wave and sets it up (name, markers, ...). Also updates Channel's shared
 	state accordingly. */
@@ -96,7 +93,6 @@ public:
 
 	void kickIn(ChannelShared&, Frame f);
 
-	float            pitch;
 	SamplePlayerMode mode;
 	Frame            shift;
 	Frame            begin;
@@ -118,7 +114,7 @@ private:
 	into the audio buffer at position 'offset'. May fire 'onLastFrame' callback
 	if the sample end is reached. */
 
-	Frame render(mcl::AudioBuffer&, Frame tracker, Frame offset, ChannelStatus) const;
+	Frame render(mcl::AudioBuffer&, Frame tracker, Frame offset, ChannelStatus, float pitch) const;
 
 	/* stop
 	Silences the last part of the audio buffer, starting at 'offset'. Used to
@@ -126,7 +122,7 @@ private:
 
 	Frame stop(mcl::AudioBuffer&, Frame offset) const;
 
-	WaveReader::Result fillBuffer(mcl::AudioBuffer&, Frame start, Frame offset) const;
+	WaveReader::Result fillBuffer(mcl::AudioBuffer&, Frame start, Frame offset, float pitch) const;
 	bool               shouldLoop(ChannelStatus) const;
 };
 } // namespace giada::m
@@ -65,20 +65,20 @@ void SampleReactor::react(ID channelId, ChannelShared& shared, const EventDispat
 	{
 	case EventDispatcher::EventType::KEY_PRESS:
 	{
-		press(channelId, shared, mode, std::get<int>(e.data), canQuantize, isLoop, velocityAsVol, volume_i);
+		press(channelId, shared, mode, std::get<int>(e.data), canQuantize, isLoop, velocityAsVol, volume_i, e.delta);
 		break;
 	}
 	case EventDispatcher::EventType::KEY_RELEASE:
 	{
 		if (mode == SamplePlayerMode::SINGLE_PRESS) // Key release is meaningful only for SINGLE_PRESS modes
-			release(shared);
+			release(shared, e.delta);
 		break;
 	}
 	case EventDispatcher::EventType::KEY_KILL:
 	{
 		const ChannelStatus playStatus = shared.playStatus.load();
 		if (playStatus == ChannelStatus::PLAY || playStatus == ChannelStatus::ENDING)
-			stop(shared);
+			stop(shared, e.delta);
 		break;
 	}
 	case EventDispatcher::EventType::SEQUENCER_STOP:
@@ -108,15 +108,15 @@ void SampleReactor::play(ChannelShared& shared, Frame localFrame) const
 
 /* -------------------------------------------------------------------------- */
 
-void SampleReactor::stop(ChannelShared& shared) const
+void SampleReactor::stop(ChannelShared& shared, Frame localFrame) const
 {
-	shared.renderQueue->push({SamplePlayer::Render::Mode::STOP, 0});
+	shared.renderQueue->push({SamplePlayer::Render::Mode::STOP, localFrame});
 }
 
 /* -------------------------------------------------------------------------- */
 
 ChannelStatus SampleReactor::pressWhileOff(ID channelId, ChannelShared& shared,
-    int velocity, bool canQuantize, bool velocityAsVol, float& volume_i) const
+    int velocity, bool canQuantize, bool velocityAsVol, float& volume_i, Frame localFrame) const
 {
 	if (velocityAsVol)
 		volume_i = u::math::map(velocity, G_MAX_VELOCITY, G_MAX_VOLUME);
@@ -126,14 +126,19 @@ ChannelStatus SampleReactor::pressWhileOff(ID channelId, ChannelShared& shared,
 		shared.quantizer->trigger(Q_ACTION_PLAY + channelId);
 		return ChannelStatus::OFF;
 	}
-	else
-		return ChannelStatus::PLAY;
+
+	/* Without an offset SamplePlayer just starts from the beginning of the next
+	block: no need to push anything. */
+
+	if (localFrame > 0)
+		shared.renderQueue->push({SamplePlayer::Render::Mode::NORMAL, localFrame});
+	return ChannelStatus::PLAY;
 }
 
 /* -------------------------------------------------------------------------- */
 
 ChannelStatus SampleReactor::pressWhilePlay(ID channelId, ChannelShared& shared,
-    SamplePlayerMode mode, bool canQuantize) const
+    SamplePlayerMode mode, bool canQuantize, Frame localFrame) const
 {
 	switch (mode)
 	{
@@ -141,14 +146,14 @@ ChannelStatus SampleReactor::pressWhilePlay(ID channelId, ChannelShared& shared,
 		if (canQuantize)
 			shared.quantizer->trigger(Q_ACTION_REWIND + channelId);
 		else
-			rewind(shared, /*localFrame=*/0);
+			rewind(shared, localFrame);
 		return ChannelStatus::PLAY;
 
 	case SamplePlayerMode::SINGLE_ENDLESS:
 		return ChannelStatus::ENDING;
 
 	case SamplePlayerMode::SINGLE_BASIC:
-		stop(shared);
+		stop(shared, localFrame);
 		return ChannelStatus::PLAY; // Let SamplePlayer stop it once done
 
 	default:
@@ -159,7 +164,7 @@ ChannelStatus SampleReactor::pressWhilePlay(ID channelId, ChannelShared& shared,
 /* -------------------------------------------------------------------------- */
 
 void SampleReactor::press(ID channelId, ChannelShared& shared, SamplePlayerMode mode,
-    int velocity, bool canQuantize, bool isLoop, bool velocityAsVol, float& volume_i) const
+    int velocity, bool canQuantize, bool isLoop, bool velocityAsVol, float& volume_i, Frame localFrame) const
 {
 	ChannelStatus playStatus = shared.playStatus.load();
 
@@ -169,14 +174,14 @@ void SampleReactor::press(ID channelId, ChannelShared& shared, SamplePlayerMode
 		if (isLoop)
 			playStatus = ChannelStatus::WAIT;
 		else
-			playStatus = pressWhileOff(channelId, shared, velocity, canQuantize, velocityAsVol, volume_i);
+			playStatus = pressWhileOff(channelId, shared, velocity, canQuantize, velocityAsVol, volume_i, localFrame);
 		break;
 
 	case ChannelStatus::PLAY:
 		if (isLoop)
 			playStatus = ChannelStatus::ENDING;
 		else
-			playStatus = pressWhilePlay(channelId, shared, mode, canQuantize);
+			playStatus = pressWhilePlay(channelId, shared, mode, canQuantize, localFrame);
 		break;
 
 	case ChannelStatus::WAIT:
@@ -196,14 +201,14 @@ void SampleReactor::press(ID channelId, ChannelShared& shared, SamplePlayerMode
 
 /* -------------------------------------------------------------------------- */
 
-void SampleReactor::release(ChannelShared& shared) const
+void SampleReactor::release(ChannelShared& shared, Frame localFrame) const
 {
 	/* Kill it if it's SINGLE_PRESS is playing. Otherwise there might be a 
 	quantization step in progress that would play the channel later on: 
 	disable it. */
 
 	if (shared.playStatus.load() == ChannelStatus::PLAY)
-		stop(shared); // Let SamplePlayer stop it once done
+		stop(shared, localFrame); // Let SamplePlayer stop it once done
 	else if (shared.quantizer->hasBeenTriggered())
 		shared.quantizer->clear();
 }
@@ -226,7 +231,7 @@ void SampleReactor::onStopBySeq(ChannelShared& shared, bool chansStopOnSeqHalt,
 
 	case ChannelStatus::PLAY:
 		if (chansStopOnSeqHalt && (isLoop || isReadingActions))
-			stop(shared);
+			stop(shared, /*localFrame=*/0);
 		break;
 
 	default:
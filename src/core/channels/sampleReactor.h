@@ -59,14 +59,19 @@ public:
 	    float& volume_i) const;
 
 private:
+	/* Frame localFrame
+	Where the action takes place in the next audio block, for sample-accurate
+	reactions to timestamped events (e.g. MIDI input). Quantized actions ignore
+	it: the quantizer provides its own offset. */
+
 	void          onStopBySeq(ChannelShared&, bool chansStopOnSeqHalt, bool isLoop) const;
-	void          release(ChannelShared&) const;
-	void          press(ID channelId, ChannelShared&, SamplePlayerMode, int velocity, bool canQuantize, bool isLoop, bool velocityAsVol, float& volume_i) const;
-	ChannelStatus pressWhilePlay(ID channelId, ChannelShared&, SamplePlayerMode, bool canQuantize) const;
-	ChannelStatus pressWhileOff(ID channelId, ChannelShared&, int velocity, bool canQuantize, bool velocityAsVol, float& volume_i) const;
+	void          release(ChannelShared&, Frame localFrame) const;
+	void          press(ID channelId, ChannelShared&, SamplePlayerMode, int velocity, bool canQuantize, bool isLoop, bool velocityAsVol, float& volume_i, Frame localFrame) const;
+	ChannelStatus pressWhilePlay(ID channelId, ChannelShared&, SamplePlayerMode, bool canQuantize, Frame localFrame) const;
+	ChannelStatus pressWhileOff(ID channelId, ChannelShared&, int velocity, bool canQuantize, bool velocityAsVol, float& volume_i, Frame localFrame) const;
 	void          rewind(ChannelShared&, Frame localFrame) const;
 	void          play(ChannelShared&, Frame localFrame) const;
-	void          stop(ChannelShared&) const;
+	void          stop(ChannelShared&, Frame localFrame) const;
 };
 
 } // namespace giada::m
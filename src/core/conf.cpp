@@ -30,6 +30,7 @@
 #include "utils/fs.h"
 #include "utils/log.h"
 #include <FL/Fl.H>
+#include <algorithm>
 #include <cassert>
 #include <fstream>
 #include <nlohmann/json.hpp>
@@ -71,13 +72,20 @@ bool Conf::read()
 	data.buffersize                 = j.value(CONF_KEY_BUFFER_SIZE, data.buffersize);
 	data.limitOutput                = j.value(CONF_KEY_LIMIT_OUTPUT, data.limitOutput);
 	data.rsmpQuality                = j.value(CONF_KEY_RESAMPLE_QUALITY, data.rsmpQuality);
+	data.renderThreads              = j.value(CONF_KEY_RENDER_THREADS, data.renderThreads);
+	data.nullDeviceInputPath        = j.value(CONF_KEY_NULL_DEVICE_INPUT_PATH, data.nullDeviceInputPath);
+	data.profilerEnabled            = j.value(CONF_KEY_PROFILER_ENABLED, data.profilerEnabled);
 	data.midiSystem                 = j.value(CONF_KEY_MIDI_SYSTEM, data.midiSystem);
 	data.midiPortOut                = j.value(CONF_KEY_MIDI_PORT_OUT, data.midiPortOut);
 	data.midiPortIn                 = j.value(CONF_KEY_MIDI_PORT_IN, data.midiPortIn);
+	data.midiExtraPortsOut          = j.value(CONF_KEY_MIDI_EXTRA_PORTS_OUT, data.midiExtraPortsOut);
+	data.midiExtraPortsIn           = j.value(CONF_KEY_MIDI_EXTRA_PORTS_IN, data.midiExtraPortsIn);
 	data.midiMapPath                = j.value(CONF_KEY_MIDIMAP_PATH, data.midiMapPath);
 	data.lastFileMap                = j.value(CONF_KEY_LAST_MIDIMAP, data.lastFileMap);
 	data.midiSync                   = j.value(CONF_KEY_MIDI_SYNC, data.midiSync);
 	data.midiTCfps                  = j.value(CONF_KEY_MIDI_TC_FPS, data.midiTCfps);
+	data.midiClockBandwidth         = j.value(CONF_KEY_MIDI_CLOCK_BANDWIDTH, data.midiClockBandwidth);
+	data.midiInDirect               = j.value(CONF_KEY_MIDI_IN_DIRECT, data.midiInDirect);
 	data.chansStopOnSeqHalt         = j.value(CONF_KEY_CHANS_STOP_ON_SEQ_HALT, data.chansStopOnSeqHalt);
 	data.treatRecsAsLoops           = j.value(CONF_KEY_TREAT_RECS_AS_LOOPS, data.treatRecsAsLoops);
 	data.inputMonitorDefaultOn      = j.value(CONF_KEY_INPUT_MONITOR_DEFAULT_ON, data.inputMonitorDefaultOn);
@@ -177,13 +185,20 @@ bool Conf::write() const
 	j[CONF_KEY_BUFFER_SIZE]                   = data.buffersize;
 	j[CONF_KEY_LIMIT_OUTPUT]                  = data.limitOutput;
 	j[CONF_KEY_RESAMPLE_QUALITY]              = data.rsmpQuality;
+	j[CONF_KEY_RENDER_THREADS]                = data.renderThreads;
+	j[CONF_KEY_NULL_DEVICE_INPUT_PATH]        = data.nullDeviceInputPath;
+	j[CONF_KEY_PROFILER_ENABLED]              = data.profilerEnabled;
 	j[CONF_KEY_MIDI_SYSTEM]                   = data.midiSystem;
 	j[CONF_KEY_MIDI_PORT_OUT]                 = data.midiPortOut;
 	j[CONF_KEY_MIDI_PORT_IN]                  = data.midiPortIn;
+	j[CONF_KEY_MIDI_EXTRA_PORTS_OUT]          = data.midiExtraPortsOut;
+	j[CONF_KEY_MIDI_EXTRA_PORTS_IN]           = data.midiExtraPortsIn;
 	j[CONF_KEY_MIDIMAP_PATH]                  = data.midiMapPath;
 	j[CONF_KEY_LAST_MIDIMAP]                  = data.lastFileMap;
 	j[CONF_KEY_MIDI_SYNC]                     = data.midiSync;
 	j[CONF_KEY_MIDI_TC_FPS]                   = data.midiTCfps;
+	j[CONF_KEY_MIDI_CLOCK_BANDWIDTH]          = data.midiClockBandwidth;
+	j[CONF_KEY_MIDI_IN_DIRECT]                = data.midiInDirect;
 	j[CONF_KEY_MIDI_IN]                       = data.midiInEnabled;
 	j[CONF_KEY_MIDI_IN_FILTER]                = data.midiInFilter;
 	j[CONF_KEY_MIDI_IN_REWIND]                = data.midiInRewind;
@@ -303,10 +318,17 @@ void Conf::sanitize()
 	data.channelsOutStart = std::max(0, data.channelsOutStart);
 	data.channelsInCount  = std::max(1, data.channelsInCount);
 	data.channelsInStart  = std::max(0, data.channelsInStart);
+	data.renderThreads    = std::clamp(data.renderThreads, 0, G_MAX_RENDER_THREADS);
 
 	data.midiPortOut = std::max(-1, data.midiPortOut);
 	data.midiPortIn  = std::max(-1, data.midiPortIn);
 
+	const auto isNegative = [](int port) { return port < 0; };
+	data.midiExtraPortsOut.erase(std::remove_if(data.midiExtraPortsOut.begin(), data.midiExtraPortsOut.end(), isNegative), data.midiExtraPortsOut.end());
+	data.midiExtraPortsIn.erase(std::remove_if(data.midiExtraPortsIn.begin(), data.midiExtraPortsIn.end(), isNegative), data.midiExtraPortsIn.end());
+
+	data.midiClockBandwidth = std::clamp(data.midiClockBandwidth, G_MIN_MIDI_CLOCK_BANDWIDTH, G_MAX_MIDI_CLOCK_BANDWIDTH);
+
 	data.uiScaling = std::clamp(data.uiScaling, G_MIN_UI_SCALING, G_MAX_UI_SCALING);
 }
 } // namespace giada::m
\ No newline at end of file
@@ -63,14 +63,21 @@ public:
 		int         buffersize       = G_DEFAULT_BUFSIZE;
 		bool        limitOutput      = false;
 		int         rsmpQuality      = 0;
-
-		int         midiSystem  = 0;
-		int         midiPortOut = G_DEFAULT_MIDI_PORT_OUT;
-		int         midiPortIn  = G_DEFAULT_MIDI_PORT_IN;
-		std::string midiMapPath = "";
-		std::string lastFileMap = "";
-		int         midiSync    = G_MIDI_SYNC_NONE;
-		float       midiTCfps   = 25.0f;
+		int         renderThreads    = 0;
+		std::string nullDeviceInputPath;
+		bool        profilerEnabled = false;
+
+		int              midiSystem         = 0;
+		int              midiPortOut        = G_DEFAULT_MIDI_PORT_OUT;
+		int              midiPortIn         = G_DEFAULT_MIDI_PORT_IN;
+		std::vector<int> midiExtraPortsOut  = {}; // Opened after midiPortOut, see KernelMidi
+		std::vector<int> midiExtraPortsIn   = {}; // Opened after midiPortIn, see KernelMidi
+		std::string      midiMapPath        = "";
+		std::string      lastFileMap        = "";
+		int              midiSync           = G_MIDI_SYNC_NONE;
+		float            midiTCfps          = 25.0f;
+		float            midiClockBandwidth = G_DEFAULT_MIDI_CLOCK_BANDWIDTH; // Hz, see MidiClockPll
+		bool             midiInDirect       = true;                           // Direct path for notes, see MidiDispatcher
 
 		bool chansStopOnSeqHalt         = false;
 		bool treatRecsAsLoops           = false;
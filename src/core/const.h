@@ -68,11 +68,24 @@ constexpr auto CONF_FILENAME = "giada.conf";
 
 /* -- Engine ---------------------------------------------------------------- */
 /* G_EVENT_DISPATCHER_RATE_MS
-The amount of sleep between each Event Dispatcher cycle. It should be lower
-than the audio thread sleep time. Note: this value will obviously increase the 
-live input latency, keep it small! */
+The maximum amount of sleep between each Event Dispatcher cycle. The Event
+Dispatcher is woken up as soon as a new event arrives: this is just a fallback
+in case a wakeup gets lost (see Worker::notify()). */
 constexpr int G_EVENT_DISPATCHER_RATE_MS = 5;
 
+/* G_MAX_RENDER_THREADS
+Maximum number of worker threads the parallel channel renderer can spawn. Zero
+threads in the configuration means serial rendering on the audio thread. */
+constexpr int G_MAX_RENDER_THREADS = 16;
+
+/* G_SILENCE_THRESHOLD, G_IDLE_HOLD_SECONDS
+A channel whose output stays below G_SILENCE_THRESHOLD (about -120 dB) for at
+least G_IDLE_HOLD_SECONDS, with nothing that could wake it up, is considered 
+idle and is not rendered. The hold time lets plug-in tails (reverbs, delays, 
+...) ring out. */
+constexpr float G_SILENCE_THRESHOLD = 0.000001f;
+constexpr float G_IDLE_HOLD_SECONDS = 2.0f;
+
 /* -- GUI ------------------------------------------------------------------- */
 constexpr int   G_GUI_FPS            = 30;
 constexpr float G_GUI_REFRESH_RATE   = 1 / static_cast<float>(G_GUI_FPS);
@@ -100,6 +113,7 @@ constexpr float G_MAX_BPM               = 999.0f;
 constexpr auto  G_MAX_BPM_STR           = "999.0";
 constexpr int   G_MAX_BEATS             = 32;
 constexpr int   G_MAX_BARS              = 32;
+constexpr int   G_PPQ                   = 960000; // Ticks per beat, see TempoMap
 constexpr int   G_MAX_QUANTIZE          = 8;
 constexpr float G_MIN_DB_SCALE          = 60.0f;
 constexpr int   G_MIN_COLUMN_WIDTH      = 140;
@@ -113,8 +127,10 @@ constexpr int   G_MIN_GUI_HEIGHT        = 510;
 constexpr int   G_MAX_IO_CHANS          = 2;
 constexpr int   G_MAX_VELOCITY          = 0x7F;
 constexpr int   G_MAX_MIDI_CHANS        = 16;
-constexpr int   G_MAX_DISPATCHER_EVENTS = 32;
+constexpr int   G_MAX_DISPATCHER_EVENTS = 256;  // Power of two
 constexpr int   G_MAX_SEQUENCER_EVENTS  = 128;  // Per block
+constexpr int   G_MAX_SEQUENCER_BUCKETS = 1024; // Per block, see ActionBuckets
+constexpr int   G_MAX_MIDI_OUT_EVENTS   = 512;  // Power of two
 constexpr float G_MIN_UI_SCALING        = 0.0f; // Auto: FLTK will figure it out
 constexpr float G_MAX_UI_SCALING        = 4.0f;
 
@@ -127,6 +143,7 @@ constexpr int G_SYS_API_ASIO   = 4;
 constexpr int G_SYS_API_CORE   = 5;
 constexpr int G_SYS_API_PULSE  = 6;
 constexpr int G_SYS_API_WASAPI = 7;
+constexpr int G_SYS_API_NULL   = 8; // Timer-driven, no audio device
 
 /* -- kernel midi ----------------------------------------------------------- */
 constexpr int G_MIDI_API_JACK = 1;
@@ -267,6 +284,14 @@ constexpr int G_MIDI_SYNC_CLOCK_S = 2; // slave
 constexpr int G_MIDI_SYNC_MTC_M   = 3; // master
 constexpr int G_MIDI_SYNC_MTC_S   = 4; // slave
 
+/* G_[...]_MIDI_CLOCK_BANDWIDTH
+Bandwidth of the loop that follows an external MIDI clock, in Hz. Lower values
+filter out more jitter, higher ones follow tempo changes faster. */
+
+constexpr float G_MIN_MIDI_CLOCK_BANDWIDTH     = 0.05f;
+constexpr float G_MAX_MIDI_CLOCK_BANDWIDTH     = 10.0f;
+constexpr float G_DEFAULT_MIDI_CLOCK_BANDWIDTH = 0.5f;
+
 /* JSON patch keys */
 
 constexpr auto PATCH_KEY_HEADER                       = "header";
@@ -307,6 +332,7 @@ constexpr auto PATCH_KEY_CHANNEL_MIDI_IN_ARM          = "midi_in_arm";
 constexpr auto PATCH_KEY_CHANNEL_MIDI_IN_VOLUME       = "midi_in_volume";
 constexpr auto PATCH_KEY_CHANNEL_MIDI_IN_MUTE         = "midi_in_mute";
 constexpr auto PATCH_KEY_CHANNEL_MIDI_IN_FILTER       = "midi_in_filter";
+constexpr auto PATCH_KEY_CHANNEL_MIDI_IN_DEVICE       = "midi_in_device";
 constexpr auto PATCH_KEY_CHANNEL_MIDI_IN_SOLO         = "midi_in_solo";
 constexpr auto PATCH_KEY_CHANNEL_MIDI_OUT_L           = "midi_out_l";
 constexpr auto PATCH_KEY_CHANNEL_MIDI_OUT_L_PLAYING   = "midi_out_l_playing";
@@ -327,6 +353,7 @@ constexpr auto PATCH_KEY_CHANNEL_MIDI_IN_READ_ACTIONS = "midi_in_read_actions";
 constexpr auto PATCH_KEY_CHANNEL_MIDI_IN_PITCH        = "midi_in_pitch";
 constexpr auto PATCH_KEY_CHANNEL_MIDI_OUT             = "midi_out";
 constexpr auto PATCH_KEY_CHANNEL_MIDI_OUT_CHAN        = "midi_out_chan";
+constexpr auto PATCH_KEY_CHANNEL_MIDI_OUT_DEVICE      = "midi_out_device";
 constexpr auto PATCH_KEY_CHANNEL_PLUGINS              = "plugins";
 constexpr auto PATCH_KEY_CHANNEL_PLUGIN_ID            = "plugin_id";
 constexpr auto PATCH_KEY_CHANNEL_ARMED                = "armed";
@@ -372,13 +399,20 @@ constexpr auto CONF_KEY_BUFFER_SIZE                   = "buffer_size";
 constexpr auto CONF_KEY_DELAY_COMPENSATION            = "delay_compensation";
 constexpr auto CONF_KEY_LIMIT_OUTPUT                  = "limit_output";
 constexpr auto CONF_KEY_RESAMPLE_QUALITY              = "resample_quality";
+constexpr auto CONF_KEY_RENDER_THREADS                = "render_threads";
+constexpr auto CONF_KEY_NULL_DEVICE_INPUT_PATH        = "null_device_input_path";
+constexpr auto CONF_KEY_PROFILER_ENABLED              = "profiler_enabled";
 constexpr auto CONF_KEY_MIDI_SYSTEM                   = "midi_system";
 constexpr auto CONF_KEY_MIDI_PORT_OUT                 = "midi_port_out";
 constexpr auto CONF_KEY_MIDI_PORT_IN                  = "midi_port_in";
+constexpr auto CONF_KEY_MIDI_EXTRA_PORTS_OUT          = "midi_extra_ports_out";
+constexpr auto CONF_KEY_MIDI_EXTRA_PORTS_IN           = "midi_extra_ports_in";
 constexpr auto CONF_KEY_MIDIMAP_PATH                  = "midimap_path";
 constexpr auto CONF_KEY_LAST_MIDIMAP                  = "last_midimap";
 constexpr auto CONF_KEY_MIDI_SYNC                     = "midi_sync";
 constexpr auto CONF_KEY_MIDI_TC_FPS                   = "midi_tc_fps";
+constexpr auto CONF_KEY_MIDI_CLOCK_BANDWIDTH          = "midi_clock_bandwidth";
+constexpr auto CONF_KEY_MIDI_IN_DIRECT                = "midi_in_direct";
 constexpr auto CONF_KEY_MIDI_IN                       = "midi_in";
 constexpr auto CONF_KEY_MIDI_IN_FILTER                = "midi_in_filter";
 constexpr auto CONF_KEY_MIDI_IN_REWIND                = "midi_in_rewind";
@@ -0,0 +1,64 @@
+/* -----------------------------------------------------------------------------
+ *
+ * Giada - Your Hardcore Loopmachine
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2022 Giovanni A. Zuliani | Monocasual Laboratories
+ *
+ * This file is part of Giada - Your Hardcore Loopmachine.
+ *
+ * Giada - Your Hardcore Loopmachine is free software: you can
+ * redistribute it and/or modify it under the terms of the GNU General
+ * Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * Giada - Your Hardcore Loopmachine is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Giada - Your Hardcore Loopmachine. If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------- */
+
+#ifndef G_DSP_KERNEL_TABLE_H
+#define G_DSP_KERNEL_TABLE_H
+
+/* Internal header, shared by the per-ISA implementations only. Keep it free of
+inline functions and standard headers: files compiled with extra instruction
+sets (e.g. -mavx2) must not emit code the linker could pick for the generic
+build. */
+
+namespace giada::m::dsp
+{
+/* KernelTable
+Set of function pointers implementing all kernels for a given instruction set.
+Buffers are interleaved: even/odd samples are left/right channels of stereo
+buffers. */
+
+struct KernelTable
+{
+	const char* name;
+
+	void (*sum)(float* dst, const float* src, int samples, float gainEven, float gainOdd);
+	void (*gain)(float* buf, int samples, float g);
+	void (*clip)(float* buf, int samples, float min, float max);
+	void (*peak)(const float* buf, int samples, float* peakEven, float* peakOdd);
+	float (*sumSquares)(const float* buf, int samples);
+	void (*interleave2)(float* dst, const float* left, const float* right, int frames);
+	void (*deinterleave2)(float* left, float* right, const float* src, int frames);
+};
+
+/* get[ISA]Table
+Return nullptr if the instruction set hasn't been compiled in. */
+
+const KernelTable* getScalarTable();
+const KernelTable* getSse2Table();
+const KernelTable* getAvx2Table();
+const KernelTable* getNeonTable();
+} // namespace giada::m::dsp
+
+#endif
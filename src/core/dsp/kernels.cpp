@@ -0,0 +1,304 @@
+/* -----------------------------------------------------------------------------
+ *
+ * Giada - Your Hardcore Loopmachine
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2022 Giovanni A. Zuliani | Monocasual Laboratories
+ *
+ * This file is part of Giada - Your Hardcore Loopmachine.
+ *
+ * Giada - Your Hardcore Loopmachine is free software: you can
+ * redistribute it and/or modify it under the terms of the GNU General
+ * Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * Giada - Your Hardcore Loopmachine is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Giada - Your Hardcore Loopmachine. If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------- */
+
+#include "core/dsp/kernels.h"
+#include "core/dsp/kernelTable.h"
+#include "deps/mcl-audio-buffer/src/audioBuffer.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <cmath>
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h>
+#endif
+
+namespace giada::m::dsp
+{
+namespace
+{
+/* hasAvx2_
+Runtime check for AVX2 support, OS support for the extended registers 
+included. */
+
+bool hasAvx2_()
+{
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+	__builtin_cpu_init();
+	return __builtin_cpu_supports("avx2");
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+	int info[4];
+	__cpuid(info, 0);
+	if (info[0] < 7)
+		return false;
+	__cpuid(info, 1);
+	const bool osxsave = info[2] & (1 << 27);
+	const bool avx     = info[2] & (1 << 28);
+	if (!osxsave || !avx || (_xgetbv(0) & 0x6) != 0x6)
+		return false;
+	__cpuidex(info, 7, 0);
+	return info[1] & (1 << 5);
+#else
+	return false;
+#endif
+}
+
+/* -------------------------------------------------------------------------- */
+
+const KernelTable* getTable_(Isa isa)
+{
+	switch (isa)
+	{
+	case Isa::SSE2:
+		return getSse2Table();
+	case Isa::AVX2:
+		return hasAvx2_() ? getAvx2Table() : nullptr;
+	case Isa::NEON:
+		return getNeonTable();
+	default:
+		return getScalarTable();
+	}
+}
+
+/* -------------------------------------------------------------------------- */
+
+Isa detect_()
+{
+	for (Isa isa : {Isa::AVX2, Isa::SSE2, Isa::NEON})
+		if (getTable_(isa) != nullptr)
+			return isa;
+	return Isa::SCALAR;
+}
+
+/* -------------------------------------------------------------------------- */
+
+std::atomic<Isa>                isa_   = detect_();
+std::atomic<const KernelTable*> table_ = getTable_(isa_.load());
+
+/* -------------------------------------------------------------------------- */
+
+const KernelTable& k_()
+{
+	return *table_.load(std::memory_order_relaxed);
+}
+
+/* -------------------------------------------------------------------------- */
+
+int countSamples_(const mcl::AudioBuffer& b)
+{
+	return b.countFrames() * b.countChannels();
+}
+} // namespace
+
+/* -------------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------- */
+
+Isa getIsa()
+{
+	return isa_.load();
+}
+
+/* -------------------------------------------------------------------------- */
+
+const char* getIsaName(Isa isa)
+{
+	switch (isa)
+	{
+	case Isa::SSE2:
+		return "SSE2";
+	case Isa::AVX2:
+		return "AVX2";
+	case Isa::NEON:
+		return "NEON";
+	default:
+		return "scalar";
+	}
+}
+
+/* -------------------------------------------------------------------------- */
+
+bool isSupported(Isa isa)
+{
+	return getTable_(isa) != nullptr;
+}
+
+/* -------------------------------------------------------------------------- */
+
+bool setIsa(Isa isa)
+{
+	const KernelTable* table = getTable_(isa);
+	if (table == nullptr)
+		return false;
+	isa_.store(isa);
+	table_.store(table);
+	return true;
+}
+
+/* -------------------------------------------------------------------------- */
+
+void sum(float* dst, const float* src, int samples, float gain)
+{
+	k_().sum(dst, src, samples, gain, gain);
+}
+
+void sumStereo(float* dst, const float* src, int frames, float gainL, float gainR)
+{
+	k_().sum(dst, src, frames * 2, gainL, gainR);
+}
+
+/* -------------------------------------------------------------------------- */
+
+void gain(float* buf, int samples, float g)
+{
+	k_().gain(buf, samples, g);
+}
+
+/* -------------------------------------------------------------------------- */
+
+void clip(float* buf, int samples, float min, float max)
+{
+	k_().clip(buf, samples, min, max);
+}
+
+/* -------------------------------------------------------------------------- */
+
+float peak(const float* buf, int samples)
+{
+	float even = 0.0f;
+	float odd  = 0.0f;
+	k_().peak(buf, samples, &even, &odd);
+	return std::max(even, odd);
+}
+
+Peak peakStereo(const float* buf, int frames)
+{
+	Peak p;
+	k_().peak(buf, frames * 2, &p.left, &p.right);
+	return p;
+}
+
+/* -------------------------------------------------------------------------- */
+
+float rms(const float* buf, int samples)
+{
+	if (samples <= 0)
+		return 0.0f;
+	return std::sqrt(k_().sumSquares(buf, samples) / samples);
+}
+
+/* -------------------------------------------------------------------------- */
+
+void interleave(float* dst, const float* const* src, int frames, int channels)
+{
+	if (channels == 2)
+	{
+		k_().interleave2(dst, src[0], src[1], frames);
+		return;
+	}
+	for (int i = 0; i < frames; i++)
+		for (int j = 0; j < channels; j++)
+			dst[i * channels + j] = src[j][i];
+}
+
+void deinterleave(float* const* dst, const float* src, int frames, int channels)
+{
+	if (channels == 2)
+	{
+		k_().deinterleave2(dst[0], dst[1], src, frames);
+		return;
+	}
+	for (int i = 0; i < frames; i++)
+		for (int j = 0; j < channels; j++)
+			dst[j][i] = src[i * channels + j];
+}
+
+/* -------------------------------------------------------------------------- */
+
+void ramp(float* buf, int frames, int channels, float from, float to)
+{
+	/* Gain is computed from the frame index instead of being accumulated, so 
+	that the last frame gets exactly 'to' (e.g. silence at the end of a fade
+	out). */
+
+	if (frames <= 0)
+		return;
+	if (frames == 1)
+	{
+		gain(buf, channels, from);
+		return;
+	}
+
+	const float range = static_cast<float>(frames - 1);
+	for (int i = 0; i < frames; i++)
+	{
+		const float g = from + (to - from) * (i / range);
+		for (int j = 0; j < channels; j++)
+			buf[i * channels + j] *= g;
+	}
+}
+
+/* -------------------------------------------------------------------------- */
+
+void sum(mcl::AudioBuffer& dst, const mcl::AudioBuffer& src, float gain, float panL, float panR)
+{
+	assert(dst.countFrames() == src.countFrames());
+
+	if (dst.countChannels() != src.countChannels() || dst.countChannels() > 2)
+	{
+		dst.sum(src, gain, {panL, panR});
+		return;
+	}
+	if (dst.countChannels() == 2)
+		sumStereo(dst[0], src[0], dst.countFrames(), gain * panL, gain * panR);
+	else
+		sum(dst[0], src[0], dst.countFrames(), gain * panL);
+}
+
+/* -------------------------------------------------------------------------- */
+
+void gain(mcl::AudioBuffer& b, float g)
+{
+	gain(b[0], countSamples_(b), g);
+}
+
+/* -------------------------------------------------------------------------- */
+
+void clip(mcl::AudioBuffer& b, float min, float max)
+{
+	clip(b[0], countSamples_(b), min, max);
+}
+
+/* -------------------------------------------------------------------------- */
+
+Peak getPeak(const mcl::AudioBuffer& b)
+{
+	if (b.countChannels() == 2)
+		return peakStereo(b[0], b.countFrames());
+
+	const float p = peak(b[0], countSamples_(b));
+	return {p, p};
+}
+} // namespace giada::m::dsp
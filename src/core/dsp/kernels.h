@@ -0,0 +1,144 @@
+/* -----------------------------------------------------------------------------
+ *
+ * Giada - Your Hardcore Loopmachine
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2022 Giovanni A. Zuliani | Monocasual Laboratories
+ *
+ * This file is part of Giada - Your Hardcore Loopmachine.
+ *
+ * Giada - Your Hardcore Loopmachine is free software: you can
+ * redistribute it and/or modify it under the terms of the GNU General
+ * Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * Giada - Your Hardcore Loopmachine is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Giada - Your Hardcore Loopmachine. If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------- */
+
+#ifndef G_DSP_KERNELS_H
+#define G_DSP_KERNELS_H
+
+#include "core/types.h"
+
+namespace mcl
+{
+class AudioBuffer;
+}
+
+/* giada::m::dsp
+Hot inner loops of the audio engine, implemented for several instruction sets
+(scalar, SSE2, AVX2, NEON). The best implementation available on the running 
+CPU is picked once at startup. Raw kernels work on interleaved float samples; 
+the mcl::AudioBuffer overloads take care of channel layouts. */
+
+namespace giada::m::dsp
+{
+enum class Isa
+{
+	SCALAR,
+	SSE2,
+	AVX2,
+	NEON
+};
+
+/* getIsa
+Returns the instruction set currently in use. */
+
+Isa getIsa();
+
+/* getIsaName
+Returns a human-readable name of the given instruction set. */
+
+const char* getIsaName(Isa);
+
+/* isSupported
+True if kernels for the given instruction set have been compiled in and the 
+running CPU supports them. */
+
+bool isSupported(Isa);
+
+/* setIsa
+Forces a specific instruction set. Returns false (and leaves the current one
+untouched) if not supported. Meant for tests and benchmarks: don't call this
+while the audio thread is running. */
+
+bool setIsa(Isa);
+
+/* sum (1)
+dst += src * gain, over 'samples' interleaved samples. */
+
+void sum(float* dst, const float* src, int samples, float gain);
+
+/* sumStereo
+Same as sum (1), with a separate gain for left and right channels of a stereo
+interleaved buffer. Used for panning. */
+
+void sumStereo(float* dst, const float* src, int frames, float gainL, float gainR);
+
+/* gain (1)
+buf *= g. */
+
+void gain(float* buf, int samples, float g);
+
+/* clip (1)
+Hard-clips samples to [min, max]. */
+
+void clip(float* buf, int samples, float min, float max);
+
+/* peak
+Returns the absolute peak value of 'samples' samples. */
+
+float peak(const float* buf, int samples);
+
+/* peakStereo
+Returns absolute peak values of left and right channels of a stereo 
+interleaved buffer. */
+
+Peak peakStereo(const float* buf, int frames);
+
+/* rms
+Returns the root mean square of 'samples' samples. */
+
+float rms(const float* buf, int samples);
+
+/* interleave, deinterleave
+Conversion from/to an array of 'channels' planar buffers. */
+
+void interleave(float* dst, const float* const* src, int frames, int channels);
+void deinterleave(float* const* dst, const float* src, int frames, int channels);
+
+/* ramp
+Applies a linear gain ramp going from 'from' (first frame) to 'to' (last frame)
+included. */
+
+void ramp(float* buf, int frames, int channels, float from, float to);
+
+/* sum (2)
+dst += src * gain * pan, where pan is a pair of left/right gains. Falls back to
+mcl::AudioBuffer::sum() when channel layouts don't match. */
+
+void sum(mcl::AudioBuffer& dst, const mcl::AudioBuffer& src, float gain,
+    float panL = 1.0f, float panR = 1.0f);
+
+/* gain (2), clip (2) */
+
+void gain(mcl::AudioBuffer&, float g);
+void clip(mcl::AudioBuffer&, float min = -1.0f, float max = 1.0f);
+
+/* getPeak
+Returns left and right absolute peaks. Mono buffers report the same value on
+both sides. */
+
+Peak getPeak(const mcl::AudioBuffer&);
+} // namespace giada::m::dsp
+
+#endif
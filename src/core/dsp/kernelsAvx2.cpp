@@ -0,0 +1,220 @@
+/* -----------------------------------------------------------------------------
+ *
+ * Giada - Your Hardcore Loopmachine
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2022 Giovanni A. Zuliani | Monocasual Laboratories
+ *
+ * This file is part of Giada - Your Hardcore Loopmachine.
+ *
+ * Giada - Your Hardcore Loopmachine is free software: you can
+ * redistribute it and/or modify it under the terms of the GNU General
+ * Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * Giada - Your Hardcore Loopmachine is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Giada - Your Hardcore Loopmachine. If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------- */
+
+#include "core/dsp/kernelTable.h"
+
+/* This file is compiled with AVX2 enabled (see CMakeLists.txt) and its kernels
+are only called after a runtime CPU check. */
+
+#if defined(__AVX2__)
+#define G_DSP_WITH_AVX2
+#include <immintrin.h>
+#endif
+
+namespace giada::m::dsp
+{
+#ifdef G_DSP_WITH_AVX2
+
+namespace
+{
+/* Vectors hold 8 interleaved samples, i.e. four stereo frames: even lanes are
+left samples, odd lanes right samples. Loops stop at multiples of 8, so the
+scalar tails keep the same even/odd alignment. */
+
+constexpr int STEP = 8;
+
+/* -------------------------------------------------------------------------- */
+
+float abs_(float f) { return f < 0.0f ? -f : f; }
+
+/* -------------------------------------------------------------------------- */
+
+void sum_(float* dst, const float* src, int samples, float gainEven, float gainOdd)
+{
+	const __m256 g = _mm256_setr_ps(gainEven, gainOdd, gainEven, gainOdd, gainEven, gainOdd, gainEven, gainOdd);
+
+	int i = 0;
+	for (; i + STEP <= samples; i += STEP)
+		_mm256_storeu_ps(dst + i, _mm256_add_ps(_mm256_loadu_ps(dst + i), _mm256_mul_ps(_mm256_loadu_ps(src + i), g)));
+	for (; i < samples; i++)
+		dst[i] += src[i] * (i & 1 ? gainOdd : gainEven);
+}
+
+/* -------------------------------------------------------------------------- */
+
+void gain_(float* buf, int samples, float gain)
+{
+	const __m256 g = _mm256_set1_ps(gain);
+
+	int i = 0;
+	for (; i + STEP <= samples; i += STEP)
+		_mm256_storeu_ps(buf + i, _mm256_mul_ps(_mm256_loadu_ps(buf + i), g));
+	for (; i < samples; i++)
+		buf[i] *= gain;
+}
+
+/* -------------------------------------------------------------------------- */
+
+void clip_(float* buf, int samples, float min, float max)
+{
+	const __m256 lo = _mm256_set1_ps(min);
+	const __m256 hi = _mm256_set1_ps(max);
+
+	int i = 0;
+	for (; i + STEP <= samples; i += STEP)
+		_mm256_storeu_ps(buf + i, _mm256_min_ps(_mm256_max_ps(_mm256_loadu_ps(buf + i), lo), hi));
+	for (; i < samples; i++)
+		buf[i] = buf[i] < min ? min : (buf[i] > max ? max : buf[i]);
+}
+
+/* -------------------------------------------------------------------------- */
+
+void peak_(const float* buf, int samples, float* peakEven, float* peakOdd)
+{
+	const __m256 signMask = _mm256_set1_ps(-0.0f);
+	__m256       acc      = _mm256_setzero_ps();
+
+	int i = 0;
+	for (; i + STEP <= samples; i += STEP)
+		acc = _mm256_max_ps(acc, _mm256_andnot_ps(signMask, _mm256_loadu_ps(buf + i)));
+
+	alignas(32) float lanes[STEP];
+	_mm256_store_ps(lanes, acc);
+
+	float even = 0.0f;
+	float odd  = 0.0f;
+	for (int j = 0; j < STEP; j += 2)
+	{
+		even = lanes[j] > even ? lanes[j] : even;
+		odd  = lanes[j + 1] > odd ? lanes[j + 1] : odd;
+	}
+	for (; i < samples; i++)
+	{
+		float& p = i & 1 ? odd : even;
+		if (abs_(buf[i]) > p)
+			p = abs_(buf[i]);
+	}
+	*peakEven = even;
+	*peakOdd  = odd;
+}
+
+/* -------------------------------------------------------------------------- */
+
+float sumSquares_(const float* buf, int samples)
+{
+	__m256 acc = _mm256_setzero_ps();
+
+	int i = 0;
+	for (; i + STEP <= samples; i += STEP)
+	{
+		const __m256 v = _mm256_loadu_ps(buf + i);
+		acc            = _mm256_add_ps(acc, _mm256_mul_ps(v, v));
+	}
+
+	alignas(32) float lanes[STEP];
+	_mm256_store_ps(lanes, acc);
+
+	float out = 0.0f;
+	for (int j = 0; j < STEP; j++)
+		out += lanes[j];
+	for (; i < samples; i++)
+		out += buf[i] * buf[i];
+	return out;
+}
+
+/* -------------------------------------------------------------------------- */
+
+void interleave2_(float* dst, const float* left, const float* right, int frames)
+{
+	int i = 0;
+	for (; i + STEP <= frames; i += STEP)
+	{
+		const __m256 l  = _mm256_loadu_ps(left + i);
+		const __m256 r  = _mm256_loadu_ps(right + i);
+		const __m256 lo = _mm256_unpacklo_ps(l, r); // l0 r0 l1 r1 | l4 r4 l5 r5
+		const __m256 hi = _mm256_unpackhi_ps(l, r); // l2 r2 l3 r3 | l6 r6 l7 r7
+		_mm256_storeu_ps(dst + i * 2, _mm256_permute2f128_ps(lo, hi, 0x20));
+		_mm256_storeu_ps(dst + i * 2 + STEP, _mm256_permute2f128_ps(lo, hi, 0x31));
+	}
+	for (; i < frames; i++)
+	{
+		dst[i * 2]     = left[i];
+		dst[i * 2 + 1] = right[i];
+	}
+}
+
+/* -------------------------------------------------------------------------- */
+
+void deinterleave2_(float* left, float* right, const float* src, int frames)
+{
+	int i = 0;
+	for (; i + STEP <= frames; i += STEP)
+	{
+		const __m256 a  = _mm256_loadu_ps(src + i * 2);
+		const __m256 b  = _mm256_loadu_ps(src + i * 2 + STEP);
+		const __m256 t0 = _mm256_permute2f128_ps(a, b, 0x20); // l0 r0 l1 r1 | l4 r4 l5 r5
+		const __m256 t1 = _mm256_permute2f128_ps(a, b, 0x31); // l2 r2 l3 r3 | l6 r6 l7 r7
+		_mm256_storeu_ps(left + i, _mm256_shuffle_ps(t0, t1, _MM_SHUFFLE(2, 0, 2, 0)));
+		_mm256_storeu_ps(right + i, _mm256_shuffle_ps(t0, t1, _MM_SHUFFLE(3, 1, 3, 1)));
+	}
+	for (; i < frames; i++)
+	{
+		left[i]  = src[i * 2];
+		right[i] = src[i * 2 + 1];
+	}
+}
+
+/* -------------------------------------------------------------------------- */
+
+constexpr KernelTable table_ = {
+    /* name          = */ "AVX2",
+    /* sum           = */ sum_,
+    /* gain          = */ gain_,
+    /* clip          = */ clip_,
+    /* peak          = */ peak_,
+    /* sumSquares    = */ sumSquares_,
+    /* interleave2   = */ interleave2_,
+    /* deinterleave2 = */ deinterleave2_};
+} // namespace
+
+/* -------------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------- */
+
+const KernelTable* getAvx2Table()
+{
+	return &table_;
+}
+
+#else
+
+const KernelTable* getAvx2Table()
+{
+	return nullptr;
+}
+
+#endif
+} // namespace giada::m::dsp
@@ -0,0 +1,203 @@
+/* -----------------------------------------------------------------------------
+ *
+ * Giada - Your Hardcore Loopmachine
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2022 Giovanni A. Zuliani | Monocasual Laboratories
+ *
+ * This file is part of Giada - Your Hardcore Loopmachine.
+ *
+ * Giada - Your Hardcore Loopmachine is free software: you can
+ * redistribute it and/or modify it under the terms of the GNU General
+ * Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * Giada - Your Hardcore Loopmachine is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Giada - Your Hardcore Loopmachine. If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------- */
+
+#include "core/dsp/kernelTable.h"
+
+#if defined(__ARM_NEON) || defined(__ARM_NEON__) || defined(_M_ARM64)
+#define G_DSP_WITH_NEON
+#include <arm_neon.h>
+#endif
+
+namespace giada::m::dsp
+{
+#ifdef G_DSP_WITH_NEON
+
+namespace
+{
+/* Vectors hold 4 interleaved samples, i.e. two stereo frames: even lanes are
+left samples, odd lanes right samples. Loops stop at multiples of 4, so the
+scalar tails keep the same even/odd alignment. */
+
+constexpr int STEP = 4;
+
+/* -------------------------------------------------------------------------- */
+
+float abs_(float f) { return f < 0.0f ? -f : f; }
+
+/* -------------------------------------------------------------------------- */
+
+void sum_(float* dst, const float* src, int samples, float gainEven, float gainOdd)
+{
+	const float       gains[STEP] = {gainEven, gainOdd, gainEven, gainOdd};
+	const float32x4_t g           = vld1q_f32(gains);
+
+	int i = 0;
+	for (; i + STEP <= samples; i += STEP)
+		vst1q_f32(dst + i, vmlaq_f32(vld1q_f32(dst + i), vld1q_f32(src + i), g));
+	for (; i < samples; i++)
+		dst[i] += src[i] * (i & 1 ? gainOdd : gainEven);
+}
+
+/* -------------------------------------------------------------------------- */
+
+void gain_(float* buf, int samples, float gain)
+{
+	int i = 0;
+	for (; i + STEP <= samples; i += STEP)
+		vst1q_f32(buf + i, vmulq_n_f32(vld1q_f32(buf + i), gain));
+	for (; i < samples; i++)
+		buf[i] *= gain;
+}
+
+/* -------------------------------------------------------------------------- */
+
+void clip_(float* buf, int samples, float min, float max)
+{
+	const float32x4_t lo = vdupq_n_f32(min);
+	const float32x4_t hi = vdupq_n_f32(max);
+
+	int i = 0;
+	for (; i + STEP <= samples; i += STEP)
+		vst1q_f32(buf + i, vminq_f32(vmaxq_f32(vld1q_f32(buf + i), lo), hi));
+	for (; i < samples; i++)
+		buf[i] = buf[i] < min ? min : (buf[i] > max ? max : buf[i]);
+}
+
+/* -------------------------------------------------------------------------- */
+
+void peak_(const float* buf, int samples, float* peakEven, float* peakOdd)
+{
+	float32x4_t acc = vdupq_n_f32(0.0f);
+
+	int i = 0;
+	for (; i + STEP <= samples; i += STEP)
+		acc = vmaxq_f32(acc, vabsq_f32(vld1q_f32(buf + i)));
+
+	float lanes[STEP];
+	vst1q_f32(lanes, acc);
+
+	float even = lanes[0] > lanes[2] ? lanes[0] : lanes[2];
+	float odd  = lanes[1] > lanes[3] ? lanes[1] : lanes[3];
+	for (; i < samples; i++)
+	{
+		float& p = i & 1 ? odd : even;
+		if (abs_(buf[i]) > p)
+			p = abs_(buf[i]);
+	}
+	*peakEven = even;
+	*peakOdd  = odd;
+}
+
+/* -------------------------------------------------------------------------- */
+
+float sumSquares_(const float* buf, int samples)
+{
+	float32x4_t acc = vdupq_n_f32(0.0f);
+
+	int i = 0;
+	for (; i + STEP <= samples; i += STEP)
+	{
+		const float32x4_t v = vld1q_f32(buf + i);
+		acc                 = vmlaq_f32(acc, v, v);
+	}
+
+	float lanes[STEP];
+	vst1q_f32(lanes, acc);
+
+	float out = lanes[0] + lanes[1] + lanes[2] + lanes[3];
+	for (; i < samples; i++)
+		out += buf[i] * buf[i];
+	return out;
+}
+
+/* -------------------------------------------------------------------------- */
+
+void interleave2_(float* dst, const float* left, const float* right, int frames)
+{
+	int i = 0;
+	for (; i + STEP <= frames; i += STEP)
+	{
+		float32x4x2_t v;
+		v.val[0] = vld1q_f32(left + i);
+		v.val[1] = vld1q_f32(right + i);
+		vst2q_f32(dst + i * 2, v);
+	}
+	for (; i < frames; i++)
+	{
+		dst[i * 2]     = left[i];
+		dst[i * 2 + 1] = right[i];
+	}
+}
+
+/* -------------------------------------------------------------------------- */
+
+void deinterleave2_(float* left, float* right, const float* src, int frames)
+{
+	int i = 0;
+	for (; i + STEP <= frames; i += STEP)
+	{
+		const float32x4x2_t v = vld2q_f32(src + i * 2);
+		vst1q_f32(left + i, v.val[0]);
+		vst1q_f32(right + i, v.val[1]);
+	}
+	for (; i < frames; i++)
+	{
+		left[i]  = src[i * 2];
+		right[i] = src[i * 2 + 1];
+	}
+}
+
+/* -------------------------------------------------------------------------- */
+
+constexpr KernelTable table_ = {
+    /* name          = */ "NEON",
+    /* sum           = */ sum_,
+    /* gain          = */ gain_,
+    /* clip          = */ clip_,
+    /* peak          = */ peak_,
+    /* sumSquares    = */ sumSquares_,
+    /* interleave2   = */ interleave2_,
+    /* deinterleave2 = */ deinterleave2_};
+} // namespace
+
+/* -------------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------- */
+
+const KernelTable* getNeonTable()
+{
+	return &table_;
+}
+
+#else
+
+const KernelTable* getNeonTable()
+{
+	return nullptr;
+}
+
+#endif
+} // namespace giada::m::dsp
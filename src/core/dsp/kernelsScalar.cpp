@@ -0,0 +1,127 @@
+/* -----------------------------------------------------------------------------
+ *
+ * Giada - Your Hardcore Loopmachine
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2022 Giovanni A. Zuliani | Monocasual Laboratories
+ *
+ * This file is part of Giada - Your Hardcore Loopmachine.
+ *
+ * Giada - Your Hardcore Loopmachine is free software: you can
+ * redistribute it and/or modify it under the terms of the GNU General
+ * Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * Giada - Your Hardcore Loopmachine is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Giada - Your Hardcore Loopmachine. If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------- */
+
+#include "core/dsp/kernelTable.h"
+#include <algorithm>
+#include <cmath>
+
+namespace giada::m::dsp
+{
+namespace
+{
+void sum_(float* dst, const float* src, int samples, float gainEven, float gainOdd)
+{
+	for (int i = 0; i < samples; i++)
+		dst[i] += src[i] * (i & 1 ? gainOdd : gainEven);
+}
+
+/* -------------------------------------------------------------------------- */
+
+void gain_(float* buf, int samples, float g)
+{
+	for (int i = 0; i < samples; i++)
+		buf[i] *= g;
+}
+
+/* -------------------------------------------------------------------------- */
+
+void clip_(float* buf, int samples, float min, float max)
+{
+	for (int i = 0; i < samples; i++)
+		buf[i] = std::clamp(buf[i], min, max);
+}
+
+/* -------------------------------------------------------------------------- */
+
+void peak_(const float* buf, int samples, float* peakEven, float* peakOdd)
+{
+	float even = 0.0f;
+	float odd  = 0.0f;
+	for (int i = 0; i < samples; i++)
+	{
+		if (i & 1)
+			odd = std::max(odd, std::fabs(buf[i]));
+		else
+			even = std::max(even, std::fabs(buf[i]));
+	}
+	*peakEven = even;
+	*peakOdd  = odd;
+}
+
+/* -------------------------------------------------------------------------- */
+
+float sumSquares_(const float* buf, int samples)
+{
+	float out = 0.0f;
+	for (int i = 0; i < samples; i++)
+		out += buf[i] * buf[i];
+	return out;
+}
+
+/* -------------------------------------------------------------------------- */
+
+void interleave2_(float* dst, const float* left, const float* right, int frames)
+{
+	for (int i = 0; i < frames; i++)
+	{
+		dst[i * 2]     = left[i];
+		dst[i * 2 + 1] = right[i];
+	}
+}
+
+/* -------------------------------------------------------------------------- */
+
+void deinterleave2_(float* left, float* right, const float* src, int frames)
+{
+	for (int i = 0; i < frames; i++)
+	{
+		left[i]  = src[i * 2];
+		right[i] = src[i * 2 + 1];
+	}
+}
+
+/* -------------------------------------------------------------------------- */
+
+constexpr KernelTable table_ = {
+    /* name          = */ "scalar",
+    /* sum           = */ sum_,
+    /* gain          = */ gain_,
+    /* clip          = */ clip_,
+    /* peak          = */ peak_,
+    /* sumSquares    = */ sumSquares_,
+    /* interleave2   = */ interleave2_,
+    /* deinterleave2 = */ deinterleave2_};
+} // namespace
+
+/* -------------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------- */
+
+const KernelTable* getScalarTable()
+{
+	return &table_;
+}
+} // namespace giada::m::dsp
@@ -0,0 +1,206 @@
+/* -----------------------------------------------------------------------------
+ *
+ * Giada - Your Hardcore Loopmachine
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2022 Giovanni A. Zuliani | Monocasual Laboratories
+ *
+ * This file is part of Giada - Your Hardcore Loopmachine.
+ *
+ * Giada - Your Hardcore Loopmachine is free software: you can
+ * redistribute it and/or modify it under the terms of the GNU General
+ * Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * Giada - Your Hardcore Loopmachine is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Giada - Your Hardcore Loopmachine. If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------- */
+
+#include "core/dsp/kernelTable.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define G_DSP_WITH_SSE2
+#include <emmintrin.h>
+#endif
+
+namespace giada::m::dsp
+{
+#ifdef G_DSP_WITH_SSE2
+
+namespace
+{
+/* Vectors hold 4 interleaved samples, i.e. two stereo frames: even lanes are
+left samples, odd lanes right samples. Loops stop at multiples of 4, so the
+scalar tails keep the same even/odd alignment. */
+
+constexpr int STEP = 4;
+
+/* -------------------------------------------------------------------------- */
+
+float abs_(float f) { return f < 0.0f ? -f : f; }
+
+/* -------------------------------------------------------------------------- */
+
+void sum_(float* dst, const float* src, int samples, float gainEven, float gainOdd)
+{
+	const __m128 g = _mm_setr_ps(gainEven, gainOdd, gainEven, gainOdd);
+
+	int i = 0;
+	for (; i + STEP <= samples; i += STEP)
+		_mm_storeu_ps(dst + i, _mm_add_ps(_mm_loadu_ps(dst + i), _mm_mul_ps(_mm_loadu_ps(src + i), g)));
+	for (; i < samples; i++)
+		dst[i] += src[i] * (i & 1 ? gainOdd : gainEven);
+}
+
+/* -------------------------------------------------------------------------- */
+
+void gain_(float* buf, int samples, float gain)
+{
+	const __m128 g = _mm_set1_ps(gain);
+
+	int i = 0;
+	for (; i + STEP <= samples; i += STEP)
+		_mm_storeu_ps(buf + i, _mm_mul_ps(_mm_loadu_ps(buf + i), g));
+	for (; i < samples; i++)
+		buf[i] *= gain;
+}
+
+/* -------------------------------------------------------------------------- */
+
+void clip_(float* buf, int samples, float min, float max)
+{
+	const __m128 lo = _mm_set1_ps(min);
+	const __m128 hi = _mm_set1_ps(max);
+
+	int i = 0;
+	for (; i + STEP <= samples; i += STEP)
+		_mm_storeu_ps(buf + i, _mm_min_ps(_mm_max_ps(_mm_loadu_ps(buf + i), lo), hi));
+	for (; i < samples; i++)
+		buf[i] = buf[i] < min ? min : (buf[i] > max ? max : buf[i]);
+}
+
+/* -------------------------------------------------------------------------- */
+
+void peak_(const float* buf, int samples, float* peakEven, float* peakOdd)
+{
+	const __m128 signMask = _mm_set1_ps(-0.0f);
+	__m128       acc      = _mm_setzero_ps();
+
+	int i = 0;
+	for (; i + STEP <= samples; i += STEP)
+		acc = _mm_max_ps(acc, _mm_andnot_ps(signMask, _mm_loadu_ps(buf + i)));
+
+	alignas(16) float lanes[STEP];
+	_mm_store_ps(lanes, acc);
+
+	float even = lanes[0] > lanes[2] ? lanes[0] : lanes[2];
+	float odd  = lanes[1] > lanes[3] ? lanes[1] : lanes[3];
+	for (; i < samples; i++)
+	{
+		float& p = i & 1 ? odd : even;
+		if (abs_(buf[i]) > p)
+			p = abs_(buf[i]);
+	}
+	*peakEven = even;
+	*peakOdd  = odd;
+}
+
+/* -------------------------------------------------------------------------- */
+
+float sumSquares_(const float* buf, int samples)
+{
+	__m128 acc = _mm_setzero_ps();
+
+	int i = 0;
+	for (; i + STEP <= samples; i += STEP)
+	{
+		const __m128 v = _mm_loadu_ps(buf + i);
+		acc            = _mm_add_ps(acc, _mm_mul_ps(v, v));
+	}
+
+	alignas(16) float lanes[STEP];
+	_mm_store_ps(lanes, acc);
+
+	float out = lanes[0] + lanes[1] + lanes[2] + lanes[3];
+	for (; i < samples; i++)
+		out += buf[i] * buf[i];
+	return out;
+}
+
+/* -------------------------------------------------------------------------- */
+
+void interleave2_(float* dst, const float* left, const float* right, int frames)
+{
+	int i = 0;
+	for (; i + STEP <= frames; i += STEP)
+	{
+		const __m128 l = _mm_loadu_ps(left + i);
+		const __m128 r = _mm_loadu_ps(right + i);
+		_mm_storeu_ps(dst + i * 2, _mm_unpacklo_ps(l, r));
+		_mm_storeu_ps(dst + i * 2 + STEP, _mm_unpackhi_ps(l, r));
+	}
+	for (; i < frames; i++)
+	{
+		dst[i * 2]     = left[i];
+		dst[i * 2 + 1] = right[i];
+	}
+}
+
+/* -------------------------------------------------------------------------- */
+
+void deinterleave2_(float* left, float* right, const float* src, int frames)
+{
+	int i = 0;
+	for (; i + STEP <= frames; i += STEP)
+	{
+		const __m128 a = _mm_loadu_ps(src + i * 2);
+		const __m128 b = _mm_loadu_ps(src + i * 2 + STEP);
+		_mm_storeu_ps(left + i, _mm_shuffle_ps(a, b, _MM_SHUFFLE(2, 0, 2, 0)));
+		_mm_storeu_ps(right + i, _mm_shuffle_ps(a, b, _MM_SHUFFLE(3, 1, 3, 1)));
+	}
+	for (; i < frames; i++)
+	{
+		left[i]  = src[i * 2];
+		right[i] = src[i * 2 + 1];
+	}
+}
+
+/* -------------------------------------------------------------------------- */
+
+constexpr KernelTable table_ = {
+    /* name          = */ "SSE2",
+    /* sum           = */ sum_,
+    /* gain          = */ gain_,
+    /* clip          = */ clip_,
+    /* peak          = */ peak_,
+    /* sumSquares    = */ sumSquares_,
+    /* interleave2   = */ interleave2_,
+    /* deinterleave2 = */ deinterleave2_};
+} // namespace
+
+/* -------------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------- */
+
+const KernelTable* getSse2Table()
+{
+	return &table_;
+}
+
+#else
+
+const KernelTable* getSse2Table()
+{
+	return nullptr;
+}
+
+#endif
+} // namespace giada::m::dsp
@@ -44,43 +44,73 @@ bool LoadState::isGood() const
 /* -------------------------------------------------------------------------- */
 
 Engine::Engine()
-: midiMapper(kernelMidi)
+: kernelMidi(kernelAudio)
+, eventDispatcher(profiler)
+, midiMapper(kernelMidi)
 , channelFactory(conf.data, model)
 , channelManager(model, channelFactory, waveFactory)
 , midiDispatcher(model)
 , actionRecorder(model)
 , synchronizer(conf.data, kernelMidi)
 , sequencer(model, synchronizer, jackTransport)
-, mixer(model)
+, mixer(model, renderPool, profiler)
 , recorder(model, sequencer, channelManager, mixer)
-, pluginHost(model)
+, pluginHost(model, profiler)
+, offlineRenderer(model, sequencer, mixer)
 {
 	kernelAudio.onAudioCallback = [this](KernelAudio::CallbackInfo info) {
+#ifdef WITH_AUDIO_JACK
+		kernelMidi.readJackPorts(info.bufferSize);
+		const int ret = audioCallback(info);
+		kernelMidi.writeJackPorts(info.bufferSize);
+		return ret;
+#else
 		return audioCallback(info);
+#endif
+	};
+
+	kernelMidi.onMidiReceived = [this](uint32_t msg, Frame delta, int device) {
+		midiDispatcher.dispatch(msg, delta, device);
+	};
+	kernelMidi.onMidiRealtime = [this](int status, KernelMidi::Clock::time_point t, int device) {
+		synchronizer.recvMIDIrealtime(status, t, device);
 	};
 
-	kernelMidi.onMidiReceived = [this](uint32_t msg) { midiDispatcher.dispatch(msg); };
+	synchronizer.onClockStart = [this](bool rewind) {
+		if (rewind)
+			eventDispatcher.pumpEvent({EventDispatcher::EventType::SEQUENCER_REWIND_CLOCK});
+		eventDispatcher.pumpEvent({EventDispatcher::EventType::SEQUENCER_START_CLOCK});
+	};
+	synchronizer.onClockStop = [this]() {
+		eventDispatcher.pumpEvent({EventDispatcher::EventType::SEQUENCER_STOP_CLOCK});
+	};
+	synchronizer.onClockChangeBpm = [this](float bpm) {
+		eventDispatcher.pumpEvent({EventDispatcher::EventType::SEQUENCER_BPM_CLOCK, 0, 0, bpm});
+	};
 
 #ifdef WITH_AUDIO_JACK
 	synchronizer.onJackRewind = [this]() {
-		eventDispatcher.pumpMidiEvent({EventDispatcher::EventType::SEQUENCER_REWIND_JACK});
+		eventDispatcher.pumpEvent({EventDispatcher::EventType::SEQUENCER_REWIND_JACK});
 	};
 	synchronizer.onJackChangeBpm = [this](float bpm) {
-		eventDispatcher.pumpMidiEvent({EventDispatcher::EventType::SEQUENCER_BPM_JACK, 0, 0, bpm});
+		eventDispatcher.pumpEvent({EventDispatcher::EventType::SEQUENCER_BPM_JACK, 0, 0, bpm});
 	};
 	synchronizer.onJackStart = [this]() {
-		eventDispatcher.pumpMidiEvent({EventDispatcher::EventType::SEQUENCER_START_JACK});
+		eventDispatcher.pumpEvent({EventDispatcher::EventType::SEQUENCER_START_JACK});
 	};
 	synchronizer.onJackStop = [this]() {
-		eventDispatcher.pumpMidiEvent({EventDispatcher::EventType::SEQUENCER_STOP_JACK});
+		eventDispatcher.pumpEvent({EventDispatcher::EventType::SEQUENCER_STOP_JACK});
 	};
 #endif
 
 	eventDispatcher.onMidiLearn       = [this](const MidiEvent& e) { midiDispatcher.learn(e); };
 	eventDispatcher.onMidiProcess     = [this](const MidiEvent& e) { midiDispatcher.process(e); };
-	eventDispatcher.onProcessChannels = [this](const EventDispatcher::EventBuffer& eb) {
-		for (Channel& ch : model.get().channels)
-			ch.react(eb);
+	eventDispatcher.onProcessChannels = [this](const EventDispatcher::EventRouter& router) {
+		/* Only the channels the events are addressed to get cloned: the others
+		stay shared with the realtime layout. */
+		model.get().channels.editIf(
+		    [&router](const Channel& ch) { return router.hasEventsFor(ch.id); },
+		    [&router](Channel& ch) { ch.react(router); });
 		model.swap(model::SwapType::SOFT);
 	};
 	eventDispatcher.onProcessSequencer = [this](const EventDispatcher::EventBuffer& eb) {
@@ -96,24 +126,38 @@ Engine::Engine()
 
 	midiDispatcher.onDispatch = [this](EventDispatcher::EventType event, Action action) {
 		/* Notify Event Dispatcher when a MIDI signal is received. */
-		eventDispatcher.pumpMidiEvent({event, 0, 0, action});
+		eventDispatcher.pumpEvent({event, 0, 0, action});
 	};
 
 	midiDispatcher.onEventReceived = [this]() {
 		recorder.startActionRecOnCallback();
 	};
 
+	model.onSwapCore = [this](model::SwapType) {
+		midiDispatcher.rebuildDirectRoutes(conf.data.midiInDirect);
+		midiDispatcher.rebuildBindings();
+	};
+
+	profiler.onReset = [this]() {
+		for (const Channel& ch : model.get().channels)
+		{
+			ch.shared->profile.reset();
+			for (Plugin* p : ch.plugins)
+				p->profile.reset();
+		}
+	};
+
 	mixer.onSignalTresholdReached = [this]() {
 		/* Invokes the signal callback. This is done by pumping a MIXER_SIGNAL_CALLBACK
         event to the Event Dispatcher, rather than invoking the callback directly.
         This is done on purpose: the callback might (and surely will) contain 
         blocking stuff from model:: that the realtime thread cannot perform directly. */
-		eventDispatcher.pumpUIevent({EventDispatcher::EventType::MIXER_SIGNAL_CALLBACK});
+		eventDispatcher.pumpEvent({EventDispatcher::EventType::MIXER_SIGNAL_CALLBACK});
 	};
 
 	mixer.onEndOfRecording = [this]() {
 		/* Same rationale as above, for the end-of-recording callback. */
-		eventDispatcher.pumpUIevent({EventDispatcher::EventType::MIXER_END_OF_REC_CALLBACK});
+		eventDispatcher.pumpEvent({EventDispatcher::EventType::MIXER_END_OF_REC_CALLBACK});
 	};
 
 	channelManager.onChannelsAltered = [this]() {
@@ -142,8 +186,8 @@ Engine::Engine()
 			recorder.stopInputRec(conf.data.inputRecMode, kernelAudio.getSampleRate());
 	};
 
-	sequencer.onBpmChange = [this](float oldVal, float newVal, int quantizerStep) {
-		actionRecorder.updateBpm(oldVal / newVal, quantizerStep);
+	offlineRenderer.onProcessBlock = [this](mcl::AudioBuffer& out, const mcl::AudioBuffer& in, const model::Layout& layout) {
+		processBlock(out, in, layout);
 	};
 }
 
@@ -160,7 +204,7 @@ void Engine::updateMixerModel()
 
 /* -------------------------------------------------------------------------- */
 
-void Engine::init()
+void Engine::init(bool nullAudio)
 {
 	if (!conf.read())
 		u::log::print("[Engine::init] Can't read configuration file! Using default values\n");
@@ -179,7 +223,14 @@ void Engine::init()
 	/* Initialize KernelAudio. If fails, interrupt the Engine initialization:
     Giada can't work without a functional KernelAudio. */
 
-	kernelAudio.openDevice(conf.data);
+	if (nullAudio)
+	{
+		Conf::Data nullConf  = conf.data;
+		nullConf.soundSystem = G_SYS_API_NULL;
+		kernelAudio.openDevice(nullConf);
+	}
+	else
+		kernelAudio.openDevice(conf.data);
 	if (!kernelAudio.isReady())
 		return;
 
@@ -188,18 +239,38 @@ void Engine::init()
 		jackTransport.setHandle(kernelAudio.getJackHandle());
 #endif
 
-	mixer.reset(sequencer.getMaxFramesInLoop(kernelAudio.getSampleRate()), kernelAudio.getBufferSize());
+	mixer.reset(kernelAudio.getBufferSize());
 	channelManager.reset(kernelAudio.getBufferSize());
 	sequencer.reset(kernelAudio.getSampleRate());
 	pluginHost.reset(kernelAudio.getBufferSize());
 	pluginManager.reset(static_cast<PluginManager::SortMethod>(conf.data.pluginSortMethod));
+	renderPool.start(conf.data.renderThreads);
+	profiler.setBudget(kernelAudio.getBufferSize(), kernelAudio.getSampleRate());
+	profiler.setEnabled(conf.data.profilerEnabled);
 
 	mixer.enable();
 	kernelAudio.startStream();
 
-	kernelMidi.openOutDevice(conf.data.midiSystem, conf.data.midiPortOut);
-	kernelMidi.openInDevice(conf.data.midiSystem, conf.data.midiPortIn);
-	kernelMidi.logPorts();
+	/* With JACK for both audio and MIDI, register MIDI ports on the audio 
+	client rather than opening a separate RtMidi one: MIDI then shares the
+	audio clock. */
+
+	bool jackMidi = false;
+#ifdef WITH_AUDIO_JACK
+	if (kernelAudio.getAPI() == G_SYS_API_JACK && conf.data.midiSystem == G_MIDI_API_JACK)
+		jackMidi = kernelMidi.openJackPorts(kernelAudio.getJackHandle());
+#endif
+	if (!jackMidi)
+	{
+		kernelMidi.openOutDevice(conf.data.midiSystem, conf.data.midiPortOut);
+		kernelMidi.openInDevice(conf.data.midiSystem, conf.data.midiPortIn);
+		for (int port : conf.data.midiExtraPortsOut)
+			kernelMidi.openOutDevice(conf.data.midiSystem, port);
+		for (int port : conf.data.midiExtraPortsIn)
+			kernelMidi.openInDevice(conf.data.midiSystem, port);
+		kernelMidi.logPorts();
+	}
+	kernelMidi.startOutput();
 
 	midiMapper.sendInitMessages(midiMapper.currentMap);
 
@@ -221,12 +292,33 @@ void Engine::reset()
 	/* Then all other components. */
 
 	model.reset();
-	mixer.reset(sequencer.getMaxFramesInLoop(kernelAudio.getSampleRate()), kernelAudio.getBufferSize());
+	mixer.reset(kernelAudio.getBufferSize());
 	channelManager.reset(kernelAudio.getBufferSize());
 	synchronizer.reset();
 	sequencer.reset(kernelAudio.getSampleRate());
 	actionRecorder.reset();
 	pluginHost.reset(kernelAudio.getBufferSize());
+	profiler.reset();
+}
+
+/* -------------------------------------------------------------------------- */
+
+int Engine::renderOffline(const OfflineRenderer::Params& params, std::function<void(float)> progress)
+{
+	/* Stop the audio stream while rendering: the offline renderer drives the
+	very same pipeline of the audio callback. */
+
+	const bool hasStream = kernelAudio.isReady();
+	if (hasStream)
+		kernelAudio.stopStream();
+
+	const int res = offlineRenderer.render(params, kernelAudio.getSampleRate(),
+	    kernelAudio.getBufferSize(), progress);
+
+	if (hasStream)
+		kernelAudio.startStream();
+
+	return res;
 }
 
 /* -------------------------------------------------------------------------- */
@@ -239,8 +331,11 @@ void Engine::shutdown()
 		u::log::print("[Engine::shutdown] KernelAudio closed\n");
 		mixer.disable();
 		u::log::print("[Engine::shutdown] Mixer closed\n");
+		renderPool.stop();
 	}
 
+	kernelMidi.stopOutput();
+
 	model::store(conf.data);
 	if (!conf.write())
 		u::log::print("[Engine::shutdown] error while saving configuration file!\n");
@@ -275,6 +370,9 @@ int Engine::audioCallback(KernelAudio::CallbackInfo kernelInfo)
 	if (!kernelInfo.ready)
 		return 0;
 
+	if (kernelInfo.xrun && profiler.isEnabled())
+		profiler.notifyXrun();
+
 	/* Prepare the LayoutLock. From this point on (until out of scope) the 
 	Layout is locked for realtime rendering by the audio thread. Rendering 
 	functions must access the realtime layout coming from layoutLock.get(). */
@@ -292,29 +390,43 @@ int Engine::audioCallback(KernelAudio::CallbackInfo kernelInfo)
 		synchronizer.recvJackSync(jackTransport.getState());
 #endif
 
+	/* Outgoing MIDI sync is computed here rather than in processBlock(), so 
+	that offline rendering doesn't send any. The sequencer has not advanced 
+	yet: its current frame is the first one of this block. */
+
+	synchronizer.advance(layout_RT.sequencer, kernelInfo.bufferSize, kernelAudio);
+
+	processBlock(out, in, layout_RT);
+
+	return 0;
+}
+
+/* -------------------------------------------------------------------------- */
+
+void Engine::processBlock(mcl::AudioBuffer& out, const mcl::AudioBuffer& in, const model::Layout& layout_RT)
+{
+	Profiler::Scope scope(profiler, Profiler::Stage::BLOCK);
+
 	/* If the sequencer is running, advance it first (i.e. parse it for events). 
-	Also advance channels (i.e. let them react to sequencer events), only if the 
-	layout is not locked: another thread might altering channel's data in the 
-	meantime (e.g. Plugins or Waves). */
+	Also advance channels (i.e. let them react to sequencer events). */
 
 	if (layout_RT.sequencer.isRunning())
 	{
+		Profiler::Scope seqScope(profiler, Profiler::Stage::SEQUENCER);
+
 		const Frame        currentFrame  = sequencer.getCurrentFrame();
-		const Frame        bufferSize    = in.countFrames();
+		const Frame        bufferSize    = out.countFrames();
 		const Frame        quantizerStep = sequencer.getQuantizerStep();              // TODO pass this to sequencer.advance - or better, Advancer class
 		const Range<Frame> renderRange   = {currentFrame, currentFrame + bufferSize}; // TODO pass this to sequencer.advance - or better, Advancer class
 
-		const Sequencer::EventBuffer& events = sequencer.advance(bufferSize, actionRecorder);
+		sequencer.advance(bufferSize, actionRecorder);
 		sequencer.render(out);
-		if (!layout_RT.locked)
-			mixer.advanceChannels(events, layout_RT, renderRange, quantizerStep);
+		mixer.advanceChannels(sequencer, layout_RT, renderRange, quantizerStep);
 	}
 
 	/* Then render Mixer: render channels, process I/O. */
 
 	mixer.render(out, in, layout_RT);
-
-	return 0;
 }
 
 /* -------------------------------------------------------------------------- */
@@ -388,14 +500,12 @@ LoadState Engine::load(const std::string& projectPath, const std::string& patchP
 
 	progress(0.6f);
 
-	/* Prepare the engine. Recorder has to recompute the actions positions if 
-	the current samplerate != patch samplerate. Clock needs to update frames
-	in sequencer. */
+	/* Prepare the engine. Actions are stored in ticks and don't depend on the
+	samplerate, but the sequencer needs to update its frames. */
 
 	mixer.updateSoloCount(channelManager.hasSolos());
-	actionRecorder.updateSamplerate(kernelAudio.getSampleRate(), patch.data.samplerate);
 	sequencer.recomputeFrames(kernelAudio.getSampleRate());
-	mixer.allocRecBuffer(sequencer.getMaxFramesInLoop(kernelAudio.getSampleRate()));
+	updateMixerModel();
 
 	progress(0.9f);
 
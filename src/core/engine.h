@@ -41,10 +41,13 @@
 #include "core/midiMapper.h"
 #include "core/mixer.h"
 #include "core/model/model.h"
+#include "core/offlineRenderer.h"
 #include "core/patch.h"
 #include "core/plugins/pluginHost.h"
 #include "core/plugins/pluginManager.h"
+#include "core/profiler.h"
 #include "core/recorder.h"
+#include "core/renderPool.h"
 #include "core/sequencer.h"
 #include "core/synchronizer.h"
 #include "core/waveFactory.h"
@@ -91,9 +94,11 @@ public:
 
 	/* init
     Initializes all sub-components. If KernelAudio fails to start, the process
-    interrupts and Giada is put in an invalid state. */
+    interrupts and Giada is put in an invalid state. If 'nullAudio' is true the
+    NullAudioDevice is used regardless of the configuration, for headless 
+    operations. */
 
-	void init();
+	void init(bool nullAudio = false);
 
 	/* reset
     Resets all sub-components to the initial state. Useful when Giada needs to
@@ -106,6 +111,13 @@ public:
 
 	void shutdown();
 
+	/* renderOffline
+	Bounces the current project to an audio file as fast as possible, with the
+	audio device suspended. See OfflineRenderer::render(). Returns G_RES_OK on
+	success. */
+
+	int renderOffline(const OfflineRenderer::Params&, std::function<void(float)> progress);
+
 	model::Model           model;
 	Conf                   conf;
 	Patch                  patch;
@@ -113,6 +125,7 @@ public:
 	KernelMidi             kernelMidi;
 	JackTransport          jackTransport;
 	WaveFactory            waveFactory;
+	Profiler               profiler;
 	EventDispatcher        eventDispatcher;
 	MidiMapper<KernelMidi> midiMapper;
 	ChannelFactory         channelFactory;
@@ -121,13 +134,22 @@ public:
 	ActionRecorder         actionRecorder;
 	Synchronizer           synchronizer;
 	Sequencer              sequencer;
+	RenderPool             renderPool;
 	Mixer                  mixer;
 	Recorder               recorder;
 	PluginHost             pluginHost;
 	PluginManager          pluginManager;
+	OfflineRenderer        offlineRenderer;
 
 private:
 	int audioCallback(KernelAudio::CallbackInfo);
+
+	/* processBlock
+	Renders a single block of audio: advances the sequencer and the channels,
+	then renders the Mixer. Shared by the real-time audio callback and the
+	offline renderer. */
+
+	void processBlock(mcl::AudioBuffer& out, const mcl::AudioBuffer& in, const model::Layout&);
 };
 } // namespace giada::m
 
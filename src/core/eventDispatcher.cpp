@@ -26,17 +26,72 @@
 
 #include "core/eventDispatcher.h"
 #include "core/const.h"
+#include "utils/log.h"
+#include <algorithm>
 #include <cassert>
 
 namespace giada::m
 {
-EventDispatcher::EventDispatcher()
+void EventDispatcher::EventRouter::route(const EventBuffer& events)
+{
+	static_assert(G_MAX_DISPATCHER_EVENTS <= UINT16_MAX);
+
+	m_events = &events;
+	m_size   = events.size();
+
+	for (std::size_t i = 0; i < m_size; i++)
+		m_order[i] = static_cast<Index>(i);
+
+	std::sort(m_order.begin(), m_order.begin() + m_size, [this](Index a, Index b) {
+		const ID ca = getChannelId(a);
+		const ID cb = getChannelId(b);
+		return ca != cb ? ca < cb : a < b;
+	});
+}
+
+/* -------------------------------------------------------------------------- */
+
+bool EventDispatcher::EventRouter::hasEventsFor(ID channelId) const
+{
+	const auto [shared, sharedEnd] = getBucket(0);
+	const auto [own, ownEnd]       = getBucket(channelId);
+	return shared != sharedEnd || own != ownEnd;
+}
+
+/* -------------------------------------------------------------------------- */
+
+EventDispatcher::EventRouter::Bucket EventDispatcher::EventRouter::getBucket(ID channelId) const
+{
+	const Index* begin = m_order.data();
+	const Index* end   = m_order.data() + m_size;
+
+	const Index* first = std::lower_bound(begin, end, channelId,
+	    [this](Index i, ID id) { return getChannelId(i) < id; });
+	const Index* last = std::upper_bound(first, end, channelId,
+	    [this](ID id, Index i) { return id < getChannelId(i); });
+	return {first, last};
+}
+
+/* -------------------------------------------------------------------------- */
+
+ID EventDispatcher::EventRouter::getChannelId(Index i) const
+{
+	return m_events->begin()[i].channelId;
+}
+
+/* -------------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------- */
+
+EventDispatcher::EventDispatcher(Profiler& p)
 : onMidiLearn(nullptr)
 , onMidiProcess(nullptr)
 , onProcessChannels(nullptr)
 , onProcessSequencer(nullptr)
 , onMixerSignalCallback(nullptr)
 , onMixerEndOfRecCallback(nullptr)
+, m_profiler(p)
+, m_droppedEvents(0)
 {
 }
 
@@ -49,8 +104,20 @@ void EventDispatcher::start()
 
 /* -------------------------------------------------------------------------- */
 
-void EventDispatcher::pumpUIevent(Event e) { UIevents.push(e); }
-void EventDispatcher::pumpMidiEvent(Event e) { MidiEvents.push(e); }
+bool EventDispatcher::pumpEvent(Event e)
+{
+	if (m_profiler.isEnabled())
+		e.timestamp = Profiler::Clock::now();
+	if (!m_eventQueue.push(e))
+		return false;
+	m_worker.notify();
+	return true;
+}
+
+/* -------------------------------------------------------------------------- */
+
+uint32_t EventDispatcher::getDroppedEvents() const { return m_eventQueue.getDropped(); }
+uint32_t EventDispatcher::getQueueHighWater() const { return m_eventQueue.getHighWater(); }
 
 /* -------------------------------------------------------------------------- */
 
@@ -94,19 +161,58 @@ void EventDispatcher::process()
 	assert(onProcessChannels != nullptr);
 	assert(onProcessSequencer != nullptr);
 
-	m_eventBuffer.clear();
+	logDroppedEvents();
+
+	/* Drain the queue in batches no larger than the event buffer, so that the
+	buffer never wraps around and overwrites events not yet dispatched. */
 
 	Event e;
-	while (UIevents.pop(e))
-		m_eventBuffer.push_back(e);
-	while (MidiEvents.pop(e))
-		m_eventBuffer.push_back(e);
+	bool  more = true;
+	while (more)
+	{
+		m_eventBuffer.clear();
+		while (m_eventBuffer.size() < EventQueue::getCapacity() && (more = m_eventQueue.pop(e)))
+			m_eventBuffer.push_back(e);
 
-	if (m_eventBuffer.size() == 0)
-		return;
+		if (m_eventBuffer.size() > 0)
+			dispatch();
+	}
+}
+
+/* -------------------------------------------------------------------------- */
 
+void EventDispatcher::dispatch()
+{
 	processFunctions();
-	onProcessChannels(m_eventBuffer);
+	m_eventRouter.route(m_eventBuffer);
+	onProcessChannels(m_eventRouter);
 	onProcessSequencer(m_eventBuffer);
+
+	if (m_profiler.isEnabled())
+		recordLatency();
+}
+
+/* -------------------------------------------------------------------------- */
+
+void EventDispatcher::logDroppedEvents()
+{
+	const uint32_t dropped = m_eventQueue.getDropped();
+	if (dropped == m_droppedEvents)
+		return;
+
+	u::log::print("[EventDispatcher] Queue full, %u event(s) dropped! High-water mark: %u/%zu\n",
+	    dropped - m_droppedEvents, m_eventQueue.getHighWater(), EventQueue::getCapacity());
+	m_droppedEvents = dropped;
+}
+
+/* -------------------------------------------------------------------------- */
+
+void EventDispatcher::recordLatency()
+{
+	const Profiler::Clock::time_point now = Profiler::Clock::now();
+
+	for (const Event& e : m_eventBuffer)
+		if (e.timestamp != Profiler::Clock::time_point{})
+			m_profiler.getEventLatency().add(now - e.timestamp);
 }
 } // namespace giada::m
\ No newline at end of file
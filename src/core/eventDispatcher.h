@@ -28,20 +28,23 @@
 #define G_EVENT_DISPATCHER_H
 
 #include "core/const.h"
-#include "core/queue.h"
+#include "core/profiler.h"
+#include "core/mpscQueue.h"
 #include "core/ringBuffer.h"
 #include "core/types.h"
 #include "core/worker.h"
 #include "src/core/actions/action.h"
+#include <array>
 #include <atomic>
+#include <cstdint>
 #include <functional>
 #include <thread>
 #include <variant>
 
 /* giada::m::EventDispatcher
-Takes events from the two queues (MIDI and UI) filled by c::events and turns 
-them into actual changes in the data model. The EventDispatcher runs in a
-separate worker thread. */
+Takes events from the queue filled by c::events (and by any other thread: UI,
+MIDI, JACK, ...) and turns them into actual changes in the data model. The EventDispatcher runs in a
+separate worker thread, woken up as soon as a new event is pumped. */
 
 namespace giada::m
 {
@@ -62,7 +65,12 @@ public:
 		SEQUENCER_REWIND_JACK,
 		SEQUENCER_BPM_JACK,
 #endif
+		SEQUENCER_START_CLOCK, // Following an external MIDI clock
+		SEQUENCER_STOP_CLOCK,
+		SEQUENCER_REWIND_CLOCK,
+		SEQUENCER_BPM_CLOCK,
 		MIDI,
+		MIDI_DIRECT, // Already played through MidiDispatcher's direct path
 		MIDI_DISPATCHER_LEARN,
 		MIDI_DISPATCHER_PROCESS,
 		MIXER_SIGNAL_CALLBACK,
@@ -71,10 +79,7 @@ public:
 		CHANNEL_KILL_READ_ACTIONS,
 		CHANNEL_TOGGLE_ARM,
 		CHANNEL_MUTE,
-		CHANNEL_SOLO,
-		CHANNEL_VOLUME,
-		CHANNEL_PITCH,
-		CHANNEL_PAN
+		CHANNEL_SOLO
 	};
 
 	struct Event
@@ -85,40 +90,114 @@ public:
 		Frame     delta     = 0;
 		ID        channelId = 0;
 		EventData data      = {};
+
+		/* timestamp
+		When the event has been pumped. Set only if the Profiler is enabled, 
+		for latency measurements. */
+
+		Profiler::Clock::time_point timestamp = {};
 	};
 
 	/* EventBuffer
-	Alias for a RingBuffer containing events to be sent to engine. The double 
-	size is due to the presence of two distinct Queues for collecting events 
-	coming from other threads. See below. */
+	Alias for a RingBuffer containing events to be sent to engine. It's never
+	filled past its capacity: see process(). */
+
+	using EventBuffer = RingBuffer<Event, G_MAX_DISPATCHER_EVENTS>;
+
+	/* EventQueue
+	Collects events coming from any thread. */
+
+	using EventQueue = MpscQueue<Event, G_MAX_DISPATCHER_EVENTS>;
+
+	/* EventRouter
+	Events in the event buffer grouped by channel ID, so that each channel only
+	visits its own events. Events with channel ID 0 are addressed to all 
+	channels. */
+
+	class EventRouter
+	{
+	public:
+		/* route
+		Groups the events in 'events', which must outlive the router. No 
+		allocations. */
+
+		void route(const EventBuffer& events);
+
+		/* hasEventsFor
+		True if at least one event is addressed to channel 'channelId', or to 
+		all channels. */
 
-	using EventBuffer = RingBuffer<Event, G_MAX_DISPATCHER_EVENTS * 2>;
+		bool hasEventsFor(ID channelId) const;
 
-	EventDispatcher();
+		/* forEachEventFor
+		Calls 'f' on each event addressed to channel 'channelId', or to all 
+		channels, in the order they have been pumped. */
+
+		template <typename F>
+		void forEachEventFor(ID channelId, F&& f) const
+		{
+			auto [shared, sharedEnd] = getBucket(0);
+			auto [own, ownEnd]       = getBucket(channelId);
+
+			while (shared != sharedEnd || own != ownEnd)
+			{
+				if (own == ownEnd || (shared != sharedEnd && *shared < *own))
+					f(m_events->begin()[*shared++]);
+				else
+					f(m_events->begin()[*own++]);
+			}
+		}
+
+	private:
+		using Index  = uint16_t;
+		using Bucket = std::pair<const Index*, const Index*>;
+
+		/* getBucket
+		Returns the positions of the events for channel 'channelId' only. */
+
+		Bucket getBucket(ID channelId) const;
+
+		ID getChannelId(Index i) const;
+
+		const EventBuffer* m_events = nullptr;
+
+		/* m_order
+		Positions of the events in the buffer, sorted by channel ID first and
+		by position then. */
+
+		std::array<Index, G_MAX_DISPATCHER_EVENTS> m_order;
+		std::size_t                                m_size = 0;
+	};
+
+	EventDispatcher(Profiler&);
 
 	/* start
 	Starts the internal worker on a separate thread. Call this on startup. */
 
 	void start();
 
-	void pumpUIevent(Event e);
-	void pumpMidiEvent(Event e);
+	/* pumpEvent
+	Pushes an event into the queue and wakes up the worker. Returns false if 
+	the queue is full. Real-time safe, callable from any thread. */
+
+	bool pumpEvent(Event e);
+
+	/* getDroppedEvents
+	Returns the number of events lost so far because the queue was full. */
+
+	uint32_t getDroppedEvents() const;
 
-	/* Event queues
-	Collect events coming from the UI or MIDI devices. Our poor man's Queue is a 
-	single-producer/single-consumer one, so we need two queues for two writers. 
-	TODO - let's add a multi-producer queue sooner or later! */
-	/*TODO - make them private*/
+	/* getQueueHighWater
+	Returns the maximum number of events ever waiting in the queue. */
 
-	Queue<Event, G_MAX_DISPATCHER_EVENTS> UIevents;
-	Queue<Event, G_MAX_DISPATCHER_EVENTS> MidiEvents;
+	uint32_t getQueueHighWater() const;
 
 	/* on[...]
 	Callbacks fired when something happens in the Event Dispatcher. */
 
 	std::function<void(const MidiEvent& e)> onMidiLearn;
 	std::function<void(const MidiEvent& e)> onMidiProcess;
-	std::function<void(const EventBuffer&)> onProcessChannels;
+	std::function<void(const EventRouter&)> onProcessChannels;
 	std::function<void(const EventBuffer&)> onProcessSequencer;
 	std::function<void()>                   onMixerSignalCallback;
 	std::function<void()>                   onMixerEndOfRecCallback;
@@ -127,16 +206,50 @@ private:
 	void processFunctions();
 	void process();
 
+	/* dispatch
+	Sends the events collected in the event buffer to their recipients. */
+
+	void dispatch();
+
+	/* logDroppedEvents
+	Writes to the log how many events have been lost since the last call, if 
+	any. */
+
+	void logDroppedEvents();
+
+	/* recordLatency
+	Feeds the Profiler with the time taken by each event in the buffer to get
+	from the queue to the channels. */
+
+	void recordLatency();
+
+	Profiler& m_profiler;
+
 	/* m_worker
 	A separate thread responsible for the event processing. */
 
 	Worker m_worker;
 
+	/* m_eventQueue
+	Events waiting to be processed by the worker. */
+
+	EventQueue m_eventQueue;
+
 	/* m_eventBuffer
 	Buffer of events sent to channels for event parsing. This is filled with 
-	Events coming from the two event queues.*/
+	Events coming from the event queue.*/
 
 	EventBuffer m_eventBuffer;
+
+	/* m_eventRouter
+	Routes the events in m_eventBuffer to channels. */
+
+	EventRouter m_eventRouter;
+
+	/* m_droppedEvents
+	Number of dropped events already written to the log. Worker thread only. */
+
+	uint32_t m_droppedEvents;
 };
 } // namespace giada::m
 
@@ -27,17 +27,37 @@
 #ifdef __APPLE__
 #include <pwd.h>
 #endif
+#include "core/dsp/kernels.h"
 #include "core/engine.h"
 #include "gui/dialogs/warnings.h"
 #include "gui/ui.h"
 #include "gui/updater.h"
+#include "utils/fs.h"
 #include "utils/log.h"
 #include "utils/ver.h"
 #ifdef WITH_TESTS
 #define CATCH_CONFIG_RUNNER
+#define CATCH_CONFIG_ENABLE_BENCHMARKING
+#include "tests/actionBuckets.cpp"
+#include "tests/actionMap.cpp"
 #include "tests/actionRecorder.cpp"
+#include "tests/channelManager.cpp"
+#include "tests/channelShared.cpp"
+#include "tests/cowVector.cpp"
+#include "tests/dspKernels.cpp"
+#include "tests/eventDispatcher.cpp"
+#include "tests/idIndex.cpp"
+#include "tests/inputRecBuffer.cpp"
+#include "tests/midiClockPll.cpp"
+#include "tests/midiDispatcher.cpp"
 #include "tests/midiLighter.cpp"
+#include "tests/mpscQueue.cpp"
+#include "tests/profiler.cpp"
+#include "tests/reclaimer.cpp"
+#include "tests/renderPool.cpp"
 #include "tests/samplePlayer.cpp"
+#include "tests/sequencer.cpp"
+#include "tests/tempoMap.cpp"
 #include "tests/utils.cpp"
 #include "tests/wave.cpp"
 #include "tests/waveFactory.cpp"
@@ -48,6 +68,10 @@
 #include <vector>
 #endif
 #include <FL/Fl.H>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
 
 extern giada::m::Engine g_engine;
 extern giada::v::Ui     g_ui;
@@ -71,6 +95,65 @@ int tests(int argc, char** argv)
 
 /* -------------------------------------------------------------------------- */
 
+int render(int argc, char** argv)
+{
+	std::vector<std::string> args(argv, argv + argc);
+	if (args.size() < 2 || args[1] != "--render")
+		return -1;
+
+	OfflineRenderer::Params params;
+	std::string             projectPath;
+
+	for (std::size_t i = 2; i < args.size(); i++)
+	{
+		if (args[i] == "--bars" && i + 1 < args.size())
+			params.bars = std::atoi(args[++i].c_str());
+		else if (args[i] == "--out" && i + 1 < args.size())
+			params.path = args[++i];
+		else if (args[i] == "--stems")
+			params.stems = true;
+		else
+			projectPath = args[i];
+	}
+
+	if (projectPath.empty() || params.path.empty() || params.bars <= 0)
+	{
+		std::fprintf(stderr, "Usage: giada --render project.gprj --bars N --out file.wav [--stems]\n");
+		return 1;
+	}
+
+	juce::initialiseJuce_GUI();
+	g_engine.init(/*nullAudio=*/true);
+
+	int res = G_RES_ERR;
+
+	if (!g_engine.kernelAudio.isReady())
+	{
+		std::fprintf(stderr, "Unable to initialize the audio engine\n");
+	}
+	else
+	{
+		const std::string patchPath = u::fs::join(projectPath, u::fs::stripExt(u::fs::basename(projectPath)) + ".gptc");
+		const LoadState   state     = g_engine.load(projectPath, patchPath, [](float) {});
+
+		if (state.patch != G_FILE_OK)
+			std::fprintf(stderr, "Unable to load project %s\n", projectPath.c_str());
+		else
+		{
+			res = g_engine.renderOffline(params, [](float) {});
+			if (res != G_RES_OK)
+				std::fprintf(stderr, "Unable to render project %s\n", projectPath.c_str());
+		}
+	}
+
+	g_engine.shutdown();
+	juce::shutdownJuce_GUI();
+
+	return res == G_RES_OK ? 0 : 1;
+}
+
+/* -------------------------------------------------------------------------- */
+
 void printBuildInfo()
 {
 	u::log::print("[init] Giada %s\n", G_VERSION_STR);
@@ -92,6 +175,8 @@ void printBuildInfo()
 
 	KernelAudio::logCompiledAPIs();
 	KernelMidi::logCompiledAPIs();
+
+	u::log::print("[init] DSP kernels: %s\n", dsp::getIsaName(dsp::getIsa()));
 }
 
 /* -------------------------------------------------------------------------- */
@@ -35,6 +35,14 @@ Performs tests, if requested. Returns -1 if no tests are available or the
 
 int tests(int argc, char** argv);
 
+/* render
+Renders a project to an audio file with no GUI, if requested with 
+`--render project.gprj --bars N --out file.wav [--stems]`. Returns -1 if the
+`--render` flag has not been passed in, the process exit code otherwise. The
+audio engine runs on the null audio device, so no sound card is needed. */
+
+int render(int argc, char** argv);
+
 void printBuildInfo();
 void startup(int argc, char** argv);
 int  run();
@@ -0,0 +1,199 @@
+/* -----------------------------------------------------------------------------
+ *
+ * Giada - Your Hardcore Loopmachine
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2022 Giovanni A. Zuliani | Monocasual Laboratories
+ *
+ * This file is part of Giada - Your Hardcore Loopmachine.
+ *
+ * Giada - Your Hardcore Loopmachine is free software: you can
+ * redistribute it and/or modify it under the terms of the GNU General
+ * Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * Giada - Your Hardcore Loopmachine is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Giada - Your Hardcore Loopmachine. If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------- */
+
+
+#include "core/inputRecBuffer.h"
+#include "core/const.h"
+#include "utils/log.h"
+#include <algorithm>
+#include <cassert>
+
+namespace giada::m
+{
+InputRecBuffer::InputRecBuffer()
+: m_numChunks(0)
+, m_maxFrames(0)
+, m_writePos(0)
+, m_droppedFrames(0)
+{
+}
+
+/* -------------------------------------------------------------------------- */
+
+InputRecBuffer::~InputRecBuffer()
+{
+	clear();
+}
+
+/* -------------------------------------------------------------------------- */
+
+template <typename F>
+void InputRecBuffer::forEachChunk(Frame frames, F f) const
+{
+	frames = std::min(frames, m_maxFrames);
+
+	for (Frame pos = 0; pos < frames; pos += CHUNK_FRAMES)
+	{
+		const mcl::AudioBuffer* chunk = m_chunks[pos / CHUNK_FRAMES].load(std::memory_order_acquire);
+		if (chunk != nullptr)
+			f(*chunk, std::min(CHUNK_FRAMES, frames - pos), pos);
+	}
+}
+
+/* -------------------------------------------------------------------------- */
+
+Frame InputRecBuffer::getMaxFrames() const { return m_maxFrames; }
+Frame InputRecBuffer::getDroppedFrames() const { return m_droppedFrames.load(); }
+
+/* -------------------------------------------------------------------------- */
+
+void InputRecBuffer::start(Frame maxFrames, Frame startFrame)
+{
+	assert(maxFrames > 0);
+
+	clear();
+
+	m_maxFrames = maxFrames;
+	m_numChunks = countChunks();
+	m_chunks    = std::make_unique<std::atomic<mcl::AudioBuffer*>[]>(m_numChunks);
+	for (int i = 0; i < m_numChunks; i++)
+		m_chunks[i].store(nullptr);
+
+	m_writePos.store(startFrame % maxFrames);
+	m_droppedFrames.store(0);
+
+	/* Make the first chunks available right away, so that the very first
+	blocks don't depend on the worker being scheduled in time. */
+
+	allocChunks(m_writePos.load());
+
+	m_worker.start([this]() { allocChunks(m_writePos.load()); }, WORKER_SLEEP);
+
+	u::log::print("[InputRecBuffer::start] maxFrames=%d, startFrame=%d, chunks=%d\n",
+	    maxFrames, startFrame, m_numChunks);
+}
+
+/* -------------------------------------------------------------------------- */
+
+void InputRecBuffer::stop()
+{
+	m_worker.stop();
+
+	if (m_droppedFrames.load() > 0)
+		u::log::print("[InputRecBuffer::stop] %d frames dropped\n", m_droppedFrames.load());
+}
+
+/* -------------------------------------------------------------------------- */
+
+void InputRecBuffer::clear()
+{
+	m_worker.stop();
+
+	for (int i = 0; i < m_numChunks; i++)
+		delete m_chunks[i].exchange(nullptr);
+
+	m_chunks.reset();
+	m_numChunks = 0;
+	m_maxFrames = 0;
+	m_writePos.store(0);
+}
+
+/* -------------------------------------------------------------------------- */
+
+void InputRecBuffer::sum(const mcl::AudioBuffer& in, Frame pos, float gain)
+{
+	if (m_numChunks == 0)
+		return;
+
+	Frame remaining = in.countFrames();
+	Frame srcOffset = 0;
+	pos             = pos % m_maxFrames;
+
+	while (remaining > 0)
+	{
+		const int   index       = pos / CHUNK_FRAMES;
+		const Frame destOffset  = pos % CHUNK_FRAMES;
+		const Frame chunkFrames = std::min(CHUNK_FRAMES - destOffset, m_maxFrames - pos);
+		const Frame count       = std::min(remaining, chunkFrames);
+
+		mcl::AudioBuffer* chunk = m_chunks[index].load(std::memory_order_acquire);
+		if (chunk != nullptr)
+			chunk->sum(in, count, srcOffset, destOffset, gain);
+		else
+			m_droppedFrames.fetch_add(count, std::memory_order_relaxed);
+
+		remaining -= count;
+		srcOffset += count;
+		pos = (pos + count) % m_maxFrames;
+	}
+
+	m_writePos.store(pos, std::memory_order_release);
+}
+
+/* -------------------------------------------------------------------------- */
+
+void InputRecBuffer::copyTo(mcl::AudioBuffer& dest, Frame frames) const
+{
+	dest.clear();
+	forEachChunk(frames, [&dest](const mcl::AudioBuffer& chunk, Frame count, Frame destOffset) {
+		dest.set(chunk, count, /*srcOffset=*/0, destOffset);
+	});
+}
+
+/* -------------------------------------------------------------------------- */
+
+void InputRecBuffer::sumTo(mcl::AudioBuffer& dest) const
+{
+	forEachChunk(dest.countFrames(), [&dest](const mcl::AudioBuffer& chunk, Frame count, Frame destOffset) {
+		dest.sum(chunk, count, /*srcOffset=*/0, destOffset, /*gain=*/1.0f);
+	});
+}
+
+/* -------------------------------------------------------------------------- */
+
+int InputRecBuffer::countChunks() const
+{
+	return static_cast<int>((m_maxFrames + CHUNK_FRAMES - 1) / CHUNK_FRAMES);
+}
+
+/* -------------------------------------------------------------------------- */
+
+void InputRecBuffer::allocChunks(Frame pos)
+{
+	const int first = static_cast<int>(pos / CHUNK_FRAMES);
+	const int count = std::min(LOOKAHEAD, m_numChunks);
+
+	for (int i = 0; i < count; i++)
+	{
+		std::atomic<mcl::AudioBuffer*>& slot = m_chunks[(first + i) % m_numChunks];
+		if (slot.load(std::memory_order_relaxed) != nullptr)
+			continue;
+		auto* chunk = new mcl::AudioBuffer(CHUNK_FRAMES, G_MAX_IO_CHANS);
+		chunk->clear();
+		slot.store(chunk, std::memory_order_release);
+	}
+}
+} // namespace giada::m
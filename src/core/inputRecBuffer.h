@@ -0,0 +1,117 @@
+/* -----------------------------------------------------------------------------
+ *
+ * Giada - Your Hardcore Loopmachine
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2022 Giovanni A. Zuliani | Monocasual Laboratories
+ *
+ * This file is part of Giada - Your Hardcore Loopmachine.
+ *
+ * Giada - Your Hardcore Loopmachine is free software: you can
+ * redistribute it and/or modify it under the terms of the GNU General
+ * Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * Giada - Your Hardcore Loopmachine is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Giada - Your Hardcore Loopmachine. If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------- */
+
+
+#ifndef G_INPUT_REC_BUFFER_H
+#define G_INPUT_REC_BUFFER_H
+
+#include "core/types.h"
+#include "core/worker.h"
+#include "deps/mcl-audio-buffer/src/audioBuffer.hpp"
+#include <atomic>
+#include <memory>
+
+namespace giada::m
+{
+/* InputRecBuffer
+Storage for audio input recording. Audio is written into fixed-size chunks that
+are allocated on demand by a background worker, a few chunks ahead of the 
+current write position. Memory usage is proportional to the recorded length 
+and the audio thread never allocates: if it outruns the worker, the missing 
+frames are dropped and counted. */
+
+class InputRecBuffer
+{
+public:
+	InputRecBuffer();
+	InputRecBuffer(const InputRecBuffer&) = delete;
+	~InputRecBuffer();
+
+	InputRecBuffer& operator=(const InputRecBuffer&) = delete;
+
+	/* getMaxFrames
+	Returns the length of the current recording session. Positions wrap around 
+	at this value. */
+
+	Frame getMaxFrames() const;
+
+	/* getDroppedFrames
+	Returns how many frames have been lost because the target chunk was not 
+	ready yet. */
+
+	Frame getDroppedFrames() const;
+
+	/* start
+	Prepares a new recording session of 'maxFrames' frames that begins at 
+	'startFrame', then starts the allocation worker. Not real-time safe. */
+
+	void start(Frame maxFrames, Frame startFrame);
+
+	/* stop
+	Stops the allocation worker. Recorded data is kept until clear() is 
+	called. */
+
+	void stop();
+
+	/* clear
+	Stops the worker and frees all chunks. */
+
+	void clear();
+
+	/* sum
+	Sums 'in' into the buffer at position 'pos', wrapping around at maxFrames.
+	Real-time safe. */
+
+	void sum(const mcl::AudioBuffer& in, Frame pos, float gain);
+
+	/* copyTo, sumTo
+	Copies (or sums) the first 'frames' recorded frames into 'dest'. Missing 
+	chunks are treated as silence. */
+
+	void copyTo(mcl::AudioBuffer& dest, Frame frames) const;
+	void sumTo(mcl::AudioBuffer& dest) const;
+
+private:
+	static constexpr Frame CHUNK_FRAMES = 16384;
+	static constexpr int   LOOKAHEAD    = 4;
+	static constexpr int   WORKER_SLEEP = 10; // ms
+
+	int  countChunks() const;
+	void allocChunks(Frame pos);
+
+	template <typename F>
+	void forEachChunk(Frame frames, F f) const;
+
+	std::unique_ptr<std::atomic<mcl::AudioBuffer*>[]> m_chunks;
+	int                                               m_numChunks;
+	Frame                                             m_maxFrames;
+	std::atomic<Frame>                                m_writePos;
+	std::atomic<Frame>                                m_droppedFrames;
+	Worker                                            m_worker;
+};
+} // namespace giada::m
+
+#endif
@@ -31,6 +31,7 @@
 #include "core/const.h"
 #include "utils/log.h"
 #include "utils/vector.h"
+#include <algorithm>
 #include <cassert>
 #include <cstddef>
 
@@ -45,6 +46,7 @@ KernelAudio::KernelAudio()
 , m_channelsOutCount(0)
 , m_channelsInCount(0)
 , m_api(0)
+, m_blockStart(0)
 {
 }
 
@@ -57,6 +59,9 @@ int KernelAudio::openDevice(const Conf::Data& conf)
 	m_api = conf.soundSystem;
 	u::log::print("[KA] using system 0x%x\n", m_api);
 
+	if (m_api == G_SYS_API_NULL)
+		return openNullDevice(conf);
+
 #if defined(__linux__) || defined(__FreeBSD__)
 
 	if (m_api == G_SYS_API_JACK && hasAPI(RtAudio::UNIX_JACK))
@@ -167,7 +172,8 @@ int KernelAudio::openDevice(const Conf::Data& conf)
 	    /* inBuf            = */ nullptr, // filled later on in audio callback
 	    /* bufferSize       = */ 0,       // filled later on in audio callback
 	    /* channelsOutCount = */ m_channelsOutCount,
-	    /* channelsInCount  = */ m_channelsInCount};
+	    /* channelsInCount  = */ m_channelsInCount,
+	    /* xrun             = */ false};
 
 	RtAudioErrorType res = m_rtAudio->openStream(
 	    &outParams,                                     // output params
@@ -193,8 +199,68 @@ int KernelAudio::openDevice(const Conf::Data& conf)
 
 /* -------------------------------------------------------------------------- */
 
+int KernelAudio::openNullDevice(const Conf::Data& conf)
+{
+	m_realBufferSize   = conf.buffersize;
+	m_realSampleRate   = conf.samplerate;
+	m_channelsOutCount = conf.channelsOutCount;
+	m_channelsInCount  = conf.channelsInCount;
+	m_inputEnabled     = conf.soundDeviceIn != -1;
+
+	/* Expose a single fake device, so that the configuration window has 
+	something to show. */
+
+	Device device;
+	device.probed            = true;
+	device.name              = "Null device";
+	device.maxOutputChannels = G_MAX_IO_CHANS;
+	device.maxInputChannels  = G_MAX_IO_CHANS;
+	device.maxDuplexChannels = G_MAX_IO_CHANS;
+	device.isDefaultOut      = true;
+	device.isDefaultIn       = true;
+	device.sampleRates       = {44100, 48000, 88200, 96000};
+
+	m_devices = {device};
+	printDevices(m_devices);
+
+	m_callbackInfo = {
+	    /* kernelAudio      = */ this,
+	    /* ready            = */ true,
+	    /* withJack         = */ false,
+	    /* outBuf           = */ nullptr, // filled later on in audio callback
+	    /* inBuf            = */ nullptr, // filled later on in audio callback
+	    /* bufferSize       = */ 0,       // filled later on in audio callback
+	    /* channelsOutCount = */ m_channelsOutCount,
+	    /* channelsInCount  = */ m_channelsInCount,
+	    /* xrun             = */ false};
+
+	m_nullDevice = std::make_unique<NullAudioDevice>(m_realSampleRate, m_realBufferSize,
+	    m_channelsOutCount, m_inputEnabled ? m_channelsInCount : 0);
+
+	if (m_inputEnabled && !conf.nullDeviceInputPath.empty())
+		m_nullDevice->loadInput(conf.nullDeviceInputPath);
+
+	m_nullDevice->onProcess = [this](float* out, float* in, int bufferSize) {
+		audioCallback(out, in, bufferSize, 0.0, 0, &m_callbackInfo);
+	};
+
+	u::log::print("[KA] Null device opened, samplerate=%d, buffersize=%d\n",
+	    m_realSampleRate, m_realBufferSize);
+
+	m_ready = true;
+	return 1;
+}
+
+/* -------------------------------------------------------------------------- */
+
 int KernelAudio::startStream()
 {
+	if (m_nullDevice != nullptr)
+	{
+		m_nullDevice->start();
+		return 1;
+	}
+
 	if (m_rtAudio->startStream() == RtAudioErrorType::RTAUDIO_NO_ERROR)
 	{
 		u::log::print("[KA] Start stream - latency = %lu\n", m_rtAudio->getStreamLatency());
@@ -207,6 +273,12 @@ int KernelAudio::startStream()
 
 int KernelAudio::stopStream()
 {
+	if (m_nullDevice != nullptr)
+	{
+		m_nullDevice->stop();
+		return 1;
+	}
+
 	if (m_rtAudio->stopStream() == RtAudioErrorType::RTAUDIO_NO_ERROR)
 	{
 		u::log::print("[KA] Stop stream\n");
@@ -219,6 +291,12 @@ int KernelAudio::stopStream()
 
 void KernelAudio::closeDevice()
 {
+	if (m_nullDevice != nullptr)
+	{
+		m_nullDevice.reset(nullptr);
+		return;
+	}
+
 	if (!m_rtAudio->isStreamOpen())
 		return;
 	m_rtAudio->stopStream();
@@ -243,6 +321,49 @@ bool KernelAudio::isInputEnabled() const { return m_inputEnabled; }
 
 /* -------------------------------------------------------------------------- */
 
+Frame KernelAudio::getFrameOffset(Clock::time_point t) const
+{
+	const Clock::rep blockStart = m_blockStart.load(std::memory_order_relaxed);
+	if (blockStart == 0 || m_realBufferSize == 0)
+		return 0;
+
+	const Clock::duration elapsed = t - Clock::time_point(Clock::duration(blockStart));
+	const double          seconds = std::chrono::duration<double>(elapsed).count();
+	const Frame           offset  = static_cast<Frame>(seconds * m_realSampleRate);
+
+	return std::clamp(offset, 0, static_cast<Frame>(m_realBufferSize) - 1);
+}
+
+/* -------------------------------------------------------------------------- */
+
+KernelAudio::Clock::time_point KernelAudio::getFrameTime(Frame offset) const
+{
+	const Clock::rep blockStart = m_blockStart.load(std::memory_order_relaxed);
+	if (blockStart == 0 || m_realSampleRate == 0)
+		return Clock::now();
+
+	const double seconds = (m_realBufferSize + offset) / static_cast<double>(m_realSampleRate);
+
+	return Clock::time_point(Clock::duration(blockStart)) +
+	       std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(seconds));
+}
+
+/* -------------------------------------------------------------------------- */
+
+KernelAudio::Clock::time_point KernelAudio::getInputTime(Frame offset) const
+{
+	const Clock::rep blockStart = m_blockStart.load(std::memory_order_relaxed);
+	if (blockStart == 0 || m_realSampleRate == 0)
+		return Clock::now();
+
+	const double seconds = (offset - static_cast<Frame>(m_realBufferSize)) / static_cast<double>(m_realSampleRate);
+
+	return Clock::time_point(Clock::duration(blockStart)) +
+	       std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(seconds));
+}
+
+/* -------------------------------------------------------------------------- */
+
 m::KernelAudio::Device KernelAudio::getDevice(const char* name) const
 {
 	for (Device device : m_devices)
@@ -379,12 +500,16 @@ void KernelAudio::printDevices(const std::vector<m::KernelAudio::Device>& device
 /* -------------------------------------------------------------------------- */
 
 int KernelAudio::audioCallback(void* outBuf, void* inBuf, unsigned bufferSize,
-    double /*streamTime*/, RtAudioStreamStatus /*status*/, void*   data)
+    double /*streamTime*/, RtAudioStreamStatus status, void* data)
 {
 	CallbackInfo info = *static_cast<CallbackInfo*>(data);
 	info.outBuf       = outBuf;
 	info.inBuf        = inBuf;
 	info.bufferSize   = bufferSize;
+	info.xrun         = status != 0;
+
+	info.kernelAudio->m_blockStart.store(Clock::now().time_since_epoch().count(), std::memory_order_relaxed);
+
 	return info.kernelAudio->onAudioCallback(info);
 }
 } // namespace giada::m
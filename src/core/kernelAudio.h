@@ -28,7 +28,11 @@
 #define G_KERNELAUDIO_H
 
 #include "core/conf.h"
+#include "core/nullAudioDevice.h"
+#include "core/types.h"
 #include "deps/rtaudio/RtAudio.h"
+#include <atomic>
+#include <chrono>
 #include <cstddef>
 #include <functional>
 #include <memory>
@@ -43,6 +47,8 @@ namespace giada::m
 class KernelAudio final
 {
 public:
+	using Clock = std::chrono::steady_clock;
+
 	struct Device
 	{
 		size_t           index             = 0;
@@ -66,13 +72,19 @@ public:
 		int          bufferSize;
 		int          channelsOutCount;
 		int          channelsInCount;
+		bool         xrun; // Over/underflow reported by the driver
 	};
 
 	KernelAudio();
 
 	static void logCompiledAPIs();
 
-	int  openDevice(const Conf::Data& conf);
+	/* openDevice
+	Opens the audio device according to the configuration. G_SYS_API_NULL 
+	selects the timer-driven NullAudioDevice: sample rate, buffer size and 
+	channels come from the configuration as usual. */
+
+	int openDevice(const Conf::Data& conf);
 	void closeDevice();
 	int  startStream();
 	int  stopStream();
@@ -91,6 +103,32 @@ public:
 	jack_client_t* getJackHandle() const;
 #endif
 
+	/* getFrameOffset
+	Converts time point 't' (e.g. when a MIDI message arrived) to a frame offset
+	within the next audio block. Everything received during block N is played 
+	in block N+1 at the same relative position: this adds one block of constant
+	latency but removes the jitter of snapping events to block boundaries. 
+	Returns 0 if no block has been processed yet. Thread-safe. */
+
+	Frame getFrameOffset(Clock::time_point t) const;
+
+	/* getFrameTime
+	The other way around: returns the time at which frame 'offset' of the 
+	current block reaches the output, assuming one block of output latency. 
+	Used for scheduling outgoing MIDI in sync with audio. Call this from the
+	audio thread. */
+
+	Clock::time_point getFrameTime(Frame offset) const;
+
+	/* getInputTime
+	Returns the time at which frame 'offset' of the previous block came in. 
+	Audio servers (e.g. JACK) hand over input events one cycle late, stamped 
+	with a frame offset in the cycle they were received: the previous block 
+	starts one block before the current one. Call this from the audio 
+	thread. */
+
+	Clock::time_point getInputTime(Frame offset) const;
+
 	/* onAudioCallback
 	Main callback invoked on each audio block. */
 
@@ -99,6 +137,8 @@ public:
 private:
 	static int audioCallback(void*, void*, unsigned, double, RtAudioStreamStatus, void*);
 
+	int openNullDevice(const Conf::Data& conf);
+
 	Device              fetchDevice(size_t deviceIndex) const;
 	std::vector<Device> fetchDevices() const;
 	void                printDevices(const std::vector<Device>& devices) const;
@@ -106,16 +146,23 @@ private:
 #ifdef WITH_AUDIO_JACK
 	JackTransport m_jackTransport;
 #endif
-	std::vector<Device>      m_devices;
-	std::unique_ptr<RtAudio> m_rtAudio;
-	CallbackInfo             m_callbackInfo;
-	bool                     m_ready;
-	bool                     m_inputEnabled;
-	unsigned                 m_realBufferSize; // Real buffer size from the soundcard
-	int                      m_realSampleRate; // Sample rate might differ if JACK in use
-	int                      m_channelsOutCount;
-	int                      m_channelsInCount;
-	int                      m_api;
+	std::vector<Device>              m_devices;
+	std::unique_ptr<RtAudio>         m_rtAudio;
+	std::unique_ptr<NullAudioDevice> m_nullDevice;
+	CallbackInfo                     m_callbackInfo;
+	bool                             m_ready;
+	bool                             m_inputEnabled;
+	unsigned                         m_realBufferSize; // Real buffer size from the soundcard
+	int                              m_realSampleRate; // Sample rate might differ if JACK in use
+	int                              m_channelsOutCount;
+	int                              m_channelsInCount;
+	int                              m_api;
+
+	/* m_blockStart
+	When the last audio block started, in nanoseconds since the clock epoch. 
+	Written by the audio thread on each callback. */
+
+	std::atomic<Clock::rep> m_blockStart;
 };
 } // namespace giada::m
 
@@ -26,9 +26,14 @@
 
 #include "core/kernelMidi.h"
 #include "core/const.h"
+#include "core/kernelAudio.h"
 #include "utils/log.h"
+#include <algorithm>
 #include <cassert>
 #include <memory>
+#ifdef WITH_AUDIO_JACK
+#include <jack/midiport.h>
+#endif
 
 namespace giada::m
 {
@@ -37,15 +42,17 @@ namespace
 constexpr auto OUTPUT_NAME = "Giada MIDI output";
 constexpr auto INPUT_NAME  = "Giada MIDI input";
 
-/* -------------------------------------------------------------------------- */
+#ifdef WITH_AUDIO_JACK
+constexpr auto JACK_OUTPUT_NAME = "midi_out";
+constexpr auto JACK_INPUT_NAME  = "midi_in";
+#endif
 
-std::vector<unsigned char> split_(uint32_t iValue)
-{
-	return {
-	    static_cast<unsigned char>((iValue >> 24) & 0xFF),
-	    static_cast<unsigned char>((iValue >> 16) & 0xFF),
-	    static_cast<unsigned char>((iValue >> 8) & 0xFF)};
-}
+/* OUTPUT_IDLE_TIMEOUT
+Maximum time the output thread sleeps when nothing is pending. The thread is 
+woken up as soon as a new message is queued: this is just a fallback in case
+a wakeup gets lost (see KernelMidi::wakeOutput()). */
+
+constexpr auto OUTPUT_IDLE_TIMEOUT = std::chrono::milliseconds(100);
 
 /* -------------------------------------------------------------------------- */
 
@@ -59,57 +66,189 @@ uint32_t join_(int b1, int b2, int b3)
 /* -------------------------------------------------------------------------- */
 /* -------------------------------------------------------------------------- */
 
-KernelMidi::KernelMidi()
+KernelMidi::KernelMidi(const KernelAudio& k)
 : onMidiReceived(nullptr)
+, onMidiRealtime(nullptr)
+, m_kernelAudio(k)
+, m_outRunning(false)
+, m_outNotified(false)
+, m_droppedOutEvents(0)
+#ifdef WITH_AUDIO_JACK
+, m_jackIn(nullptr)
+, m_jackOut(nullptr)
+, m_jackEnabled(false)
+, m_jackDropped(0)
+#endif
+{
+#ifdef WITH_AUDIO_JACK
+	m_jackPending.reserve(G_MAX_MIDI_OUT_EVENTS);
+#endif
+}
+
+/* -------------------------------------------------------------------------- */
+
+KernelMidi::~KernelMidi()
 {
+	stopOutput();
 }
 
 /* -------------------------------------------------------------------------- */
 
 bool KernelMidi::openOutDevice(int api, int port)
 {
-	if (port == -1)
-		return false;
+	/* The slot is taken even if the device can't be opened: channels refer to
+	devices by index, which must not depend on what succeeded. */
 
-	u::log::print("[KM] Opening output device '%s', port=%d\n", OUTPUT_NAME, port);
+	std::unique_ptr<RtMidiOut> midiOut;
+	if (port != -1)
+	{
+		u::log::print("[KM] Opening output device '%s', port=%d\n", OUTPUT_NAME, port);
 
-	m_midiOut = makeDevice<RtMidiOut>(api, OUTPUT_NAME);
-	if (m_midiOut == nullptr)
-		return false;
+		midiOut = makeDevice<RtMidiOut>(api, OUTPUT_NAME);
+		if (midiOut != nullptr && !openPort(*midiOut, port))
+			midiOut = nullptr;
+	}
 
-	return openPort(*m_midiOut, port);
+	const bool opened = midiOut != nullptr;
+
+	std::lock_guard<std::mutex> lock(m_outMutex);
+	m_midiOuts.push_back(std::move(midiOut));
+	return opened;
 }
 
 /* -------------------------------------------------------------------------- */
 
 bool KernelMidi::openInDevice(int api, int port)
 {
-	if (port == -1)
-		return false;
+	/* Same as openOutDevice(): the slot is taken anyway. */
 
-	u::log::print("[KM] Opening input device '%s', port=%d\n", INPUT_NAME, port);
+	std::unique_ptr<RtMidiIn> midiIn;
+	if (port != -1)
+	{
+		u::log::print("[KM] Opening input device '%s', port=%d\n", INPUT_NAME, port);
 
-	m_midiIn = makeDevice<RtMidiIn>(api, INPUT_NAME);
-	if (m_midiIn == nullptr)
-		return false;
+		midiIn = makeDevice<RtMidiIn>(api, INPUT_NAME);
+		if (midiIn != nullptr && !openPort(*midiIn, port))
+			midiIn = nullptr;
+	}
+
+	InDevice& device = *m_midiIns.emplace_back(std::make_unique<InDevice>(
+	    InDevice{std::move(midiIn), this, static_cast<int>(m_midiIns.size())}));
 
-	if (!openPort(*m_midiIn, port))
+	if (device.rtMidi == nullptr)
 		return false;
 
-	m_midiIn->setCallback(&s_callback, this);
-	m_midiIn->ignoreTypes(true, false, true); // Ignore all system/time msgs, for now
+	device.rtMidi->setCallback(&s_callback, &device);
+	device.rtMidi->ignoreTypes(true, false, true); // Keep timing messages only: MIDI clock might be followed
 
 	return true;
 }
 
 /* -------------------------------------------------------------------------- */
 
+#ifdef WITH_AUDIO_JACK
+
+bool KernelMidi::openJackPorts(jack_client_t* client)
+{
+	assert(client != nullptr);
+
+	u::log::print("[KM] Registering JACK MIDI ports '%s' and '%s'\n", JACK_INPUT_NAME, JACK_OUTPUT_NAME);
+
+	m_jackIn  = jack_port_register(client, JACK_INPUT_NAME, JACK_DEFAULT_MIDI_TYPE, JackPortIsInput, 0);
+	m_jackOut = jack_port_register(client, JACK_OUTPUT_NAME, JACK_DEFAULT_MIDI_TYPE, JackPortIsOutput, 0);
+
+	if (m_jackIn == nullptr || m_jackOut == nullptr)
+	{
+		u::log::print("[KM] Unable to register JACK MIDI ports!\n");
+		return false;
+	}
+
+	m_jackEnabled.store(true);
+	return true;
+}
+
+/* -------------------------------------------------------------------------- */
+
+void KernelMidi::readJackPorts(Frame bufferSize)
+{
+	if (!m_jackEnabled.load())
+		return;
+
+	void*                buffer = jack_port_get_buffer(m_jackIn, bufferSize);
+	const jack_nframes_t count  = jack_midi_get_event_count(buffer);
+
+	/* Events came in during the previous cycle. Their offset is kept as is:
+	like RtMidi input, they are played in the next block at the same relative
+	position. Their arrival time is only needed to follow a MIDI clock. */
+
+	for (jack_nframes_t i = 0; i < count; i++)
+	{
+		jack_midi_event_t event;
+		if (jack_midi_event_get(&event, buffer, i) != 0 || event.size == 0 || event.size > 3)
+			continue; // SysEx not supported
+
+		uint32_t data = 0;
+		for (std::size_t j = 0; j < event.size; j++)
+			data |= static_cast<uint32_t>(event.buffer[j]) << (24 - j * 8);
+
+		const Frame offset = static_cast<Frame>(event.time);
+		m_jackInQueue.push({data, static_cast<int>(event.size), m_kernelAudio.getInputTime(offset), offset, 0});
+	}
+
+	if (count > 0)
+		wakeOutput();
+}
+
+/* -------------------------------------------------------------------------- */
+
+void KernelMidi::writeJackPorts(Frame bufferSize)
+{
+	if (!m_jackEnabled.load())
+		return;
+
+	void* buffer = jack_port_get_buffer(m_jackOut, bufferSize);
+	jack_midi_clear_buffer(buffer);
+
+	/* JACK wants events in frame order. Insertion keeps messages on the same 
+	frame in the order they were queued. Never grow m_jackPending past its 
+	reserved size, so that nothing is allocated here: whatever doesn't fit 
+	stays in the queue for the next cycle. */
+
+	const auto byOffset = [](const TimedMessage& a, const TimedMessage& b) { return a.offset < b.offset; };
+
+	TimedMessage m;
+	while (m_jackPending.size() < G_MAX_MIDI_OUT_EVENTS && m_jackOutQueue.pop(m))
+	{
+		m.offset = std::clamp(m.offset, 0, bufferSize - 1);
+		m_jackPending.insert(std::upper_bound(m_jackPending.begin(), m_jackPending.end(), m, byOffset), m);
+	}
+
+	for (const TimedMessage& pending : m_jackPending)
+	{
+		jack_midi_data_t* data = jack_midi_event_reserve(buffer, pending.offset, pending.size);
+		if (data == nullptr)
+		{
+			m_jackDropped.fetch_add(1);
+			continue;
+		}
+		for (int i = 0; i < pending.size; i++)
+			data[i] = static_cast<jack_midi_data_t>((pending.data >> (24 - i * 8)) & 0xFF);
+	}
+	m_jackPending.clear();
+}
+
+#endif
+
+/* -------------------------------------------------------------------------- */
+
 void KernelMidi::logPorts()
 {
-	if (m_midiOut != nullptr)
-		logPorts(*m_midiOut, OUTPUT_NAME);
-	if (m_midiIn != nullptr)
-		logPorts(*m_midiIn, INPUT_NAME);
+	/* All devices of a kind see the same system ports: ask the first one. */
+
+	if (RtMidiOut* out = getFirstOut(); out != nullptr)
+		logPorts(*out, OUTPUT_NAME);
+	if (RtMidiIn* in = getFirstIn(); in != nullptr)
+		logPorts(*in, INPUT_NAME);
 }
 
 /* -------------------------------------------------------------------------- */
@@ -126,65 +265,262 @@ bool KernelMidi::hasAPI(int API) const
 
 /* -------------------------------------------------------------------------- */
 
-std::string KernelMidi::getOutPortName(unsigned p) const { return getPortName(*m_midiOut, p); }
-std::string KernelMidi::getInPortName(unsigned p) const { return getPortName(*m_midiIn, p); }
+std::string KernelMidi::getOutPortName(unsigned p) const { return getFirstOut() != nullptr ? getPortName(*getFirstOut(), p) : ""; }
+std::string KernelMidi::getInPortName(unsigned p) const { return getFirstIn() != nullptr ? getPortName(*getFirstIn(), p) : ""; }
+
+/* -------------------------------------------------------------------------- */
+
+RtMidiOut* KernelMidi::getFirstOut() const
+{
+	for (const std::unique_ptr<RtMidiOut>& out : m_midiOuts)
+		if (out != nullptr)
+			return out.get();
+	return nullptr;
+}
+
+RtMidiIn* KernelMidi::getFirstIn() const
+{
+	for (const std::unique_ptr<InDevice>& in : m_midiIns)
+		if (in->rtMidi != nullptr)
+			return in->rtMidi.get();
+	return nullptr;
+}
 
 /* -------------------------------------------------------------------------- */
 
 void KernelMidi::send(uint32_t data)
 {
-	if (m_midiOut == nullptr)
+#ifdef WITH_AUDIO_JACK
+	if (usingJackPorts())
+	{
+		m_jackOutQueue.push({data, 3, {}, 0});
+		return;
+	}
+#endif
+	m_outQueue.push({data, 3, Clock::now()});
+	wakeOutput();
+}
+
+/* -------------------------------------------------------------------------- */
+
+void KernelMidi::send(int b1, int b2, int b3)
+{
+	const int      size = b2 == -1 ? 1 : b3 == -1 ? 2 : 3;
+	const uint32_t data = join_(b1, size > 1 ? b2 : 0, size > 2 ? b3 : 0);
+#ifdef WITH_AUDIO_JACK
+	if (usingJackPorts())
+	{
+		m_jackOutQueue.push({data, size, {}, 0});
 		return;
+	}
+#endif
+	m_outQueue.push({data, size, Clock::now()});
+	wakeOutput();
+}
 
-	std::vector<unsigned char> msg = split_(data);
+/* -------------------------------------------------------------------------- */
 
-	m_midiOut->sendMessage(&msg);
-	u::log::print("[KM::send] send msg=0x%X (%X %X %X)\n", data, msg[0], msg[1], msg[2]);
+bool KernelMidi::schedule(uint32_t data, int size, Frame offset, int device)
+{
+	assert(size >= 1 && size <= 3);
+#ifdef WITH_AUDIO_JACK
+	if (usingJackPorts())
+		return m_jackOutQueue.push({data, size, {}, offset}); // Single JACK port
+#endif
+	const bool pushed = m_outQueue.push({data, size, m_kernelAudio.getFrameTime(offset), 0, device});
+	wakeOutput();
+	return pushed;
 }
 
 /* -------------------------------------------------------------------------- */
 
-void KernelMidi::send(int b1, int b2, int b3)
+void KernelMidi::startOutput()
 {
-	if (m_midiOut == nullptr)
+	if (m_outRunning.load())
 		return;
+	m_outRunning.store(true);
+	m_outThread = std::thread([this]() { outputLoop(); });
+}
+
+/* -------------------------------------------------------------------------- */
+
+uint32_t KernelMidi::getDroppedOutEvents() const
+{
+#ifdef WITH_AUDIO_JACK
+	return m_outQueue.getDropped() + m_jackOutQueue.getDropped() + m_jackDropped.load();
+#else
+	return m_outQueue.getDropped();
+#endif
+}
 
-	std::vector<unsigned char> msg(1, b1);
+uint32_t KernelMidi::getOutQueueHighWater() const
+{
+#ifdef WITH_AUDIO_JACK
+	return std::max(m_outQueue.getHighWater(), m_jackOutQueue.getHighWater());
+#else
+	return m_outQueue.getHighWater();
+#endif
+}
 
-	if (b2 != -1)
-		msg.push_back(b2);
-	if (b3 != -1)
-		msg.push_back(b3);
+/* -------------------------------------------------------------------------- */
 
-	m_midiOut->sendMessage(&msg);
-	u::log::print("[KM::send] send msg=(%X %X %X)\n", b1, b2, b3);
+bool KernelMidi::usingJackPorts() const
+{
+#ifdef WITH_AUDIO_JACK
+	return m_jackEnabled.load();
+#else
+	return false;
+#endif
 }
 
 /* -------------------------------------------------------------------------- */
 
-unsigned KernelMidi::countOutPorts() const { return m_midiOut != nullptr ? m_midiOut->getPortCount() : 0; }
-unsigned KernelMidi::countInPorts() const { return m_midiIn != nullptr ? m_midiIn->getPortCount() : 0; }
+void KernelMidi::stopOutput()
+{
+	if (!m_outRunning.load())
+		return;
+	m_outRunning.store(false);
+	wakeOutput();
+	m_outThread.join();
+}
+
+/* -------------------------------------------------------------------------- */
+
+unsigned KernelMidi::countOutPorts() const { return getFirstOut() != nullptr ? getFirstOut()->getPortCount() : 0; }
+unsigned KernelMidi::countInPorts() const { return getFirstIn() != nullptr ? getFirstIn()->getPortCount() : 0; }
 
 /* -------------------------------------------------------------------------- */
 
 void KernelMidi::s_callback(double /*t*/, std::vector<unsigned char>* msg, void* data)
 {
-	static_cast<KernelMidi*>(data)->callback(msg);
+	/* RtMidi's timestamp is the delta time from the previous message, which 
+	can't be related to the audio clock. Take the arrival time instead: the 
+	callback is invoked as soon as the message is read from the device. */
+
+	const InDevice* device = static_cast<InDevice*>(data);
+	device->kernelMidi->callback(msg, Clock::now(), device->index);
+}
+
+/* -------------------------------------------------------------------------- */
+
+void KernelMidi::callback(std::vector<unsigned char>* msg, Clock::time_point t, int device)
+{
+	uint32_t data = 0;
+	for (std::size_t i = 0; i < msg->size() && i < 3; i++)
+		data |= static_cast<uint32_t>(msg->at(i)) << (24 - i * 8);
+
+	receive(data, static_cast<int>(msg->size()), t, m_kernelAudio.getFrameOffset(t), device);
 }
 
 /* -------------------------------------------------------------------------- */
 
-void KernelMidi::callback(std::vector<unsigned char>* msg)
+void KernelMidi::receive(uint32_t data, int size, Clock::time_point t, Frame offset, int device)
 {
 	assert(onMidiReceived != nullptr);
+	assert(onMidiRealtime != nullptr);
 
-	if (msg->size() < 3)
+	const int status = (data >> 24) & 0xFF;
+
+	if (size == 1 && status >= MIDI_CLOCK)
+	{
+		onMidiRealtime(status, t, device);
+		return;
+	}
+
+	if (size < 3)
 	{
-		G_DEBUG("Received unknown MIDI signal - bytes=" << msg->size());
+		G_DEBUG("Received unknown MIDI signal - bytes=" << size);
 		return;
 	}
 
-	onMidiReceived(join_(msg->at(0), msg->at(1), msg->at(2)));
+	onMidiReceived(data, offset, device);
+}
+
+/* -------------------------------------------------------------------------- */
+
+void KernelMidi::outputLoop()
+{
+	/* Messages come in time order from the audio thread, but keep 'pending' 
+	sorted anyway: nothing prevents two producers from interleaving. */
+
+	std::vector<TimedMessage>  pending;
+	std::vector<unsigned char> msg;
+	pending.reserve(G_MAX_MIDI_OUT_EVENTS);
+	msg.reserve(3);
+
+	const auto byTime = [](const TimedMessage& a, const TimedMessage& b) { return a.time < b.time; };
+
+	while (m_outRunning.load())
+	{
+		TimedMessage m;
+#ifdef WITH_AUDIO_JACK
+		while (m_jackInQueue.pop(m))
+			receive(m.data, m.size, m.time, m.offset, m.device);
+#endif
+		while (m_outQueue.pop(m))
+			pending.insert(std::upper_bound(pending.begin(), pending.end(), m, byTime), m);
+
+		const Clock::time_point now = Clock::now();
+
+		auto due = pending.begin();
+		for (; due != pending.end() && due->time <= now; ++due)
+		{
+			msg.clear();
+			for (int i = 0; i < due->size; i++)
+				msg.push_back(static_cast<unsigned char>((due->data >> (24 - i * 8)) & 0xFF));
+
+			/* Devices are looked up by index on each message: no copies of the
+			message, just one more send per target device. */
+
+			std::lock_guard<std::mutex> lock(m_outMutex);
+			for (std::size_t i = 0; i < m_midiOuts.size(); i++)
+				if (m_midiOuts[i] != nullptr && (due->device == -1 || due->device == static_cast<int>(i)))
+					m_midiOuts[i]->sendMessage(&msg);
+		}
+		pending.erase(pending.begin(), due);
+
+		logDroppedOutEvents();
+
+		/* Sleep until the next message is due, or until a new one comes in. 
+		With nothing pending there's no deadline: just wait for a wakeup. */
+
+		std::unique_lock lock(m_outWaitMutex);
+
+		const auto notified = [this]() { return m_outNotified.load() || !m_outRunning.load(); };
+		if (pending.empty())
+			m_outCond.wait_for(lock, OUTPUT_IDLE_TIMEOUT, notified);
+		else
+			m_outCond.wait_until(lock, pending.front().time, notified);
+		m_outNotified.store(false);
+	}
+}
+
+/* -------------------------------------------------------------------------- */
+
+void KernelMidi::wakeOutput()
+{
+	m_outNotified.store(true);
+
+	/* Same as Worker::notify(): never blocks, so it's safe to call from the 
+	audio thread. Going through the mutex orders the wakeup with the predicate
+	check of the output thread. */
+
+	if (m_outWaitMutex.try_lock())
+		m_outWaitMutex.unlock();
+	m_outCond.notify_one();
+}
+
+/* -------------------------------------------------------------------------- */
+
+void KernelMidi::logDroppedOutEvents()
+{
+	const uint32_t dropped = m_outQueue.getDropped();
+	if (dropped == m_droppedOutEvents)
+		return;
+
+	u::log::print("[KM] Output queue full, %u message(s) dropped! High-water mark: %u/%zu\n",
+	    dropped - m_droppedOutEvents, m_outQueue.getHighWater(), OutQueue::getCapacity());
+	m_droppedOutEvents = dropped;
 }
 
 /* -------------------------------------------------------------------------- */
@@ -27,19 +27,35 @@
 #ifndef G_KERNELMIDI_H
 #define G_KERNELMIDI_H
 
+#include "core/const.h"
+#include "core/mpscQueue.h"
+#include "core/types.h"
 #include "midiMapper.h"
 #include <RtMidi.h>
+#ifdef WITH_AUDIO_JACK
+#include <jack/jack.h>
+#endif
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
 #include <cstdint>
 #include <functional>
 #include <memory>
+#include <mutex>
 #include <string>
+#include <thread>
+#include <vector>
 
 namespace giada::m
 {
+class KernelAudio;
 class KernelMidi final
 {
 public:
-	KernelMidi();
+	using Clock = std::chrono::steady_clock;
+
+	KernelMidi(const KernelAudio&);
+	~KernelMidi();
 
 	static void logCompiledAPIs();
 
@@ -55,26 +71,124 @@ public:
 	bool hasAPI(int API) const;
 
 	/* send
-    Sends a MIDI message 's' as uint32_t or as separate bytes. */
+    Sends a MIDI message 's' as uint32_t or as separate bytes to all output 
+	devices, as soon as possible. Lock-free: the message is queued for the 
+	output thread, so it's safe to call from any thread, the audio one 
+	included. */
 
 	void send(uint32_t s);
 	void send(int b1, int b2 = -1, int b3 = -1);
 
+	/* schedule
+	Queues a MIDI message made of the first 'size' bytes of 's', to be sent 
+	when frame 'offset' of the current audio block reaches the output. 
+	'device' is the index of the output device, or -1 for all of them. 
+	Lock-free: meant to be called by the audio thread. Returns false if the 
+	queue is full. */
+
+	bool schedule(uint32_t s, int size, Frame offset, int device = -1);
+
+	/* getDroppedOutEvents, getOutQueueHighWater
+	Messages lost because the output queue was full, and the maximum number of
+	messages ever waiting in it. */
+
+	uint32_t getDroppedOutEvents() const;
+	uint32_t getOutQueueHighWater() const;
+
+	/* startOutput, stopOutput
+	Starts and stops the thread that sends scheduled messages. */
+
+	void startOutput();
+	void stopOutput();
+
 	/* setApi
     Sets the Api in use for both in & out messages. */
 
 	void setApi(int api);
 
+	/* openOutDevice, openInDevice
+	Open a new device on the system port 'port'. Can be called more than once:
+	devices are indexed in calling order, starting from 0. Each call takes an 
+	index even if it fails (or 'port' is -1), so that the index of a device 
+	only depends on its place in the configuration. */
+
 	bool openOutDevice(int api, int port);
 	bool openInDevice(int api, int port);
 
+#ifdef WITH_AUDIO_JACK
+
+	/* openJackPorts
+	Registers a MIDI input and output port on the JACK client used for audio,
+	as an alternative to the RtMidi devices. Outgoing messages are then written
+	in the JACK process callback, at their exact frame offset. Incoming ones 
+	are read there, with the offset they came in at, but are delivered by the
+	output thread: the callbacks they trigger are not realtime-safe. */
+
+	bool openJackPorts(jack_client_t*);
+
+	/* readJackPorts, writeJackPorts
+	Collect the incoming messages and write the outgoing ones for the current
+	JACK cycle. Must be called by the audio thread, the former at the 
+	beginning of the audio callback, the latter at the end. Do nothing if JACK 
+	ports are not in use. */
+
+	void readJackPorts(Frame bufferSize);
+	void writeJackPorts(Frame bufferSize);
+#endif
+
 	void logPorts();
 
-	std::function<void(uint32_t)> onMidiReceived;
+	/* onMidiReceived
+	Callback fired when a MIDI message comes in, along with the frame of the 
+	audio block it belongs to and the index of the input device it comes 
+	from. */
+
+	std::function<void(uint32_t, Frame, int)> onMidiReceived;
+
+	/* onMidiRealtime
+	Callback fired when a single-byte real-time message (clock, start, 
+	continue, stop) comes in, along with the time it was received and the 
+	index of the input device it comes from. */
+
+	std::function<void(int, Clock::time_point, int)> onMidiRealtime;
 
 private:
+	struct TimedMessage
+	{
+		uint32_t          data   = 0;
+		int               size   = 0;
+		Clock::time_point time   = {};
+		Frame             offset = 0;  // Frame in the audio block, JACK ports only
+		int               device = -1; // Device index, -1 = all (output only)
+	};
+
+	/* InDevice
+	An input device, along with its index: RtMidi callbacks get a pointer to 
+	it, so that messages can be tagged with their source. 'rtMidi' is null if
+	the device couldn't be opened. */
+
+	struct InDevice
+	{
+		std::unique_ptr<RtMidiIn> rtMidi;
+		KernelMidi*               kernelMidi;
+		int                       index;
+	};
+
+	using OutQueue = MpscQueue<TimedMessage, G_MAX_MIDI_OUT_EVENTS>;
+
 	static void s_callback(double, std::vector<unsigned char>*, void*);
-	void        callback(std::vector<unsigned char>*);
+	void        callback(std::vector<unsigned char>*, Clock::time_point, int device);
+
+	/* receive
+	Forwards an incoming message to the onMidiRealtime or onMidiReceived 
+	callbacks. */
+
+	void receive(uint32_t data, int size, Clock::time_point t, Frame offset, int device);
+
+	/* usingJackPorts
+	True if openJackPorts() has succeeded: MIDI goes through JACK then. */
+
+	bool usingJackPorts() const;
 
 	template <typename Device>
 	std::unique_ptr<Device> makeDevice(int api, std::string name) const;
@@ -84,8 +198,97 @@ private:
 
 	bool openPort(RtMidi&, int port);
 
-	std::unique_ptr<RtMidiOut> m_midiOut;
-	std::unique_ptr<RtMidiIn>  m_midiIn;
+	/* getFirstOut, getFirstIn
+	Return the first open device, used to list the system ports, or nullptr. */
+
+	RtMidiOut* getFirstOut() const;
+	RtMidiIn*  getFirstIn() const;
+
+	/* outputLoop
+	Body of the output thread: collects scheduled messages and sends each one
+	when its time comes. With JACK ports it delivers the incoming messages
+	instead, as soon as the audio thread has read them. */
+
+	void outputLoop();
+
+	/* wakeOutput
+	Wakes up the output thread, so that it picks up new messages. Never 
+	blocks: safe to call from any thread. */
+
+	void wakeOutput();
+
+	/* logDroppedOutEvents
+	Prints a warning if new messages have been dropped since the last call. 
+	Called by the output thread. */
+
+	void logDroppedOutEvents();
+
+	const KernelAudio& m_kernelAudio;
+
+	/* m_midiOuts, m_midiIns
+	Devices, by index (i.e. configuration slot). Null if the device couldn't
+	be opened. Input devices are heap-allocated, so that the pointer given to
+	RtMidi stays valid. */
+
+	std::vector<std::unique_ptr<RtMidiOut>> m_midiOuts;
+	std::vector<std::unique_ptr<InDevice>>  m_midiIns;
+
+	/* m_outMutex
+	Protects m_midiOuts from being changed while the output thread is sending.
+	Never taken by the audio thread. */
+
+	std::mutex m_outMutex;
+
+	/* m_outQueue
+	Outgoing messages, waiting to be picked up by the output thread. Filled by
+	any thread: the audio one, channels rendered in parallel by the RenderPool, 
+	the UI. */
+
+	OutQueue          m_outQueue;
+	std::thread       m_outThread;
+	std::atomic<bool> m_outRunning;
+
+	/* m_outWaitMutex, m_outCond, m_outNotified
+	Let the output thread sleep until a message is due or a new one is queued,
+	see wakeOutput(). */
+
+	std::mutex              m_outWaitMutex;
+	std::condition_variable m_outCond;
+	std::atomic<bool>       m_outNotified;
+
+	/* m_droppedOutEvents
+	Dropped messages already reported by logDroppedOutEvents(). Owned by the
+	output thread. */
+
+	uint32_t m_droppedOutEvents;
+
+#ifdef WITH_AUDIO_JACK
+
+	/* m_jackIn, m_jackOut
+	JACK MIDI ports, valid when m_jackEnabled is true. */
+
+	jack_port_t*      m_jackIn;
+	jack_port_t*      m_jackOut;
+	std::atomic<bool> m_jackEnabled;
+
+	/* m_jackInQueue, m_jackOutQueue
+	Messages read from the JACK input port, waiting to be delivered by the
+	output thread; messages waiting for the next JACK cycle to be written. */
+
+	OutQueue m_jackInQueue;
+	OutQueue m_jackOutQueue;
+
+	/* m_jackPending
+	Outgoing messages of the current cycle sorted by frame. Preallocated, 
+	owned by the audio thread. */
+
+	std::vector<TimedMessage> m_jackPending;
+
+	/* m_jackDropped
+	Messages that didn't fit in the JACK output buffer. */
+
+	std::atomic<uint32_t> m_jackDropped;
+#endif
 };
 } // namespace giada::m
 
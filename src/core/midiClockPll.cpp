@@ -0,0 +1,175 @@
+/* -----------------------------------------------------------------------------
+ *
+ * Giada - Your Hardcore Loopmachine
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2022 Giovanni A. Zuliani | Monocasual Laboratories
+ *
+ * This file is part of Giada - Your Hardcore Loopmachine.
+ *
+ * Giada - Your Hardcore Loopmachine is free software: you can
+ * redistribute it and/or modify it under the terms of the GNU General
+ * Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * Giada - Your Hardcore Loopmachine is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Giada - Your Hardcore Loopmachine. If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------- */
+
+#include "core/midiClockPll.h"
+#include "core/const.h"
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+
+namespace giada::m
+{
+namespace
+{
+constexpr int    TICKS_PER_BEAT = 24;
+constexpr int    LOCK_TICKS     = TICKS_PER_BEAT; // One beat
+constexpr double PI             = 3.14159265358979323846;
+
+/* PHASE_GAIN, MAX_CORRECTION
+Tuning for MidiClockFollower. The phase error, in beats, is turned into a 
+tempo correction meant to absorb it within the next beat. The correction is
+capped, so that a large error doesn't make the tempo jump around. */
+
+constexpr double PHASE_GAIN     = 0.5;
+constexpr double MAX_CORRECTION = 0.05;
+} // namespace
+
+/* -------------------------------------------------------------------------- */
+
+MidiClockPll::MidiClockPll()
+{
+	reset();
+}
+
+/* -------------------------------------------------------------------------- */
+
+void MidiClockPll::reset()
+{
+	m_count     = -1;
+	m_time      = 0.0;
+	m_next      = 0.0;
+	m_period    = 0.0;
+	m_lastInput = 0.0;
+}
+
+/* -------------------------------------------------------------------------- */
+
+void MidiClockPll::tick(double t, double bandwidth)
+{
+	assert(bandwidth > 0.0);
+
+	const int64_t count = m_count++;
+	const double  prev  = m_lastInput;
+	m_lastInput         = t;
+
+	/* First tick: no period yet. Second tick: the first measured interval is
+	the initial guess. */
+
+	if (count < 0)
+	{
+		m_time = t;
+		return;
+	}
+	if (count == 0)
+	{
+		m_period = t - m_time;
+		m_time   = t;
+		m_next   = t + m_period;
+		return;
+	}
+
+	const double error = t - m_next;
+
+	/* An error larger than a period means a dropout or a sudden jump in 
+	tempo: filtering makes no sense, start over from the last interval. */
+
+	if (std::abs(error) > m_period)
+	{
+		m_period = t - prev;
+		m_time   = t;
+		m_next   = t + m_period;
+		return;
+	}
+
+	/* Loop coefficients for a critically damped loop, see F. Adriaensen, 
+	"Using a DLL to filter time" (2005). */
+
+	const double omega = 2.0 * PI * bandwidth * m_period;
+	const double b     = std::sqrt(2.0) * omega;
+	const double c     = omega * omega;
+
+	m_time = m_next;
+	m_next += b * error + m_period;
+	m_period += c * error;
+}
+
+/* -------------------------------------------------------------------------- */
+
+bool    MidiClockPll::isLocked() const { return m_count + 1 >= LOCK_TICKS && m_period > 0.0; }
+int64_t MidiClockPll::getCount() const { return m_count; }
+double  MidiClockPll::getTime() const { return m_time; }
+double  MidiClockPll::getPeriod() const { return m_period; }
+
+/* -------------------------------------------------------------------------- */
+
+float MidiClockPll::getBpm() const
+{
+	return m_period > 0.0 ? static_cast<float>(60.0 / (m_period * TICKS_PER_BEAT)) : 0.0f;
+}
+
+/* -------------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------- */
+
+MidiClockFollower::MidiClockFollower()
+{
+	reset();
+}
+
+/* -------------------------------------------------------------------------- */
+
+void MidiClockFollower::reset()
+{
+	m_beats          = 0.0;
+	m_nextCorrection = 0.0;
+}
+
+/* -------------------------------------------------------------------------- */
+
+float MidiClockFollower::advance(Frame frames, Frame framesInBeat, double now, const std::optional<Master>& master)
+{
+	assert(framesInBeat > 0);
+
+	const double beats = m_beats;
+	m_beats += frames / static_cast<double>(framesInBeat);
+
+	if (beats < m_nextCorrection || !master || master->period <= 0.0 || master->count < 0)
+		return 0.0f;
+	m_nextCorrection = beats + 1.0;
+
+	/* Where the master is when this block reaches the output, vs where the 
+	sequencer is. A positive error means the sequencer is late. */
+
+	const double masterBeats = (master->count + (now - master->time) / master->period) / TICKS_PER_BEAT;
+	const double correction  = std::clamp((masterBeats - beats) * PHASE_GAIN, -MAX_CORRECTION, MAX_CORRECTION);
+
+	return std::clamp(static_cast<float>(60.0 / (master->period * TICKS_PER_BEAT) * (1.0 + correction)), G_MIN_BPM, G_MAX_BPM);
+}
+
+/* -------------------------------------------------------------------------- */
+
+double MidiClockFollower::getBeats() const { return m_beats; }
+} // namespace giada::m
@@ -0,0 +1,137 @@
+/* -----------------------------------------------------------------------------
+ *
+ * Giada - Your Hardcore Loopmachine
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2022 Giovanni A. Zuliani | Monocasual Laboratories
+ *
+ * This file is part of Giada - Your Hardcore Loopmachine.
+ *
+ * Giada - Your Hardcore Loopmachine is free software: you can
+ * redistribute it and/or modify it under the terms of the GNU General
+ * Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * Giada - Your Hardcore Loopmachine is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Giada - Your Hardcore Loopmachine. If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------- */
+
+#ifndef G_MIDI_CLOCK_PLL_H
+#define G_MIDI_CLOCK_PLL_H
+
+#include "core/types.h"
+#include <cstdint>
+#include <optional>
+
+namespace giada::m
+{
+/* MidiClockPll
+Follows an incoming MIDI clock (24 ticks per beat) with a second order 
+delay-locked loop: arrival times are noisy, the loop filters them into a 
+smooth period (i.e. tempo) and a smooth time for each tick (i.e. phase). The
+bandwidth, in Hz, trades jitter rejection for tracking speed: lower values 
+give a steadier tempo but follow tempo changes more slowly. Times are in 
+seconds, on any monotonic clock. */
+
+class MidiClockPll
+{
+public:
+	MidiClockPll();
+
+	/* reset
+	Forgets everything: the next tick is tick 0. */
+
+	void reset();
+
+	/* tick
+	Feeds the arrival time 't' of a new clock tick. */
+
+	void tick(double t, double bandwidth);
+
+	/* isLocked
+	True when enough ticks have been received for the estimate to be usable. */
+
+	bool isLocked() const;
+
+	/* getCount
+	Returns the index of the last tick received since reset, or -1. */
+
+	int64_t getCount() const;
+
+	/* getTime
+	Returns the filtered time of the last tick received. */
+
+	double getTime() const;
+
+	/* getPeriod
+	Returns the filtered time between two ticks. */
+
+	double getPeriod() const;
+
+	float getBpm() const;
+
+private:
+	int64_t m_count;
+	double  m_time;      // Filtered time of the last tick
+	double  m_next;      // Predicted time of the next tick
+	double  m_period;    // Filtered period
+	double  m_lastInput; // Unfiltered time of the last tick
+};
+
+/* -------------------------------------------------------------------------- */
+
+/* MidiClockFollower
+Drives the tempo of the sequencer so that it follows an external MIDI clock.
+Beats played are accumulated block by block, at the tempo each block was 
+played at: a tempo change only affects the beats that come after it. */
+
+class MidiClockFollower
+{
+public:
+	/* Master
+	Position of the external clock: index of the last tick since the song 
+	started, its time and the time between two ticks. */
+
+	struct Master
+	{
+		int64_t count;
+		double  time;
+		double  period;
+	};
+
+	MidiClockFollower();
+
+	/* reset
+	Starts over from beat 0. */
+
+	void reset();
+
+	/* advance
+	Accounts for a block of 'frames' frames, played with 'framesInBeat' frames 
+	per beat, that reaches the output at time 'now'. Returns the tempo that 
+	brings the sequencer on the master by the next beat, or 0 if no correction 
+	is due: corrections happen once per beat at most. Without a 'master' (e.g.
+	not locked yet) the correction is tried again on the next block. */
+
+	float advance(Frame frames, Frame framesInBeat, double now, const std::optional<Master>&);
+
+	/* getBeats
+	Returns the beats played since the last reset. */
+
+	double getBeats() const;
+
+private:
+	double m_beats;
+	double m_nextCorrection; // In beats
+};
+} // namespace giada::m
+
+#endif
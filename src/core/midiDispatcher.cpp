@@ -36,8 +36,11 @@
 #include "glue/plugin.h"
 #include "utils/log.h"
 #include "utils/math.h"
+#include <algorithm>
 #include <cassert>
 #include <cstddef>
+#include <iterator>
+#include <utility>
 #include <vector>
 
 namespace giada::m
@@ -46,11 +49,22 @@ MidiDispatcher::MidiDispatcher(model::Model& m)
 : onDispatch(nullptr)
 , m_learnCb(nullptr)
 , m_model(m)
+, m_directRoutes(nullptr)
+, m_directEnabled(false)
+, m_bindings(nullptr)
 {
 }
 
 /* -------------------------------------------------------------------------- */
 
+MidiDispatcher::~MidiDispatcher()
+{
+	delete m_directRoutes.load();
+	delete m_bindings.load();
+}
+
+/* -------------------------------------------------------------------------- */
+
 void MidiDispatcher::startChannelLearn(int param, ID channelId, std::function<void()> f)
 {
 	m_learnCb = [=](m::MidiEvent e) { learnChannel(e, param, channelId, f); };
@@ -90,7 +104,7 @@ void MidiDispatcher::clearPluginLearn(std::size_t paramIndex, ID pluginId, std::
 
 /* -------------------------------------------------------------------------- */
 
-void MidiDispatcher::dispatch(uint32_t msg)
+void MidiDispatcher::dispatch(uint32_t msg, Frame delta, int device)
 {
 	assert(onDispatch != nullptr);
 
@@ -99,9 +113,17 @@ void MidiDispatcher::dispatch(uint32_t msg)
 	We must also fix the velocity zero issue for those devices that sends NOTE
 	OFF events as NOTE ON + velocity zero. Let's make it a real NOTE OFF event. */
 
-	MidiEvent midiEvent(msg);
+	MidiEvent midiEvent(msg, delta);
+	midiEvent.setDevice(device);
 	midiEvent.fixVelocityZero();
 
+	/* Notes for armed MIDI channels take the direct path first, so that they 
+	reach the plug-ins in the next block. They still go through the Event 
+	Dispatcher below, for action recording. */
+
+	if (m_learnCb == nullptr && midiEvent.isNoteOnOff())
+		routeDirectly(midiEvent);
+
 	u::log::print("[midiDispatcher] MIDI received - 0x%X (chan %d)\n", midiEvent.getRaw(),
 	    midiEvent.getChannel());
 
@@ -117,6 +139,175 @@ void MidiDispatcher::dispatch(uint32_t msg)
 
 /* -------------------------------------------------------------------------- */
 
+void MidiDispatcher::rebuildDirectRoutes(bool enabled)
+{
+	m_directEnabled.store(enabled);
+
+	auto routes = std::make_unique<DirectRoutes>();
+	if (enabled)
+		for (const Channel& c : m_model.get().channels)
+			if (c.midiReceiver && c.armed)
+				routes->push_back({c.midiLearner, c.shared});
+
+	/* Publish the new table, then retire the old one: the MIDI thread might
+	still be reading it. */
+
+	std::unique_ptr<DirectRoutes> old(m_directRoutes.exchange(routes.release()));
+	m_model.retire(std::move(old));
+}
+
+/* -------------------------------------------------------------------------- */
+
+void MidiDispatcher::rebuildBindings()
+{
+	const model::Layout& layout   = m_model.get();
+	auto                 bindings = std::make_unique<Bindings>();
+
+	bindings->addMaster(layout.midiIn);
+	for (const Channel& c : layout.channels)
+		bindings->addChannel(c.id, c.midiLearner, c.plugins, c.armed, c.midiReceiver.has_value());
+
+	std::unique_ptr<Bindings> old(m_bindings.exchange(bindings.release()));
+	m_model.retire(std::move(old));
+}
+
+/* -------------------------------------------------------------------------- */
+
+std::vector<MidiDispatcher::Binding> MidiDispatcher::findBindings(const MidiEvent& e) const
+{
+	const model::Reclaimer::ReadScope scope    = m_model.read();
+	const Bindings*                   bindings = m_bindings.load();
+
+	if (bindings == nullptr)
+		return {};
+	return bindings->find(e.getRawNoVelocity());
+}
+
+/* -------------------------------------------------------------------------- */
+
+void MidiDispatcher::Bindings::bind(std::vector<uint32_t>& seen, uint32_t value, Binding b)
+{
+	if (value == 0x0 || std::find(seen.begin(), seen.end(), value) != seen.end())
+		return;
+	seen.push_back(value);
+	m_learnt[value].push_back(b);
+}
+
+/* -------------------------------------------------------------------------- */
+
+void MidiDispatcher::Bindings::addMaster(const model::MidiIn& midiIn)
+{
+	using Target = Binding::Target;
+
+	const std::size_t     rank = m_rank++;
+	std::vector<uint32_t> seen;
+
+	const auto masterBinding = [rank](int param) {
+		return Binding{Target::MASTER, param, 0, 0, 0, -1, -1, false, rank};
+	};
+
+	bind(seen, midiIn.rewind, masterBinding(G_MIDI_IN_REWIND));
+	bind(seen, midiIn.startStop, masterBinding(G_MIDI_IN_START_STOP));
+	bind(seen, midiIn.actionRec, masterBinding(G_MIDI_IN_ACTION_REC));
+	bind(seen, midiIn.inputRec, masterBinding(G_MIDI_IN_INPUT_REC));
+	bind(seen, midiIn.metronome, masterBinding(G_MIDI_IN_METRONOME));
+	bind(seen, midiIn.volumeIn, masterBinding(G_MIDI_IN_VOLUME_IN));
+	bind(seen, midiIn.volumeOut, masterBinding(G_MIDI_IN_VOLUME_OUT));
+	bind(seen, midiIn.beatDouble, masterBinding(G_MIDI_IN_BEAT_DOUBLE));
+	bind(seen, midiIn.beatHalf, masterBinding(G_MIDI_IN_BEAT_HALF));
+}
+
+/* -------------------------------------------------------------------------- */
+
+void MidiDispatcher::Bindings::addChannel(ID channelId, const MidiLearner& l,
+    const std::vector<Plugin*>& plugins, bool armed, bool direct)
+{
+	using Target = Binding::Target;
+
+	/* Channels with MIDI input disabled don't react to anything. */
+
+	if (!l.enabled)
+		return;
+
+	const std::size_t     rank = m_rank++;
+	std::vector<uint32_t> seen;
+
+	const auto channelBinding = [channelId, &l, rank](int param) {
+		return Binding{Target::CHANNEL, param, channelId, 0, 0, l.filter, l.device, false, rank};
+	};
+
+	bind(seen, l.keyPress.getValue(), channelBinding(G_MIDI_IN_KEYPRESS));
+	bind(seen, l.keyRelease.getValue(), channelBinding(G_MIDI_IN_KEYREL));
+	bind(seen, l.mute.getValue(), channelBinding(G_MIDI_IN_MUTE));
+	bind(seen, l.kill.getValue(), channelBinding(G_MIDI_IN_KILL));
+	bind(seen, l.arm.getValue(), channelBinding(G_MIDI_IN_ARM));
+	bind(seen, l.solo.getValue(), channelBinding(G_MIDI_IN_SOLO));
+	bind(seen, l.volume.getValue(), channelBinding(G_MIDI_IN_VOLUME));
+	bind(seen, l.pitch.getValue(), channelBinding(G_MIDI_IN_PITCH));
+	bind(seen, l.readActions.getValue(), channelBinding(G_MIDI_IN_READ_ACTIONS));
+
+	/* Plug-in parameters don't take priorities: all matching ones react. */
+
+	for (const Plugin* p : plugins)
+		for (const MidiLearnParam& param : p->midiInParams)
+			if (param.getValue() != 0x0)
+				m_learnt[param.getValue()].push_back(
+				    {Target::PLUGIN, 0, channelId, p->id, param.getIndex(), l.filter, l.device, false, rank});
+
+	if (armed)
+		m_armed.push_back({Target::ARMED_CHANNEL, 0, channelId, 0, 0, l.filter, l.device, direct, rank});
+}
+
+/* -------------------------------------------------------------------------- */
+
+std::vector<MidiDispatcher::Binding> MidiDispatcher::Bindings::find(uint32_t pure) const
+{
+	const auto it = m_learnt.find(pure);
+	if (it == m_learnt.end())
+		return m_armed;
+
+	/* Both lists are sorted by owner. Merging them puts each armed channel 
+	right after its own learnt bindings, as std::merge takes elements from the
+	first range first when ranks are equal. */
+
+	const std::vector<Binding>& learnt = it->second;
+	std::vector<Binding>        out;
+
+	out.reserve(learnt.size() + m_armed.size());
+	std::merge(learnt.begin(), learnt.end(), m_armed.begin(), m_armed.end(), std::back_inserter(out),
+	    [](const Binding& a, const Binding& b) { return a.rank < b.rank; });
+	return out;
+}
+
+/* -------------------------------------------------------------------------- */
+
+bool MidiDispatcher::Binding::isAllowed(int c, int d) const
+{
+	return (filter == -1 || filter == c) && (device == -1 || device == d);
+}
+
+/* -------------------------------------------------------------------------- */
+
+void MidiDispatcher::routeDirectly(const MidiEvent& e)
+{
+	const model::Reclaimer::ReadScope scope  = m_model.read();
+	const DirectRoutes*               routes = m_directRoutes.load();
+
+	if (routes == nullptr)
+		return;
+
+	/* Same as MidiReceiver::parseMidi(): plug-ins get everything on channel 0. */
+
+	MidiEvent flat(e);
+	flat.setChannel(0);
+
+	for (const DirectRoute& route : *routes)
+		if (route.midiLearner.isAllowed(e.getChannel(), e.getDevice()))
+			route.shared->midiQueue.push(flat);
+}
+
+/* -------------------------------------------------------------------------- */
+
 void MidiDispatcher::learn(const MidiEvent& e)
 {
 	assert(m_learnCb != nullptr);
@@ -129,8 +320,8 @@ void MidiDispatcher::process(const MidiEvent& e)
 {
 	assert(onEventReceived != nullptr);
 
-	processMaster(e);
-	processChannels(e);
+	for (const Binding& b : findBindings(e))
+		processBinding(b, e);
 	onEventReceived();
 }
 
@@ -145,166 +336,174 @@ bool MidiDispatcher::isMasterMidiInAllowed(int c)
 
 /* -------------------------------------------------------------------------- */
 
-bool MidiDispatcher::isChannelMidiInAllowed(ID channelId, int c)
+bool MidiDispatcher::isChannelMidiInAllowed(ID channelId, int c, int device)
 {
-	return m_model.get().getChannel(channelId).midiLearner.isAllowed(c);
+	return std::as_const(m_model).get().getChannel(channelId).midiLearner.isAllowed(c, device);
 }
 
 /* -------------------------------------------------------------------------- */
 
-void MidiDispatcher::processPlugins(ID channelId, const std::vector<Plugin*>& plugins,
-    const MidiEvent& midiEvent)
+void MidiDispatcher::processBinding(const Binding& b, const MidiEvent& e)
 {
-	uint32_t pure = midiEvent.getRawNoVelocity();
-	float    vf   = u::math::map(midiEvent.getVelocity(), G_MAX_VELOCITY, 1.0f);
+	using Target = Binding::Target;
+
+	/* Do nothing on this channel if MIDI in is filtered out for the current 
+	MIDI channel or input device. Master bindings don't filter. */
 
-	/* Plugins' parameters layout reflects the structure of the matrix
-	Channel::midiInPlugins. It is safe to assume then that Plugin 'p' and 
-	parameter indexes match both the structure of Channel::midiInPlugins and the 
-	vector of plugins. */
+	if (b.target != Target::MASTER && !b.isAllowed(e.getChannel(), e.getDevice()))
+		return;
 
-	for (Plugin* p : plugins)
+	switch (b.target)
 	{
-		for (const MidiLearnParam& param : p->midiInParams)
-		{
-			if (pure != param.getValue())
-				continue;
-			c::events::setPluginParameter(channelId, p->id, param.getIndex(), vf, Thread::MIDI);
-			u::log::print("  >>> [pluginId=%d paramIndex=%d] (pure=0x%X, value=%d, float=%f)\n",
-			    p->id, param.getIndex(), pure, midiEvent.getVelocity(), vf);
-		}
+	case Target::MASTER:
+		processMaster(b.param, e);
+		break;
+
+	case Target::CHANNEL:
+		processChannel(b.param, b.channelId, e);
+		break;
+
+	case Target::PLUGIN:
+	{
+		const float vf = u::math::map(e.getVelocity(), G_MAX_VELOCITY, 1.0f);
+		c::events::setPluginParameter(b.channelId, b.pluginId, b.paramIndex, vf, Thread::MIDI);
+		u::log::print("  >>> [pluginId=%d paramIndex=%d] (pure=0x%X, value=%d, float=%f)\n",
+		    b.pluginId, b.paramIndex, e.getRawNoVelocity(), e.getVelocity(), vf);
+		break;
+	}
+
+	case Target::ARMED_CHANNEL:
+		/* Redirect raw MIDI message (pure + velocity) to plug-ins in armed
+		channels. */
+		c::events::sendMidiToChannel(b.channelId, e, Thread::MIDI,
+		    b.direct && m_directEnabled.load() && e.isNoteOnOff());
+		break;
 	}
 }
 
 /* -------------------------------------------------------------------------- */
 
-void MidiDispatcher::processChannels(const MidiEvent& midiEvent)
+void MidiDispatcher::processChannel(int param, ID channelId, const MidiEvent& midiEvent)
 {
-	uint32_t pure = midiEvent.getRawNoVelocity();
+	const uint32_t pure = midiEvent.getRawNoVelocity();
 
-	for (const Channel& c : m_model.get().channels)
+	switch (param)
 	{
+	case G_MIDI_IN_KEYPRESS:
+		u::log::print("  >>> keyPress, ch=%d (pure=0x%X)\n", channelId, pure);
+		c::events::pressChannel(channelId, midiEvent.getVelocity(), Thread::MIDI, midiEvent.getDelta());
+		break;
 
-		/* Do nothing on this channel if MIDI in is disabled or filtered out for
-		the current MIDI channel. */
-		if (!c.midiLearner.isAllowed(midiEvent.getChannel()))
-			continue;
-
-		if (pure == c.midiLearner.keyPress.getValue())
-		{
-			u::log::print("  >>> keyPress, ch=%d (pure=0x%X)\n", c.id, pure);
-			c::events::pressChannel(c.id, midiEvent.getVelocity(), Thread::MIDI);
-		}
-		else if (pure == c.midiLearner.keyRelease.getValue())
-		{
-			u::log::print("  >>> keyRel ch=%d (pure=0x%X)\n", c.id, pure);
-			c::events::releaseChannel(c.id, Thread::MIDI);
-		}
-		else if (pure == c.midiLearner.mute.getValue())
-		{
-			u::log::print("  >>> mute ch=%d (pure=0x%X)\n", c.id, pure);
-			c::events::toggleMuteChannel(c.id, Thread::MIDI);
-		}
-		else if (pure == c.midiLearner.kill.getValue())
-		{
-			u::log::print("  >>> kill ch=%d (pure=0x%X)\n", c.id, pure);
-			c::events::killChannel(c.id, Thread::MIDI);
-		}
-		else if (pure == c.midiLearner.arm.getValue())
-		{
-			u::log::print("  >>> arm ch=%d (pure=0x%X)\n", c.id, pure);
-			c::events::toggleArmChannel(c.id, Thread::MIDI);
-		}
-		else if (pure == c.midiLearner.solo.getValue())
-		{
-			u::log::print("  >>> solo ch=%d (pure=0x%X)\n", c.id, pure);
-			c::events::toggleSoloChannel(c.id, Thread::MIDI);
-		}
-		else if (pure == c.midiLearner.volume.getValue())
-		{
-			float vf = u::math::map(midiEvent.getVelocity(), G_MAX_VELOCITY, G_MAX_VOLUME);
-			u::log::print("  >>> volume ch=%d (pure=0x%X, value=%d, float=%f)\n",
-			    c.id, pure, midiEvent.getVelocity(), vf);
-			c::events::setChannelVolume(c.id, vf, Thread::MIDI);
-		}
-		else if (pure == c.midiLearner.pitch.getValue())
-		{
-			float vf = u::math::map(midiEvent.getVelocity(), G_MAX_VELOCITY, G_MAX_PITCH);
-			u::log::print("  >>> pitch ch=%d (pure=0x%X, value=%d, float=%f)\n",
-			    c.id, pure, midiEvent.getVelocity(), vf);
-			c::events::setChannelPitch(c.id, vf, Thread::MIDI);
-		}
-		else if (pure == c.midiLearner.readActions.getValue())
-		{
-			u::log::print("  >>> toggle read actions ch=%d (pure=0x%X)\n", c.id, pure);
-			c::events::toggleReadActionsChannel(c.id, Thread::MIDI);
-		}
-
-		/* Process learned plugins parameters. */
-		processPlugins(c.id, c.plugins, midiEvent);
+	case G_MIDI_IN_KEYREL:
+		u::log::print("  >>> keyRel ch=%d (pure=0x%X)\n", channelId, pure);
+		c::events::releaseChannel(channelId, Thread::MIDI, midiEvent.getDelta());
+		break;
 
-		/* Redirect raw MIDI message (pure + velocity) to plug-ins in armed
-		channels. */
-		if (c.armed)
-			c::events::sendMidiToChannel(c.id, midiEvent, Thread::MIDI);
+	case G_MIDI_IN_MUTE:
+		u::log::print("  >>> mute ch=%d (pure=0x%X)\n", channelId, pure);
+		c::events::toggleMuteChannel(channelId, Thread::MIDI);
+		break;
+
+	case G_MIDI_IN_KILL:
+		u::log::print("  >>> kill ch=%d (pure=0x%X)\n", channelId, pure);
+		c::events::killChannel(channelId, Thread::MIDI, midiEvent.getDelta());
+		break;
+
+	case G_MIDI_IN_ARM:
+		u::log::print("  >>> arm ch=%d (pure=0x%X)\n", channelId, pure);
+		c::events::toggleArmChannel(channelId, Thread::MIDI);
+		break;
+
+	case G_MIDI_IN_SOLO:
+		u::log::print("  >>> solo ch=%d (pure=0x%X)\n", channelId, pure);
+		c::events::toggleSoloChannel(channelId, Thread::MIDI);
+		break;
+
+	case G_MIDI_IN_VOLUME:
+	{
+		float vf = u::math::map(midiEvent.getVelocity(), G_MAX_VELOCITY, G_MAX_VOLUME);
+		u::log::print("  >>> volume ch=%d (pure=0x%X, value=%d, float=%f)\n",
+		    channelId, pure, midiEvent.getVelocity(), vf);
+		c::events::setChannelVolume(channelId, vf, Thread::MIDI);
+		break;
+	}
+
+	case G_MIDI_IN_PITCH:
+	{
+		float vf = u::math::map(midiEvent.getVelocity(), G_MAX_VELOCITY, G_MAX_PITCH);
+		u::log::print("  >>> pitch ch=%d (pure=0x%X, value=%d, float=%f)\n",
+		    channelId, pure, midiEvent.getVelocity(), vf);
+		c::events::setChannelPitch(channelId, vf, Thread::MIDI);
+		break;
+	}
+
+	case G_MIDI_IN_READ_ACTIONS:
+		u::log::print("  >>> toggle read actions ch=%d (pure=0x%X)\n", channelId, pure);
+		c::events::toggleReadActionsChannel(channelId, Thread::MIDI);
+		break;
 	}
 }
 
 /* -------------------------------------------------------------------------- */
 
-void MidiDispatcher::processMaster(const MidiEvent& midiEvent)
+void MidiDispatcher::processMaster(int param, const MidiEvent& midiEvent)
 {
-	const uint32_t       pure   = midiEvent.getRawNoVelocity();
-	const model::MidiIn& midiIn = m_model.get().midiIn;
+	const uint32_t pure = midiEvent.getRawNoVelocity();
 
-	if (pure == midiIn.rewind)
+	switch (param)
 	{
+	case G_MIDI_IN_REWIND:
 		c::events::rewindSequencer(Thread::MIDI);
 		u::log::print("  >>> rewind (master) (pure=0x%X)\n", pure);
-	}
-	else if (pure == midiIn.startStop)
-	{
+		break;
+
+	case G_MIDI_IN_START_STOP:
 		c::events::toggleSequencer(Thread::MIDI);
 		u::log::print("  >>> startStop (master) (pure=0x%X)\n", pure);
-	}
-	else if (pure == midiIn.actionRec)
-	{
+		break;
+
+	case G_MIDI_IN_ACTION_REC:
 		c::events::toggleActionRecording();
 		u::log::print("  >>> actionRec (master) (pure=0x%X)\n", pure);
-	}
-	else if (pure == midiIn.inputRec)
-	{
+		break;
+
+	case G_MIDI_IN_INPUT_REC:
 		c::events::toggleInputRecording();
 		u::log::print("  >>> inputRec (master) (pure=0x%X)\n", pure);
-	}
-	else if (pure == midiIn.metronome)
-	{
+		break;
+
+	case G_MIDI_IN_METRONOME:
 		c::events::toggleMetronome();
 		u::log::print("  >>> metronome (master) (pure=0x%X)\n", pure);
-	}
-	else if (pure == midiIn.volumeIn)
+		break;
+
+	case G_MIDI_IN_VOLUME_IN:
 	{
 		float vf = u::math::map(midiEvent.getVelocity(), G_MAX_VELOCITY, G_MAX_VOLUME);
 		c::events::setMasterInVolume(vf, Thread::MIDI);
 		u::log::print("  >>> input volume (master) (pure=0x%X, value=%d, float=%f)\n",
 		    pure, midiEvent.getVelocity(), vf);
+		break;
 	}
-	else if (pure == midiIn.volumeOut)
+
+	case G_MIDI_IN_VOLUME_OUT:
 	{
 		float vf = u::math::map(midiEvent.getVelocity(), G_MAX_VELOCITY, G_MAX_VOLUME);
 		c::events::setMasterOutVolume(vf, Thread::MIDI);
 		u::log::print("  >>> output volume (master) (pure=0x%X, value=%d, float=%f)\n",
 		    pure, midiEvent.getVelocity(), vf);
+		break;
 	}
-	else if (pure == midiIn.beatDouble)
-	{
+
+	case G_MIDI_IN_BEAT_DOUBLE:
 		c::events::multiplyBeats();
 		u::log::print("  >>> sequencer x2 (master) (pure=0x%X)\n", pure);
-	}
-	else if (pure == midiIn.beatHalf)
-	{
+		break;
+
+	case G_MIDI_IN_BEAT_HALF:
 		c::events::divideBeats();
 		u::log::print("  >>> sequencer /2 (master) (pure=0x%X)\n", pure);
+		break;
 	}
 }
 
@@ -312,7 +511,7 @@ void MidiDispatcher::processMaster(const MidiEvent& midiEvent)
 
 void MidiDispatcher::learnChannel(MidiEvent e, int param, ID channelId, std::function<void()> doneCb)
 {
-	if (!isChannelMidiInAllowed(channelId, e.getChannel()))
+	if (!isChannelMidiInAllowed(channelId, e.getChannel(), e.getDevice()))
 		return;
 
 	uint32_t raw = e.getRawNoVelocity();
@@ -415,14 +614,19 @@ void MidiDispatcher::learnMaster(MidiEvent e, int param, std::function<void()> d
 
 void MidiDispatcher::learnPlugin(MidiEvent e, std::size_t paramIndex, ID pluginId, std::function<void()> doneCb)
 {
-	model::DataLock lock   = m_model.lockData(model::SwapType::NONE);
-	Plugin*         plugin = m_model.findShared<Plugin>(pluginId);
+	/* No need to lock anything: MidiLearnParam values are atomic. */
+
+	Plugin* plugin = m_model.findShared<Plugin>(pluginId);
 
 	assert(plugin != nullptr);
 	assert(paramIndex < plugin->midiInParams.size());
 
 	plugin->midiInParams[paramIndex].setValue(e.getRawNoVelocity());
 
+	/* No model swap here: refresh the bindings by hand. */
+
+	rebuildBindings();
+
 	stopLearn();
 	doneCb();
 }
@@ -31,9 +31,12 @@
 #include "core/midiEvent.h"
 #include "core/model/model.h"
 #include "core/types.h"
+#include <atomic>
 #include <cstddef>
 #include <cstdint>
 #include <functional>
+#include <unordered_map>
+#include <vector>
 
 namespace giada::m
 {
@@ -41,6 +44,7 @@ class MidiDispatcher
 {
 public:
 	MidiDispatcher(model::Model&);
+	~MidiDispatcher();
 
 	void startChannelLearn(int param, ID channelId, std::function<void()> f);
 	void startMasterLearn(int param, std::function<void()> f);
@@ -50,10 +54,99 @@ public:
 	void startPluginLearn(std::size_t paramIndex, ID pluginId, std::function<void()> f);
 	void clearPluginLearn(std::size_t paramIndex, ID pluginId, std::function<void()> f);
 
+	/* Binding
+	Something a learnt MIDI message is bound to: a master parameter, a 
+	channel parameter (G_MIDI_IN_* in 'param') or a plug-in parameter. Armed 
+	channels get a binding too, since they take every message. 'filter' and 
+	'device' are the MIDI channel and input device filters of the owner (-1 = 
+	all). 'rank' is the position of the owner in dispatch order: 0 for the 
+	master, then one per channel as they appear in the model. */
+
+	struct Binding
+	{
+		enum class Target
+		{
+			MASTER,
+			CHANNEL,
+			PLUGIN,
+			ARMED_CHANNEL
+		};
+
+		Target      target;
+		int         param      = 0;
+		ID          channelId  = 0;
+		ID          pluginId   = 0;
+		std::size_t paramIndex = 0;
+		int         filter     = -1;
+		int         device     = -1;
+		bool        direct     = false; // Armed channel on the direct path, if enabled
+		std::size_t rank       = 0;
+
+		bool isAllowed(int c, int d) const;
+	};
+
+	/* Bindings
+	Targets by learnt message (pure value, no velocity), plus the armed 
+	channels. Built by rebuildBindings() from the model. */
+
+	class Bindings
+	{
+	public:
+		/* addMaster
+		Binds the learnt master parameters. Call this before adding any 
+		channel. */
+
+		void addMaster(const model::MidiIn&);
+
+		/* addChannel
+		Binds the learnt parameters of a channel, then the ones of its plug-ins
+		and, if 'armed', the channel itself. Channels must be added in model 
+		order. Does nothing if MIDI input is disabled for the channel. */
+
+		void addChannel(ID channelId, const MidiLearner&, const std::vector<Plugin*>&,
+		    bool armed, bool direct);
+
+		/* find
+		Returns the targets of message 'pure' in dispatch order, the same as a
+		scan of the model would give: master first, then channel by channel. */
+
+		std::vector<Binding> find(uint32_t pure) const;
+
+	private:
+		/* bind
+		Adds 'b' to the targets of 'value', unless 'value' is empty or already
+		in 'seen'. Parameters of the same owner are bound by priority: when two
+		of them share the same message, only the first one reacts (e.g. key 
+		press wins over mute). */
+
+		void bind(std::vector<uint32_t>& seen, uint32_t value, Binding b);
+
+		std::unordered_map<uint32_t, std::vector<Binding>> m_learnt;
+		std::vector<Binding>                               m_armed;
+		std::size_t                                        m_rank = 0;
+	};
+
 	/* dispatch
-    Main callback invoked by kernelMidi whenever a new MIDI data comes in. */
+    Main callback invoked by kernelMidi whenever a new MIDI data comes in. 
+	'delta' is the frame offset within the next audio block where the message
+	should take effect. */
+
+	void dispatch(uint32_t msg, Frame delta = 0, int device = 0);
+
+	/* rebuildDirectRoutes
+	Refreshes the list of channels that take notes straight from the MIDI 
+	thread (direct path), bypassing the Event Dispatcher: armed MIDI channels.
+	Everything else keeps going through the Event Dispatcher. Call this on 
+	each model change. If 'enabled' is false the direct path is turned off. */
+
+	void rebuildDirectRoutes(bool enabled);
 
-	void dispatch(uint32_t msg);
+	/* rebuildBindings
+	Compiles the learnt MIDI messages of master, channels and plug-in 
+	parameters into a lookup table, so that process() finds the targets of a
+	message without scanning the whole model. Call this on each model change. */
+
+	void rebuildBindings();
 
 	/* learn
     Learns event 'e'. Called by the Event Dispatcher. */
@@ -78,17 +171,40 @@ public:
 	std::function<void()> onEventReceived;
 
 private:
+	/* DirectRoute
+	A channel that takes notes from the direct path. 'shared' is kept alive by
+	the model's Reclaimer while a read scope is open. */
+
+	struct DirectRoute
+	{
+		MidiLearner    midiLearner;
+		ChannelShared* shared;
+	};
+
+	using DirectRoutes = std::vector<DirectRoute>;
+
+	/* findBindings
+	Returns a copy of the bindings event 'e' triggers, so that they can be 
+	processed outside of the read scope. */
+
+	std::vector<Binding> findBindings(const MidiEvent& e) const;
+
+	/* routeDirectly
+	Pushes a note straight into the MIDI queue of the channels on the direct 
+	path. Called by the MIDI thread. */
+
+	void routeDirectly(const MidiEvent& e);
+
 	bool isMasterMidiInAllowed(int c);
-	bool isChannelMidiInAllowed(ID channelId, int c);
+	bool isChannelMidiInAllowed(ID channelId, int c, int device);
 
-	void processChannels(const MidiEvent& midiEvent);
-	void processMaster(const MidiEvent& midiEvent);
+	void processBinding(const Binding&, const MidiEvent&);
+	void processMaster(int param, const MidiEvent&);
+	void processChannel(int param, ID channelId, const MidiEvent&);
 
 	void learnChannel(MidiEvent e, int param, ID channelId, std::function<void()> doneCb);
 	void learnMaster(MidiEvent e, int param, std::function<void()> doneCb);
 
-	void processPlugins(ID channelId, const std::vector<Plugin*>& plugins,
-	    const MidiEvent& midiEvent);
 	void learnPlugin(MidiEvent e, std::size_t paramIndex, ID pluginId,
 	    std::function<void()> doneCb);
 
@@ -99,6 +215,19 @@ private:
 	std::function<void(MidiEvent)> m_learnCb;
 
 	model::Model& m_model;
+
+	/* m_directRoutes
+	Owned. Read by the MIDI thread without locks, so it's replaced on change 
+	and the old one retired through the model. */
+
+	std::atomic<DirectRoutes*> m_directRoutes;
+	std::atomic<bool>          m_directEnabled;
+
+	/* m_bindings
+	Owned. Same publishing scheme as m_directRoutes: rebuilt by whoever swaps
+	the model, read by the Event Dispatcher. */
+
+	std::atomic<Bindings*> m_bindings;
 };
 } // namespace giada::m
 
@@ -74,6 +74,11 @@ void MidiEvent::setDelta(int d)
 	m_delta = d;
 }
 
+void MidiEvent::setDevice(int d)
+{
+	m_device = d;
+}
+
 /* -------------------------------------------------------------------------- */
 
 void MidiEvent::setChannel(int c)
@@ -133,6 +138,11 @@ int MidiEvent::getDelta() const
 	return m_delta;
 }
 
+int MidiEvent::getDevice() const
+{
+	return m_device;
+}
+
 /* -------------------------------------------------------------------------- */
 
 uint32_t MidiEvent::getRaw() const
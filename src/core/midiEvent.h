@@ -63,6 +63,11 @@ public:
 	bool  isNoteOnOff() const;
 	int   getDelta() const;
 
+	/* getDevice
+	Index of the MIDI input device the event comes from. */
+
+	int getDevice() const;
+
 	/* getRaw(), getRawNoVelocity()
 	Returns the raw MIDI message. If getRawNoVelocity(), the velocity value is
 	stripped off (i.e. velocity == 0). */
@@ -71,6 +76,7 @@ public:
 	uint32_t getRawNoVelocity() const;
 
 	void setDelta(int d);
+	void setDevice(int d);
 	void setChannel(int c);
 	void setVelocity(int v);
 
@@ -89,6 +95,7 @@ private:
 	int m_note;
 	int m_velocity;
 	int m_delta;
+	int m_device = 0;
 };
 } // namespace m
 } // namespace giada
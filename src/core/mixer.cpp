@@ -26,29 +26,21 @@
 
 #include "core/mixer.h"
 #include "core/const.h"
+#include "core/dsp/kernels.h"
 #include "core/model/model.h"
+#include "core/profiler.h"
+#include "core/renderPool.h"
 #include "utils/log.h"
 #include "utils/math.h"
 
 namespace giada::m
 {
-namespace
-{
-/* CH_LEFT, CH_RIGHT
-Channels identifiers. */
-
-constexpr int CH_LEFT  = 0;
-constexpr int CH_RIGHT = 1;
-} // namespace
-
-/* -------------------------------------------------------------------------- */
-/* -------------------------------------------------------------------------- */
-/* -------------------------------------------------------------------------- */
-
-Mixer::Mixer(model::Model& m)
+Mixer::Mixer(model::Model& m, RenderPool& p, Profiler& prof)
 : onSignalTresholdReached(nullptr)
 , onEndOfRecording(nullptr)
 , m_model(m)
+, m_renderPool(p)
+, m_profiler(prof)
 , m_signalCbFired(false)
 , m_endOfRecCbFired(false)
 {
@@ -56,16 +48,15 @@ Mixer::Mixer(model::Model& m)
 
 /* -------------------------------------------------------------------------- */
 
-void Mixer::reset(Frame maxFramesInLoop, Frame framesInBuffer)
+void Mixer::reset(Frame framesInBuffer)
 {
-	/* Allocate working buffers. rec buffer has variable size: it depends on how
-	many frames there are in the current loop. */
+	/* Allocate working buffers. The rec buffer grows on demand while 
+	recording, so there's nothing to preallocate for it. */
 
-	m_model.get().mixer.getRecBuffer().alloc(maxFramesInLoop, G_MAX_IO_CHANS);
+	m_model.get().mixer.getRecBuffer().clear();
 	m_model.get().mixer.getInBuffer().alloc(framesInBuffer, G_MAX_IO_CHANS);
 
-	u::log::print("[mixer::reset] buffers ready - maxFramesInLoop=%d, framesInBuffer=%d\n",
-	    maxFramesInLoop, framesInBuffer);
+	u::log::print("[mixer::reset] buffers ready - framesInBuffer=%d\n", framesInBuffer);
 }
 
 /* -------------------------------------------------------------------------- */
@@ -83,36 +74,30 @@ void Mixer::enable()
 void Mixer::disable()
 {
 	m_model.get().mixer.a_setActive(false);
-	while (m_model.isLocked())
-		;
+	m_model.synchronize();
 	u::log::print("[mixer::disable] disabled\n");
 }
 
 /* -------------------------------------------------------------------------- */
 
-void Mixer::allocRecBuffer(Frame frames)
-{
-	m_model.get().mixer.getRecBuffer().alloc(frames, G_MAX_IO_CHANS);
-}
-
 void Mixer::clearRecBuffer()
 {
 	m_model.get().mixer.getRecBuffer().clear();
 }
 
-const mcl::AudioBuffer& Mixer::getRecBuffer()
+const InputRecBuffer& Mixer::getRecBuffer()
 {
 	return m_model.get().mixer.getRecBuffer();
 }
 
 /* -------------------------------------------------------------------------- */
 
-void Mixer::advanceChannels(const Sequencer::EventBuffer& events,
+void Mixer::advanceChannels(const Sequencer& sequencer,
     const model::Layout& rtLayout, Range<Frame> block, Frame quantizerStep)
 {
 	for (const Channel& c : rtLayout.channels)
 		if (!c.isInternal())
-			c.advance(events, block, quantizerStep);
+			c.advance(sequencer.getChannelEvents(c.id), block, quantizerStep);
 }
 
 /* -------------------------------------------------------------------------- */
@@ -159,25 +144,38 @@ void Mixer::render(mcl::AudioBuffer& out, const mcl::AudioBuffer& in, const mode
 	mixer.a_setPeakOut({0.0f, 0.0f});
 	mixer.a_setPeakIn({0.0f, 0.0f});
 
+	/* Nothing can make sound in this block: keep the input meter alive and 
+	leave 'out' to the silence it has been cleared with. */
+
+	if (isQuiescent(layout_RT, hasInput))
+	{
+		if (hasInput)
+			processLineIn(mixer, in, masterInCh.shared->volume.load(), recTriggerLevel, isSeqActive);
+		return;
+	}
+
 	if (hasInput)
 	{
-		processLineIn(mixer, in, masterInCh.volume, recTriggerLevel, isSeqActive);
+		processLineIn(mixer, in, masterInCh.shared->volume.load(), recTriggerLevel, isSeqActive);
 		renderMasterIn(masterInCh, mixer.getInBuffer());
 	}
 
 	if (shouldLineInRec)
 	{
 		const Frame newTrackerPos = lineInRec(in, mixer.getRecBuffer(),
-		    mixer.a_getInputTracker(), maxFramesToRec, masterInCh.volume,
+		    mixer.a_getInputTracker(), maxFramesToRec, masterInCh.shared->volume.load(),
 		    allowsOverdub);
 		mixer.a_setInputTracker(newTrackerPos);
 	}
 
-	/* Channel processing. Don't do it if layout is locked: another thread is 
-	changing data (e.g. Plugins or Waves). */
+	/* Channel processing. */
 
-	if (!layout_RT.locked)
+	{
+		Profiler::Scope scope(m_profiler, Profiler::Stage::CHANNELS);
 		renderChannels(layout_RT.channels, out, mixer.getInBuffer());
+	}
+
+	Profiler::Scope scope(m_profiler, Profiler::Stage::OUTPUT);
 
 	/* Render remaining internal channels. */
 
@@ -186,18 +184,27 @@ void Mixer::render(mcl::AudioBuffer& out, const mcl::AudioBuffer& in, const mode
 
 	/* Post processing. */
 
-	finalizeOutput(mixer, out, inToOut, limitOutput, masterOutCh.volume);
+	finalizeOutput(mixer, out, inToOut, limitOutput, masterOutCh.shared->volume.load());
 }
 
 /* -------------------------------------------------------------------------- */
 
 void Mixer::startInputRec(Frame from)
 {
-	m_model.get().mixer.a_setInputTracker(from);
+	const model::Mixer& mixer = m_model.get().mixer;
+
+	mixer.getRecBuffer().start(mixer.maxFramesToRec, from);
+	mixer.a_setInputTracker(from);
 }
 
 Frame Mixer::stopInputRec()
 {
+	/* Wait for any in-flight audio block to finish writing into the rec 
+	buffer before stopping it. */
+
+	m_model.synchronize();
+	m_model.get().mixer.getRecBuffer().stop();
+
 	const Frame ret = m_model.get().mixer.a_getInputTracker();
 	m_model.get().mixer.a_setInputTracker(0);
 	m_signalCbFired   = false;
@@ -228,7 +235,7 @@ Mixer::RecordInfo Mixer::getRecordInfo() const
 {
 	return {
 	    m_model.get().mixer.a_getInputTracker(),
-	    m_model.get().mixer.getRecBuffer().countFrames()};
+	    m_model.get().mixer.maxFramesToRec};
 }
 
 /* -------------------------------------------------------------------------- */
@@ -245,15 +252,34 @@ Peak Mixer::makePeak(const mcl::AudioBuffer& b) const
 {
 	if (!b.isAllocd())
 		return {0.0f, 0.0f};
-	return {b.getPeak(CH_LEFT), b.getPeak(b.countChannels() == 1 ? CH_LEFT : CH_RIGHT)};
+	return dsp::getPeak(b);
+}
+
+/* -------------------------------------------------------------------------- */
+
+bool Mixer::isQuiescent(const model::Layout& layout_RT, bool hasInput) const
+{
+	if (layout_RT.sequencer.isRunning() ||
+	    layout_RT.recorder.a_isRecordingInput() ||
+	    (hasInput && layout_RT.mixer.inToOut))
+		return false;
+
+	/* Master In is excluded: its output goes nowhere if no channel is 
+	monitoring the input. Master Out and Preview are included, so that their
+	tails and previews are not cut. */
+
+	for (const Channel& c : layout_RT.channels)
+		if (c.id != MASTER_IN_CHANNEL_ID && !c.isIdle())
+			return false;
+	return true;
 }
 
 /* -------------------------------------------------------------------------- */
 
-Frame Mixer::lineInRec(const mcl::AudioBuffer& inBuf, mcl::AudioBuffer& recBuf, Frame inputTracker,
+Frame Mixer::lineInRec(const mcl::AudioBuffer& inBuf, InputRecBuffer& recBuf, Frame inputTracker,
     Frame maxFrames, float inVol, bool allowsOverdub) const
 {
-	assert(maxFrames > 0 && maxFrames <= recBuf.countFrames());
+	assert(maxFrames > 0);
 	assert(onEndOfRecording != nullptr);
 
 	if (inputTracker >= maxFrames && !allowsOverdub && !m_endOfRecCbFired)
@@ -263,11 +289,7 @@ Frame Mixer::lineInRec(const mcl::AudioBuffer& inBuf, mcl::AudioBuffer& recBuf,
 		return 0;
 	}
 
-	const Frame framesToCopy = -1; // copy everything
-	const Frame srcOffset    = 0;
-	const Frame destOffset   = inputTracker % maxFrames; // loop over at maxFrames
-
-	recBuf.sum(inBuf, framesToCopy, srcOffset, destOffset, inVol);
+	recBuf.sum(inBuf, inputTracker % maxFrames, inVol); // loop over at maxFrames
 
 	return inputTracker + inBuf.countFrames();
 }
@@ -298,11 +320,35 @@ void Mixer::processLineIn(const model::Mixer& mixer, const mcl::AudioBuffer& inB
 
 /* -------------------------------------------------------------------------- */
 
-void Mixer::renderChannels(const std::vector<Channel>& channels, mcl::AudioBuffer& out, mcl::AudioBuffer& in) const
+void Mixer::renderChannels(const model::CowVector<Channel>& channels, mcl::AudioBuffer& out, mcl::AudioBuffer& in) const
 {
+	if (!m_renderPool.isEnabled())
+	{
+		for (const Channel& c : channels)
+		{
+			if (c.isInternal())
+				continue;
+			Profiler::Scope scope(m_profiler, c.shared->profile);
+			c.render(&out, &in, isChannelAudible(c));
+		}
+		return;
+	}
+
+	/* Master In has already been processed at this point, so channels reading
+	from it through their AudioReceiver can safely run concurrently. */
+
+	auto renderJob = [this, &channels, &in](std::size_t i) {
+		const Channel& c = channels[i];
+		if (c.isInternal())
+			return;
+		Profiler::Scope scope(m_profiler, c.shared->profile);
+		c.renderIsolated(in);
+	};
+	m_renderPool.run(channels.size(), renderJob);
+
 	for (const Channel& c : channels)
 		if (!c.isInternal())
-			c.render(&out, &in, isChannelAudible(c));
+			c.mix(out, isChannelAudible(c));
 }
 
 /* -------------------------------------------------------------------------- */
@@ -326,9 +372,7 @@ void Mixer::renderPreview(const Channel& ch, mcl::AudioBuffer& out) const
 
 void Mixer::limit(mcl::AudioBuffer& outBuf) const
 {
-	for (int i = 0; i < outBuf.countFrames(); i++)
-		for (int j = 0; j < outBuf.countChannels(); j++)
-			outBuf[i][j] = std::max(-1.0f, std::min(outBuf[i][j], 1.0f));
+	dsp::clip(outBuf, -1.0f, 1.0f);
 }
 
 /* -------------------------------------------------------------------------- */
@@ -337,13 +381,13 @@ void Mixer::finalizeOutput(const model::Mixer& mixer, mcl::AudioBuffer& buf,
     bool inToOut, bool shouldLimit, float vol) const
 {
 	if (inToOut)
-		buf.sum(mixer.getInBuffer(), vol);
+		dsp::sum(buf, mixer.getInBuffer(), vol);
 	else
-		buf.applyGain(vol);
+		dsp::gain(buf, vol);
 
 	if (shouldLimit)
 		limit(buf);
 
-	mixer.a_setPeakOut({buf.getPeak(CH_LEFT), buf.getPeak(CH_RIGHT)});
+	mixer.a_setPeakOut(makePeak(buf));
 }
 } // namespace giada::m
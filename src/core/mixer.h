@@ -27,7 +27,9 @@
 #ifndef G_MIXER_H
 #define G_MIXER_H
 
+#include "core/inputRecBuffer.h"
 #include "core/midiEvent.h"
+#include "core/model/cowVector.h"
 #include "core/queue.h"
 #include "core/ringBuffer.h"
 #include "core/sequencer.h"
@@ -52,6 +54,8 @@ namespace giada::m
 {
 struct Action;
 class Channel;
+class RenderPool;
+class Profiler;
 class Mixer
 {
 public:
@@ -68,7 +72,7 @@ public:
 		Frame maxLength;
 	};
 
-	Mixer(model::Model&);
+	Mixer(model::Model&, RenderPool&, Profiler&);
 
 	/* isActive
 	Mixer might be inactive (not initialized or suspended). */
@@ -97,7 +101,7 @@ public:
 	/* reset
 	Brings everything back to the initial state. */
 
-	void reset(Frame framesInLoop, Frame framesInBuffer);
+	void reset(Frame framesInBuffer);
 
 	/* enable, disable
 	Toggles master callback processing. Useful to suspend the rendering. */
@@ -105,13 +109,8 @@ public:
 	void enable();
 	void disable();
 
-	/* allocRecBuffer
-	Allocates new memory for the virtual input channel. */
-
-	void allocRecBuffer(Frame frames);
-
 	/* clearRecBuffer
-	Clears internal virtual channel. */
+	Clears internal virtual channel and frees its memory. */
 
 	void clearRecBuffer();
 
@@ -119,22 +118,24 @@ public:
 	Returns a read-only reference to the internal virtual channel. Use this to
 	merge data into channel after an input recording session. */
 
-	const mcl::AudioBuffer& getRecBuffer();
+	const InputRecBuffer& getRecBuffer();
 
 	/* startInputRec, stopInputRec
 	Starts/stops input recording on frame 'from'. The latter returns the number 
-	of recorded frames. */
+	of recorded frames. Not real-time safe: the rec buffer is prepared on start 
+	and its allocation worker is stopped on stop. */
 
 	void  startInputRec(Frame from);
 	Frame stopInputRec();
 
 	/* advanceChannels
 	Processes Channels' static events (e.g. pre-recorded actions or sequencer 
-	events) in the current audio block. Called by the main audio thread when the 
-	sequencer is running. */
+	events) in the current audio block. Each channel gets only the events 
+	addressed to it. Called by the main audio thread when the sequencer is 
+	running, after Sequencer::advance(). */
 
-	void advanceChannels(const Sequencer::EventBuffer&, const model::Layout&,
-	    Range<Frame>, Frame quantizerStep);
+	void advanceChannels(const Sequencer&, const model::Layout&, Range<Frame>,
+	    Frame quantizerStep);
 
 	/* updateSoloCount
     Updates the number of solo-ed channels in mixer. */
@@ -170,12 +171,19 @@ private:
 
 	Peak makePeak(const mcl::AudioBuffer& b) const;
 
+	/* isQuiescent
+	True if the whole project is silent and nothing can change that in the 
+	current block: sequencer stopped, no input recording or monitoring, all
+	channels idle. Rendering can be skipped altogether. */
+
+	bool isQuiescent(const model::Layout&, bool hasInput) const;
+
 	/* lineInRec
 	Records from line in. 'maxFrames' determines how many frames to record 
 	before the internal tracker loops over. The value changes whether you are 
 	recording in RIGID or FREE mode. Returns the number of recorded frames. */
 
-	Frame lineInRec(const mcl::AudioBuffer& inBuf, mcl::AudioBuffer& recBuf,
+	Frame lineInRec(const mcl::AudioBuffer& inBuf, InputRecBuffer& recBuf,
 	    Frame inputTracker, Frame maxFrames, float inVol, bool allowsOverdub) const;
 
 	/* processLineIn
@@ -185,7 +193,12 @@ private:
 	void processLineIn(const model::Mixer& mixer, const mcl::AudioBuffer& inBuf,
 	    float inVol, float recTriggerLevel, bool isSeqActive) const;
 
-	void renderChannels(const std::vector<Channel>& channels, mcl::AudioBuffer& out, mcl::AudioBuffer& in) const;
+	/* renderChannels
+	Renders all regular channels into 'out'. If the RenderPool is enabled 
+	channels are rendered in parallel into their own buffers, then summed to 
+	'out' serially in the original order, so the result is deterministic. */
+
+	void renderChannels(const model::CowVector<Channel>& channels, mcl::AudioBuffer& out, mcl::AudioBuffer& in) const;
 	void renderMasterIn(const Channel&, mcl::AudioBuffer& in) const;
 	void renderMasterOut(const Channel&, mcl::AudioBuffer& out) const;
 	void renderPreview(const Channel&, mcl::AudioBuffer& out) const;
@@ -203,6 +216,8 @@ private:
 	    bool limit, float vol) const;
 
 	model::Model& m_model;
+	RenderPool&   m_renderPool;
+	Profiler&     m_profiler;
 
 	/* m_signalCbFired, m_endOfRecCbFired
 	Boolean guards to determine whether the callbacks have been fired or not, 
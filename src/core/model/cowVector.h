@@ -0,0 +1,152 @@
+/* -----------------------------------------------------------------------------
+ *
+ * Giada - Your Hardcore Loopmachine
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2022 Giovanni A. Zuliani | Monocasual Laboratories
+ *
+ * This file is part of Giada - Your Hardcore Loopmachine.
+ *
+ * Giada - Your Hardcore Loopmachine is free software: you can
+ * redistribute it and/or modify it under the terms of the GNU General
+ * Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * Giada - Your Hardcore Loopmachine is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Giada - Your Hardcore Loopmachine. If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------- */
+
+
+#ifndef G_MODEL_COW_VECTOR_H
+#define G_MODEL_COW_VECTOR_H
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace giada::m::model
+{
+/* CowVector
+Vector of copy-on-write items. Copying a CowVector only copies the pointers to 
+its items, which stay shared across copies until one of them is edited: the 
+item is then cloned and only the clone is modified. Read access never clones; 
+write access is explicit through edit() and editIf(). Copies and edits must 
+happen on the non-realtime thread: the realtime one only reads items. */
+
+template <typename T>
+class CowVector
+{
+	using Ptrs = std::vector<std::shared_ptr<T>>;
+
+public:
+	class ConstIterator
+	{
+	public:
+		using iterator_category = std::forward_iterator_tag;
+		using value_type        = T;
+		using difference_type   = std::ptrdiff_t;
+		using pointer           = const T*;
+		using reference         = const T&;
+
+		ConstIterator(typename Ptrs::const_iterator it)
+		: m_it(it)
+		{
+		}
+
+		reference operator*() const { return **m_it; }
+		pointer   operator->() const { return m_it->get(); }
+
+		ConstIterator& operator++()
+		{
+			++m_it;
+			return *this;
+		}
+
+		ConstIterator operator++(int)
+		{
+			ConstIterator tmp = *this;
+			++m_it;
+			return tmp;
+		}
+
+		bool operator==(const ConstIterator& o) const { return m_it == o.m_it; }
+		bool operator!=(const ConstIterator& o) const { return m_it != o.m_it; }
+
+	private:
+		typename Ptrs::const_iterator m_it;
+	};
+
+	ConstIterator begin() const { return {m_items.cbegin()}; }
+	ConstIterator end() const { return {m_items.cend()}; }
+
+	std::size_t size() const { return m_items.size(); }
+	bool        empty() const { return m_items.empty(); }
+
+	const T& operator[](std::size_t i) const { return *m_items[i]; }
+	const T& back() const { return *m_items.back(); }
+
+	/* isShared
+	True if the i-th item is also referenced by another CowVector. */
+
+	bool isShared(std::size_t i) const { return m_items[i].use_count() > 1; }
+
+	/* edit
+	Returns a writable reference to the i-th item, cloning it first if it is
+	shared with another CowVector. */
+
+	T& edit(std::size_t i)
+	{
+		assert(i < m_items.size());
+		std::shared_ptr<T>& item = m_items[i];
+		if (item.use_count() > 1)
+			item = std::make_shared<T>(std::as_const(*item));
+		return *item;
+	}
+
+	/* editIf
+	Calls 'f' on a writable reference to each item that satisfies 'pred'. Items 
+	that don't match are left untouched and shared. */
+
+	template <typename P, typename F>
+	void editIf(P pred, F f)
+	{
+		for (std::size_t i = 0; i < m_items.size(); i++)
+			if (pred(std::as_const(*m_items[i])))
+				f(edit(i));
+	}
+
+	/* push_back
+	Appends a copy of 'item'. Items are always copy-constructed in their final
+	location, so that types binding callbacks to 'this' in the copy constructor 
+	(e.g. Channel) stay consistent. */
+
+	void push_back(const T& item) { m_items.push_back(std::make_shared<T>(item)); }
+
+	template <typename P>
+	void removeIf(P pred)
+	{
+		m_items.erase(std::remove_if(m_items.begin(), m_items.end(),
+		                  [&pred](const std::shared_ptr<T>& item) { return pred(std::as_const(*item)); }),
+		    m_items.end());
+	}
+
+	void clear() { m_items.clear(); }
+
+private:
+	Ptrs m_items;
+};
+} // namespace giada::m::model
+
+#endif
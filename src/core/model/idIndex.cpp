@@ -0,0 +1,73 @@
+/* -----------------------------------------------------------------------------
+ *
+ * Giada - Your Hardcore Loopmachine
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2022 Giovanni A. Zuliani | Monocasual Laboratories
+ *
+ * This file is part of Giada - Your Hardcore Loopmachine.
+ *
+ * Giada - Your Hardcore Loopmachine is free software: you can
+ * redistribute it and/or modify it under the terms of the GNU General
+ * Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * Giada - Your Hardcore Loopmachine is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Giada - Your Hardcore Loopmachine. If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------- */
+
+
+#include "core/model/idIndex.h"
+#include <algorithm>
+
+namespace giada::m::model
+{
+int IdIndex::get(ID id) const
+{
+	if (id < 0)
+		return NONE;
+	if (id > MAX_ID)
+	{
+		const auto it = m_large.find(id);
+		return it != m_large.end() ? it->second : NONE;
+	}
+	if (static_cast<std::size_t>(id) >= m_positions.size())
+		return NONE;
+	return m_positions[id];
+}
+
+/* -------------------------------------------------------------------------- */
+
+void IdIndex::clear()
+{
+	std::fill(m_positions.begin(), m_positions.end(), NONE);
+	m_large.clear();
+}
+
+/* -------------------------------------------------------------------------- */
+
+void IdIndex::set(ID id, int position)
+{
+	if (id < 0)
+		return;
+	if (id > MAX_ID)
+	{
+		if (position == NONE)
+			m_large.erase(id);
+		else
+			m_large[id] = position;
+		return;
+	}
+	if (static_cast<std::size_t>(id) >= m_positions.size())
+		m_positions.resize(id + 1, NONE);
+	m_positions[id] = position;
+}
+} // namespace giada::m::model
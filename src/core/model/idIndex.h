@@ -0,0 +1,90 @@
+/* -----------------------------------------------------------------------------
+ *
+ * Giada - Your Hardcore Loopmachine
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2022 Giovanni A. Zuliani | Monocasual Laboratories
+ *
+ * This file is part of Giada - Your Hardcore Loopmachine.
+ *
+ * Giada - Your Hardcore Loopmachine is free software: you can
+ * redistribute it and/or modify it under the terms of the GNU General
+ * Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * Giada - Your Hardcore Loopmachine is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Giada - Your Hardcore Loopmachine. If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------- */
+
+
+#ifndef G_MODEL_ID_INDEX_H
+#define G_MODEL_ID_INDEX_H
+
+#include "core/types.h"
+#include <cstddef>
+#include <unordered_map>
+#include <vector>
+
+namespace giada::m::model
+{
+/* IdIndex
+Compact ID -> position table for containers of objects with a unique ID. IDs 
+are small sequential integers (see IdManager), so a plain vector indexed by ID 
+gives constant-time, cache-friendly lookups. Positions are hints: the container 
+may have been edited after the last rebuild, so callers must check the ID of 
+the object found at that position and fall back to a scan on mismatch. */
+
+class IdIndex
+{
+public:
+	static constexpr int NONE = -1;
+
+	/* get
+	Returns the position of the object with the given ID, or NONE if unknown. 
+	Real-time safe (no allocations). */
+
+	int get(ID id) const;
+
+	/* rebuild
+	Recomputes the table from a container. 'getId' returns the ID of the i-th
+	object. Might allocate. */
+
+	template <typename F>
+	void rebuild(std::size_t size, F getId)
+	{
+		clear();
+		for (std::size_t i = 0; i < size; i++)
+			set(getId(i), static_cast<int>(i));
+	}
+
+	/* set
+	Stores the position of a single object. Pass NONE to forget it. Might 
+	allocate. */
+
+	void set(ID id, int position);
+
+	void clear();
+
+private:
+	/* MAX_ID
+	IDs above this value go to the 'm_large' hash map instead of the vector, so
+	that a weird ID can't blow up memory usage. Still constant time, just a bit
+	slower. Happens with long-lived objects that never reuse IDs, e.g. actions
+	in a long session. */
+
+	static constexpr ID MAX_ID = 1 << 16;
+
+	std::vector<int>            m_positions;
+	std::unordered_map<ID, int> m_large;
+};
+} // namespace giada::m::model
+
+#endif
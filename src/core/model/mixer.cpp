@@ -97,6 +97,6 @@ void Mixer::a_setPeakIn(Peak p) const
 
 /* -------------------------------------------------------------------------- */
 
-mcl::AudioBuffer& Mixer::getRecBuffer() const { return shared->recBuffer; }
+InputRecBuffer&   Mixer::getRecBuffer() const { return shared->recBuffer; }
 mcl::AudioBuffer& Mixer::getInBuffer() const { return shared->inBuffer; }
 } // namespace giada::m::model
@@ -28,6 +28,7 @@
 #define G_MODEL_MIXER_H
 
 #include "core/const.h"
+#include "core/inputRecBuffer.h"
 #include "core/types.h"
 #include "core/weakAtomic.h"
 #include "deps/mcl-audio-buffer/src/audioBuffer.hpp"
@@ -50,7 +51,7 @@ public:
 	void a_setPeakOut(Peak) const;
 	void a_setPeakIn(Peak) const;
 
-	mcl::AudioBuffer& getRecBuffer() const;
+	InputRecBuffer&   getRecBuffer() const;
 	mcl::AudioBuffer& getInBuffer() const;
 
 	bool  hasSolos        = false;
@@ -73,9 +74,9 @@ private:
 		WeakAtomic<Frame> inputTracker = 0;
 
 		/* recBuffer
-		Working buffer for audio recording. */
+		Chunked storage for audio recording. Not copied across model swaps. */
 
-		mcl::AudioBuffer recBuffer;
+		InputRecBuffer recBuffer;
 
 		/* inBuffer
 		Working buffer for input channel. Used for the in->out bridge. */
@@ -25,6 +25,7 @@
  * -------------------------------------------------------------------------- */
 
 #include "core/model/model.h"
+#include <algorithm>
 #include <cassert>
 #include <memory>
 #ifdef G_DEBUG_MODE
@@ -38,27 +39,56 @@ namespace giada::m::model
 {
 namespace
 {
-template <typename T>
-auto getIter_(const std::vector<std::unique_ptr<T>>& source, ID id)
+template <typename S>
+void rebuildIndex_(const S& source, IdIndex& index)
 {
-	return u::vector::findIf(source, [id](const std::unique_ptr<T>& p) { return p->id == id; });
+	index.rebuild(source.size(), [&source](std::size_t i) { return source[i]->id; });
 }
 
 /* -------------------------------------------------------------------------- */
 
+/* find_
+Looks up an object by ID through the index. Read-only: the index is kept up 
+to date by whoever edits the container (see rebuildSharedIndex()). */
+
 template <typename S>
-auto* get_(S& source, ID id)
+typename S::value_type::pointer find_(const S& source, const IdIndex& index, ID id)
+{
+	const int i = index.get(id);
+	if (i != IdIndex::NONE && static_cast<std::size_t>(i) < source.size() && source[i]->id == id)
+		return source[i].get();
+	return nullptr;
+}
+
+/* -------------------------------------------------------------------------- */
+
+/* extract_
+Removes an object from a container of unique_ptrs and hands it over. */
+
+template <typename D, typename T>
+auto extract_(D& dest, const T& ref)
 {
-	auto it = getIter_(source, id);
-	return it == source.end() ? nullptr : it->get();
+	auto it = std::find_if(dest.begin(), dest.end(), [&ref](const auto& other) { return other.get() == &ref; });
+	assert(it != dest.end());
+
+	auto out = std::move(*it);
+	dest.erase(it);
+	return out;
 }
 
 /* -------------------------------------------------------------------------- */
 
+/* replace_
+Puts 'obj' in place of the object with the same ID and returns the latter. */
+
 template <typename D, typename T>
-void remove_(D& dest, T& ref)
+std::unique_ptr<T> replace_(D& dest, std::unique_ptr<T> obj)
 {
-	u::vector::removeIf(dest, [&ref](const auto& other) { return other.get() == &ref; });
+	auto it = std::find_if(dest.begin(), dest.end(), [&obj](const auto& other) { return other->id == obj->id; });
+	assert(it != dest.end());
+
+	std::swap(*it, obj);
+	return obj;
 }
 } // namespace
 
@@ -66,18 +96,15 @@ void remove_(D& dest, T& ref)
 /* -------------------------------------------------------------------------- */
 /* -------------------------------------------------------------------------- */
 
-DataLock::DataLock(Model& m, SwapType t)
-: m_model(m)
-, m_swapType(t)
+LayoutLock::LayoutLock(mcl::AtomicSwapper<Layout>& layout, Reclaimer& reclaimer)
+: m_readScope(reclaimer)
+, m_rtLock(layout)
 {
-	m_model.get().locked = true;
-	m_model.swap(SwapType::NONE);
 }
 
-DataLock::~DataLock()
+const Layout& LayoutLock::get() const
 {
-	m_model.get().locked = false;
-	m_model.swap(m_swapType);
+	return m_rtLock.get();
 }
 
 /* -------------------------------------------------------------------------- */
@@ -86,16 +113,38 @@ DataLock::~DataLock()
 
 Channel& Layout::getChannel(ID id)
 {
-	return const_cast<Channel&>(const_cast<const Layout*>(this)->getChannel(id));
+	return channels.edit(getChannelPosition(id));
 }
 
 const Channel& Layout::getChannel(ID id) const
 {
-	auto it = std::find_if(channels.begin(), channels.end(), [id](const Channel& c) {
-		return c.id == id;
-	});
-	assert(it != channels.end());
-	return *it;
+	return channels[getChannelPosition(id)];
+}
+
+/* -------------------------------------------------------------------------- */
+
+void Layout::rebuildIndex()
+{
+	m_channelsIndex.rebuild(channels.size(), [this](std::size_t i) { return channels[i].id; });
+}
+
+/* -------------------------------------------------------------------------- */
+
+std::size_t Layout::getChannelPosition(ID id) const
+{
+	/* Fast path. The index is always valid in the realtime Layout; the non-
+	realtime one might have been edited since the last swap, hence the check
+	and the fallback scan. */
+
+	const int i = m_channelsIndex.get(id);
+	if (i != IdIndex::NONE && static_cast<std::size_t>(i) < channels.size() && channels[i].id == id)
+		return i;
+
+	std::size_t j = 0;
+	while (j < channels.size() && channels[j].id != id)
+		j++;
+	assert(j < channels.size());
+	return j;
 }
 
 /* -------------------------------------------------------------------------- */
@@ -104,14 +153,32 @@ const Channel& Layout::getChannel(ID id) const
 
 Model::Model()
 : onSwap(nullptr)
+, onSwapCore(nullptr)
+, m_actions(nullptr)
+, m_channelsShared(nullptr)
 {
 	reset();
 }
 
 /* -------------------------------------------------------------------------- */
 
+Model::~Model()
+{
+	delete m_actions.load();
+	delete m_channelsShared.load();
+}
+
+/* -------------------------------------------------------------------------- */
+
 void Model::reset()
 {
+	/* Channels' shared state can still be reached by other threads until the 
+	new Layout is published, e.g. by the MIDI thread through MidiDispatcher's
+	direct routes (rebuilt by the swap below). Move it aside and retire it, 
+	rather than deleting it in place. */
+
+	auto oldChannelsShared = std::make_unique<ChannelSharedPtrs>(std::move(m_shared.channelsShared));
+
 	get()    = {};
 	m_shared = {};
 
@@ -119,7 +186,11 @@ void Model::reset()
 	get().mixer.shared     = &m_shared.mixerShared;
 	get().recorder.shared  = &m_shared.recorderShared;
 
+	rebuildSharedIndex();
+	publishChannelsShared();
+	retire(replaceShared(std::make_unique<Actions::Map>()));
 	swap(SwapType::NONE);
+	retire(std::move(oldChannelsShared));
 }
 
 /* -------------------------------------------------------------------------- */
@@ -129,28 +200,61 @@ const Layout& Model::get() const { return m_layout.get(); }
 
 LayoutLock Model::get_RT()
 {
-	return LayoutLock(m_layout);
+	return LayoutLock(m_layout, m_reclaimer);
+}
+
+Reclaimer::ReadScope Model::read()
+{
+	return Reclaimer::ReadScope(m_reclaimer);
 }
 
 void Model::swap(SwapType t)
 {
+	get().rebuildIndex();
 	m_layout.swap();
+	m_reclaimer.collect();
+	if (onSwapCore)
+		onSwapCore(t);
 	if (onSwap)
 		onSwap(t);
 }
 
 /* -------------------------------------------------------------------------- */
 
-DataLock Model::lockData(SwapType t)
+void Model::synchronize()
+{
+	m_reclaimer.synchronize();
+}
+
+/* -------------------------------------------------------------------------- */
+
+void Model::rebuildSharedIndex()
+{
+	rebuildIndex_(m_shared.plugins, m_pluginsIndex);
+	rebuildIndex_(m_shared.waves, m_wavesIndex);
+}
+
+/* -------------------------------------------------------------------------- */
+
+void Model::publishChannelsShared()
 {
-	return DataLock(*this, t);
+	auto table = std::make_unique<ChannelSharedMap>();
+	for (const ChannelSharedPtr& shared : m_shared.channelsShared)
+		table->emplace(shared->id, shared.get());
+
+	std::unique_ptr<ChannelSharedMap> old(m_channelsShared.exchange(table.release()));
+	retire(std::move(old));
 }
 
 /* -------------------------------------------------------------------------- */
 
-bool Model::isLocked() const
+ChannelShared* Model::findChannelShared(ID id) const
 {
-	return m_layout.isLocked();
+	const ChannelSharedMap* table = m_channelsShared.load();
+	if (table == nullptr)
+		return nullptr;
+	const auto it = table->find(id);
+	return it != table->end() ? it->second : nullptr;
 }
 
 /* -------------------------------------------------------------------------- */
@@ -163,7 +267,7 @@ T& Model::getAllShared()
 	if constexpr (std::is_same_v<T, WavePtrs>)
 		return m_shared.waves;
 	if constexpr (std::is_same_v<T, Actions::Map>)
-		return m_shared.actions;
+		return *m_actions.load();
 	if constexpr (std::is_same_v<T, ChannelSharedPtrs>)
 		return m_shared.channelsShared;
 
@@ -178,18 +282,18 @@ template ChannelSharedPtrs& Model::getAllShared<ChannelSharedPtrs>();
 /* -------------------------------------------------------------------------- */
 
 template <typename T>
-T* Model::findShared(ID id)
+T* Model::findShared(ID id) const
 {
 	if constexpr (std::is_same_v<T, Plugin>)
-		return get_(m_shared.plugins, id);
+		return find_(m_shared.plugins, m_pluginsIndex, id);
 	if constexpr (std::is_same_v<T, Wave>)
-		return get_(m_shared.waves, id);
+		return find_(m_shared.waves, m_wavesIndex, id);
 
 	assert(false);
 }
 
-template Plugin* Model::findShared<Plugin>(ID id);
-template Wave*   Model::findShared<Wave>(ID id);
+template Plugin* Model::findShared<Plugin>(ID id) const;
+template Wave*   Model::findShared<Wave>(ID id) const;
 
 /* -------------------------------------------------------------------------- */
 
@@ -201,7 +305,11 @@ void Model::addShared(T obj)
 	if constexpr (std::is_same_v<T, WavePtr>)
 		m_shared.waves.push_back(std::move(obj));
 	if constexpr (std::is_same_v<T, ChannelSharedPtr>)
+	{
 		m_shared.channelsShared.push_back(std::move(obj));
+		publishChannelsShared();
+	}
+	rebuildSharedIndex();
 }
 
 template void Model::addShared<PluginPtr>(PluginPtr p);
@@ -214,13 +322,37 @@ template <typename T>
 void Model::removeShared(const T& ref)
 {
 	if constexpr (std::is_same_v<T, Plugin>)
-		remove_(m_shared.plugins, ref);
+		retire(extract_(m_shared.plugins, ref));
 	if constexpr (std::is_same_v<T, Wave>)
-		remove_(m_shared.waves, ref);
+		retire(extract_(m_shared.waves, ref));
+	if constexpr (std::is_same_v<T, ChannelShared>)
+	{
+		/* Unpublish first: no new reader must find it once retired. */
+		ChannelSharedPtr shared = extract_(m_shared.channelsShared, ref);
+		publishChannelsShared();
+		retire(std::move(shared));
+	}
+	rebuildSharedIndex();
 }
 
 template void Model::removeShared<Plugin>(const Plugin& t);
 template void Model::removeShared<Wave>(const Wave& t);
+template void Model::removeShared<ChannelShared>(const ChannelShared& t);
+
+/* -------------------------------------------------------------------------- */
+
+template <typename T>
+std::unique_ptr<T> Model::replaceShared(std::unique_ptr<T> obj)
+{
+	if constexpr (std::is_same_v<T, Wave>)
+		obj = replace_(m_shared.waves, std::move(obj));
+	if constexpr (std::is_same_v<T, Actions::Map>)
+		obj.reset(m_actions.exchange(obj.release()));
+	return obj;
+}
+
+template WavePtr                       Model::replaceShared<Wave>(WavePtr w);
+template std::unique_ptr<Actions::Map> Model::replaceShared<Actions::Map>(std::unique_ptr<Actions::Map> m);
 
 /* -------------------------------------------------------------------------- */
 
@@ -244,14 +376,29 @@ template ChannelShared& Model::backShared<ChannelShared>();
 template <typename T>
 void Model::clearShared()
 {
+	const auto retireAll = [this](auto& source) {
+		for (auto& obj : source)
+			retire(std::move(obj));
+		source.clear();
+	};
+
 	if constexpr (std::is_same_v<T, PluginPtrs>)
-		m_shared.plugins.clear();
+		retireAll(m_shared.plugins);
 	if constexpr (std::is_same_v<T, WavePtrs>)
-		m_shared.waves.clear();
+		retireAll(m_shared.waves);
+	if constexpr (std::is_same_v<T, ChannelSharedPtrs>)
+	{
+		ChannelSharedPtrs shared = std::move(m_shared.channelsShared);
+		m_shared.channelsShared.clear();
+		publishChannelsShared();
+		retireAll(shared);
+	}
+	rebuildSharedIndex();
 }
 
 template void Model::clearShared<PluginPtrs>();
 template void Model::clearShared<WavePtrs>();
+template void Model::clearShared<ChannelSharedPtrs>();
 
 /* -------------------------------------------------------------------------- */
 
@@ -293,12 +440,13 @@ void Model::debug()
 
 	puts("model::shared.actions");
 
-	for (const auto& [frame, actions] : getAllShared<Actions::Map>())
+	const Actions::Map& actions = getAllShared<Actions::Map>();
+	for (auto it = actions.begin(); it != actions.end(); ++it)
 	{
-		fmt::print("\tframe: {}\n", frame);
-		for (const Action& a : actions)
-			fmt::print("\t\t({}) - ID={}, frame={}, channel={}, value=0x{}, prevId={}, prev={}, nextId={}, next={}\n",
-			    (void*)&a, a.id, a.frame, a.channelId, a.event.getRaw(), a.prevId, (void*)a.prev, a.nextId, (void*)a.next);
+		fmt::print("\ttick: {}\n", it.getTick());
+		for (const Action& a : it.getActions())
+			fmt::print("\t\t({}) - ID={}, tick={}, channel={}, value=0x{}, prevId={}, nextId={}\n",
+			    (void*)&a, a.id, a.tick, a.channelId, a.event.getRaw(), a.prevId, a.nextId);
 	}
 
 	puts("model::shared.plugins");
@@ -29,7 +29,10 @@
 
 #include "core/channels/channel.h"
 #include "core/const.h"
+#include "core/model/cowVector.h"
+#include "core/model/idIndex.h"
 #include "core/model/mixer.h"
+#include "core/model/reclaimer.h"
 #include "core/model/recorder.h"
 #include "core/model/sequencer.h"
 #include "core/plugins/plugin.h"
@@ -39,7 +42,9 @@
 #include "deps/mcl-audio-buffer/src/audioBuffer.hpp"
 #include "src/core/actions/actions.h"
 #include "utils/vector.h"
+#include <atomic>
 #include <memory>
+#include <unordered_map>
 
 namespace giada::m::model
 {
@@ -58,29 +63,55 @@ struct MidiIn
 	uint32_t metronome  = 0x0;
 };
 
+/* Channels
+Channels are shared between the realtime and the non-realtime Layouts: a swap
+only copies pointers, and only the channels that are edited get cloned. */
+
+using Channels = CowVector<Channel>;
+
 struct Layout
 {
+	/* getChannel
+	The non-const version returns a writable Channel, cloning it first if it is
+	shared with the realtime Layout. */
+
 	Channel&       getChannel(ID id);
 	const Channel& getChannel(ID id) const;
 
-	Sequencer            sequencer;
-	Mixer                mixer;
-	Recorder             recorder;
-	MidiIn               midiIn;
-	std::vector<Channel> channels;
+	Sequencer sequencer;
+	Mixer     mixer;
+	Recorder  recorder;
+	MidiIn    midiIn;
+	Channels  channels;
 
-	/* locked
-	If locked, Mixer won't process channels. This is used to allow editing the 
-	data (e.g. Actions or Plugins) a channel points to without data races. */
+	/* rebuildIndex
+	Refreshes the ID -> position table used by getChannel(). Model calls this 
+	on every swap, so the realtime Layout is always fully indexed. */
+
+	void rebuildIndex();
+
+private:
+	std::size_t getChannelPosition(ID id) const;
 
-	bool locked = false;
+	IdIndex m_channelsIndex;
 };
 
 /* LayoutLock
-Alias for a REALTIME scoped lock provided by the Swapper class. Use this in the
-real-time thread to lock the Layout. */
+REALTIME scoped lock on the Layout. Use this in the real-time thread to lock the
+Layout. It also registers the thread as a reader in the Reclaimer, so that any
+shared data retired in the meantime stays alive until the lock is released. */
 
-using LayoutLock = mcl::AtomicSwapper<Layout>::RtLock;
+class LayoutLock
+{
+public:
+	LayoutLock(mcl::AtomicSwapper<Layout>&, Reclaimer&);
+
+	const Layout& get() const;
+
+private:
+	Reclaimer::ReadScope               m_readScope;
+	mcl::AtomicSwapper<Layout>::RtLock m_rtLock;
+};
 
 /* SwapType
 Type of Layout change. 
@@ -105,21 +136,18 @@ using PluginPtrs        = std::vector<PluginPtr>;
 using WavePtrs          = std::vector<WavePtr>;
 using ChannelSharedPtrs = std::vector<ChannelSharedPtr>;
 
+/* ChannelSharedMap
+Channel ID -> shared state table, see Model::findChannelShared(). */
+
+using ChannelSharedMap = std::unordered_map<ID, ChannelShared*>;
+
 /* -------------------------------------------------------------------------- */
 
-class DataLock;
 class Model
 {
 public:
 	Model();
-
-	bool isLocked() const;
-
-	/* lockData
-	Returns a scoped locker DataLock object. Use this when you want to lock
-	the model: a locked model won't be processed by Mixer. */
-
-	[[nodiscard]] DataLock lockData(SwapType t = SwapType::HARD);
+	~Model();
 
 	/* reser
 	Resets the internal layout to default. */
@@ -132,6 +160,14 @@ public:
 
 	LayoutLock get_RT();
 
+	/* read
+	Registers the calling thread as a reader of shared data, for threads other
+	than the audio one that look up shared objects without a LayoutLock (e.g. 
+	the MIDI input thread). Anything retired meanwhile stays alive until the 
+	returned scope is gone. Real-time safe. */
+
+	Reclaimer::ReadScope read();
+
 	/* get
 	Returns a reference to the NON-REALTIME layout structure. */
 
@@ -143,15 +179,33 @@ public:
 
 	void swap(SwapType t);
 
+	/* synchronize
+	Waits until the realtime thread is done with any block it started before
+	this call. Blocks started afterwards are not waited for. */
+
+	void synchronize();
+
+	/* getAllShared
+	Returns a container of shared data. Don't add or remove objects through 
+	it: use addShared(), removeShared() and clearShared(), which keep the 
+	lookup tables up to date. */
+
 	template <typename T>
 	T& getAllShared();
 
 	/* findShared
 	Finds something in the shared data given an ID. Returns nullptr if the
-	object is not found. */
+	object is not found. Read-only: never touches the index. */
 
 	template <typename T>
-	T* findShared(ID id);
+	T* findShared(ID id) const;
+
+	/* findChannelShared
+	Returns the shared state of channel 'id', or nullptr if the channel is 
+	gone. Lock-free, for threads other than the main one (e.g. MIDI input, 
+	Event Dispatcher): keep a read() scope around while using the result. */
+
+	ChannelShared* findChannelShared(ID id) const;
 
 	/* addShared
 	Adds some shared data (by moving it). */
@@ -159,9 +213,31 @@ public:
 	template <typename T>
 	void addShared(T);
 
+	/* removeShared
+	Removes some shared data. The object is retired, not deleted: call this 
+	only when the realtime Layout no longer points to it (i.e. after a swap). */
+
 	template <typename T>
 	void removeShared(const T&);
 
+	/* replaceShared
+	Replaces the shared object with the same ID as the new one (or the whole 
+	Actions::Map) and returns the old one. Shared data read by the realtime 
+	thread must never be edited in place: make a copy, edit it, replace the 
+	original and retire() it once the Layout no longer points to it. */
+
+	template <typename T>
+	std::unique_ptr<T> replaceShared(std::unique_ptr<T>);
+
+	/* retire
+	Deletes 'obj' as soon as the realtime thread can't be reading it anymore. */
+
+	template <typename T>
+	void retire(std::unique_ptr<T> obj)
+	{
+		m_reclaimer.retire(std::move(obj));
+	}
+
 	/* backShared
 	Returns a reference to the last added shared item. */
 
@@ -181,6 +257,12 @@ public:
 
 	std::function<void(SwapType)> onSwap = nullptr;
 
+	/* onSwapCore
+	Same as onSwap, but reserved to engine components that cache data derived
+	from the layout. Fired before onSwap. */
+
+	std::function<void(SwapType)> onSwapCore = nullptr;
+
 private:
 	struct Shared
 	{
@@ -190,25 +272,38 @@ private:
 		std::vector<std::unique_ptr<ChannelShared>> channelsShared;
 
 		std::vector<std::unique_ptr<Wave>>   waves;
-		Actions::Map                         actions;
 		std::vector<std::unique_ptr<Plugin>> plugins;
 	};
 
+	/* rebuildSharedIndex
+	Refreshes the ID -> position tables used by findShared(). */
+
+	void rebuildSharedIndex();
+
+	/* publishChannelsShared
+	Publishes a new m_channelsShared table and retires the old one. Call this
+	every time channelsShared changes, before retiring anything removed from 
+	it. */
+
+	void publishChannelsShared();
+
 	mcl::AtomicSwapper<Layout> m_layout;
 	Shared                     m_shared;
-};
+	IdIndex                    m_pluginsIndex;
+	IdIndex                    m_wavesIndex;
+	Reclaimer                  m_reclaimer;
 
-/* -------------------------------------------------------------------------- */
+	/* m_actions
+	Owned. Read by the realtime thread without locks, so it is only replaced, 
+	never edited in place. */
 
-class DataLock
-{
-public:
-	DataLock(Model&, SwapType t);
-	~DataLock();
+	std::atomic<Actions::Map*> m_actions;
 
-private:
-	Model&   m_model;
-	SwapType m_swapType;
+	/* m_channelsShared
+	Owned. Same publishing scheme as m_actions: immutable, replaced by the main
+	thread on change, read by any thread through findChannelShared(). */
+
+	std::atomic<ChannelSharedMap*> m_channelsShared;
 };
 } // namespace giada::m::model
 
@@ -0,0 +1,132 @@
+/* -----------------------------------------------------------------------------
+ *
+ * Giada - Your Hardcore Loopmachine
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2022 Giovanni A. Zuliani | Monocasual Laboratories
+ *
+ * This file is part of Giada - Your Hardcore Loopmachine.
+ *
+ * Giada - Your Hardcore Loopmachine is free software: you can
+ * redistribute it and/or modify it under the terms of the GNU General
+ * Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * Giada - Your Hardcore Loopmachine is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Giada - Your Hardcore Loopmachine. If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------- */
+
+
+#include "core/model/reclaimer.h"
+#include <algorithm>
+#include <thread>
+
+namespace giada::m::model
+{
+Reclaimer::ReadScope::ReadScope(Reclaimer& r)
+: m_reclaimer(r)
+{
+	/* Register in the current epoch's slot, then make sure the epoch has not 
+	moved in the meantime. If it has, a writer might have already checked the 
+	slot and found it empty: retry with the new one. */
+
+	for (;;)
+	{
+		const uint64_t epoch = m_reclaimer.m_epoch.load();
+		m_slot               = epoch & 1;
+		m_reclaimer.m_readers[m_slot].fetch_add(1);
+		if (m_reclaimer.m_epoch.load() == epoch)
+			break;
+		m_reclaimer.m_readers[m_slot].fetch_sub(1);
+	}
+}
+
+/* -------------------------------------------------------------------------- */
+
+Reclaimer::ReadScope::~ReadScope()
+{
+	m_reclaimer.m_readers[m_slot].fetch_sub(1);
+}
+
+/* -------------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------- */
+
+void Reclaimer::retire(std::shared_ptr<void> obj)
+{
+	std::scoped_lock lock(m_mutex);
+
+	m_retired.push_back({std::move(obj), m_epoch.load()});
+	if (tryAdvance())
+		tryAdvance();
+	freeExpired();
+}
+
+/* -------------------------------------------------------------------------- */
+
+void Reclaimer::collect()
+{
+	std::scoped_lock lock(m_mutex);
+
+	if (m_retired.empty())
+		return;
+	if (tryAdvance())
+		tryAdvance();
+	freeExpired();
+}
+
+/* -------------------------------------------------------------------------- */
+
+void Reclaimer::synchronize()
+{
+	std::scoped_lock lock(m_mutex);
+
+	/* Two steps: the first one drains the readers of the previous epoch, the
+	second one those of the current epoch. */
+
+	for (int i = 0; i < 2; i++)
+		while (!tryAdvance())
+			std::this_thread::yield();
+	freeExpired();
+}
+
+/* -------------------------------------------------------------------------- */
+
+std::size_t Reclaimer::countRetired() const
+{
+	std::scoped_lock lock(m_mutex);
+	return m_retired.size();
+}
+
+/* -------------------------------------------------------------------------- */
+
+bool Reclaimer::tryAdvance()
+{
+	const uint64_t epoch = m_epoch.load();
+	if (m_readers[(epoch + 1) & 1].load() > 0)
+		return false;
+	m_epoch.store(epoch + 1);
+	return true;
+}
+
+/* -------------------------------------------------------------------------- */
+
+void Reclaimer::freeExpired()
+{
+	/* An object retired in epoch E might be seen by readers of epochs E-1 and 
+	E. Both are gone once the epoch reaches E+2. */
+
+	const uint64_t epoch = m_epoch.load();
+	m_retired.erase(std::remove_if(m_retired.begin(), m_retired.end(),
+	                    [epoch](const Retired& r) { return r.epoch + 2 <= epoch; }),
+	    m_retired.end());
+}
+} // namespace giada::m::model
@@ -0,0 +1,130 @@
+/* -----------------------------------------------------------------------------
+ *
+ * Giada - Your Hardcore Loopmachine
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2022 Giovanni A. Zuliani | Monocasual Laboratories
+ *
+ * This file is part of Giada - Your Hardcore Loopmachine.
+ *
+ * Giada - Your Hardcore Loopmachine is free software: you can
+ * redistribute it and/or modify it under the terms of the GNU General
+ * Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * Giada - Your Hardcore Loopmachine is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Giada - Your Hardcore Loopmachine. If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------- */
+
+
+#ifndef G_MODEL_RECLAIMER_H
+#define G_MODEL_RECLAIMER_H
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace giada::m::model
+{
+/* Reclaimer
+Epoch-based deferred deletion for objects shared with the realtime thread. 
+Readers (the audio thread) wrap their work in a ReadScope; writers publish a new
+version of an object first, then retire() the old one, which is deleted only 
+after all the readers that could still see it are gone. Readers never wait and
+never allocate. */
+
+class Reclaimer
+{
+public:
+	/* ReadScope
+	Marks the lifetime of a reader. Real-time safe. */
+
+	class ReadScope
+	{
+	public:
+		ReadScope(Reclaimer&);
+		ReadScope(const ReadScope&) = delete;
+		~ReadScope();
+
+	private:
+		Reclaimer& m_reclaimer;
+		int        m_slot;
+	};
+
+	Reclaimer()                 = default;
+	Reclaimer(const Reclaimer&) = delete;
+
+	/* retire
+	Schedules 'obj' for deletion. It must be already unreachable for new 
+	readers. Not real-time safe. */
+
+	template <typename T>
+	void retire(std::unique_ptr<T> obj)
+	{
+		if (obj != nullptr)
+			retire(std::shared_ptr<void>(std::move(obj)));
+	}
+
+	/* collect
+	Deletes the retired objects no reader can see anymore. Never blocks on 
+	readers: whatever is still in use is left for the next call. */
+
+	void collect();
+
+	/* synchronize
+	Waits until all the readers that started before the call are gone, then
+	deletes what has been retired so far. Readers that start afterwards are
+	not waited for. */
+
+	void synchronize();
+
+	/* countRetired
+	Returns the number of objects waiting to be deleted. */
+
+	std::size_t countRetired() const;
+
+private:
+	struct Retired
+	{
+		std::shared_ptr<void> object;
+		uint64_t              epoch;
+	};
+
+	void retire(std::shared_ptr<void>);
+
+	/* tryAdvance
+	Moves to the next epoch if no reader is left in the previous one. Requires
+	m_mutex. */
+
+	bool tryAdvance();
+
+	/* freeExpired
+	Deletes objects retired at least two epochs ago. Requires m_mutex. */
+
+	void freeExpired();
+
+	/* m_readers
+	Number of active readers, by epoch parity. Only the current and the 
+	previous epoch can have readers. */
+
+	std::array<std::atomic<int>, 2> m_readers = {};
+	std::atomic<uint64_t>           m_epoch   = 0;
+
+	mutable std::mutex   m_mutex;
+	std::vector<Retired> m_retired;
+};
+} // namespace giada::m::model
+
+#endif
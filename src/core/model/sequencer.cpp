@@ -42,6 +42,13 @@ bool Sequencer::canQuantize() const
 
 /* -------------------------------------------------------------------------- */
 
+TempoMap Sequencer::getTempoMap() const
+{
+	return TempoMap(framesInBeat);
+}
+
+/* -------------------------------------------------------------------------- */
+
 bool Sequencer::isRunning() const
 {
 	return status == SeqStatus::RUNNING;
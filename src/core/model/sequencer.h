@@ -28,6 +28,7 @@
 #define G_MODEL_SEQUENCER_H
 
 #include "core/const.h"
+#include "core/tempoMap.h"
 #include "core/types.h"
 #include "core/weakAtomic.h"
 #include "deps/mcl-audio-buffer/src/audioBuffer.hpp"
@@ -55,6 +56,11 @@ public:
 
 	bool canQuantize() const;
 
+	/* getTempoMap
+	Returns the tempo map for converting action positions to frames. */
+
+	TempoMap getTempoMap() const;
+
 	bool a_isOnBar() const;
 	bool a_isOnBeat() const;
 	bool a_isOnFirstBeat() const;
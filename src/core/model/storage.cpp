@@ -33,6 +33,7 @@
 #include "core/patch.h"
 #include "core/plugins/pluginManager.h"
 #include "core/sequencer.h"
+#include "core/tempoMap.h"
 #include "core/waveFactory.h"
 #include "src/core/actions/actionRecorder.h"
 #include <cassert>
@@ -55,9 +56,22 @@ void loadChannels_(const std::vector<Patch::Channel>& channels, int samplerate)
 
 /* -------------------------------------------------------------------------- */
 
-void loadActions_(const std::vector<Patch::Action>& pactions)
+/* getPatchTempoMap_
+Actions are stored in frames in the patch, at the patch tempo and sample rate. 
+Same math as in Sequencer::recomputeFrames(). */
+
+TempoMap getPatchTempoMap_(const Patch::Data& patch)
 {
-	g_engine.model.getAllShared<Actions::Map>() = g_engine.actionRecorder.deserializeActions(pactions);
+	const int framesInLoop = static_cast<int>((patch.samplerate * (60.0f / patch.bpm)) * patch.beats);
+	return TempoMap(static_cast<int>(framesInLoop / (float)patch.beats));
+}
+
+/* -------------------------------------------------------------------------- */
+
+void loadActions_(const std::vector<Patch::Action>& pactions, const TempoMap& tempoMap)
+{
+	g_engine.model.retire(g_engine.model.replaceShared(
+	    std::make_unique<Actions::Map>(g_engine.actionRecorder.deserializeActions(pactions, tempoMap))));
 }
 } // namespace
 
@@ -80,7 +94,8 @@ void store(Patch::Data& patch)
 	for (const auto& p : g_engine.model.getAllShared<PluginPtrs>())
 		patch.plugins.push_back(g_engine.pluginManager.serializePlugin(*p));
 
-	patch.actions = g_engine.actionRecorder.serializeActions(g_engine.model.getAllShared<Actions::Map>());
+	patch.actions = g_engine.actionRecorder.serializeActions(g_engine.model.getAllShared<Actions::Map>(),
+	    layout.sequencer.getTempoMap());
 
 	patch.waves.clear();
 	for (const auto& w : g_engine.model.getAllShared<WavePtrs>())
@@ -114,18 +129,21 @@ void store(Conf::Data& conf)
 
 LoadState load(const Patch::Data& patch)
 {
-	DataLock lock = g_engine.model.lockData(SwapType::NONE);
+	/* The Mixer is disabled while loading a patch, so shared data can be 
+	replaced in place here. */
+
+	assert(!g_engine.mixer.isActive());
 
 	/* Clear and re-initialize channels first. */
 
 	g_engine.model.get().channels = {};
-	g_engine.model.getAllShared<ChannelSharedPtrs>().clear();
+	g_engine.model.clearShared<ChannelSharedPtrs>();
 
 	LoadState state;
 
 	/* Load external data first: plug-ins and waves. */
 
-	g_engine.model.getAllShared<PluginPtrs>().clear();
+	g_engine.model.clearShared<PluginPtrs>();
 	for (const Patch::Plugin& pplugin : patch.plugins)
 	{
 		std::unique_ptr<Plugin> p = g_engine.pluginManager.deserializePlugin(
@@ -134,17 +152,17 @@ LoadState load(const Patch::Data& patch)
 		if (!p->valid)
 			state.missingPlugins.push_back(pplugin.path);
 
-		g_engine.model.getAllShared<PluginPtrs>().push_back(std::move(p));
+		g_engine.model.addShared(std::move(p));
 	}
 
-	g_engine.model.getAllShared<WavePtrs>().clear();
+	g_engine.model.clearShared<WavePtrs>();
 	for (const Patch::Wave& pwave : patch.waves)
 	{
 		std::unique_ptr<Wave> w = g_engine.waveFactory.deserializeWave(pwave, g_engine.kernelAudio.getSampleRate(),
 		    g_engine.conf.data.rsmpQuality);
 
 		if (w != nullptr)
-			g_engine.model.getAllShared<WavePtrs>().push_back(std::move(w));
+			g_engine.model.addShared(std::move(w));
 		else
 			state.missingWaves.push_back(pwave.path);
 	}
@@ -152,7 +170,7 @@ LoadState load(const Patch::Data& patch)
 	/* Then load up channels, actions and global properties. */
 
 	loadChannels_(patch.channels, g_engine.patch.data.samplerate);
-	loadActions_(patch.actions);
+	loadActions_(patch.actions, getPatchTempoMap_(patch));
 
 	g_engine.model.get().sequencer.status   = SeqStatus::STOPPED;
 	g_engine.model.get().sequencer.bars     = patch.bars;
@@ -160,6 +178,8 @@ LoadState load(const Patch::Data& patch)
 	g_engine.model.get().sequencer.bpm      = patch.bpm;
 	g_engine.model.get().sequencer.quantize = patch.quantize;
 
+	g_engine.model.swap(SwapType::NONE);
+
 	return state;
 }
 
@@ -0,0 +1,175 @@
+/* -----------------------------------------------------------------------------
+ *
+ * Giada - Your Hardcore Loopmachine
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2022 Giovanni A. Zuliani | Monocasual Laboratories
+ *
+ * This file is part of Giada - Your Hardcore Loopmachine.
+ *
+ * Giada - Your Hardcore Loopmachine is free software: you can
+ * redistribute it and/or modify it under the terms of the GNU General
+ * Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * Giada - Your Hardcore Loopmachine is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Giada - Your Hardcore Loopmachine. If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------- */
+
+
+#ifndef G_MPSC_QUEUE_H
+#define G_MPSC_QUEUE_H
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace giada::m
+{
+/* MpscQueue
+Bounded multiple producers, single consumer lock-free queue. Each slot carries 
+a sequence number that tells producers and the consumer whether it is free or
+filled (Vyukov's bounded queue). Pushing into a full queue fails and the loss
+is counted; the high-water mark keeps track of the maximum number of items
+ever queued, for tuning 'size'. */
+
+template <typename T, std::size_t size>
+class MpscQueue
+{
+	static_assert(size >= 2 && (size & (size - 1)) == 0, "MpscQueue size must be a power of two");
+
+public:
+	MpscQueue()
+	: m_head(0)
+	, m_tail(0)
+	, m_dropped(0)
+	, m_highWater(0)
+	{
+		for (std::size_t i = 0; i < size; i++)
+			m_slots[i].sequence.store(i, std::memory_order_relaxed);
+	}
+
+	MpscQueue(const MpscQueue&) = delete;
+	MpscQueue(MpscQueue&&)      = delete;
+	MpscQueue& operator=(const MpscQueue&) = delete;
+	MpscQueue& operator=(MpscQueue&&) = delete;
+
+	/* push
+	Thread-safe, can be called by any thread. Returns false if the queue is 
+	full. */
+
+	bool push(const T& item)
+	{
+		std::size_t pos = m_tail.load(std::memory_order_relaxed);
+		Slot*       slot;
+
+		while (true)
+		{
+			slot = &m_slots[pos & MASK];
+
+			const std::size_t    seq  = slot->sequence.load(std::memory_order_acquire);
+			const std::ptrdiff_t diff = static_cast<std::ptrdiff_t>(seq) - static_cast<std::ptrdiff_t>(pos);
+
+			if (diff == 0) // Slot free: try to claim it
+			{
+				if (m_tail.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+					break;
+			}
+			else if (diff < 0) // Queue full, nothing to do
+			{
+				m_dropped.fetch_add(1, std::memory_order_relaxed);
+				return false;
+			}
+			else // Another producer got there first
+				pos = m_tail.load(std::memory_order_relaxed);
+		}
+
+		slot->item = item;
+		slot->sequence.store(pos + 1, std::memory_order_release);
+
+		/* The consumer might have already moved past this item: the count is
+		just an estimate. */
+
+		const std::size_t head = m_head.load(std::memory_order_relaxed);
+		if (pos + 1 > head)
+			updateHighWater(std::min(pos + 1 - head, size));
+		return true;
+	}
+
+	/* pop
+	Must be called by a single consumer thread. Returns false if the queue is
+	empty. */
+
+	bool pop(T& item)
+	{
+		const std::size_t pos  = m_head.load(std::memory_order_relaxed);
+		Slot&             slot = m_slots[pos & MASK];
+
+		if (slot.sequence.load(std::memory_order_acquire) != pos + 1) // Empty, or still being written
+			return false;
+
+		item = slot.item;
+		slot.sequence.store(pos + size, std::memory_order_release);
+		m_head.store(pos + 1, std::memory_order_relaxed);
+		return true;
+	}
+
+	bool isEmpty() const
+	{
+		return m_head.load() == m_tail.load();
+	}
+
+	/* getDropped
+	Returns the number of items discarded because the queue was full. */
+
+	uint32_t getDropped() const { return m_dropped.load(std::memory_order_relaxed); }
+
+	/* getHighWater
+	Returns the maximum number of items ever found in the queue. */
+
+	uint32_t getHighWater() const { return m_highWater.load(std::memory_order_relaxed); }
+
+	static constexpr std::size_t getCapacity() { return size; }
+
+private:
+	static constexpr std::size_t MASK = size - 1;
+
+	/* CACHE_LINE
+	Head and tail live on separate cache lines, so that producers and the 
+	consumer don't invalidate each other's line on every operation. */
+
+	static constexpr std::size_t CACHE_LINE = 64;
+
+	struct Slot
+	{
+		std::atomic<std::size_t> sequence;
+		T                        item;
+	};
+
+	void updateHighWater(std::size_t count)
+	{
+		uint32_t curr = m_highWater.load(std::memory_order_relaxed);
+		while (count > curr && !m_highWater.compare_exchange_weak(curr, static_cast<uint32_t>(count), std::memory_order_relaxed))
+			;
+	}
+
+	std::array<Slot, size> m_slots;
+
+	alignas(CACHE_LINE) std::atomic<std::size_t> m_head;
+	alignas(CACHE_LINE) std::atomic<std::size_t> m_tail;
+	alignas(CACHE_LINE) std::atomic<uint32_t> m_dropped;
+	std::atomic<uint32_t>                     m_highWater;
+};
+} // namespace giada::m
+
+#endif
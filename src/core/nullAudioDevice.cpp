@@ -0,0 +1,182 @@
+/* -----------------------------------------------------------------------------
+ *
+ * Giada - Your Hardcore Loopmachine
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2022 Giovanni A. Zuliani | Monocasual Laboratories
+ *
+ * This file is part of Giada - Your Hardcore Loopmachine.
+ *
+ * Giada - Your Hardcore Loopmachine is free software: you can
+ * redistribute it and/or modify it under the terms of the GNU General
+ * Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * Giada - Your Hardcore Loopmachine is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Giada - Your Hardcore Loopmachine. If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------- */
+
+#include "core/nullAudioDevice.h"
+#include "utils/log.h"
+#include <algorithm>
+#include <cassert>
+#include <chrono>
+#include <sndfile.h>
+
+namespace giada::m
+{
+NullAudioDevice::NullAudioDevice(int sampleRate, int bufferSize, int channelsOut, int channelsIn)
+: onProcess(nullptr)
+, m_sampleRate(sampleRate)
+, m_bufferSize(bufferSize)
+, m_channelsOut(channelsOut)
+, m_channelsIn(channelsIn)
+, m_outBuf(bufferSize * channelsOut, 0.0f)
+, m_inBuf(bufferSize * channelsIn, 0.0f)
+, m_inputPos(0)
+, m_running(false)
+, m_missedDeadlines(0)
+, m_maxLoad(0.0f)
+{
+}
+
+/* -------------------------------------------------------------------------- */
+
+NullAudioDevice::~NullAudioDevice()
+{
+	stop();
+}
+
+/* -------------------------------------------------------------------------- */
+
+bool NullAudioDevice::loadInput(const std::string& path)
+{
+	if (m_channelsIn == 0)
+		return false;
+
+	SF_INFO  header = {};
+	SNDFILE* file   = sf_open(path.c_str(), SFM_READ, &header);
+	if (file == nullptr)
+	{
+		u::log::print("[NullAudioDevice::loadInput] unable to read %s: %s\n", path, sf_strerror(file));
+		return false;
+	}
+
+	if (header.samplerate != m_sampleRate)
+		u::log::print("[NullAudioDevice::loadInput] warning: sample rate mismatch (%d != %d)\n",
+		    header.samplerate, m_sampleRate);
+
+	std::vector<float> raw(header.frames * header.channels);
+	sf_readf_float(file, raw.data(), header.frames);
+	sf_close(file);
+
+	/* Map file channels to input channels: extra input channels replicate the
+	last channel available in the file. */
+
+	m_inputData.resize(header.frames * m_channelsIn);
+	for (sf_count_t f = 0; f < header.frames; f++)
+		for (int c = 0; c < m_channelsIn; c++)
+			m_inputData[f * m_channelsIn + c] = raw[f * header.channels + std::min(c, header.channels - 1)];
+	m_inputPos = 0;
+
+	u::log::print("[NullAudioDevice::loadInput] input loaded from %s (%d frames)\n", path, header.frames);
+	return true;
+}
+
+/* -------------------------------------------------------------------------- */
+
+void NullAudioDevice::start()
+{
+	assert(onProcess != nullptr);
+
+	if (m_running.load())
+		return;
+	m_running.store(true);
+	m_thread = std::thread([this]() { run(); });
+
+	u::log::print("[NullAudioDevice::start] started - samplerate=%d, buffersize=%d\n",
+	    m_sampleRate, m_bufferSize);
+}
+
+/* -------------------------------------------------------------------------- */
+
+void NullAudioDevice::stop()
+{
+	if (!m_running.load())
+		return;
+	m_running.store(false);
+	if (m_thread.joinable())
+		m_thread.join();
+
+	u::log::print("[NullAudioDevice::stop] stopped - missed deadlines=%d, max load=%.2f\n",
+	    m_missedDeadlines.load(), m_maxLoad.load());
+}
+
+/* -------------------------------------------------------------------------- */
+
+bool  NullAudioDevice::isRunning() const { return m_running.load(); }
+int   NullAudioDevice::getMissedDeadlines() const { return m_missedDeadlines.load(); }
+float NullAudioDevice::getMaxLoad() const { return m_maxLoad.load(); }
+
+/* -------------------------------------------------------------------------- */
+
+void NullAudioDevice::fillInput()
+{
+	if (m_inputData.empty())
+		return;
+
+	const std::size_t inputFrames = m_inputData.size() / m_channelsIn;
+	for (int f = 0; f < m_bufferSize; f++)
+	{
+		std::copy_n(m_inputData.begin() + m_inputPos * m_channelsIn, m_channelsIn, m_inBuf.begin() + f * m_channelsIn);
+		m_inputPos = (m_inputPos + 1) % inputFrames;
+	}
+}
+
+/* -------------------------------------------------------------------------- */
+
+void NullAudioDevice::run()
+{
+	using Clock = std::chrono::steady_clock;
+
+	const auto period = std::chrono::duration_cast<Clock::duration>(
+	    std::chrono::duration<double>(m_bufferSize / static_cast<double>(m_sampleRate)));
+
+	Clock::time_point deadline = Clock::now() + period;
+
+	while (m_running.load())
+	{
+		fillInput();
+
+		const Clock::time_point start = Clock::now();
+		onProcess(m_outBuf.data(), m_channelsIn > 0 ? m_inBuf.data() : nullptr, m_bufferSize);
+		const Clock::time_point end = Clock::now();
+
+		const float load = std::chrono::duration<float>(end - start) / std::chrono::duration<float>(period);
+		if (load > m_maxLoad.load())
+			m_maxLoad.store(load);
+
+		/* A callback that finishes after its deadline is an xrun on a real 
+		device. Skip the lost periods and realign to the clock, as a sound card
+		would do. */
+
+		if (end > deadline)
+		{
+			m_missedDeadlines.fetch_add(1);
+			while (deadline < end)
+				deadline += period;
+		}
+
+		std::this_thread::sleep_until(deadline);
+		deadline += period;
+	}
+}
+} // namespace giada::m
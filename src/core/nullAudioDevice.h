@@ -0,0 +1,104 @@
+/* -----------------------------------------------------------------------------
+ *
+ * Giada - Your Hardcore Loopmachine
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2022 Giovanni A. Zuliani | Monocasual Laboratories
+ *
+ * This file is part of Giada - Your Hardcore Loopmachine.
+ *
+ * Giada - Your Hardcore Loopmachine is free software: you can
+ * redistribute it and/or modify it under the terms of the GNU General
+ * Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * Giada - Your Hardcore Loopmachine is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Giada - Your Hardcore Loopmachine. If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------- */
+
+#ifndef G_NULL_AUDIO_DEVICE_H
+#define G_NULL_AUDIO_DEVICE_H
+
+#include <atomic>
+#include <functional>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace giada::m
+{
+/* NullAudioDevice
+A fake audio device driven by a high-resolution timer. It invokes the audio
+callback once per buffer period, as a real sound card would do, and keeps track
+of deadlines missed by the callback. Useful for headless operations, load 
+testing and running the engine where no sound card is available. */
+
+class NullAudioDevice final
+{
+public:
+	NullAudioDevice(int sampleRate, int bufferSize, int channelsOut, int channelsIn);
+	~NullAudioDevice();
+
+	/* loadInput
+	Reads the audio file 'path' and feeds it, looped, to the input buffer. 
+	Returns false if the file can't be read: input will be silent. */
+
+	bool loadInput(const std::string& path);
+
+	void start();
+	void stop();
+
+	bool isRunning() const;
+
+	/* getMissedDeadlines
+	Returns the number of callbacks that took longer than the buffer period. */
+
+	int getMissedDeadlines() const;
+
+	/* getMaxLoad
+	Returns the worst callback duration seen so far, as a fraction of the buffer
+	period (1.0 = the whole period was used). */
+
+	float getMaxLoad() const;
+
+	/* onProcess
+	Callback fired on each buffer period. 'in' is nullptr if there are no input
+	channels. */
+
+	std::function<void(float* out, float* in, int bufferSize)> onProcess;
+
+private:
+	void run();
+	void fillInput();
+
+	int m_sampleRate;
+	int m_bufferSize;
+	int m_channelsOut;
+	int m_channelsIn;
+
+	std::vector<float> m_outBuf;
+	std::vector<float> m_inBuf;
+
+	/* m_inputData, m_inputPos
+	Interleaved audio data read from file, already mapped to m_channelsIn 
+	channels, and the current read position in frames. */
+
+	std::vector<float> m_inputData;
+	std::size_t        m_inputPos;
+
+	std::thread        m_thread;
+	std::atomic<bool>  m_running;
+	std::atomic<int>   m_missedDeadlines;
+	std::atomic<float> m_maxLoad;
+};
+} // namespace giada::m
+
+#endif
@@ -0,0 +1,187 @@
+/* -----------------------------------------------------------------------------
+ *
+ * Giada - Your Hardcore Loopmachine
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2022 Giovanni A. Zuliani | Monocasual Laboratories
+ *
+ * This file is part of Giada - Your Hardcore Loopmachine.
+ *
+ * Giada - Your Hardcore Loopmachine is free software: you can
+ * redistribute it and/or modify it under the terms of the GNU General
+ * Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * Giada - Your Hardcore Loopmachine is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Giada - Your Hardcore Loopmachine. If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------- */
+
+#include "core/offlineRenderer.h"
+#include "core/const.h"
+#include "core/mixer.h"
+#include "core/model/model.h"
+#include "core/sequencer.h"
+#include "deps/mcl-audio-buffer/src/audioBuffer.hpp"
+#include "utils/fs.h"
+#include "utils/log.h"
+#include <algorithm>
+#include <cassert>
+#include <sndfile.h>
+#include <utility>
+#include <vector>
+
+namespace giada::m
+{
+namespace
+{
+/* openFile_
+Opens a new audio file for writing. Returns nullptr on failure. */
+
+SNDFILE* openFile_(const std::string& path, int sampleRate)
+{
+	SF_INFO header    = {};
+	header.samplerate = sampleRate;
+	header.channels   = G_MAX_IO_CHANS;
+	header.format     = u::fs::getExt(path) == ".flac" ? SF_FORMAT_FLAC | SF_FORMAT_PCM_24 : SF_FORMAT_WAV | SF_FORMAT_FLOAT;
+
+	SNDFILE* file = sf_open(path.c_str(), SFM_WRITE, &header);
+	if (file == nullptr)
+		u::log::print("[OfflineRenderer] unable to open %s for writing: %s\n", path, sf_strerror(file));
+	return file;
+}
+} // namespace
+
+/* -------------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------- */
+
+OfflineRenderer::OfflineRenderer(model::Model& m, Sequencer& s, Mixer& mx)
+: onProcessBlock(nullptr)
+, m_model(m)
+, m_sequencer(s)
+, m_mixer(mx)
+{
+}
+
+/* -------------------------------------------------------------------------- */
+
+int OfflineRenderer::render(const Params& params, int sampleRate, int bufferSize,
+    std::function<void(float)> progress)
+{
+	assert(onProcessBlock != nullptr);
+
+	const Frame totalFrames = m_sequencer.getFramesInBar() * params.bars;
+
+	if (totalFrames <= 0 || sampleRate <= 0 || bufferSize <= 0)
+	{
+		u::log::print("[OfflineRenderer::render] nothing to render\n");
+		return G_RES_ERR_NO_DATA;
+	}
+
+	const std::string ext  = u::fs::getExt(params.path).empty() ? ".wav" : u::fs::getExt(params.path);
+	const std::string base = u::fs::stripExt(params.path);
+
+	SNDFILE* master = openFile_(base + ext, sampleRate);
+	if (master == nullptr)
+		return G_RES_ERR_IO;
+
+	std::vector<std::pair<ID, SNDFILE*>> stems;
+
+	const auto closeAll = [&master, &stems]() {
+		for (const auto& [channelId, stem] : stems)
+			sf_close(stem);
+		sf_close(master);
+	};
+
+	if (params.stems)
+	{
+		for (const Channel& ch : m_model.get().channels)
+		{
+			if (ch.isInternal())
+				continue;
+			SNDFILE* stem = openFile_(base + "-" + std::to_string(ch.id) + ext, sampleRate);
+			if (stem == nullptr)
+			{
+				closeAll();
+				return G_RES_ERR_IO;
+			}
+			stems.push_back({ch.id, stem});
+		}
+	}
+
+	u::log::print("[OfflineRenderer::render] rendering %d bars (%d frames) to %s\n",
+	    params.bars, totalFrames, base + ext);
+
+	/* Suspend the real-time rendering, then start the sequencer from the 
+	beginning. The previous state is restored at the end. */
+
+	const bool      wasActive = m_mixer.isActive();
+	const SeqStatus oldStatus = m_sequencer.getStatus();
+
+	m_mixer.disable();
+	m_sequencer.rewind();
+	m_sequencer.setStatus(SeqStatus::RUNNING);
+
+	mcl::AudioBuffer out(bufferSize, G_MAX_IO_CHANS);
+	mcl::AudioBuffer in; // No input while rendering offline
+
+	/* Any short write (e.g. disk full) aborts the render: a truncated file 
+	must not look like a successful one. */
+
+	int   res      = G_RES_OK;
+	Frame rendered = 0;
+
+	const auto write = [&res](SNDFILE* file, const float* data, Frame frames) {
+		if (sf_writef_float(file, data, frames) == frames)
+			return;
+		u::log::print("[OfflineRenderer::render] write error: %s\n", sf_strerror(file));
+		res = G_RES_ERR_IO;
+	};
+
+	while (rendered < totalFrames && res == G_RES_OK)
+	{
+		const Frame frames = std::min<Frame>(bufferSize, totalFrames - rendered);
+
+		out.clear();
+		{
+			const model::LayoutLock layoutLock = m_model.get_RT();
+			const model::Layout&    layout     = layoutLock.get();
+
+			onProcessBlock(out, in, layout);
+
+			for (const auto& [channelId, stem] : stems)
+				write(stem, layout.getChannel(channelId).shared->audioBuffer[0], frames);
+		}
+
+		write(master, out[0], frames);
+
+		rendered += frames;
+		progress(rendered / static_cast<float>(totalFrames));
+	}
+
+	m_sequencer.setStatus(oldStatus);
+	m_sequencer.rewind();
+	if (wasActive)
+		m_mixer.enable();
+
+	closeAll();
+
+	if (res != G_RES_OK)
+	{
+		u::log::print("[OfflineRenderer::render] aborted after %d frames\n", rendered);
+		return res;
+	}
+
+	u::log::print("[OfflineRenderer::render] done\n");
+
+	return G_RES_OK;
+}
+} // namespace giada::m
@@ -0,0 +1,83 @@
+/* -----------------------------------------------------------------------------
+ *
+ * Giada - Your Hardcore Loopmachine
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2022 Giovanni A. Zuliani | Monocasual Laboratories
+ *
+ * This file is part of Giada - Your Hardcore Loopmachine.
+ *
+ * Giada - Your Hardcore Loopmachine is free software: you can
+ * redistribute it and/or modify it under the terms of the GNU General
+ * Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * Giada - Your Hardcore Loopmachine is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Giada - Your Hardcore Loopmachine. If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------- */
+
+#ifndef G_OFFLINE_RENDERER_H
+#define G_OFFLINE_RENDERER_H
+
+#include "core/types.h"
+#include <functional>
+#include <string>
+
+namespace mcl
+{
+class AudioBuffer;
+}
+
+namespace giada::m::model
+{
+class Model;
+struct Layout;
+} // namespace giada::m::model
+
+namespace giada::m
+{
+class Sequencer;
+class Mixer;
+class OfflineRenderer final
+{
+public:
+	struct Params
+	{
+		std::string path;
+		int         bars  = 1;
+		bool        stems = false;
+	};
+
+	OfflineRenderer(model::Model&, Sequencer&, Mixer&);
+
+	/* render
+	Renders 'params.bars' bars of the current project to the audio file 
+	'params.path' as fast as the CPU allows, without an audio device. The file
+	format is deduced from the extension: FLAC for '.flac', WAV otherwise. If 
+	'params.stems' is true, also writes one file per channel (post plug-ins, 
+	pre fader) next to the main one. Returns G_RES_OK on success. */
+
+	int render(const Params&, int sampleRate, int bufferSize, std::function<void(float)> progress);
+
+	/* onProcessBlock
+	Callback fired for each block to render. Must run the same pipeline as the
+	real-time audio callback. */
+
+	std::function<void(mcl::AudioBuffer& out, const mcl::AudioBuffer& in, const model::Layout&)> onProcessBlock;
+
+private:
+	model::Model& m_model;
+	Sequencer&    m_sequencer;
+	Mixer&        m_mixer;
+};
+} // namespace giada::m
+
+#endif
@@ -162,6 +162,7 @@ void readChannels_(Patch::Data& patch, const nl::json& j)
 		c.midiInMute        = jchannel.value(PATCH_KEY_CHANNEL_MIDI_IN_MUTE, 0);
 		c.midiInSolo        = jchannel.value(PATCH_KEY_CHANNEL_MIDI_IN_SOLO, 0);
 		c.midiInFilter      = jchannel.value(PATCH_KEY_CHANNEL_MIDI_IN_FILTER, 0);
+		c.midiInDevice      = jchannel.value(PATCH_KEY_CHANNEL_MIDI_IN_DEVICE, -1);
 		c.midiOutL          = jchannel.value(PATCH_KEY_CHANNEL_MIDI_OUT_L, 0);
 		c.midiOutLplaying   = jchannel.value(PATCH_KEY_CHANNEL_MIDI_OUT_L_PLAYING, 0);
 		c.midiOutLmute      = jchannel.value(PATCH_KEY_CHANNEL_MIDI_OUT_L_MUTE, 0);
@@ -181,6 +182,7 @@ void readChannels_(Patch::Data& patch, const nl::json& j)
 		c.midiInPitch       = jchannel.value(PATCH_KEY_CHANNEL_MIDI_IN_PITCH, 0);
 		c.midiOut           = jchannel.value(PATCH_KEY_CHANNEL_MIDI_OUT, 0);
 		c.midiOutChan       = jchannel.value(PATCH_KEY_CHANNEL_MIDI_OUT_CHAN, 0);
+		c.midiOutDevice     = jchannel.value(PATCH_KEY_CHANNEL_MIDI_OUT_DEVICE, -1);
 
 		if (jchannel.contains(PATCH_KEY_CHANNEL_PLUGINS))
 			for (const auto& jplugin : jchannel[PATCH_KEY_CHANNEL_PLUGINS])
@@ -313,6 +315,7 @@ void writeChannels_(const Patch::Data& patch, nl::json& j)
 		jchannel[PATCH_KEY_CHANNEL_MIDI_IN_MUTE]         = c.midiInMute;
 		jchannel[PATCH_KEY_CHANNEL_MIDI_IN_SOLO]         = c.midiInSolo;
 		jchannel[PATCH_KEY_CHANNEL_MIDI_IN_FILTER]       = c.midiInFilter;
+		jchannel[PATCH_KEY_CHANNEL_MIDI_IN_DEVICE]       = c.midiInDevice;
 		jchannel[PATCH_KEY_CHANNEL_MIDI_OUT_L]           = c.midiOutL;
 		jchannel[PATCH_KEY_CHANNEL_MIDI_OUT_L_PLAYING]   = c.midiOutLplaying;
 		jchannel[PATCH_KEY_CHANNEL_MIDI_OUT_L_MUTE]      = c.midiOutLmute;
@@ -332,6 +335,7 @@ void writeChannels_(const Patch::Data& patch, nl::json& j)
 		jchannel[PATCH_KEY_CHANNEL_MIDI_IN_PITCH]        = c.midiInPitch;
 		jchannel[PATCH_KEY_CHANNEL_MIDI_OUT]             = c.midiOut;
 		jchannel[PATCH_KEY_CHANNEL_MIDI_OUT_CHAN]        = c.midiOutChan;
+		jchannel[PATCH_KEY_CHANNEL_MIDI_OUT_DEVICE]      = c.midiOutDevice;
 
 		jchannel[PATCH_KEY_CHANNEL_PLUGINS] = nl::json::array();
 		for (ID pid : c.pluginIds)
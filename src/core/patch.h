@@ -78,6 +78,7 @@ public:
 		uint32_t    midiInMute;
 		uint32_t    midiInSolo;
 		int         midiInFilter;
+		int         midiInDevice = -1;
 		bool        midiOutL;
 		uint32_t    midiOutLplaying;
 		uint32_t    midiOutLmute;
@@ -98,6 +99,7 @@ public:
 		// midi channel
 		bool            midiOut;
 		int             midiOutChan;
+		int             midiOutDevice = -1;
 		std::vector<ID> pluginIds;
 	};
 
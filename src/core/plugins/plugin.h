@@ -31,6 +31,7 @@
 #include "core/midiLearnParam.h"
 #include "core/plugins/pluginHost.h"
 #include "core/plugins/pluginState.h"
+#include "core/profiler.h"
 #include <juce_audio_processors/juce_audio_processors.h>
 #include <juce_gui_basics/juce_gui_basics.h>
 #include <memory>
@@ -116,6 +117,12 @@ public:
 
 	bool valid;
 
+	/* profile
+	CPU usage of this plug-in. Filled by PluginHost only when the Profiler is
+	enabled. */
+
+	Profiler::Stats profile;
+
 	std::function<void(int w, int h)> onEditorResize;
 
 private:
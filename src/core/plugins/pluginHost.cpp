@@ -27,9 +27,12 @@
 #include "core/plugins/pluginHost.h"
 #include "core/channels/channel.h"
 #include "core/const.h"
+#include "core/dsp/kernels.h"
 #include "core/model/model.h"
 #include "core/plugins/plugin.h"
 #include "core/plugins/pluginManager.h"
+#include "core/profiler.h"
+#include "core/renderPool.h"
 #include "deps/mcl-audio-buffer/src/audioBuffer.hpp"
 #include "utils/log.h"
 #include "utils/vector.h"
@@ -70,8 +73,9 @@ bool PluginHost::Info::canControlTransport()
 /* -------------------------------------------------------------------------- */
 /* -------------------------------------------------------------------------- */
 
-PluginHost::PluginHost(model::Model& m)
+PluginHost::PluginHost(model::Model& m, Profiler& p)
 : m_model(m)
+, m_profiler(p)
 {
 }
 
@@ -80,7 +84,9 @@ PluginHost::PluginHost(model::Model& m)
 void PluginHost::reset(int bufferSize)
 {
 	freeAllPlugins();
-	m_audioBuffer.setSize(G_MAX_IO_CHANS, bufferSize);
+	m_audioBuffers.resize(G_MAX_RENDER_THREADS + 1);
+	for (juce::AudioBuffer<float>& b : m_audioBuffers)
+		b.setSize(G_MAX_IO_CHANS, bufferSize);
 }
 
 /* -------------------------------------------------------------------------- */
@@ -88,19 +94,21 @@ void PluginHost::reset(int bufferSize)
 void PluginHost::processStack(mcl::AudioBuffer& outBuf, const std::vector<Plugin*>& plugins,
     juce::MidiBuffer* events)
 {
-	assert(outBuf.countFrames() == m_audioBuffer.getNumSamples());
+	juce::AudioBuffer<float>& tempBuf = m_audioBuffers[RenderPool::getThreadIndex()];
 
-	giadaToJuceTempBuf(outBuf);
+	assert(outBuf.countFrames() == tempBuf.getNumSamples());
+
+	giadaToJuceTempBuf(outBuf, tempBuf);
 
 	if (events == nullptr)
 	{
 		juce::MidiBuffer dummyEvents; // empty
-		processPlugins(plugins, dummyEvents);
+		processPlugins(plugins, tempBuf, dummyEvents);
 	}
 	else
-		processPlugins(plugins, *events);
+		processPlugins(plugins, tempBuf, *events);
 
-	juceToGiadaOutBuf(outBuf);
+	juceToGiadaOutBuf(outBuf, tempBuf);
 }
 
 /* -------------------------------------------------------------------------- */
@@ -144,7 +152,11 @@ void PluginHost::freeAllPlugins()
 
 void PluginHost::setPluginParameter(ID pluginId, int paramIndex, float value)
 {
-	m_model.findShared<Plugin>(pluginId)->setParameter(paramIndex, value);
+	/* Called by the Event Dispatcher: the plug-in might have been removed in 
+	the meantime. */
+
+	if (Plugin* plugin = m_model.findShared<Plugin>(pluginId); plugin != nullptr)
+		plugin->setParameter(paramIndex, value);
 }
 
 /* -------------------------------------------------------------------------- */
@@ -164,56 +176,50 @@ void PluginHost::toggleBypass(ID pluginId)
 
 /* -------------------------------------------------------------------------- */
 
-void PluginHost::giadaToJuceTempBuf(const mcl::AudioBuffer& outBuf)
+void PluginHost::giadaToJuceTempBuf(const mcl::AudioBuffer& outBuf, juce::AudioBuffer<float>& tempBuf) const
 {
-	assert(outBuf.countChannels() == m_audioBuffer.getNumChannels());
-
-	using namespace juce;
-	using Format = AudioData::Format<AudioData::Float32, AudioData::BigEndian>;
+	assert(outBuf.countChannels() == tempBuf.getNumChannels());
 
-	AudioData::deinterleaveSamples(
-	    AudioData::InterleavedSource<Format>{outBuf[0], outBuf.countChannels()},
-	    AudioData::NonInterleavedDest<Format>{m_audioBuffer.getArrayOfWritePointers(), m_audioBuffer.getNumChannels()},
-	    outBuf.countFrames());
+	dsp::deinterleave(tempBuf.getArrayOfWritePointers(), outBuf[0], outBuf.countFrames(),
+	    outBuf.countChannels());
 }
 
-void PluginHost::juceToGiadaOutBuf(mcl::AudioBuffer& outBuf) const
+void PluginHost::juceToGiadaOutBuf(mcl::AudioBuffer& outBuf, const juce::AudioBuffer<float>& tempBuf) const
 {
-	assert(outBuf.countChannels() == m_audioBuffer.getNumChannels());
+	assert(outBuf.countChannels() == tempBuf.getNumChannels());
 
-	using namespace juce;
-	using Format = AudioData::Format<AudioData::Float32, AudioData::BigEndian>;
-
-	AudioData::interleaveSamples(
-	    AudioData::NonInterleavedSource<Format>{m_audioBuffer.getArrayOfReadPointers(), m_audioBuffer.getNumChannels()},
-	    AudioData::InterleavedDest<Format>{outBuf[0], outBuf.countChannels()},
-	    outBuf.countFrames());
+	dsp::interleave(outBuf[0], tempBuf.getArrayOfReadPointers(), outBuf.countFrames(),
+	    outBuf.countChannels());
 }
 
 /* -------------------------------------------------------------------------- */
 
-void PluginHost::processPlugins(const std::vector<Plugin*>& plugins, juce::MidiBuffer& events)
+void PluginHost::processPlugins(const std::vector<Plugin*>& plugins,
+    juce::AudioBuffer<float>& tempBuf, juce::MidiBuffer& events)
 {
 	for (Plugin* p : plugins)
 	{
 		if (!p->valid || p->isSuspended() || p->isBypassed())
 			continue;
-		processPlugin(p, events);
+		processPlugin(p, tempBuf, events);
 	}
 	events.clear();
 }
 
 /* -------------------------------------------------------------------------- */
 
-void PluginHost::processPlugin(Plugin* p, const juce::MidiBuffer& events)
+void PluginHost::processPlugin(Plugin* p, juce::AudioBuffer<float>& tempBuf,
+    const juce::MidiBuffer& events)
 {
-	const Plugin::Buffer& pluginBuffer = p->process(m_audioBuffer, events);
+	Profiler::Scope scope(m_profiler, p->profile);
+
+	const Plugin::Buffer& pluginBuffer = p->process(tempBuf, events);
 	const bool            isInstrument = p->isInstrument();
 
 	/* Merge the plugin buffer back into the local one. Special care is needed
 	if audio channels mismatch. */
 
-	for (int i = 0, j = 0; i < m_audioBuffer.getNumChannels(); i++)
+	for (int i = 0, j = 0; i < tempBuf.getNumChannels(); i++)
 	{
 		/* If instrument (i.e. a plug-in that accepts MIDI and produces audio 
 		out of it), SUM the local working buffer to the main one. This allows
@@ -222,9 +228,9 @@ void PluginHost::processPlugin(Plugin* p, const juce::MidiBuffer& events)
 		working buffer is simply copied over the main one. */
 
 		if (isInstrument)
-			m_audioBuffer.addFrom(i, 0, pluginBuffer, j, 0, pluginBuffer.getNumSamples());
+			tempBuf.addFrom(i, 0, pluginBuffer, j, 0, pluginBuffer.getNumSamples());
 		else
-			m_audioBuffer.copyFrom(i, 0, pluginBuffer, j, 0, pluginBuffer.getNumSamples());
+			tempBuf.copyFrom(i, 0, pluginBuffer, j, 0, pluginBuffer.getNumSamples());
 		if (i < p->countMainOutChannels() - 1)
 			j++;
 	}
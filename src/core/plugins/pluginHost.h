@@ -32,6 +32,7 @@
 #include <juce_audio_basics/juce_audio_basics.h>
 #include <juce_gui_basics/juce_gui_basics.h>
 #include <memory>
+#include <vector>
 
 namespace mcl
 {
@@ -51,6 +52,7 @@ class Model;
 namespace giada::m
 {
 class Sequencer;
+class Profiler;
 class PluginHost final
 {
 public:
@@ -67,7 +69,7 @@ public:
 		int              m_sampleRate;
 	};
 
-	PluginHost(model::Model&);
+	PluginHost(model::Model&, Profiler&);
 
 	/* reset
 	Brings everything back to the initial state. */
@@ -112,23 +114,30 @@ public:
 
 private:
 	/* giadaToJuceTempBuf
-	Copies the Giada buffer 'outBuf' to the private JUCE buffer for local
-	processing. */
+	Copies the Giada buffer 'outBuf' to the private JUCE buffer 'tempBuf' for 
+	local processing. */
 
-	void giadaToJuceTempBuf(const mcl::AudioBuffer& outBuf);
+	void giadaToJuceTempBuf(const mcl::AudioBuffer& outBuf, juce::AudioBuffer<float>& tempBuf) const;
 
 	/* juceToGiadaOutBuf
-	Copies the private JUCE buffer to Giada buffer 'outBuf'. */
+	Copies the private JUCE buffer 'tempBuf' to Giada buffer 'outBuf'. */
 
-	void juceToGiadaOutBuf(mcl::AudioBuffer& outBuf) const;
+	void juceToGiadaOutBuf(mcl::AudioBuffer& outBuf, const juce::AudioBuffer<float>& tempBuf) const;
 
-	void processPlugins(const std::vector<Plugin*>&, juce::MidiBuffer& events);
+	void processPlugins(const std::vector<Plugin*>&, juce::AudioBuffer<float>& tempBuf,
+	    juce::MidiBuffer& events);
 
-	void processPlugin(Plugin*, const juce::MidiBuffer& events);
+	void processPlugin(Plugin*, juce::AudioBuffer<float>& tempBuf, const juce::MidiBuffer& events);
 
 	model::Model& m_model;
+	Profiler&     m_profiler;
 
-	juce::AudioBuffer<float> m_audioBuffer;
+	/* m_audioBuffers
+	Private JUCE working buffers, one for each rendering thread (see 
+	RenderPool::getThreadIndex()), so that plug-in stacks of different channels
+	can be processed in parallel. */
+
+	std::vector<juce::AudioBuffer<float>> m_audioBuffers;
 };
 } // namespace giada::m
 
@@ -0,0 +1,267 @@
+/* -----------------------------------------------------------------------------
+ *
+ * Giada - Your Hardcore Loopmachine
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2022 Giovanni A. Zuliani | Monocasual Laboratories
+ *
+ * This file is part of Giada - Your Hardcore Loopmachine.
+ *
+ * Giada - Your Hardcore Loopmachine is free software: you can
+ * redistribute it and/or modify it under the terms of the GNU General
+ * Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * Giada - Your Hardcore Loopmachine is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Giada - Your Hardcore Loopmachine. If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------- */
+
+#include "core/profiler.h"
+#include <algorithm>
+#include <cmath>
+
+namespace giada::m
+{
+namespace
+{
+/* SMOOTHING
+Weight of the newest sample in the exponential moving average. At 44.1 kHz and
+256 frames, roughly half a second of history. */
+
+constexpr float SMOOTHING = 0.02f;
+} // namespace
+
+/* -------------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------- */
+
+Profiler::Stats::Stats(const Stats& o)
+: m_average(o.getAverage())
+, m_peak(o.getPeak())
+, m_overruns(o.getOverruns())
+{
+}
+
+/* -------------------------------------------------------------------------- */
+
+Profiler::Stats& Profiler::Stats::operator=(const Stats& o)
+{
+	if (this == &o)
+		return *this;
+	m_average.store(o.getAverage(), std::memory_order_relaxed);
+	m_peak.store(o.getPeak(), std::memory_order_relaxed);
+	m_overruns.store(o.getOverruns(), std::memory_order_relaxed);
+	return *this;
+}
+
+/* -------------------------------------------------------------------------- */
+
+float    Profiler::Stats::getAverage() const { return m_average.load(std::memory_order_relaxed); }
+float    Profiler::Stats::getPeak() const { return m_peak.load(std::memory_order_relaxed); }
+uint32_t Profiler::Stats::getOverruns() const { return m_overruns.load(std::memory_order_relaxed); }
+
+/* -------------------------------------------------------------------------- */
+
+void Profiler::Stats::add(float load)
+{
+	/* Single writer: plain load/store pairs are enough, no RMW needed. */
+
+	const float average = getAverage();
+	m_average.store(average + SMOOTHING * (load - average), std::memory_order_relaxed);
+	m_peak.store(std::max(getPeak(), load), std::memory_order_relaxed);
+	if (load > 1.0f)
+		m_overruns.store(getOverruns() + 1, std::memory_order_relaxed);
+}
+
+/* -------------------------------------------------------------------------- */
+
+void Profiler::Stats::reset()
+{
+	m_average.store(0.0f, std::memory_order_relaxed);
+	m_peak.store(0.0f, std::memory_order_relaxed);
+	m_overruns.store(0, std::memory_order_relaxed);
+}
+
+/* -------------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------- */
+
+uint32_t Profiler::Histogram::getCount() const
+{
+	uint32_t count = 0;
+	for (const std::atomic<uint32_t>& b : m_buckets)
+		count += b.load(std::memory_order_relaxed);
+	return count;
+}
+
+uint32_t Profiler::Histogram::getCount(std::size_t bucket) const
+{
+	return m_buckets[bucket].load(std::memory_order_relaxed);
+}
+
+/* -------------------------------------------------------------------------- */
+
+uint64_t Profiler::Histogram::getPercentile(float p) const
+{
+	const uint32_t count = getCount();
+	if (count == 0)
+		return 0;
+
+	const uint32_t target = std::max<uint32_t>(1, std::ceil(count * std::clamp(p, 0.0f, 1.0f)));
+
+	uint32_t sum = 0;
+	for (std::size_t i = 0; i < BUCKETS; i++)
+	{
+		sum += getCount(i);
+		if (sum >= target)
+			return uint64_t{1} << i;
+	}
+	return uint64_t{1} << (BUCKETS - 1);
+}
+
+/* -------------------------------------------------------------------------- */
+
+void Profiler::Histogram::add(Clock::duration d)
+{
+	const auto us = std::chrono::duration_cast<std::chrono::microseconds>(d).count();
+
+	std::size_t bucket = 0;
+	while (bucket < BUCKETS - 1 && us >= (int64_t{1} << bucket))
+		bucket++;
+
+	/* Single writer: no RMW needed. */
+
+	m_buckets[bucket].store(getCount(bucket) + 1, std::memory_order_relaxed);
+}
+
+/* -------------------------------------------------------------------------- */
+
+void Profiler::Histogram::reset()
+{
+	for (std::atomic<uint32_t>& b : m_buckets)
+		b.store(0, std::memory_order_relaxed);
+}
+
+/* -------------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------- */
+
+Profiler::Scope::Scope(const Profiler& p, Stats& s)
+: m_profiler(p)
+, m_stats(p.isEnabled() ? &s : nullptr)
+{
+	if (m_stats != nullptr)
+		m_start = Clock::now();
+}
+
+/* -------------------------------------------------------------------------- */
+
+Profiler::Scope::Scope(Profiler& p, Stage s)
+: Scope(p, p.getStage(s))
+{
+}
+
+/* -------------------------------------------------------------------------- */
+
+Profiler::Scope::~Scope()
+{
+	if (m_stats != nullptr)
+		m_stats->add(m_profiler.toLoad(Clock::now() - m_start));
+}
+
+/* -------------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------- */
+
+Profiler::Profiler()
+: m_enabled(false)
+, m_budgetNs(0.0)
+, m_xruns(0)
+{
+}
+
+/* -------------------------------------------------------------------------- */
+
+bool Profiler::isEnabled() const
+{
+	return m_enabled.load(std::memory_order_relaxed);
+}
+
+uint32_t Profiler::getXruns() const
+{
+	return m_xruns.load(std::memory_order_relaxed);
+}
+
+/* -------------------------------------------------------------------------- */
+
+const Profiler::Stats& Profiler::getStage(Stage s) const
+{
+	return m_stages[static_cast<std::size_t>(s)];
+}
+
+Profiler::Stats& Profiler::getStage(Stage s)
+{
+	return m_stages[static_cast<std::size_t>(s)];
+}
+
+/* -------------------------------------------------------------------------- */
+
+const Profiler::Histogram& Profiler::getEventLatency() const { return m_eventLatency; }
+Profiler::Histogram&       Profiler::getEventLatency() { return m_eventLatency; }
+
+/* -------------------------------------------------------------------------- */
+
+void Profiler::setEnabled(bool v)
+{
+	if (v)
+		reset();
+	m_enabled.store(v, std::memory_order_relaxed);
+}
+
+/* -------------------------------------------------------------------------- */
+
+void Profiler::setBudget(int bufferSize, int sampleRate)
+{
+	if (sampleRate <= 0)
+		return;
+	m_budgetNs.store(bufferSize * 1e9 / sampleRate, std::memory_order_relaxed);
+}
+
+/* -------------------------------------------------------------------------- */
+
+void Profiler::notifyXrun()
+{
+	m_xruns.fetch_add(1, std::memory_order_relaxed);
+}
+
+/* -------------------------------------------------------------------------- */
+
+void Profiler::reset()
+{
+	for (Stats& s : m_stages)
+		s.reset();
+	m_eventLatency.reset();
+	m_xruns.store(0, std::memory_order_relaxed);
+
+	if (onReset != nullptr)
+		onReset();
+}
+
+/* -------------------------------------------------------------------------- */
+
+float Profiler::toLoad(Clock::duration d) const
+{
+	const double budget = m_budgetNs.load(std::memory_order_relaxed);
+	if (budget <= 0.0)
+		return 0.0f;
+	return static_cast<float>(std::chrono::duration<double, std::nano>(d).count() / budget);
+}
+} // namespace giada::m
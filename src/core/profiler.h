@@ -0,0 +1,192 @@
+/* -----------------------------------------------------------------------------
+ *
+ * Giada - Your Hardcore Loopmachine
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2022 Giovanni A. Zuliani | Monocasual Laboratories
+ *
+ * This file is part of Giada - Your Hardcore Loopmachine.
+ *
+ * Giada - Your Hardcore Loopmachine is free software: you can
+ * redistribute it and/or modify it under the terms of the GNU General
+ * Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * Giada - Your Hardcore Loopmachine is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Giada - Your Hardcore Loopmachine. If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------- */
+
+#ifndef G_PROFILER_H
+#define G_PROFILER_H
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+
+namespace giada::m
+{
+/* Profiler
+Lightweight CPU accounting for the audio thread. Measures the time spent in
+each stage of the block (and optionally in each channel and plug-in) and
+expresses it as a fraction of the real-time budget, i.e. the duration of a 
+block at the current sample rate. All measurements are skipped with a single
+relaxed atomic load when profiling is disabled. */
+
+class Profiler final
+{
+public:
+	using Clock = std::chrono::steady_clock;
+
+	enum class Stage : std::size_t
+	{
+		BLOCK = 0, // Whole audio callback
+		SEQUENCER, // Sequencer advance and channel reactions
+		CHANNELS,  // Channel rendering, plug-ins included
+		OUTPUT,    // Master channels, preview and output finalization
+		COUNT
+	};
+
+	/* Stats
+	Running statistics for a single measured entity. Written by one thread at a
+	time (the one rendering the entity), read by the UI thread. Loads are 
+	fractions of the block budget: 1.0 means the whole block was spent there. */
+
+	class Stats
+	{
+	public:
+		Stats() = default;
+		Stats(const Stats&);
+		Stats& operator=(const Stats&);
+
+		float    getAverage() const;
+		float    getPeak() const;
+		uint32_t getOverruns() const;
+
+		void add(float load);
+		void reset();
+
+	private:
+		std::atomic<float>    m_average  = 0.0f;
+		std::atomic<float>    m_peak     = 0.0f;
+		std::atomic<uint32_t> m_overruns = 0;
+	};
+
+	/* Histogram
+	Distribution of durations, in power-of-two buckets: bucket 0 holds anything
+	below 1 us, bucket i holds [2^(i-1), 2^i) us. Written by one thread, read by
+	any other. */
+
+	class Histogram
+	{
+	public:
+		static constexpr std::size_t BUCKETS = 24; // Last one: 4 s and above
+
+		Histogram() = default;
+
+		uint32_t getCount() const;
+		uint32_t getCount(std::size_t bucket) const;
+
+		/* getPercentile
+		Returns the upper bound, in microseconds, of the bucket where the 
+		percentile 'p' (0.0 - 1.0) falls. Returns 0 if empty. */
+
+		uint64_t getPercentile(float p) const;
+
+		void add(Clock::duration);
+		void reset();
+
+	private:
+		std::array<std::atomic<uint32_t>, BUCKETS> m_buckets = {};
+	};
+
+	/* Scope
+	RAII helper: measures the lifetime of the object and feeds the result into
+	a Stats object. Does nothing if the profiler is disabled. */
+
+	class Scope
+	{
+	public:
+		Scope(const Profiler&, Stats&);
+		Scope(Profiler&, Stage);
+		~Scope();
+
+		Scope(const Scope&) = delete;
+		Scope& operator=(const Scope&) = delete;
+
+	private:
+		const Profiler&   m_profiler;
+		Stats*            m_stats;
+		Clock::time_point m_start;
+	};
+
+	Profiler();
+
+	bool     isEnabled() const;
+	uint32_t getXruns() const;
+
+	/* getStage
+	Returns statistics for the given block stage. */
+
+	const Stats& getStage(Stage) const;
+	Stats&       getStage(Stage);
+
+	/* getEventLatency
+	Returns the distribution of the time taken by events (key presses, MIDI 
+	notes, ...) to go from the Event Dispatcher queues to the channels. */
+
+	const Histogram& getEventLatency() const;
+	Histogram&       getEventLatency();
+
+	/* setEnabled
+	Enables or disables the profiler. Statistics are reset on enable. */
+
+	void setEnabled(bool);
+
+	/* setBudget
+	Sets the real-time budget of a single block, given the current audio 
+	settings. */
+
+	void setBudget(int bufferSize, int sampleRate);
+
+	/* notifyXrun
+	Records a buffer over/underflow reported by the audio driver. */
+
+	void notifyXrun();
+
+	/* reset
+	Clears block stages, event latency and xrun statistics, then fires 
+	'onReset' for the statistics the Profiler doesn't own. */
+
+	void reset();
+
+	/* onReset
+	Callback fired by reset(). Clears per-channel and per-plug-in statistics, 
+	which live in the model. */
+
+	std::function<void()> onReset;
+
+private:
+	/* toLoad
+	Converts an elapsed time into a fraction of the block budget. */
+
+	float toLoad(Clock::duration) const;
+
+	std::atomic<bool>                                         m_enabled;
+	std::atomic<double>                                       m_budgetNs;
+	std::atomic<uint32_t>                                     m_xruns;
+	std::array<Stats, static_cast<std::size_t>(Stage::COUNT)> m_stages;
+	Histogram                                                 m_eventLatency;
+};
+} // namespace giada::m
+
+#endif
@@ -75,6 +75,11 @@ public:
 		return true;
 	}
 
+	bool isEmpty() const
+	{
+		return m_head.load() == m_tail.load();
+	}
+
 private:
 	std::size_t increment(std::size_t i) const
 	{
@@ -32,6 +32,7 @@
 #include "core/types.h"
 #include "src/core/actions/actionRecorder.h"
 #include "src/core/actions/actions.h"
+#include <utility>
 
 namespace giada::m
 {
@@ -100,7 +101,7 @@ void Recorder::stopActionRec(ActionRecorder& actionRecorder)
 
 	for (ID id : channels)
 	{
-		Channel& ch = m_model.get().getChannel(id);
+		const Channel& ch = std::as_const(m_model).get().getChannel(id);
 		ch.shared->readActions.store(true);
 		ch.shared->recStatus.store(ChannelStatus::PLAY);
 		if (ch.type == ChannelType::MIDI)
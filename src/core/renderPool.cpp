@@ -0,0 +1,269 @@
+/* -----------------------------------------------------------------------------
+ *
+ * Giada - Your Hardcore Loopmachine
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2022 Giovanni A. Zuliani | Monocasual Laboratories
+ *
+ * This file is part of Giada - Your Hardcore Loopmachine.
+ *
+ * Giada - Your Hardcore Loopmachine is free software: you can
+ * redistribute it and/or modify it under the terms of the GNU General
+ * Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * Giada - Your Hardcore Loopmachine is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Giada - Your Hardcore Loopmachine. If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------- */
+
+#include "core/renderPool.h"
+#include "core/const.h"
+#include "utils/log.h"
+#include <algorithm>
+#include <cassert>
+#include <chrono>
+#if defined(G_OS_WINDOWS)
+#include <windows.h>
+#else
+#include <pthread.h>
+#include <sched.h>
+#endif
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#include <immintrin.h>
+#define G_RENDER_POOL_HAS_PAUSE
+#endif
+
+namespace giada::m
+{
+namespace
+{
+/* SPIN_COUNT
+Number of busy-wait iterations an idle worker performs before going to sleep.
+Keeps wakeup latency low when blocks come in quickly. */
+
+constexpr int SPIN_COUNT = 2000;
+
+/* IDLE_TIMEOUT
+Upper bound for an idle worker's sleep. Workers are woken up as soon as a new
+batch comes in: this is just a fallback in case a wakeup gets lost (see
+RenderPool::wakeWorkers()), which would only cost some parallelism, never a
+deadlock, since the caller can run the whole batch by itself. */
+
+constexpr auto IDLE_TIMEOUT = std::chrono::milliseconds(100);
+
+thread_local int t_threadIndex = 0;
+
+/* -------------------------------------------------------------------------- */
+
+void pause_()
+{
+#ifdef G_RENDER_POOL_HAS_PAUSE
+	_mm_pause();
+#endif
+}
+
+/* -------------------------------------------------------------------------- */
+
+void setRealtimePriority_()
+{
+#if defined(G_OS_WINDOWS)
+	if (SetThreadPriority(GetCurrentThread(), THREAD_PRIORITY_TIME_CRITICAL) == 0)
+		u::log::print("[RenderPool] Can't set real-time priority for worker thread\n");
+#else
+	sched_param param;
+	param.sched_priority = (std::max)(sched_get_priority_min(SCHED_FIFO), sched_get_priority_max(SCHED_FIFO) - 10);
+	if (pthread_setschedparam(pthread_self(), SCHED_FIFO, &param) != 0)
+		u::log::print("[RenderPool] Can't set real-time priority for worker thread\n");
+#endif
+}
+} // namespace
+
+/* -------------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------- */
+
+RenderPool::RenderPool()
+: m_running(false)
+, m_batch(0)
+, m_done(0)
+, m_job(nullptr)
+, m_ctx(nullptr)
+, m_parked(0)
+{
+}
+
+/* -------------------------------------------------------------------------- */
+
+RenderPool::~RenderPool()
+{
+	stop();
+}
+
+/* -------------------------------------------------------------------------- */
+
+void RenderPool::start(int numThreads)
+{
+	stop();
+
+	numThreads = std::clamp(numThreads, 0, G_MAX_RENDER_THREADS);
+	if (numThreads == 0)
+	{
+		u::log::print("[RenderPool::start] parallel rendering disabled\n");
+		return;
+	}
+
+	m_running.store(true);
+	for (int i = 0; i < numThreads; i++)
+		m_threads.emplace_back([this, i]() { work(i + 1); });
+
+	u::log::print("[RenderPool::start] parallel rendering enabled, %d worker threads\n", numThreads);
+}
+
+/* -------------------------------------------------------------------------- */
+
+void RenderPool::stop()
+{
+	if (m_threads.empty())
+		return;
+
+	m_running.store(false);
+	{
+		std::scoped_lock lock(m_mutex);
+	}
+	m_cond.notify_all();
+	for (std::thread& t : m_threads)
+		t.join();
+	m_threads.clear();
+}
+
+/* -------------------------------------------------------------------------- */
+
+bool RenderPool::isEnabled() const
+{
+	return !m_threads.empty();
+}
+
+/* -------------------------------------------------------------------------- */
+
+int RenderPool::getThreadIndex()
+{
+	return t_threadIndex;
+}
+
+/* -------------------------------------------------------------------------- */
+
+void RenderPool::runImpl(std::size_t count, Job job, void* ctx)
+{
+	if (!isEnabled() || count <= 1)
+	{
+		for (std::size_t i = 0; i < count; i++)
+			job(ctx, i);
+		return;
+	}
+
+	assert(count <= FIELD_MASK);
+
+	/* Job and context can be safely written here: workers only read them after
+	having claimed a job from the new batch below, which is published with
+	release semantics. */
+
+	m_job = job;
+	m_ctx = ctx;
+	m_done.store(0, std::memory_order_relaxed);
+
+	const uint64_t gen = (m_batch.load(std::memory_order_relaxed) >> GEN_SHIFT) + 1;
+	m_batch.store((gen << GEN_SHIFT) | (static_cast<uint64_t>(count) << COUNT_SHIFT));
+	wakeWorkers();
+
+	/* Take part in the work, then wait for jobs claimed by other workers. */
+
+	consume();
+	while (m_done.load(std::memory_order_acquire) < count)
+		pause_();
+}
+
+/* -------------------------------------------------------------------------- */
+
+void RenderPool::consume()
+{
+	uint64_t batch = m_batch.load(std::memory_order_acquire);
+	while (true)
+	{
+		const uint64_t next  = batch & FIELD_MASK;
+		const uint64_t count = (batch >> COUNT_SHIFT) & FIELD_MASK;
+
+		if (next >= count)
+			return;
+		if (!m_batch.compare_exchange_weak(batch, batch + 1, std::memory_order_acq_rel, std::memory_order_acquire))
+			continue;
+
+		m_job(m_ctx, static_cast<std::size_t>(next));
+		m_done.fetch_add(1, std::memory_order_release);
+
+		batch = m_batch.load(std::memory_order_acquire);
+	}
+}
+
+/* -------------------------------------------------------------------------- */
+
+void RenderPool::work(int index)
+{
+	t_threadIndex = index;
+	setRealtimePriority_();
+
+	/* Sequentially consistent load: it pairs with the store of a new batch and 
+	the m_parked counter in wakeWorkers(), so that either the worker sees the
+	new batch or the caller sees the worker parked. */
+
+	auto hasNewBatch = [this](uint64_t gen) {
+		return (m_batch.load() >> GEN_SHIFT) != gen;
+	};
+
+	while (m_running.load())
+	{
+		const uint64_t gen = m_batch.load(std::memory_order_acquire) >> GEN_SHIFT;
+
+		consume();
+
+		for (int i = 0; i < SPIN_COUNT && !hasNewBatch(gen); i++)
+			pause_();
+
+		if (hasNewBatch(gen))
+			continue;
+
+		std::unique_lock<std::mutex> lock(m_mutex);
+		m_parked.fetch_add(1);
+		m_cond.wait_for(lock, IDLE_TIMEOUT, [this, &hasNewBatch, gen]() {
+			return hasNewBatch(gen) || !m_running.load();
+		});
+		m_parked.fetch_sub(1);
+	}
+}
+
+/* -------------------------------------------------------------------------- */
+
+void RenderPool::wakeWorkers()
+{
+	/* Workers busy or spinning will pick up the new batch by themselves: skip
+	the system call entirely. */
+
+	if (m_parked.load() == 0)
+		return;
+
+	/* Same as Worker::notify(): going through the mutex guarantees that a 
+	parked worker is either before its predicate check (and will see the new 
+	batch) or already blocked (and will get the signal). */
+
+	if (m_mutex.try_lock())
+		m_mutex.unlock();
+	m_cond.notify_all();
+}
+} // namespace giada::m
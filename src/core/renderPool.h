@@ -0,0 +1,133 @@
+/* -----------------------------------------------------------------------------
+ *
+ * Giada - Your Hardcore Loopmachine
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2022 Giovanni A. Zuliani | Monocasual Laboratories
+ *
+ * This file is part of Giada - Your Hardcore Loopmachine.
+ *
+ * Giada - Your Hardcore Loopmachine is free software: you can
+ * redistribute it and/or modify it under the terms of the GNU General
+ * Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * Giada - Your Hardcore Loopmachine is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Giada - Your Hardcore Loopmachine. If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------- */
+
+#ifndef G_RENDER_POOL_H
+#define G_RENDER_POOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace giada::m
+{
+/* RenderPool
+A pool of pre-spawned worker threads that execute a batch of independent jobs
+in parallel, with the calling thread (usually the audio one) taking part in the
+work. Jobs are claimed through a single atomic counter, so no memory is 
+allocated and no lock is taken on the caller side. */
+
+class RenderPool final
+{
+public:
+	RenderPool();
+	~RenderPool();
+
+	/* start
+	Spawns 'numThreads' worker threads. Zero threads disables the pool: run()
+	will then execute all jobs serially on the calling thread. */
+
+	void start(int numThreads);
+
+	/* stop
+	Joins all worker threads. Don't call this while run() is in progress. */
+
+	void stop();
+
+	/* isEnabled
+	True if there is at least one worker thread available. */
+
+	bool isEnabled() const;
+
+	/* run
+	Executes 'f(i)' for each i in [0, count) across the workers and the calling
+	thread. Returns when all jobs are done. 'f' must stay alive for the whole 
+	call. */
+
+	template <typename F>
+	void run(std::size_t count, F& f)
+	{
+		runImpl(count, [](void* ctx, std::size_t i) { (*static_cast<F*>(ctx))(i); }, &f);
+	}
+
+	/* getThreadIndex
+	Returns the index of the calling thread: 0 for any thread outside the pool
+	(e.g. the audio thread), [1, numThreads] for workers. Useful to pick a 
+	per-thread working buffer. */
+
+	static int getThreadIndex();
+
+private:
+	using Job = void (*)(void*, std::size_t);
+
+	/* Batch word layout: [ generation (32 bits) | count (16 bits) | next (16 bits) ].
+	Packing everything in a single atomic word makes sure a worker can only 
+	claim jobs from the batch it has seen. */
+
+	static constexpr uint64_t COUNT_SHIFT = 16;
+	static constexpr uint64_t GEN_SHIFT   = 32;
+	static constexpr uint64_t FIELD_MASK  = 0xFFFF;
+
+	void runImpl(std::size_t count, Job, void* ctx);
+
+	/* consume
+	Claims and executes jobs until the current batch is exhausted. */
+
+	void consume();
+
+	/* work
+	Main loop of each worker thread. */
+
+	void work(int index);
+
+	/* wakeWorkers
+	Wakes up workers sleeping on m_cond, if any. Never blocks, so it's safe to
+	call from the audio thread. */
+
+	void wakeWorkers();
+
+	std::vector<std::thread> m_threads;
+	std::atomic<bool>        m_running;
+	std::atomic<uint64_t>    m_batch;
+	std::atomic<std::size_t> m_done;
+	Job                      m_job;
+	void*                    m_ctx;
+
+	/* m_mutex, m_cond, m_parked
+	Used only by idle workers to sleep between blocks. m_parked counts the 
+	workers sleeping (or about to) on m_cond, so that the caller signals the
+	condition variable only when someone is actually waiting on it. */
+
+	std::mutex              m_mutex;
+	std::condition_variable m_cond;
+	std::atomic<int>        m_parked;
+};
+} // namespace giada::m
+
+#endif
@@ -34,6 +34,7 @@
 #include "core/synchronizer.h"
 #include "utils/log.h"
 #include "utils/math.h"
+#include <algorithm>
 
 namespace giada::m
 {
@@ -52,6 +53,9 @@ Sequencer::Sequencer(model::Model& m, Synchronizer& s, JackTransport& j)
 , m_model(m)
 , m_synchronizer(s)
 , m_jackTransport(j)
+, m_parsedEvents(0)
+, m_actionBuckets(G_MAX_SEQUENCER_BUCKETS)
+, m_tempoMap(0)
 , m_quantizerStep(1)
 {
 	quantizer.schedule(Q_ACTION_REWIND, [this](Frame delta) { rewindQ(delta); });
@@ -157,6 +161,22 @@ void Sequencer::react(const EventDispatcher::EventBuffer& events, int sampleRate
 			break;
 #endif
 
+		case EventDispatcher::EventType::SEQUENCER_START_CLOCK:
+			rawStart();
+			break;
+
+		case EventDispatcher::EventType::SEQUENCER_STOP_CLOCK:
+			rawStop();
+			break;
+
+		case EventDispatcher::EventType::SEQUENCER_REWIND_CLOCK:
+			rawRewind();
+			break;
+
+		case EventDispatcher::EventType::SEQUENCER_BPM_CLOCK:
+			rawSetBpm(std::get<float>(e.data), sampleRate);
+			break;
+
 		default:
 			break;
 		}
@@ -165,54 +185,110 @@ void Sequencer::react(const EventDispatcher::EventBuffer& events, int sampleRate
 
 /* -------------------------------------------------------------------------- */
 
-const Sequencer::EventBuffer& Sequencer::advance(Frame bufferSize, const ActionRecorder& actionRecorder)
+void Sequencer::advance(Frame bufferSize, const ActionRecorder& actionRecorder)
 {
 	m_eventBuffer.clear();
 
 	const model::Sequencer& sequencer = m_model.get().sequencer;
 
+	/* Fetch the actions once: another thread might publish a new Map while the
+	block is being parsed. */
+
+	const ActionMap& actions = actionRecorder.getAll();
+
+	m_tempoMap = sequencer.getTempoMap();
+
 	const Frame start        = sequencer.a_getCurrentFrame();
 	const Frame end          = start + bufferSize;
 	const Frame framesInLoop = sequencer.framesInLoop;
-	const Frame framesInBar  = sequencer.framesInBar;
 	const Frame framesInBeat = sequencer.framesInBeat;
 	const Frame nextFrame    = end % framesInLoop;
 	const int   nextBeat     = nextFrame / framesInBeat;
 
-	/* Process events in the current block. */
+	/* Process events in the current block. The block is split in two (or more,
+	with very short loops) when it wraps around 'framesInLoop'. */
+
+	const Frame first     = start % framesInLoop;
+	const Frame remaining = std::max(0, bufferSize - (framesInLoop - first)); // Past the first wrap
+	const Frame ranges    = 1 + u::math::ceilToMultiple(remaining, framesInLoop) / framesInLoop;
 
-	for (Frame i = start, local = 0; i < end; i++, local++)
+	m_actionBuckets.clear(actions, static_cast<std::size_t>(ranges));
+
+	Frame global = first;
+	for (Frame local = 0; local < bufferSize;)
 	{
+		const Frame length = std::min(bufferSize - local, framesInLoop - global);
+		parseRange(Range<Frame>(global, global + length), local);
+		local += length;
+		global = 0;
+	}
+
+	m_parsedEvents = m_eventBuffer.size();
 
-		Frame global = i % framesInLoop; // wraps around 'framesInLoop'
+	m_actionBuckets.sort();
 
-		if (global == 0)
+	/* Advance this and quantizer after the event parsing. */
+
+	sequencer.a_setCurrentFrame(nextFrame);
+	sequencer.a_setCurrentBeat(nextBeat);
+	quantizer.advance(Range<Frame>(start, end), getQuantizerStep());
+}
+
+/* -------------------------------------------------------------------------- */
+
+Sequencer::ChannelEvents Sequencer::getChannelEvents(ID channelId) const
+{
+	const auto [first, last] = m_actionBuckets.get(channelId);
+	return {&m_eventBuffer, m_parsedEvents, first, last, m_tempoMap};
+}
+
+/* -------------------------------------------------------------------------- */
+
+void Sequencer::parseRange(Range<Frame> range, Frame delta)
+{
+	const model::Sequencer& sequencer = m_model.get().sequencer;
+
+	const Frame framesInBar  = sequencer.framesInBar;
+	const Frame framesInBeat = sequencer.framesInBeat;
+	const Frame begin        = range.getBegin();
+	const Frame end          = range.getEnd();
+
+	/* Beat and bar boundaries are found arithmetically. */
+
+	Frame nextBeat = u::math::ceilToMultiple(begin, framesInBeat);
+	Frame nextBar  = u::math::ceilToMultiple(begin, framesInBar);
+
+	for (Frame boundary = std::min(nextBeat, nextBar); boundary < end; boundary = std::min(nextBeat, nextBar))
+	{
+		const Frame local = delta + boundary - begin;
+
+		if (boundary == 0)
 		{
-			m_eventBuffer.push_back({EventType::FIRST_BEAT, global, local});
+			m_eventBuffer.push_back({EventType::FIRST_BEAT, boundary, local});
 			m_metronome.trigger(Metronome::Click::BEAT, local);
 		}
-		else if (global % framesInBar == 0)
+		else if (boundary == nextBar)
 		{
-			m_eventBuffer.push_back({EventType::BAR, global, local});
+			m_eventBuffer.push_back({EventType::BAR, boundary, local});
 			m_metronome.trigger(Metronome::Click::BAR, local);
 		}
-		else if (global % framesInBeat == 0)
+		else
 		{
 			m_metronome.trigger(Metronome::Click::BEAT, local);
 		}
 
-		const std::vector<Action>* as = actionRecorder.getActionsOnFrame(global);
-		if (as != nullptr)
-			m_eventBuffer.push_back({EventType::ACTIONS, global, local, as});
+		if (boundary == nextBeat)
+			nextBeat += framesInBeat;
+		if (boundary == nextBar)
+			nextBar += framesInBar;
 	}
 
-	/* Advance this and quantizer after the event parsing. */
-
-	sequencer.a_setCurrentFrame(nextFrame);
-	sequencer.a_setCurrentBeat(nextBeat);
-	quantizer.advance(Range<Frame>(start, end), getQuantizerStep());
+	/* Bucket actions by channel. Channels then merge their own bucket with the
+	events above. toTick(f) is the first tick on frame 'f', so ticks in 
+	[toTick(begin), toTick(end)) are exactly those falling on frames 
+	[begin, end). */
 
-	return m_eventBuffer;
+	m_actionBuckets.add(m_tempoMap.toTick(begin), m_tempoMap.toTick(end), begin, delta);
 }
 
 /* -------------------------------------------------------------------------- */
@@ -322,18 +398,14 @@ void Sequencer::setBpm(float b, int sampleRate)
 
 void Sequencer::rawSetBpm(float v, int sampleRate)
 {
-	assert(onBpmChange != nullptr);
-
-	const float oldVal = m_model.get().sequencer.bpm;
-	const float newVal = v;
+	/* Actions are stored in ticks: they follow the new tempo without being 
+	touched. */
 
-	m_model.get().sequencer.bpm = newVal;
+	m_model.get().sequencer.bpm = v;
 	recomputeFrames(sampleRate);
 	m_model.swap(model::SwapType::HARD);
 
-	onBpmChange(oldVal, newVal, m_quantizerStep);
-
-	u::log::print("[clock::rawSetBpm] Bpm changed to %f\n", newVal);
+	u::log::print("[clock::rawSetBpm] Bpm changed to %f\n", v);
 }
 /* -------------------------------------------------------------------------- */
 
@@ -27,9 +27,13 @@
 #ifndef G_SEQUENCER_H
 #define G_SEQUENCER_H
 
+#include "core/actions/actionBuckets.h"
+#include "core/actions/actionMap.h"
 #include "core/eventDispatcher.h"
 #include "core/metronome.h"
 #include "core/quantizer.h"
+#include "core/range.h"
+#include "core/tempoMap.h"
 #include <vector>
 
 namespace mcl
@@ -61,14 +65,58 @@ public:
 
 	struct Event
 	{
-		EventType                  type    = EventType::NONE;
-		Frame                      global  = 0;
-		Frame                      delta   = 0;
-		const std::vector<Action>* actions = nullptr;
+		EventType       type   = EventType::NONE;
+		Frame           global = 0;
+		Frame           delta  = 0;
+		ActionMap::View actions;
 	};
 
 	using EventBuffer = RingBuffer<Event, G_MAX_SEQUENCER_EVENTS>;
 
+	/* ChannelEvents
+	Events of the current block addressed to a single channel: the ones shared 
+	by all channels (beats, bars, rewinds) plus the channel's own actions. */
+
+	struct ChannelEvents
+	{
+		/* forEach
+		Calls 'f' on each event, sorted by delta. Shared events come first when 
+		on the same frame, while those added after parsing (i.e. quantized
+		rewinds) come last. Actions are delivered as ACTIONS events, one per 
+		tick. */
+
+		template <typename F>
+		void forEach(F&& f) const
+		{
+			auto event  = events->begin();
+			auto parsed = events->begin() + parsedEvents;
+
+			for (auto it = first; it != last; ++it)
+			{
+				ActionMap::View rest = it->actions;
+				while (!rest.empty())
+				{
+					const auto [group, next] = rest.splitFirstTick();
+					const Frame global       = tempoMap.toFrame(group.begin()->tick);
+					const Event e            = {EventType::ACTIONS, global, it->delta + global - it->begin, group};
+
+					for (; event != parsed && event->delta <= e.delta; ++event)
+						f(*event);
+					f(e);
+					rest = next;
+				}
+			}
+			for (; event != events->end(); ++event)
+				f(*event);
+		}
+
+		const EventBuffer*            events;
+		std::size_t                   parsedEvents;
+		ActionBuckets::const_iterator first;
+		ActionBuckets::const_iterator last;
+		TempoMap                      tempoMap;
+	};
+
 	Sequencer(model::Model&, Synchronizer&, JackTransport&);
 
 	/* canQuantize
@@ -137,10 +185,16 @@ public:
 
 	/* advance
 	Parses sequencer events that might occur in a block and advances the internal 
-	quantizer. Returns a reference to the internal EventBuffer filled with events
-	(if any). Call this on each new audio block. */
+	quantizer. Actions are bucketed by channel, so that each channel only gets 
+	its own: see getChannelEvents(). Call this on each new audio block. */
 
-	const EventBuffer& advance(Frame bufferSize, const ActionRecorder&);
+	void advance(Frame bufferSize, const ActionRecorder&);
+
+	/* getChannelEvents
+	Returns the events found by the last advance() call for channel 
+	'channelId'. O(log n). */
+
+	ChannelEvents getChannelEvents(ID channelId) const;
 
 	/* render
 	Renders audio coming out from the sequencer: that is, the metronome! */
@@ -165,11 +219,17 @@ public:
 
 	Quantizer quantizer;
 
-	std::function<void(SeqStatus)>         onAboutStart;
-	std::function<void()>                  onAboutStop;
-	std::function<void(float, float, int)> onBpmChange;
+	std::function<void(SeqStatus)> onAboutStart;
+	std::function<void()>          onAboutStop;
 
 private:
+	/* parseRange
+	Fills the event buffers with the events found in 'range', which must not 
+	wrap around the loop. 'delta' is the offset of the range within the current
+	block. Actions come from the map passed to m_actionBuckets.clear(). */
+
+	void parseRange(Range<Frame> range, Frame delta);
+
 	/* rewindQ
 	Rewinds sequencer, quantized mode. */
 
@@ -201,6 +261,22 @@ private:
 
 	EventBuffer m_eventBuffer;
 
+	/* m_parsedEvents
+	Number of events in m_eventBuffer found while parsing the current block. 
+	The ones past this point are added later on by the quantizer. */
+
+	std::size_t m_parsedEvents;
+
+	/* m_actionBuckets
+	Actions found in the current block, bucketed by channel. */
+
+	ActionBuckets m_actionBuckets;
+
+	/* m_tempoMap
+	Tempo used to parse the current block. Actions are stored in ticks. */
+
+	TempoMap m_tempoMap;
+
 	Metronome m_metronome;
 
 	/* m_quantizerStep
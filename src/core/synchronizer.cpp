@@ -29,21 +29,80 @@
 #include "core/kernelAudio.h"
 #include "core/kernelMidi.h"
 #include "core/model/model.h"
+#include "core/tempoMap.h"
+#include "utils/math.h"
+#include <algorithm>
+#include <cassert>
+#include <cmath>
 
 namespace giada::m
 {
+namespace
+{
+/* CLOCKS_PER_BEAT
+MIDI clock resolution. G_PPQ is a multiple of it, so clocks fall on exact 
+ticks. */
+
+constexpr int CLOCKS_PER_BEAT = 24;
+static_assert(G_PPQ % CLOCKS_PER_BEAT == 0);
+
+/* CLOCK_BPM_RESOLUTION
+When following an external MIDI clock, tempo changes smaller than this are
+ignored. */
+
+constexpr float CLOCK_BPM_RESOLUTION = 0.01f;
+
+/* -------------------------------------------------------------------------- */
+
+uint32_t pack_(int b1, int b2 = 0)
+{
+	return (static_cast<uint32_t>(b1) << 24) | (static_cast<uint32_t>(b2) << 16);
+}
+
+/* -------------------------------------------------------------------------- */
+
+/* getMtcRate_
+Returns the SMPTE rate code sent along with the hours in MTC quarter frames. */
+
+int getMtcRate_(float fps)
+{
+	if (fps < 24.5f)
+		return 0; // 24 fps
+	if (fps < 27.5f)
+		return 1; // 25 fps
+	if (fps < 29.99f)
+		return 2; // 29.97 fps, drop frame
+	return 3;     // 30 fps
+}
+} // namespace
+
+/* -------------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------- */
+
 Synchronizer::Synchronizer(const Conf::Data& c, KernelMidi& k)
+: onClockStart(nullptr)
+, onClockStop(nullptr)
+, onClockChangeBpm(nullptr)
 #ifdef WITH_AUDIO_JACK
-: onJackRewind(nullptr)
+, onJackRewind(nullptr)
 , onJackChangeBpm(nullptr)
 , onJackStart(nullptr)
 , onJackStop(nullptr)
+#endif
+, m_mtcFrame(0)
+, m_mtcQuarter(0)
+, m_mtcRewind(false)
+, m_clockOrigin(0)
+, m_clockRunning(false)
+, m_clockVersion(0)
+, m_clockCount(0)
+, m_clockTime(0.0)
+, m_clockPeriod(0.0)
+, m_clockRewind(false)
+, m_clockDevice(-1)
 , m_kernelMidi(k)
 , m_conf(c)
-#else
-: m_kernelMidi(k)
-, m_conf(c)
-#endif
 {
 	reset();
 }
@@ -52,98 +111,232 @@ Synchronizer::Synchronizer(const Conf::Data& c, KernelMidi& k)
 
 void Synchronizer::reset()
 {
-	m_midiTCrate = static_cast<int>((m_conf.samplerate / m_conf.midiTCfps) * G_MAX_IO_CHANS); // stereo values
+	m_mtcRewind.store(true);
+	m_clockRewind.store(true);
+	m_clockDevice.store(-1);
 }
 
 /* -------------------------------------------------------------------------- */
 
-void Synchronizer::sendMIDIsync(const model::Sequencer& sequencer)
+void Synchronizer::advance(const model::Sequencer& sequencer, Frame bufferSize, const KernelAudio& kernelAudio)
 {
-	/* Sending MIDI sync while waiting is meaningless. */
+	if (m_mtcRewind.exchange(false))
+	{
+		m_mtcFrame   = 0;
+		m_mtcQuarter = 0;
+	}
 
-	if (sequencer.status == SeqStatus::WAITING)
+	if (m_conf.midiSync == G_MIDI_SYNC_CLOCK_S)
+	{
+		followClock(sequencer, bufferSize, kernelAudio);
 		return;
+	}
 
-	const int currentFrame = sequencer.a_getCurrentFrame();
+	/* Sending MIDI sync while waiting or stopped is meaningless. */
 
-	/* TODO - only Master (_M) is implemented so far. */
+	if (!sequencer.isRunning())
+		return;
+
+	/* TODO - MTC slave (_S) is not implemented. */
 
 	if (m_conf.midiSync == G_MIDI_SYNC_CLOCK_M)
-	{
-		if (currentFrame % (sequencer.framesInBeat / 24) == 0)
-			m_kernelMidi.send(MIDI_CLOCK, -1, -1);
+		advanceClock(sequencer, bufferSize);
+	else if (m_conf.midiSync == G_MIDI_SYNC_MTC_M)
+		advanceTimecode(bufferSize, kernelAudio);
+}
+
+/* -------------------------------------------------------------------------- */
+
+void Synchronizer::advanceClock(const model::Sequencer& sequencer, Frame bufferSize)
+{
+	constexpr Tick CLOCK_STEP = G_PPQ / CLOCKS_PER_BEAT;
+
+	const TempoMap tempoMap     = sequencer.getTempoMap();
+	const Frame    framesInLoop = sequencer.framesInLoop;
+
+	if (framesInLoop <= 0)
 		return;
+
+	/* Same as in Sequencer::advance(): the block is split in two (or more)
+	when it wraps around the loop. Clocks restart from the first beat. */
+
+	Frame global = sequencer.a_getCurrentFrame() % framesInLoop;
+	for (Frame local = 0; local < bufferSize;)
+	{
+		const Frame length = std::min(bufferSize - local, framesInLoop - global);
+		const Frame end    = global + length;
+
+		for (Tick t = u::math::ceilToMultiple(tempoMap.toTick(global), CLOCK_STEP);; t += CLOCK_STEP)
+		{
+			const Frame frame = tempoMap.toFrame(t);
+			if (frame >= end)
+				break;
+			m_kernelMidi.schedule(pack_(MIDI_CLOCK), 1, local + frame - global);
+		}
+
+		local += length;
+		global = 0;
 	}
+}
 
-	if (m_conf.midiSync == G_MIDI_SYNC_MTC_M)
+/* -------------------------------------------------------------------------- */
+
+void Synchronizer::advanceTimecode(Frame bufferSize, const KernelAudio& kernelAudio)
+{
+	/* Quarter frames are spread evenly, four per timecode frame. A full 
+	timecode is sent every eight quarter frames (i.e. two timecode frames),
+	with the value of the timecode frame the first quarter belongs to. */
+
+	const double  fps             = m_conf.midiTCfps;
+	const int     fpsInt          = static_cast<int>(fps + 0.5);
+	const int     rate            = getMtcRate_(m_conf.midiTCfps);
+	const double  framesInQuarter = kernelAudio.getSampleRate() / (fps * 4.0);
+	const int64_t end             = m_mtcFrame + bufferSize;
+
+	if (fpsInt <= 0)
+		return;
+
+	while (true)
 	{
+		const int64_t frame = static_cast<int64_t>(m_mtcQuarter * framesInQuarter);
+		if (frame >= end)
+			break;
 
-		/* check if a new timecode frame has passed. If so, send MIDI TC
-		 * quarter frames. 8 quarter frames, divided in two branches:
-		 * 1-4 and 5-8. We check timecode frame's parity: if even, send
-		 * range 1-4, if odd send 5-8. */
+		const int     piece   = static_cast<int>(m_mtcQuarter % 8);
+		const int64_t tcFrame = (m_mtcQuarter / 8) * 2;
+		const int64_t seconds = tcFrame / fpsInt;
 
-		if (currentFrame % m_midiTCrate != 0) // no timecode frame passed
-			return;
+		const int frames = static_cast<int>(tcFrame % fpsInt);
+		const int secs   = static_cast<int>(seconds % 60);
+		const int mins   = static_cast<int>((seconds / 60) % 60);
+		const int hours  = static_cast<int>((seconds / 3600) % 24);
 
-		/* frame low nibble
-		 * frame high nibble
-		 * seconds low nibble
-		 * seconds high nibble */
+		const int nibbles[8] = {
+		    frames & 0x0F, frames >> 4,
+		    secs & 0x0F, secs >> 4,
+		    mins & 0x0F, mins >> 4,
+		    hours & 0x0F, (hours >> 4) | (rate << 1)};
 
-		if (m_midiTCframes % 2 == 0)
-		{
-			m_kernelMidi.send(MIDI_MTC_QUARTER, (m_midiTCframes & 0x0F) | 0x00, -1);
-			m_kernelMidi.send(MIDI_MTC_QUARTER, (m_midiTCframes >> 4) | 0x10, -1);
-			m_kernelMidi.send(MIDI_MTC_QUARTER, (m_midiTCseconds & 0x0F) | 0x20, -1);
-			m_kernelMidi.send(MIDI_MTC_QUARTER, (m_midiTCseconds >> 4) | 0x30, -1);
-		}
+		const Frame offset = static_cast<Frame>(std::max<int64_t>(frame - m_mtcFrame, 0));
+		m_kernelMidi.schedule(pack_(MIDI_MTC_QUARTER, (piece << 4) | nibbles[piece]), 2, offset);
 
-		/* minutes low nibble
-		 * minutes high nibble
-		 * hours low nibble
-		 * hours high nibble SMPTE frame rate */
+		m_mtcQuarter++;
+	}
 
-		else
-		{
-			m_kernelMidi.send(MIDI_MTC_QUARTER, (m_midiTCminutes & 0x0F) | 0x40, -1);
-			m_kernelMidi.send(MIDI_MTC_QUARTER, (m_midiTCminutes >> 4) | 0x50, -1);
-			m_kernelMidi.send(MIDI_MTC_QUARTER, (m_midiTChours & 0x0F) | 0x60, -1);
-			m_kernelMidi.send(MIDI_MTC_QUARTER, (m_midiTChours >> 4) | 0x70, -1);
-		}
+	m_mtcFrame = end;
+}
 
-		m_midiTCframes++;
+/* -------------------------------------------------------------------------- */
 
-		/* check if total timecode frames are greater than timecode fps:
-		 * if so, a second has passed */
+void Synchronizer::followClock(const model::Sequencer& sequencer, Frame bufferSize, const KernelAudio& kernelAudio)
+{
+	assert(onClockChangeBpm != nullptr);
 
-		if (m_midiTCframes > m_conf.midiTCfps)
-		{
-			m_midiTCframes = 0;
-			m_midiTCseconds++;
-			if (m_midiTCseconds >= 60)
-			{
-				m_midiTCminutes++;
-				m_midiTCseconds = 0;
-				if (m_midiTCminutes >= 60)
-				{
-					m_midiTChours++;
-					m_midiTCminutes = 0;
-				}
-			}
-			//u::log::print("%d:%d:%d:%d\n", m_midiTChours, m_midiTCminutes, m_midiTCseconds, m_midiTCframes);
-		}
+	if (m_clockRewind.exchange(false))
+		m_clockFollower.reset();
+
+	if (!sequencer.isRunning() || sequencer.framesInBeat <= 0)
+		return;
+
+	const double now = std::chrono::duration<double>(kernelAudio.getFrameTime(0).time_since_epoch()).count();
+	const float  bpm = m_clockFollower.advance(bufferSize, sequencer.framesInBeat, now, readClock());
+
+	/* A tempo change is a model swap: skip the negligible ones. */
+
+	if (bpm > 0.0f && std::abs(bpm - sequencer.bpm) >= CLOCK_BPM_RESOLUTION)
+		onClockChangeBpm(bpm);
+}
+
+/* -------------------------------------------------------------------------- */
+
+std::optional<MidiClockFollower::Master> Synchronizer::readClock() const
+{
+	/* Never wait for the MIDI thread here: if it's in the middle of an 
+	update, just give up. */
+
+	const uint32_t version = m_clockVersion.load(std::memory_order_acquire);
+	const int64_t  count   = m_clockCount.load(std::memory_order_relaxed);
+	const double   time    = m_clockTime.load(std::memory_order_relaxed);
+	const double   period  = m_clockPeriod.load(std::memory_order_relaxed);
+	std::atomic_thread_fence(std::memory_order_acquire);
+
+	if (version % 2 != 0 || version != m_clockVersion.load(std::memory_order_relaxed))
+		return {};
+	return MidiClockFollower::Master{count, time, period};
+}
+
+/* -------------------------------------------------------------------------- */
+
+void Synchronizer::recvMIDIrealtime(int status, Clock::time_point t, int device)
+{
+	assert(onClockStart != nullptr);
+	assert(onClockStop != nullptr);
+
+	if (m_conf.midiSync != G_MIDI_SYNC_CLOCK_S)
+		return;
+
+	/* Each input device calls this from its own thread, but the clock state 
+	and the sequence lock below allow a single writer: follow the first device
+	that sends something, ignore the others until reset. */
+
+	int clockDevice = -1;
+	if (!m_clockDevice.compare_exchange_strong(clockDevice, device) && clockDevice != device)
+		return;
+
+	switch (status)
+	{
+	case MIDI_CLOCK:
+		m_pll.tick(std::chrono::duration<double>(t.time_since_epoch()).count(), m_conf.midiClockBandwidth);
+		if (!m_clockRunning)
+			m_clockOrigin++; // Keep tracking the tempo, but the song doesn't move
+		publishClock();
+		break;
+
+	case MIDI_START:
+		/* The next tick is the first beat. */
+		m_clockOrigin  = m_pll.getCount() + 1;
+		m_clockRunning = true;
+		m_clockRewind.store(true);
+		publishClock();
+		onClockStart(/*rewind=*/true);
+		break;
+
+	case MIDI_CONTINUE:
+		m_clockRunning = true;
+		onClockStart(/*rewind=*/false);
+		break;
+
+	case MIDI_STOP:
+		m_clockRunning = false;
+		onClockStop();
+		break;
+
+	default:
+		break;
 	}
 }
 
 /* -------------------------------------------------------------------------- */
 
+void Synchronizer::publishClock()
+{
+	const uint32_t version = m_clockVersion.load(std::memory_order_relaxed);
+
+	m_clockVersion.store(version + 1, std::memory_order_relaxed);
+	std::atomic_thread_fence(std::memory_order_release);
+
+	m_clockCount.store(m_pll.getCount() - m_clockOrigin, std::memory_order_relaxed);
+	m_clockTime.store(m_pll.getTime(), std::memory_order_relaxed);
+	m_clockPeriod.store(m_pll.isLocked() ? m_pll.getPeriod() : 0.0, std::memory_order_relaxed);
+
+	m_clockVersion.store(version + 2, std::memory_order_release);
+}
+
+/* -------------------------------------------------------------------------- */
+
 void Synchronizer::sendMIDIrewind()
 {
-	m_midiTCframes  = 0;
-	m_midiTCseconds = 0;
-	m_midiTCminutes = 0;
-	m_midiTChours   = 0;
+	m_mtcRewind.store(true);
 
 	/* For cueing the slave to a particular start point, Quarter Frame messages 
     are not used. Instead, an MTC Full Frame message should be sent. The Full 
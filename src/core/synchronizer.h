@@ -30,9 +30,14 @@
 #ifdef WITH_AUDIO_JACK
 #include "core/jackTransport.h"
 #endif
-#include "core/types.h"
 #include "core/conf.h"
+#include "core/midiClockPll.h"
+#include "core/types.h"
+#include <atomic>
+#include <chrono>
+#include <cstdint>
 #include <functional>
+#include <optional>
 
 namespace giada::m::kernelAudio
 {
@@ -47,9 +52,12 @@ class Sequencer;
 namespace giada::m
 {
 class KernelMidi;
+class KernelAudio;
 class Synchronizer final
 {
 public:
+	using Clock = std::chrono::steady_clock;
+
 	Synchronizer(const Conf::Data&, KernelMidi&);
 
 	/* reset
@@ -57,10 +65,13 @@ public:
 
 	void reset();
 
-	/* sendMIDIsync
-    Generates MIDI sync output data. */
+	/* advance
+	Generates MIDI clock or MTC messages falling in the next 'bufferSize' 
+	frames and schedules them on KernelMidi at their exact time within the 
+	block. When following an external MIDI clock, adjusts the tempo instead.
+	Call this from the audio thread, before the sequencer advances. */
 
-	void sendMIDIsync(const model::Sequencer& clock);
+	void advance(const model::Sequencer&, Frame bufferSize, const KernelAudio&);
 
 	/* sendMIDIrewind
     Rewinds timecode to beat 0 and also send a MTC full frame to cue the slave. */
@@ -70,6 +81,21 @@ public:
 	void sendMIDIstart();
 	void sendMIDIstop();
 
+	/* recvMIDIrealtime
+	Receives a MIDI real-time message (clock, start, continue, stop), the time
+	it arrived and the input device it comes from. Only used when following an
+	external MIDI clock. Called by the MIDI thread. */
+
+	void recvMIDIrealtime(int status, Clock::time_point t, int device);
+
+	/* onClock[...]
+	Callbacks fired when following an external MIDI clock. onClockChangeBpm 
+	is called by the audio thread, at most once per beat. */
+
+	std::function<void(bool rewind)> onClockStart;
+	std::function<void()>            onClockStop;
+	std::function<void(float)>       onClockChangeBpm;
+
 #ifdef WITH_AUDIO_JACK
 
 	/* recvJackSync
@@ -87,14 +113,70 @@ public:
 #endif
 
 private:
-	/* midiTC*
-    MIDI timecode variables. */
-
-	int m_midiTCrate    = 0; // Send MTC data every m_midiTCrate frames
-	int m_midiTCframes  = 0;
-	int m_midiTCseconds = 0;
-	int m_midiTCminutes = 0;
-	int m_midiTChours   = 0;
+	/* advanceClock
+	Schedules 24 MIDI clocks per beat. Clocks are placed in musical time, so
+	they stay aligned to the beats even when framesInBeat is not a multiple of
+	24. */
+
+	void advanceClock(const model::Sequencer&, Frame bufferSize);
+
+	/* advanceTimecode
+	Schedules MTC quarter frames, four per timecode frame. */
+
+	void advanceTimecode(Frame bufferSize, const KernelAudio&);
+
+	/* followClock
+	Compares the position of the sequencer with the one of the external 
+	clock, and asks for a tempo that brings them together by the next beat. */
+
+	void followClock(const model::Sequencer&, Frame bufferSize, const KernelAudio&);
+
+	/* readClock
+	Returns the latest snapshot of m_pll, or nothing if the MIDI thread is 
+	updating it right now. */
+
+	std::optional<MidiClockFollower::Master> readClock() const;
+
+	/* publishClock
+	Makes the current state of m_pll available to the audio thread. */
+
+	void publishClock();
+
+	/* m_mtc[...]
+	MIDI timecode state, owned by the audio thread: position in frames since 
+	the last rewind and index of the next quarter frame to send. m_mtcRewind
+	asks the audio thread to start over. */
+
+	int64_t           m_mtcFrame;
+	int64_t           m_mtcQuarter;
+	std::atomic<bool> m_mtcRewind;
+
+	/* m_pll, m_clockOrigin, m_clockRunning
+	External MIDI clock state, owned by the MIDI thread of m_clockDevice, the
+	input device the clock is taken from (-1 = none yet). m_clockOrigin is the
+	index of the tick the song started on: ticks received while stopped push
+	it forward. */
+
+	MidiClockPll m_pll;
+	int64_t      m_clockOrigin;
+	bool         m_clockRunning;
+
+	/* m_clock[...]
+	Snapshot of m_pll for the audio thread, guarded by a sequence lock: 
+	m_clockVersion is odd while the MIDI thread is writing. A period of 0 means
+	not locked yet. */
+
+	std::atomic<uint32_t> m_clockVersion;
+	std::atomic<int64_t>  m_clockCount;
+	std::atomic<double>   m_clockTime;
+	std::atomic<double>   m_clockPeriod;
+	std::atomic<bool>     m_clockRewind;
+	std::atomic<int>      m_clockDevice;
+
+	/* m_clockFollower
+	Beats played since the external clock started. Audio thread only. */
+
+	MidiClockFollower m_clockFollower;
 
 #ifdef WITH_AUDIO_JACK
 
@@ -0,0 +1,58 @@
+/* -----------------------------------------------------------------------------
+ *
+ * Giada - Your Hardcore Loopmachine
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2022 Giovanni A. Zuliani | Monocasual Laboratories
+ *
+ * This file is part of Giada - Your Hardcore Loopmachine.
+ *
+ * Giada - Your Hardcore Loopmachine is free software: you can
+ * redistribute it and/or modify it under the terms of the GNU General
+ * Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * Giada - Your Hardcore Loopmachine is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Giada - Your Hardcore Loopmachine. If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------- */
+
+
+#include "core/tempoMap.h"
+#include "core/const.h"
+#include <algorithm>
+#include <cassert>
+
+namespace giada::m
+{
+TempoMap::TempoMap(Frame framesInBeat)
+: m_framesInBeat(std::max(framesInBeat, 1)) // Sequencer not set up yet
+{
+}
+
+/* -------------------------------------------------------------------------- */
+
+Frame TempoMap::toFrame(Tick t) const
+{
+	assert(t >= 0);
+	return static_cast<Frame>(t * m_framesInBeat / G_PPQ);
+}
+
+/* -------------------------------------------------------------------------- */
+
+Tick TempoMap::toTick(Frame f) const
+{
+	assert(f >= 0);
+
+	/* Round up: toFrame() rounds down, and a tick is shorter than a frame. */
+
+	return (static_cast<Tick>(f) * G_PPQ + m_framesInBeat - 1) / m_framesInBeat;
+}
+} // namespace giada::m
@@ -0,0 +1,64 @@
+/* -----------------------------------------------------------------------------
+ *
+ * Giada - Your Hardcore Loopmachine
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2022 Giovanni A. Zuliani | Monocasual Laboratories
+ *
+ * This file is part of Giada - Your Hardcore Loopmachine.
+ *
+ * Giada - Your Hardcore Loopmachine is free software: you can
+ * redistribute it and/or modify it under the terms of the GNU General
+ * Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * Giada - Your Hardcore Loopmachine is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Giada - Your Hardcore Loopmachine. If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------- */
+
+
+#ifndef G_TEMPO_MAP_H
+#define G_TEMPO_MAP_H
+
+#include "core/types.h"
+
+namespace giada::m
+{
+/* TempoMap
+Converts between musical time, in ticks (G_PPQ per beat), and frames. Actions
+are stored in ticks, so that tempo and sample rate changes don't move them 
+around. There's a single tempo for the whole sequencer for now: this boils down
+to a scale factor.
+
+A tick is shorter than a frame at any supported tempo and sample rate, so 
+converting a frame to ticks and back always gives the original frame. */
+
+class TempoMap
+{
+public:
+	TempoMap(Frame framesInBeat);
+
+	/* toFrame
+	Returns the frame a tick falls on. */
+
+	Frame toFrame(Tick) const;
+
+	/* toTick
+	Returns the first tick that falls on frame 'f'. */
+
+	Tick toTick(Frame f) const;
+
+private:
+	Tick m_framesInBeat;
+};
+} // namespace giada::m
+
+#endif
@@ -27,11 +27,14 @@
 #ifndef G_TYPES_H
 #define G_TYPES_H
 
+#include <cstdint>
+
 namespace giada
 {
 using ID    = int;
 using Pixel = int;
 using Frame = int;
+using Tick  = int64_t; // Musical time, see m::TempoMap
 
 enum class Thread
 {
@@ -26,6 +26,7 @@
 
 #include "waveFx.h"
 #include "const.h"
+#include "core/dsp/kernels.h"
 #include "deps/mcl-audio-buffer/src/audioBuffer.hpp"
 #include "utils/log.h"
 #include "wave.h"
@@ -37,26 +38,12 @@ namespace giada::m::wfx
 {
 namespace
 {
-void fadeFrame_(Wave& w, int i, float val)
-{
-	for (int j = 0; j < w.getBuffer().countChannels(); j++)
-		w.getBuffer()[i][j] *= val;
-}
-
-/* -------------------------------------------------------------------------- */
-
 float getPeak_(const Wave& w, int a, int b)
 {
-	float peak = 0.0f;
-	float abs  = 0.0f;
-	for (int i = a; i < b; i++)
-	{
-		for (int j = 0; j < w.getBuffer().countChannels(); j++) // Find highest value in any channel
-			abs = fabs(w.getBuffer()[i][j]);
-		if (abs > peak)
-			peak = abs;
-	}
-	return peak;
+	/* Highest value in any channel. */
+
+	const mcl::AudioBuffer& buf = w.getBuffer();
+	return dsp::peak(buf[a], (b - a) * buf.countChannels());
 }
 } // namespace
 
@@ -72,11 +59,8 @@ void normalize(Wave& w, int a, int b)
 	if (peak == 0.0f || peak > 1.0f)
 		return;
 
-	for (int i = a; i < b; i++)
-	{
-		for (int j = 0; j < w.getBuffer().countChannels(); j++)
-			w.getBuffer()[i][j] = w.getBuffer()[i][j] * (1.0f / peak);
-	}
+	mcl::AudioBuffer& buf = w.getBuffer();
+	dsp::gain(buf[a], (b - a) * buf.countChannels(), 1.0f / peak);
 	w.setEdited(true);
 }
 
@@ -194,15 +178,12 @@ void fade(Wave& w, int a, int b, Fade type)
 {
 	u::log::print("[wfx::fade] fade from %d to %d (range = %d)\n", a, b, b - a);
 
-	float m = 0.0f;
-	float d = 1.0f / (float)(b - a);
+	mcl::AudioBuffer& buf = w.getBuffer();
 
 	if (type == Fade::IN)
-		for (int i = a; i <= b; i++, m += d)
-			fadeFrame_(w, i, m);
+		dsp::ramp(buf[a], b - a + 1, buf.countChannels(), 0.0f, 1.0f);
 	else
-		for (int i = b; i >= a; i--, m += d)
-			fadeFrame_(w, i, m);
+		dsp::ramp(buf[a], b - a + 1, buf.countChannels(), 1.0f, 0.0f);
 
 	w.setEdited(true);
 }
@@ -25,12 +25,13 @@
  * -------------------------------------------------------------------------- */
 
 #include "worker.h"
-#include "utils/time.h"
+#include <chrono>
 
 namespace giada
 {
 Worker::Worker()
 : m_running(false)
+, m_notified(false)
 {
 }
 
@@ -50,7 +51,7 @@ void Worker::start(std::function<void()> f, int sleep)
 		while (m_running.load() == true)
 		{
 			f();
-			u::time::sleep(sleep);
+			wait(sleep);
 		}
 	});
 }
@@ -60,7 +61,35 @@ void Worker::start(std::function<void()> f, int sleep)
 void Worker::stop()
 {
 	m_running.store(false);
+	notify();
 	if (m_thread.joinable())
 		m_thread.join();
 }
+
+/* -------------------------------------------------------------------------- */
+
+void Worker::notify()
+{
+	m_notified.store(true);
+
+	/* Going through the mutex guarantees that the worker is either before its
+	predicate check (and will see the flag) or already blocked (and will get 
+	the signal). */
+
+	if (m_mutex.try_lock())
+		m_mutex.unlock();
+	m_cond.notify_one();
+}
+
+/* -------------------------------------------------------------------------- */
+
+void Worker::wait(int sleep)
+{
+	std::unique_lock lock(m_mutex);
+
+	m_cond.wait_for(lock, std::chrono::milliseconds(sleep), [this]() {
+		return m_notified.load() || !m_running.load();
+	});
+	m_notified.store(false);
+}
 } // namespace giada
@@ -28,7 +28,9 @@
 #define G_WORKER_H
 
 #include <atomic>
+#include <condition_variable>
 #include <functional>
+#include <mutex>
 #include <thread>
 
 namespace giada
@@ -39,12 +41,33 @@ public:
 	Worker();
 	~Worker();
 
+	/* start
+	Runs 'f' on a separate thread every 'sleep' milliseconds, or right away 
+	when notified. */
+
 	void start(std::function<void()> f, int sleep);
 	void stop();
 
+	/* notify
+	Wakes up the worker, so that 'f' runs as soon as possible. Never blocks, so
+	it's safe to call from the realtime thread: the mutex is only try-locked to
+	order the wakeup with the worker's predicate check. Only if that fails, 
+	because the worker is in the middle of the check, can the wakeup be missed:
+	'sleep' bounds the delay in that rare case. */
+
+	void notify();
+
   private:
-	std::thread       m_thread;
-	std::atomic<bool> m_running;
+	/* wait
+	Sleeps for 'sleep' milliseconds at most, or until notified. */
+
+	void wait(int sleep);
+
+	std::thread             m_thread;
+	std::atomic<bool>       m_running;
+	std::atomic<bool>       m_notified;
+	std::mutex              m_mutex;
+	std::condition_variable m_cond;
 };
 } // namespace giada
 
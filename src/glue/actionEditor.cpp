@@ -35,6 +35,7 @@
 #include "glue/events.h"
 #include "glue/recorder.h"
 #include <cassert>
+#include <utility>
 
 extern giada::m::Engine g_engine;
 
@@ -81,7 +82,7 @@ Vertical envelope points are forbidden. */
 void recordNonFirstEnvelopeAction_(ID channelId, Frame frame, int value)
 {
 	const m::Action a1 = g_engine.actionRecorder.getClosestAction(channelId, frame, m::MidiEvent::ENVELOPE);
-	const m::Action a3 = a1.next != nullptr ? *a1.next : m::Action{};
+	const m::Action a3 = g_engine.actionRecorder.getAction(a1.nextId);
 
 	assert(a1.isValid());
 	assert(a3.isValid());
@@ -102,7 +103,7 @@ void recordNonFirstEnvelopeAction_(ID channelId, Frame frame, int value)
 bool isSinglePressMode_(ID channelId)
 {
 	/* TODO - use m::model getChannel utils (to be added) */
-	return g_engine.model.get().getChannel(channelId).samplePlayer->mode == SamplePlayerMode::SINGLE_PRESS;
+	return std::as_const(g_engine.model).get().getChannel(channelId).samplePlayer->mode == SamplePlayerMode::SINGLE_PRESS;
 }
 } // namespace
 
@@ -142,7 +143,14 @@ Frame Data::getCurrentFrame() const
 
 bool Data::isChannelPlaying() const
 {
-	return g_engine.model.get().getChannel(channelId).isPlaying();
+	return std::as_const(g_engine.model).get().getChannel(channelId).isPlaying();
+}
+
+/* -------------------------------------------------------------------------- */
+
+m::Action Data::getAction(ID id) const
+{
+	return g_engine.actionRecorder.getAction(id);
 }
 
 /* -------------------------------------------------------------------------- */
@@ -151,7 +159,7 @@ bool Data::isChannelPlaying() const
 
 Data getData(ID channelId)
 {
-	return Data(g_engine.model.get().getChannel(channelId));
+	return Data(std::as_const(g_engine.model).get().getChannel(channelId));
 }
 
 /* -------------------------------------------------------------------------- */
@@ -188,10 +196,11 @@ void deleteMidiAction(ID channelId, const m::Action& a)
 	/* Send a note-off first in case we are deleting it in a middle of a 
 	key_on/key_off sequence. Check if 'next' exist first: could be orphaned. */
 
-	if (a.next != nullptr)
+	const m::Action next = g_engine.actionRecorder.getAction(a.nextId);
+	if (next.isValid())
 	{
-		events::sendMidiToChannel(channelId, a.next->event, Thread::MAIN);
-		g_engine.actionRecorder.deleteAction(a.id, a.next->id);
+		events::sendMidiToChannel(channelId, next.event, Thread::MAIN);
+		g_engine.actionRecorder.deleteAction(a.id, next.id);
 	}
 	else
 		g_engine.actionRecorder.deleteAction(a.id);
@@ -204,7 +213,7 @@ void deleteMidiAction(ID channelId, const m::Action& a)
 void updateMidiAction(ID channelId, const m::Action& a, int note, int velocity,
     Frame f1, Frame f2)
 {
-	g_engine.actionRecorder.deleteAction(a.id, a.next->id);
+	g_engine.actionRecorder.deleteAction(a.id, a.nextId);
 	recordMidiAction(channelId, note, velocity, f1, f2);
 }
 
@@ -235,7 +244,7 @@ void updateSampleAction(ID channelId, const m::Action& a, int type,
     Frame f1, Frame f2)
 {
 	if (isSinglePressMode_(channelId))
-		g_engine.actionRecorder.deleteAction(a.id, a.next->id);
+		g_engine.actionRecorder.deleteAction(a.id, a.nextId);
 	else
 		g_engine.actionRecorder.deleteAction(a.id);
 
@@ -246,8 +255,8 @@ void updateSampleAction(ID channelId, const m::Action& a, int type,
 
 void deleteSampleAction(ID channelId, const m::Action& a)
 {
-	if (a.next != nullptr) // For ChannelMode::SINGLE_PRESS combo
-		g_engine.actionRecorder.deleteAction(a.id, a.next->id);
+	if (a.nextId != 0) // For ChannelMode::SINGLE_PRESS combo
+		g_engine.actionRecorder.deleteAction(a.id, a.nextId);
 	else
 		g_engine.actionRecorder.deleteAction(a.id);
 
@@ -290,13 +299,13 @@ void deleteEnvelopeAction(ID channelId, const m::Action& a)
 	}
 	else
 	{
-		assert(a.prev != nullptr);
-		assert(a.next != nullptr);
+		const m::Action a1     = g_engine.actionRecorder.getAction(a.prevId);
+		const m::Action a1prev = g_engine.actionRecorder.getAction(a1.prevId);
+		const m::Action a3     = g_engine.actionRecorder.getAction(a.nextId);
+		const m::Action a3next = g_engine.actionRecorder.getAction(a3.nextId);
 
-		const m::Action a1     = *a.prev;
-		const m::Action a1prev = *a1.prev;
-		const m::Action a3     = *a.next;
-		const m::Action a3next = *a3.next;
+		assert(a1.isValid());
+		assert(a3.isValid());
 
 		/* Original status:   a1--->a--->a3
 		   Modified status:   a1-------->a3 
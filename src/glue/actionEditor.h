@@ -57,6 +57,11 @@ struct Data
 	Frame getCurrentFrame() const;
 	bool  isChannelPlaying() const;
 
+	/* getAction
+	Returns the action with the given ID, or an invalid action if not found. */
+
+	m::Action getAction(ID id) const;
+
 	ID                     channelId;
 	std::string            channelName;
 	Frame                  framesInSeq;
@@ -65,6 +65,7 @@
 #include <cassert>
 #include <cmath>
 #include <functional>
+#include <utility>
 
 extern giada::v::Ui     g_ui;
 extern giada::m::Engine g_engine;
@@ -84,6 +85,16 @@ void printLoadError_(int res)
 	else if (res == G_RES_ERR_NO_DATA)
 		v::gdAlert(g_ui.langMapper.get(v::LangMap::MESSAGE_CHANNEL_NOFILESPECIFIED));
 }
+
+/* -------------------------------------------------------------------------- */
+
+/* getChannel_
+Read-only access to a channel, without cloning it. */
+
+const m::Channel& getChannel_(ID channelId)
+{
+	return std::as_const(g_engine.model).get().getChannel(channelId);
+}
 } // namespace
 
 /* -------------------------------------------------------------------------- */
@@ -94,16 +105,16 @@ SampleData::SampleData(const m::Channel& ch)
 : waveId(ch.samplePlayer->getWaveId())
 , mode(ch.samplePlayer->mode)
 , isLoop(ch.samplePlayer->isAnyLoopMode())
-, pitch(ch.samplePlayer->pitch)
+, pitch(ch.shared->pitch.load())
 , begin(ch.samplePlayer->begin)
 , end(ch.samplePlayer->end)
 , inputMonitor(ch.audioReceiver->inputMonitor)
 , overdubProtection(ch.audioReceiver->overdubProtection)
-, m_channel(&ch)
+, m_shared(ch.shared)
 {
 }
 
-Frame SampleData::getTracker() const { return m_channel->shared->tracker.load(); }
+Frame SampleData::getTracker() const { return m_shared->tracker.load(); }
 
 /* -------------------------------------------------------------------------- */
 
@@ -123,11 +134,11 @@ Data::Data(const m::Channel& c)
 , type(c.type)
 , height(c.height)
 , name(c.name)
-, volume(c.volume)
-, pan(c.pan)
+, volume(c.shared->volume.load())
+, pan(c.shared->pan.load())
 , key(c.key)
 , hasActions(c.hasActions)
-, m_channel(&c)
+, m_shared(c.shared)
 {
 	if (c.type == ChannelType::SAMPLE)
 		sample = std::make_optional<SampleData>(c);
@@ -135,14 +146,14 @@ Data::Data(const m::Channel& c)
 		midi = std::make_optional<MidiData>(c);
 }
 
-ChannelStatus Data::getPlayStatus() const { return m_channel->shared->playStatus.load(); }
-ChannelStatus Data::getRecStatus() const { return m_channel->shared->recStatus.load(); }
-bool          Data::getReadActions() const { return m_channel->shared->readActions.load(); }
+ChannelStatus Data::getPlayStatus() const { return m_shared->playStatus.load(); }
+ChannelStatus Data::getRecStatus() const { return m_shared->recStatus.load(); }
+bool          Data::getReadActions() const { return m_shared->readActions.load(); }
 bool          Data::isRecordingInput() const { return g_engine.recorder.isRecordingInput(); }
 bool          Data::isRecordingAction() const { return g_engine.recorder.isRecordingAction(); }
-bool          Data::isMuted() const { return m_channel->isMuted(); }
-bool          Data::isSoloed() const { return m_channel->isSoloed(); }
-bool          Data::isArmed() const { return m_channel->armed; }
+bool          Data::isMuted() const { return getChannel_(id).isMuted(); }
+bool          Data::isSoloed() const { return getChannel_(id).isSoloed(); }
+bool          Data::isArmed() const { return getChannel_(id).armed; }
 
 /* -------------------------------------------------------------------------- */
 /* -------------------------------------------------------------------------- */
@@ -150,7 +161,7 @@ bool          Data::isArmed() const { return m_channel->armed; }
 
 Data getData(ID channelId)
 {
-	return Data(g_engine.model.get().getChannel(channelId));
+	return Data(getChannel_(channelId));
 }
 
 std::vector<Data> getChannels()
@@ -239,7 +250,7 @@ void deleteChannel(ID channelId)
 		return;
 	g_ui.closeAllSubwindows();
 
-	const std::vector<m::Plugin*> plugins = g_engine.model.get().getChannel(channelId).plugins;
+	const std::vector<m::Plugin*> plugins = getChannel_(channelId).plugins;
 
 	g_engine.channelManager.deleteChannel(channelId);
 	g_engine.mixer.updateSoloCount(g_engine.channelManager.hasSolos());
@@ -285,7 +296,7 @@ void cloneChannel(ID channelId)
 {
 	g_engine.actionRecorder.cloneActions(channelId, g_engine.channelFactory.getNextId());
 
-	const m::Channel&       ch      = g_engine.model.get().getChannel(channelId);
+	const m::Channel&       ch      = getChannel_(channelId);
 	std::vector<m::Plugin*> plugins = g_engine.pluginManager.clonePlugins(ch.plugins, g_engine.patch.data.samplerate,
 	    g_engine.kernelAudio.getBufferSize(), g_engine.model, g_engine.sequencer);
 	g_engine.channelManager.cloneChannel(channelId, g_engine.kernelAudio.getBufferSize(), plugins);
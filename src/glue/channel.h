@@ -63,7 +63,7 @@ struct SampleData
 	bool             overdubProtection;
 
 private:
-	const m::Channel* m_channel;
+	const m::ChannelShared* m_shared;
 };
 
 struct MidiData
@@ -104,7 +104,10 @@ struct Data
 	std::optional<MidiData>   midi;
 
 private:
-	const m::Channel* m_channel;
+	/* Channels are copy-on-write and can be replaced by a clone at any time: 
+	keep only the (stable) shared state and look up the rest by ID. */
+
+	const m::ChannelShared* m_shared;
 };
 
 /* getChannels
@@ -145,6 +145,8 @@ AudioData getAudioData()
 
 #endif
 
+	audioData.apis[G_SYS_API_NULL] = "Null (no audio device)";
+
 	std::vector<m::KernelAudio::Device> devices = g_engine.kernelAudio.getDevices();
 
 	for (const m::KernelAudio::Device& device : devices)
@@ -161,6 +163,7 @@ AudioData getAudioData()
 	audioData.limitOutput     = g_engine.conf.data.limitOutput;
 	audioData.recTriggerLevel = g_engine.conf.data.recTriggerLevel;
 	audioData.resampleQuality = g_engine.conf.data.rsmpQuality;
+	audioData.renderThreads   = g_engine.conf.data.renderThreads;
 	audioData.outputDevice    = getAudioDeviceData_(DeviceType::OUTPUT,
         g_engine.conf.data.soundDeviceOut, g_engine.conf.data.channelsOutCount,
         g_engine.conf.data.channelsOutStart);
@@ -203,6 +206,7 @@ MidiData getMidiData()
 
 	midiData.syncModes[G_MIDI_SYNC_NONE]    = "(disabled)";
 	midiData.syncModes[G_MIDI_SYNC_CLOCK_M] = "MIDI Clock (master)";
+	midiData.syncModes[G_MIDI_SYNC_CLOCK_S] = "MIDI Clock (slave)";
 	midiData.syncModes[G_MIDI_SYNC_MTC_M]   = "MTC (master)";
 
 	midiData.midiMaps = g_engine.midiMapper.getMapFilesFound();
@@ -256,6 +260,7 @@ void save(const AudioData& data)
 	g_engine.conf.data.channelsInStart  = data.inputDevice.channelsStart;
 	g_engine.conf.data.limitOutput      = data.limitOutput;
 	g_engine.conf.data.rsmpQuality      = data.resampleQuality;
+	g_engine.conf.data.renderThreads    = data.renderThreads;
 	g_engine.conf.data.buffersize       = data.bufferSize;
 	g_engine.conf.data.recTriggerLevel  = data.recTriggerLevel;
 	g_engine.conf.data.samplerate       = data.sampleRate;
@@ -77,6 +77,7 @@ struct AudioData
 	bool            limitOutput;
 	float           recTriggerLevel;
 	int             resampleQuality;
+	int             renderThreads;
 };
 
 struct MidiData
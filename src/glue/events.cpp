@@ -66,46 +66,53 @@ namespace
 {
 void pushEvent_(m::EventDispatcher::Event e, Thread t)
 {
-	bool res = true;
-	if (t == Thread::MAIN)
-	{
-		res = g_engine.eventDispatcher.UIevents.push(e);
-	}
-	else if (t == Thread::MIDI)
+	assert(t == Thread::MAIN || t == Thread::MIDI);
+
+	const bool res = g_engine.eventDispatcher.pumpEvent(e);
+	if (t == Thread::MIDI)
 	{
-		res = g_engine.eventDispatcher.MidiEvents.push(e);
 		u::gui::ScopedLock lock;
 		g_ui.mainWindow->keyboard->notifyMidiIn(e.channelId);
 	}
-	else
-	{
-		assert(false);
-	}
 
 	if (!res)
 		G_DEBUG("[events] Queue full!\n");
 }
+
+/* -------------------------------------------------------------------------- */
+
+/* notifyMidiIn_
+Continuous parameters skip the Event Dispatcher (see setChannelVolume() and 
+friends): blink the MIDI activity light by hand as pushEvent_() would do. */
+
+void notifyMidiIn_(ID channelId, Thread t)
+{
+	if (t != Thread::MIDI)
+		return;
+	u::gui::ScopedLock lock;
+	g_ui.mainWindow->keyboard->notifyMidiIn(channelId);
+}
 } // namespace
 
 /* -------------------------------------------------------------------------- */
 /* -------------------------------------------------------------------------- */
 /* -------------------------------------------------------------------------- */
 
-void pressChannel(ID channelId, int velocity, Thread t)
+void pressChannel(ID channelId, int velocity, Thread t, Frame delta)
 {
 	m::MidiEvent e;
 	e.setVelocity(velocity);
-	pushEvent_({m::EventDispatcher::EventType::KEY_PRESS, 0, channelId, velocity}, t);
+	pushEvent_({m::EventDispatcher::EventType::KEY_PRESS, delta, channelId, velocity}, t);
 }
 
-void releaseChannel(ID channelId, Thread t)
+void releaseChannel(ID channelId, Thread t, Frame delta)
 {
-	pushEvent_({m::EventDispatcher::EventType::KEY_RELEASE, 0, channelId, {}}, t);
+	pushEvent_({m::EventDispatcher::EventType::KEY_RELEASE, delta, channelId, {}}, t);
 }
 
-void killChannel(ID channelId, Thread t)
+void killChannel(ID channelId, Thread t, Frame delta)
 {
-	pushEvent_({m::EventDispatcher::EventType::KEY_KILL, 0, channelId, {}}, t);
+	pushEvent_({m::EventDispatcher::EventType::KEY_KILL, delta, channelId, {}}, t);
 }
 
 /* -------------------------------------------------------------------------- */
@@ -114,7 +121,8 @@ float setChannelVolume(ID channelId, float v, Thread t, bool repaintMainUi)
 {
 	v = std::clamp(v, 0.0f, G_MAX_VOLUME);
 
-	pushEvent_({m::EventDispatcher::EventType::CHANNEL_VOLUME, 0, channelId, v}, t);
+	g_engine.channelManager.setVolume(channelId, v);
+	notifyMidiIn_(channelId, t);
 
 	if (t != Thread::MAIN || repaintMainUi)
 	{
@@ -131,7 +139,8 @@ float setChannelPitch(ID channelId, float v, Thread t)
 {
 	v = std::clamp(v, G_MIN_PITCH, G_MAX_PITCH);
 
-	pushEvent_({m::EventDispatcher::EventType::CHANNEL_PITCH, 0, channelId, v}, t);
+	g_engine.channelManager.setPitch(channelId, v);
+	notifyMidiIn_(channelId, t);
 
 	sampleEditor::onRefresh(t, [v](v::gdSampleEditor& e) { e.pitchTool->update(v); });
 
@@ -144,8 +153,7 @@ float sendChannelPan(ID channelId, float v)
 {
 	v = std::clamp(v, 0.0f, G_MAX_PAN);
 
-	/* Pan event is currently triggered only by the main thread. */
-	pushEvent_({m::EventDispatcher::EventType::CHANNEL_PAN, 0, channelId, v}, Thread::MAIN);
+	g_engine.channelManager.setPan(channelId, v);
 
 	return v;
 }
@@ -181,9 +189,13 @@ void killReadActionsChannel(ID channelId, Thread t)
 
 /* -------------------------------------------------------------------------- */
 
-void sendMidiToChannel(ID channelId, m::MidiEvent e, Thread t)
+void sendMidiToChannel(ID channelId, m::MidiEvent e, Thread t, bool played)
 {
-	pushEvent_({m::EventDispatcher::EventType::MIDI, 0, channelId, m::Action{0, channelId, 0, e}}, t);
+	/* If already played by the direct MIDI path, the event is just for the
+	action recorder. */
+
+	const auto type = played ? m::EventDispatcher::EventType::MIDI_DIRECT : m::EventDispatcher::EventType::MIDI;
+	pushEvent_({type, e.getDelta(), channelId, m::Action{0, channelId, 0, e}}, t);
 }
 
 /* -------------------------------------------------------------------------- */
@@ -197,7 +209,7 @@ void toggleMetronome()
 
 void setMasterInVolume(float v, Thread t)
 {
-	pushEvent_({m::EventDispatcher::EventType::CHANNEL_VOLUME, 0, m::Mixer::MASTER_IN_CHANNEL_ID, v}, t);
+	g_engine.channelManager.setVolume(m::Mixer::MASTER_IN_CHANNEL_ID, v);
 
 	if (t != Thread::MAIN)
 	{
@@ -208,7 +220,7 @@ void setMasterInVolume(float v, Thread t)
 
 void setMasterOutVolume(float v, Thread t)
 {
-	pushEvent_({m::EventDispatcher::EventType::CHANNEL_VOLUME, 0, m::Mixer::MASTER_OUT_CHANNEL_ID, v}, t);
+	g_engine.channelManager.setVolume(m::Mixer::MASTER_OUT_CHANNEL_ID, v);
 
 	if (t != Thread::MAIN)
 	{
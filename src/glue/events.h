@@ -42,11 +42,14 @@ class MidiEvent;
 namespace giada::c::events
 {
 /* Channel*
-Channel-related events. */
+Channel-related events. Optional 'delta' is the frame offset within the next
+audio block where the event should take effect (e.g. for timestamped MIDI 
+input). 'played' marks MIDI events already sent to plug-ins by MidiDispatcher's
+direct path. */
 
-void  pressChannel(ID channelId, int velocity, Thread t);
-void  releaseChannel(ID channelId, Thread t);
-void  killChannel(ID channelId, Thread t);
+void  pressChannel(ID channelId, int velocity, Thread t, Frame delta = 0);
+void  releaseChannel(ID channelId, Thread t, Frame delta = 0);
+void  killChannel(ID channelId, Thread t, Frame delta = 0);
 float setChannelVolume(ID channelId, float v, Thread t, bool repaintMainUi = false);
 float setChannelPitch(ID channelId, float v, Thread t);
 float sendChannelPan(ID channelId, float v); // FIXME typo: should be setChannelPan
@@ -55,7 +58,7 @@ void  toggleSoloChannel(ID channelId, Thread t);
 void  toggleArmChannel(ID channelId, Thread t);
 void  toggleReadActionsChannel(ID channelId, Thread t);
 void  killReadActionsChannel(ID channelId, Thread t);
-void  sendMidiToChannel(ID channelId, m::MidiEvent e, Thread t);
+void  sendMidiToChannel(ID channelId, m::MidiEvent e, Thread t, bool played = false);
 
 /* Main*
 Master I/O, transport and other engine-related events. */
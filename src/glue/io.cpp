@@ -50,6 +50,7 @@
 #include "utils/log.h"
 #include "utils/math.h"
 #include <FL/Fl.H>
+#include <utility>
 
 extern giada::v::Ui     g_ui;
 extern giada::m::Engine g_engine;
@@ -152,14 +153,14 @@ Master_InputData::Master_InputData(const m::model::MidiIn& midiIn)
 
 Channel_InputData channel_getInputData(ID channelId)
 {
-	return Channel_InputData(g_engine.model.get().getChannel(channelId));
+	return Channel_InputData(std::as_const(g_engine.model).get().getChannel(channelId));
 }
 
 /* -------------------------------------------------------------------------- */
 
 Channel_OutputData channel_getOutputData(ID channelId)
 {
-	return Channel_OutputData(g_engine.model.get().getChannel(channelId));
+	return Channel_OutputData(std::as_const(g_engine.model).get().getChannel(channelId));
 }
 
 /* -------------------------------------------------------------------------- */
@@ -97,6 +97,15 @@ void openBrowserForSampleSave(ID channelId)
 
 /* -------------------------------------------------------------------------- */
 
+void openBrowserForRender()
+{
+	v::gdWindow* w = new v::gdBrowserSave(g_ui.langMapper.get(v::LangMap::BROWSER_RENDERPROJECT),
+	    g_engine.conf.data.samplePath.c_str(), g_engine.patch.data.name, c::storage::renderProject, 0, g_engine.conf.data);
+	g_ui.openSubWindow(*g_ui.mainWindow.get(), w, WID_FILE_BROWSER);
+}
+
+/* -------------------------------------------------------------------------- */
+
 void openAboutWindow()
 {
 	g_ui.openSubWindow(*g_ui.mainWindow.get(), new v::gdAbout(), WID_ABOUT);
@@ -52,6 +52,7 @@ void openBrowserForProjectLoad();
 void openBrowserForProjectSave();
 void openBrowserForSampleLoad(ID channelId);
 void openBrowserForSampleSave(ID channelId);
+void openBrowserForRender();
 void openAboutWindow();
 void openKeyGrabberWindow(int key, std::function<bool(int)>);
 void openBpmWindow(std::string bpmValue);
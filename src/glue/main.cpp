@@ -35,6 +35,7 @@
 #include "core/model/model.h"
 #include "core/plugins/pluginHost.h"
 #include "core/plugins/pluginManager.h"
+#include "core/profiler.h"
 #include "core/recorder.h"
 #include "core/sequencer.h"
 #include "core/synchronizer.h"
@@ -51,14 +52,62 @@
 #include "utils/log.h"
 #include "utils/string.h"
 #include <FL/Fl.H>
+#include <algorithm>
 #include <cassert>
 #include <cmath>
+#include <utility>
 
 extern giada::v::Ui     g_ui;
 extern giada::m::Engine g_engine;
 
 namespace giada::c::main
 {
+namespace
+{
+void printStats_(const std::string& label, const m::Profiler::Stats& s)
+{
+	u::log::print("[profiler] %-24s avg=%5.1f%% peak=%6.1f%% overruns=%u\n", label,
+	    s.getAverage() * 100.0f, s.getPeak() * 100.0f, s.getOverruns());
+}
+
+/* -------------------------------------------------------------------------- */
+
+void printProfilerReport_()
+{
+	const m::Profiler& profiler = g_engine.profiler;
+
+	u::log::print("[profiler] ---- DSP load report (xruns=%u) ----\n", profiler.getXruns());
+	printStats_("block", profiler.getStage(m::Profiler::Stage::BLOCK));
+	printStats_("sequencer", profiler.getStage(m::Profiler::Stage::SEQUENCER));
+	printStats_("channels", profiler.getStage(m::Profiler::Stage::CHANNELS));
+	printStats_("output", profiler.getStage(m::Profiler::Stage::OUTPUT));
+
+	const m::Profiler::Histogram& latency = profiler.getEventLatency();
+	u::log::print("[profiler] %-24s events=%u p50<%lluus p99<%lluus max<%lluus\n", "event latency",
+	    latency.getCount(), static_cast<unsigned long long>(latency.getPercentile(0.5f)),
+	    static_cast<unsigned long long>(latency.getPercentile(0.99f)),
+	    static_cast<unsigned long long>(latency.getPercentile(1.0f)));
+	u::log::print("[profiler] %-24s dropped=%u high-water=%u/%d\n", "event queue",
+	    g_engine.eventDispatcher.getDroppedEvents(), g_engine.eventDispatcher.getQueueHighWater(),
+	    G_MAX_DISPATCHER_EVENTS);
+	u::log::print("[profiler] %-24s dropped=%u high-water=%u/%d\n", "midi out queue",
+	    g_engine.kernelMidi.getDroppedOutEvents(), g_engine.kernelMidi.getOutQueueHighWater(),
+	    G_MAX_MIDI_OUT_EVENTS);
+
+	for (const m::Channel& ch : g_engine.model.get().channels)
+	{
+		if (!ch.isInternal())
+			printStats_("channel " + std::to_string(ch.id) + " " + ch.name, ch.shared->profile);
+		for (const m::Plugin* p : ch.plugins)
+			printStats_("  plugin " + std::to_string(p->id) + " " + p->getName(), p->profile);
+	}
+}
+} // namespace
+
+/* -------------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------- */
+
 Timer::Timer(const m::model::Sequencer& c)
 : bpm(c.bpm)
 , beats(c.beats)
@@ -74,8 +123,8 @@ Timer::Timer(const m::model::Sequencer& c)
 /* -------------------------------------------------------------------------- */
 
 IO::IO(const m::Channel& out, const m::Channel& in, const m::model::Mixer& m)
-: masterOutVol(out.volume)
-, masterInVol(in.volume)
+: masterOutVol(out.shared->volume.load())
+, masterInVol(in.shared->volume.load())
 , masterOutHasPlugins(out.plugins.size() > 0)
 , masterInHasPlugins(in.plugins.size() > 0)
 , inToOut(m.inToOut)
@@ -101,6 +150,40 @@ bool IO::isKernelReady()
 	return g_engine.kernelAudio.isReady();
 }
 
+/* -------------------------------------------------------------------------- */
+
+float IO::getDspLoad()
+{
+	return g_engine.profiler.getStage(m::Profiler::Stage::BLOCK).getAverage();
+}
+
+bool IO::isProfilerEnabled()
+{
+	return g_engine.profiler.isEnabled();
+}
+
+std::vector<DspLoad> IO::getDspLoads()
+{
+	std::vector<DspLoad> out;
+	for (const m::Channel& ch : g_engine.model.get().channels)
+	{
+		if (!ch.isInternal())
+			out.push_back({ch.name, ch.shared->profile.getAverage(), ch.shared->profile.getPeak()});
+		for (const m::Plugin* p : ch.plugins)
+			out.push_back({p->getName(), p->profile.getAverage(), p->profile.getPeak()});
+	}
+	std::sort(out.begin(), out.end(), [](const DspLoad& a, const DspLoad& b) { return a.average > b.average; });
+	return out;
+}
+
+/* -------------------------------------------------------------------------- */
+
+bool IO::hasDroppedEvents()
+{
+	return g_engine.eventDispatcher.getDroppedEvents() > 0 ||
+	       g_engine.kernelMidi.getDroppedOutEvents() > 0;
+}
+
 /* -------------------------------------------------------------------------- */
 /* -------------------------------------------------------------------------- */
 /* -------------------------------------------------------------------------- */
@@ -114,8 +197,8 @@ Timer getTimer()
 
 IO getIO()
 {
-	return IO(g_engine.model.get().getChannel(m::Mixer::MASTER_OUT_CHANNEL_ID),
-	    g_engine.model.get().getChannel(m::Mixer::MASTER_IN_CHANNEL_ID),
+	return IO(std::as_const(g_engine.model).get().getChannel(m::Mixer::MASTER_OUT_CHANNEL_ID),
+	    std::as_const(g_engine.model).get().getChannel(m::Mixer::MASTER_IN_CHANNEL_ID),
 	    g_engine.model.get().mixer);
 }
 
@@ -196,7 +279,7 @@ void setBeats(int beats, int bars)
 		return;
 
 	g_engine.sequencer.setBeats(beats, bars, g_engine.kernelAudio.getSampleRate());
-	g_engine.mixer.allocRecBuffer(g_engine.sequencer.getMaxFramesInLoop(g_engine.kernelAudio.getSampleRate()));
+	g_engine.updateMixerModel();
 }
 
 /* -------------------------------------------------------------------------- */
@@ -251,6 +334,17 @@ void toggleRecOnSignal()
 
 /* -------------------------------------------------------------------------- */
 
+void toggleProfiler()
+{
+	const bool enable = !g_engine.profiler.isEnabled();
+	if (!enable)
+		printProfilerReport_();
+	g_engine.profiler.setEnabled(enable);
+	g_engine.conf.data.profilerEnabled = enable;
+}
+
+/* -------------------------------------------------------------------------- */
+
 void toggleFreeInputRec()
 {
 	if (!g_engine.recorder.canEnableFreeInputRec())
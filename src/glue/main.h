@@ -28,6 +28,8 @@
 #define G_MAIN_H
 
 #include "core/types.h"
+#include <string>
+#include <vector>
 
 namespace giada::m
 {
@@ -55,6 +57,13 @@ struct Timer
 	bool  isRecordingInput;
 };
 
+struct DspLoad
+{
+	std::string name;
+	float       average;
+	float       peak;
+};
+
 struct IO
 {
 	IO() = default;
@@ -69,6 +78,25 @@ struct IO
 	Peak getMasterOutPeak();
 	Peak getMasterInPeak();
 	bool isKernelReady();
+
+	/* getDspLoad
+	Returns the average time spent in the audio callback, as a fraction of the
+	block duration. Meaningful only if the profiler is enabled. */
+
+	float getDspLoad();
+	bool  isProfilerEnabled();
+
+	/* getDspLoads
+	Returns the load of each channel and plug-in, heaviest first. Meaningful 
+	only if the profiler is enabled. */
+
+	std::vector<DspLoad> getDspLoads();
+
+	/* hasDroppedEvents
+	True if the Event Dispatcher had to discard some input events, or the MIDI
+	output some outgoing messages, because their queue was full. */
+
+	bool hasDroppedEvents();
 };
 
 struct Sequencer
@@ -129,6 +157,12 @@ void setInToOut(bool v);
 
 void toggleRecOnSignal();
 void toggleFreeInputRec();
+
+/* toggleProfiler
+Enables or disables the DSP load profiler. When disabling, a detailed report
+with per-stage, per-channel and per-plugin CPU usage is written to the log. */
+
+void toggleProfiler();
 #ifdef G_DEBUG_MODE
 void printDebugInfo();
 #endif
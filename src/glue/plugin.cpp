@@ -42,6 +42,7 @@
 #include <FL/Fl.H>
 #include <cassert>
 #include <memory>
+#include <utility>
 
 extern giada::v::Ui     g_ui;
 extern giada::m::Engine g_engine;
@@ -115,7 +116,7 @@ Plugins::Plugins(const m::Channel& c)
 
 Plugins getPlugins(ID channelId)
 {
-	return Plugins(g_engine.model.get().getChannel(channelId));
+	return Plugins(std::as_const(g_engine.model).get().getChannel(channelId));
 }
 
 Plugin getPlugin(m::Plugin& plugin, const m::Conf::Data& conf, ID channelId)
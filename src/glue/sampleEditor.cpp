@@ -52,6 +52,7 @@
 #include <FL/Fl.H>
 #include <cassert>
 #include <memory>
+#include <utility>
 
 extern giada::v::Ui     g_ui;
 extern giada::m::Engine g_engine;
@@ -60,19 +61,28 @@ namespace giada::c::sampleEditor
 {
 namespace
 {
-m::Channel& getChannel_(ID channelId)
+/* getChannel_, editChannel_
+Read-only and writable access to a channel. The latter clones the channel if 
+it is still shared with the realtime layout. */
+
+const m::Channel& getChannel_(ID channelId)
+{
+	return std::as_const(g_engine.model).get().getChannel(channelId);
+}
+
+m::Channel& editChannel_(ID channelId)
 {
 	return g_engine.model.get().getChannel(channelId);
 }
 
 m::SamplePlayer& getSamplePlayer_(ID channelId)
 {
-	return getChannel_(channelId).samplePlayer.value();
+	return editChannel_(channelId).samplePlayer.value();
 }
 
 m::Wave& getWave_(ID channelId)
 {
-	return *const_cast<m::Wave*>(getSamplePlayer_(channelId).getWave());
+	return *const_cast<m::Wave*>(getChannel_(channelId).samplePlayer->getWave());
 }
 
 /* -------------------------------------------------------------------------- */
@@ -104,9 +114,9 @@ void resetBeginEnd_(ID channelId)
 Data::Data(const m::Channel& c)
 : channelId(c.id)
 , name(c.name)
-, volume(c.volume)
-, pan(c.pan)
-, pitch(c.samplePlayer->pitch)
+, volume(c.shared->volume.load())
+, pan(c.shared->pan.load())
+, pitch(c.shared->pitch.load())
 , begin(c.samplePlayer->begin)
 , end(c.samplePlayer->end)
 , shift(c.samplePlayer->shift)
@@ -116,7 +126,6 @@ Data::Data(const m::Channel& c)
 , waveRate(c.samplePlayer->getWave()->getRate())
 , wavePath(c.samplePlayer->getWave()->getPath())
 , isLogical(c.samplePlayer->getWave()->isLogical())
-, m_channel(&c)
 {
 }
 
@@ -132,7 +141,7 @@ Frame Data::a_getPreviewTracker() const
 
 const m::Wave& Data::getWaveRef() const
 {
-	return *m_channel->samplePlayer->getWave();
+	return *getChannel_(channelId).samplePlayer->getWave();
 }
 
 Frame Data::getFramesInBar() const
@@ -152,7 +161,7 @@ Frame Data::getFramesInLoop() const
 Data getData(ID channelId)
 {
 	/* Prepare the preview channel first, then return Data object. */
-	m::Channel& previewChannel = getChannel_(m::Mixer::PREVIEW_CHANNEL_ID);
+	m::Channel& previewChannel = editChannel_(m::Mixer::PREVIEW_CHANNEL_ID);
 	previewChannel.samplePlayer->loadWave(*previewChannel.shared, &getWave_(channelId));
 	g_engine.model.swap(m::model::SwapType::SOFT);
 
@@ -182,7 +191,7 @@ v::gdSampleEditor* getSampleEditorWindow()
 
 void setBeginEnd(ID channelId, Frame b, Frame e)
 {
-	m::Channel& c = getChannel_(channelId);
+	const m::Channel& c = getChannel_(channelId);
 
 	b = std::clamp(b, 0, c.samplePlayer->getWaveSize() - 1);
 	e = std::clamp(e, 1, c.samplePlayer->getWaveSize() - 1);
@@ -204,8 +213,7 @@ void setBeginEnd(ID channelId, Frame b, Frame e)
 void cut(ID channelId, Frame a, Frame b)
 {
 	copy(channelId, a, b);
-	m::model::DataLock lock = g_engine.model.lockData();
-	m::wfx::cut(getWave_(channelId), a, b);
+	g_engine.channelManager.editWave(channelId, [a, b](m::Wave& w) { m::wfx::cut(w, a, b); });
 	resetBeginEnd_(channelId);
 }
 
@@ -226,22 +234,10 @@ void paste(ID channelId, Frame a)
 		return;
 	}
 
-	/* Get the existing wave in channel. */
-
-	m::Wave& wave = getWave_(channelId);
-
-	/* Temporary disable wave reading in channel. From now on, the audio thread
-	won't be reading any wave, so editing it is safe.  */
-
-	m::model::DataLock lock = g_engine.model.lockData();
-
-	/* Paste copied data to destination wave. */
-
-	m::wfx::paste(*waveBuffer_, wave, a);
-
-	/* Pass the old wave that contains the pasted data to channel. */
+	/* Paste copied data to a copy of the destination wave. The audio thread
+	keeps reading the original one until the copy is published. */
 
-	getChannel_(channelId).samplePlayer->setWave(&wave, 1.0f);
+	g_engine.channelManager.editWave(channelId, [a](m::Wave& w) { m::wfx::paste(*waveBuffer_, w, a); });
 
 	/* In the meantime, shift begin/end points to keep the previous position. */
 
@@ -261,48 +257,42 @@ void paste(ID channelId, Frame a)
 
 void silence(ID channelId, int a, int b)
 {
-	m::model::DataLock lock = g_engine.model.lockData();
-	m::wfx::silence(getWave_(channelId), a, b);
+	g_engine.channelManager.editWave(channelId, [a, b](m::Wave& w) { m::wfx::silence(w, a, b); });
 }
 
 /* -------------------------------------------------------------------------- */
 
 void fade(ID channelId, int a, int b, m::wfx::Fade type)
 {
-	m::model::DataLock lock = g_engine.model.lockData();
-	m::wfx::fade(getWave_(channelId), a, b, type);
+	g_engine.channelManager.editWave(channelId, [a, b, type](m::Wave& w) { m::wfx::fade(w, a, b, type); });
 }
 
 /* -------------------------------------------------------------------------- */
 
 void smoothEdges(ID channelId, int a, int b)
 {
-	m::model::DataLock lock = g_engine.model.lockData();
-	m::wfx::smooth(getWave_(channelId), a, b);
+	g_engine.channelManager.editWave(channelId, [a, b](m::Wave& w) { m::wfx::smooth(w, a, b); });
 }
 
 /* -------------------------------------------------------------------------- */
 
 void reverse(ID channelId, Frame a, Frame b)
 {
-	m::model::DataLock lock = g_engine.model.lockData();
-	m::wfx::reverse(getWave_(channelId), a, b);
+	g_engine.channelManager.editWave(channelId, [a, b](m::Wave& w) { m::wfx::reverse(w, a, b); });
 }
 
 /* -------------------------------------------------------------------------- */
 
 void normalize(ID channelId, int a, int b)
 {
-	m::model::DataLock lock = g_engine.model.lockData();
-	m::wfx::normalize(getWave_(channelId), a, b);
+	g_engine.channelManager.editWave(channelId, [a, b](m::Wave& w) { m::wfx::normalize(w, a, b); });
 }
 
 /* -------------------------------------------------------------------------- */
 
 void trim(ID channelId, int a, int b)
 {
-	m::model::DataLock lock = g_engine.model.lockData();
-	m::wfx::trim(getWave_(channelId), a, b);
+	g_engine.channelManager.editWave(channelId, [a, b](m::Wave& w) { m::wfx::trim(w, a, b); });
 	resetBeginEnd_(channelId);
 }
 
@@ -330,7 +320,7 @@ void stopPreview()
 
 void togglePreview(bool shouldLoop)
 {
-	const bool isPlaying = g_engine.model.get().getChannel(m::Mixer::PREVIEW_CHANNEL_ID).isPlaying();
+	const bool isPlaying = getChannel_(m::Mixer::PREVIEW_CHANNEL_ID).isPlaying();
 	isPlaying ? stopPreview() : playPreview(shouldLoop);
 }
 
@@ -338,7 +328,7 @@ void togglePreview(bool shouldLoop)
 
 void setPreviewTracker(Frame f)
 {
-	g_engine.model.get().getChannel(m::Mixer::PREVIEW_CHANNEL_ID).shared->tracker.store(f);
+	getChannel_(m::Mixer::PREVIEW_CHANNEL_ID).shared->tracker.store(f);
 	g_engine.model.swap(m::model::SwapType::SOFT);
 
 	previewTracker_ = f;
@@ -348,7 +338,7 @@ void setPreviewTracker(Frame f)
 
 void cleanupPreview()
 {
-	m::Channel& channel = getChannel_(m::Mixer::PREVIEW_CHANNEL_ID);
+	m::Channel& channel = editChannel_(m::Mixer::PREVIEW_CHANNEL_ID);
 
 	channel.samplePlayer->loadWave(*channel.shared, nullptr);
 	g_engine.model.swap(m::model::SwapType::SOFT);
@@ -394,10 +384,10 @@ void shift(ID channelId, Frame offset)
 {
 	Frame shift = getSamplePlayer_(channelId).shift;
 
-	m::model::DataLock lock = g_engine.model.lockData();
+	/* The new shift value is published along with the shifted wave. */
 
-	m::wfx::shift(getWave_(channelId), offset - shift);
 	getSamplePlayer_(channelId).shift = offset;
+	g_engine.channelManager.editWave(channelId, [offset, shift](m::Wave& w) { m::wfx::shift(w, offset - shift); });
 
 	getSampleEditorWindow()->shiftTool->update(offset);
 }
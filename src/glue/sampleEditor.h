@@ -70,9 +70,6 @@ struct Data
 	int         waveRate;
 	std::string wavePath;
 	bool        isLogical;
-
-private:
-	const m::Channel* m_channel;
 };
 
 /* onRefresh --- TODO - wrong name */
@@ -55,6 +55,7 @@
 #include "utils/log.h"
 #include "utils/string.h"
 #include <cassert>
+#include <utility>
 
 extern giada::m::Engine g_engine;
 extern giada::v::Ui     g_ui;
@@ -179,7 +180,7 @@ void saveSample(void* data)
 	        g_ui.langMapper.get(v::LangMap::MESSAGE_STORAGE_FILEEXISTS)))
 		return;
 
-	ID       waveId = g_engine.model.get().getChannel(channelId).samplePlayer->getWaveId();
+	ID       waveId = std::as_const(g_engine.model).get().getChannel(channelId).samplePlayer->getWaveId();
 	m::Wave* wave   = g_engine.model.findShared<m::Wave>(waveId);
 
 	assert(wave != nullptr);
@@ -196,14 +197,56 @@ void saveSample(void* data)
 
 	g_engine.conf.data.samplePath = u::fs::dirname(filePath);
 
-	/* Update logical and edited states in Wave. */
+	/* Update logical and edited states in Wave. The audio thread doesn't read
+	them, so the Wave can be changed in place. Swap anyway to refresh the UI. */
 
-	m::model::DataLock lock = g_engine.model.lockData();
 	wave->setLogical(false);
 	wave->setEdited(false);
+	g_engine.model.swap(m::model::SwapType::HARD);
 
 	/* Finally close the browser. */
 
 	browser->do_callback();
 }
+
+/* -------------------------------------------------------------------------- */
+
+void renderProject(void* data)
+{
+	v::gdBrowserSave* browser = static_cast<v::gdBrowserSave*>(data);
+	const std::string name    = browser->getName();
+
+	if (name == "")
+	{
+		v::gdAlert(g_ui.langMapper.get(v::LangMap::MESSAGE_STORAGE_CHOOSEFILENAME));
+		return;
+	}
+
+	const std::string ext      = u::fs::getExt(name) == ".flac" ? ".flac" : ".wav";
+	const std::string filePath = u::fs::join(browser->getCurrentPath(), u::fs::stripExt(name) + ext);
+
+	if (u::fs::fileExists(filePath) &&
+	    !v::gdConfirmWin(g_ui.langMapper.get(v::LangMap::COMMON_WARNING),
+	        g_ui.langMapper.get(v::LangMap::MESSAGE_STORAGE_FILEEXISTS)))
+		return;
+
+	auto progress   = g_ui.mainWindow->getScopedProgress(g_ui.langMapper.get(v::LangMap::MESSAGE_STORAGE_RENDERINGPROJECT));
+	auto progressCb = [&p = progress.get()](float v) {
+		p.setProgress(v);
+	};
+
+	m::OfflineRenderer::Params params;
+	params.path = filePath;
+	params.bars = g_engine.sequencer.getBars();
+
+	if (g_engine.renderOffline(params, progressCb) != G_RES_OK)
+	{
+		v::gdAlert(g_ui.langMapper.get(v::LangMap::MESSAGE_STORAGE_RENDERINGPROJECTERROR));
+		return;
+	}
+
+	g_engine.conf.data.samplePath = u::fs::dirname(filePath);
+
+	browser->do_callback();
+}
 } // namespace giada::c::storage
\ No newline at end of file
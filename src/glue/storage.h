@@ -32,6 +32,12 @@ namespace giada::c::storage
 void loadProject(void* data);
 void saveProject(void* data);
 void saveSample(void* data);
+
+/* renderProject
+Callback attached to the save browser: bounces the whole loop of the current
+project to an audio file. */
+
+void renderProject(void* data);
 void loadSample(void* data);
 } // namespace giada::c::storage
 
@@ -373,7 +373,7 @@ void gePianoRoll::rebuild(c::actionEditor::Data& d)
 
 		assert(a1.isValid()); // a2 might be null if orphaned
 
-		const m::Action& a2 = a1.next != nullptr ? *a1.next : m::Action{};
+		const m::Action a2 = m_data->getAction(a1.nextId);
 
 		Pixel px = x() + m_base->frameToPixel(a1.frame);
 		Pixel py = y() + noteToY(a1.event.getNote());
@@ -168,7 +168,8 @@ geTabAudio::geTabAudio(geompp::Rect<int> bounds)
 			line4->end();
 		}
 
-		rsmpQuality = new geChoice(g_ui.langMapper.get(LangMap::CONFIG_AUDIO_RESAMPLING), LABEL_WIDTH);
+		rsmpQuality   = new geChoice(g_ui.langMapper.get(LangMap::CONFIG_AUDIO_RESAMPLING), LABEL_WIDTH);
+		renderThreads = new geChoice(g_ui.langMapper.get(LangMap::CONFIG_AUDIO_RENDERTHREADS), LABEL_WIDTH);
 
 		body->add(soundsys, 20);
 		body->add(line1, 20);
@@ -177,6 +178,7 @@ geTabAudio::geTabAudio(geompp::Rect<int> bounds)
 		body->add(line3, 20);
 		body->add(line4, 20);
 		body->add(rsmpQuality, 20);
+		body->add(renderThreads, 20);
 		body->add(new geBox(g_ui.langMapper.get(LangMap::CONFIG_RESTARTGIADA)));
 		body->end();
 	}
@@ -235,6 +237,12 @@ geTabAudio::geTabAudio(geompp::Rect<int> bounds)
 	rsmpQuality->showItem(m_data.resampleQuality);
 	rsmpQuality->onChange = [this](ID id) { m_data.resampleQuality = id; };
 
+	renderThreads->addItem(g_ui.langMapper.get(LangMap::CONFIG_AUDIO_RENDERTHREADS_OFF), 0);
+	for (int i = 1; i <= G_MAX_RENDER_THREADS; i++)
+		renderThreads->addItem(std::to_string(i), i);
+	renderThreads->showItem(m_data.renderThreads);
+	renderThreads->onChange = [this](ID id) { m_data.renderThreads = id; };
+
 	recTriggerLevel->setValue(u::string::fToString(m_data.recTriggerLevel, 1));
 	recTriggerLevel->onChange = [this](const std::string& s) { m_data.recTriggerLevel = std::stof(s); };
 
@@ -303,6 +311,7 @@ void geTabAudio::deactivateAll()
 	channelsIn->deactivate();
 	recTriggerLevel->deactivate();
 	rsmpQuality->deactivate();
+	renderThreads->deactivate();
 }
 
 /* -------------------------------------------------------------------------- */
@@ -315,6 +324,7 @@ void geTabAudio::activateAll()
 	channelsOut->activate();
 	samplerate->activate();
 	rsmpQuality->activate();
+	renderThreads->activate();
 	if (m_data.inputDevice.index != -1)
 	{
 		sounddevIn->activate();
@@ -75,6 +75,7 @@ public:
 	geChannelMenu* channelsIn;
 	geInput*       recTriggerLevel;
 	geChoice*      rsmpQuality;
+	geChoice*      renderThreads;
 
 private:
 	void invalidate();
@@ -0,0 +1,87 @@
+/* -----------------------------------------------------------------------------
+ *
+ * Giada - Your Hardcore Loopmachine
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2022 Giovanni A. Zuliani | Monocasual Laboratories
+ *
+ * This file is part of Giada - Your Hardcore Loopmachine.
+ *
+ * Giada - Your Hardcore Loopmachine is free software: you can
+ * redistribute it and/or modify it under the terms of the GNU General
+ * Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * Giada - Your Hardcore Loopmachine is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Giada - Your Hardcore Loopmachine. If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------- */
+
+#include "gui/elems/dspMeter.h"
+#include "core/const.h"
+#include "gui/drawing.h"
+#include <FL/Fl.H>
+#include <algorithm>
+#include <cmath>
+#include <fmt/core.h>
+
+namespace giada::v
+{
+geDspMeter::geDspMeter()
+: Fl_Box(0, 0, 0, 0)
+, onClick(nullptr)
+, onTooltip(nullptr)
+, load(0.0f)
+, enabled(false)
+, dropped(false)
+{
+}
+
+/* -------------------------------------------------------------------------- */
+
+void geDspMeter::draw()
+{
+	const geompp::Rect outline(x(), y(), w(), h());
+	const geompp::Rect body(outline.reduced(1));
+
+	drawRect(outline, dropped ? G_COLOR_BLUE : G_COLOR_GREY_4);
+	drawRectf(body, G_COLOR_GREY_2); // Cleanup
+
+	if (!enabled)
+	{
+		drawText("DSP", body, FL_HELVETICA, G_GUI_FONT_SIZE_BASE, G_COLOR_GREY_4);
+		return;
+	}
+
+	/* Turn blue when close to the block budget: xruns are around the corner. */
+
+	const float loadClamped = std::clamp(load, 0.0f, 1.0f);
+	const int   color       = load > 0.8f ? G_COLOR_BLUE : G_COLOR_GREY_4;
+
+	drawRectf(body.withW(std::round(loadClamped * body.w)), color);
+	drawText(fmt::format("{}%", static_cast<int>(std::round(load * 100.0f))), body,
+	    FL_HELVETICA, G_GUI_FONT_SIZE_BASE, G_COLOR_LIGHT_2);
+}
+
+/* -------------------------------------------------------------------------- */
+
+int geDspMeter::handle(int e)
+{
+	if (e == FL_PUSH)
+	{
+		if (onClick != nullptr)
+			onClick();
+		return 1;
+	}
+	if (e == FL_ENTER && onTooltip != nullptr)
+		copy_tooltip(onTooltip().c_str()); // Fl_Tooltip reads it right after FL_ENTER
+	return Fl_Box::handle(e);
+}
+} // namespace giada::v
@@ -0,0 +1,60 @@
+/* -----------------------------------------------------------------------------
+ *
+ * Giada - Your Hardcore Loopmachine
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2022 Giovanni A. Zuliani | Monocasual Laboratories
+ *
+ * This file is part of Giada - Your Hardcore Loopmachine.
+ *
+ * Giada - Your Hardcore Loopmachine is free software: you can
+ * redistribute it and/or modify it under the terms of the GNU General
+ * Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * Giada - Your Hardcore Loopmachine is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Giada - Your Hardcore Loopmachine. If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------- */
+
+#ifndef GE_DSP_METER_H
+#define GE_DSP_METER_H
+
+#include <FL/Fl_Box.H>
+#include <functional>
+#include <string>
+
+namespace giada::v
+{
+/* geDspMeter
+Shows the average DSP load of the audio callback, i.e. the fraction of the 
+block duration spent rendering. Clicking on it toggles the profiler. The 
+outline is highlighted if some input events have been dropped. Hovering it
+shows the tooltip returned by 'onTooltip', if any, e.g. the per-channel and 
+per-plug-in breakdown. */
+
+class geDspMeter : public Fl_Box
+{
+public:
+	geDspMeter();
+
+	void draw() override;
+	int  handle(int e) override;
+
+	std::function<void()>        onClick;
+	std::function<std::string()> onTooltip;
+
+	float load;    // DSP load from Profiler, 1.0 = full block
+	bool  enabled; // Profiler state
+	bool  dropped; // Event Dispatcher has lost events
+};
+} // namespace giada::v
+
+#endif
@@ -33,10 +33,13 @@
 #include "gui/elems/basics/dial.h"
 #include "gui/elems/basics/imageButton.h"
 #include "gui/elems/basics/textButton.h"
+#include "gui/elems/dspMeter.h"
 #include "gui/elems/soundMeter.h"
 #include "gui/graphics.h"
 #include "gui/ui.h"
 #include "utils/gui.h"
+#include <algorithm>
+#include <fmt/core.h>
 
 extern giada::v::Ui g_ui;
 
@@ -47,6 +50,7 @@ geMainIO::geMainIO()
 {
 	m_outMeter    = new geSoundMeter(0, 0, 0, 0);
 	m_inMeter     = new geSoundMeter(0, 0, 0, 0);
+	m_dspMeter    = new geDspMeter();
 	m_outVol      = new geDial(0, 0, 0, 0);
 	m_inVol       = new geDial(0, 0, 0, 0);
 	m_inToOut     = new geTextButton("");
@@ -60,6 +64,7 @@ geMainIO::geMainIO()
 	add(m_outMeter);
 	add(m_outVol, G_GUI_UNIT);
 	add(m_masterFxOut, G_GUI_UNIT);
+	add(m_dspMeter, 40);
 	end();
 
 	m_outMeter->copy_tooltip(g_ui.langMapper.get(LangMap::MAIN_IO_LABEL_OUTMETER));
@@ -69,6 +74,7 @@ geMainIO::geMainIO()
 	m_inToOut->copy_tooltip(g_ui.langMapper.get(LangMap::MAIN_IO_LABEL_INTOOUT));
 	m_masterFxOut->copy_tooltip(g_ui.langMapper.get(LangMap::MAIN_IO_LABEL_FXOUT));
 	m_masterFxIn->copy_tooltip(g_ui.langMapper.get(LangMap::MAIN_IO_LABEL_FXIN));
+	m_dspMeter->copy_tooltip(g_ui.langMapper.get(LangMap::MAIN_IO_LABEL_DSPMETER));
 
 	m_outVol->onChange = [](float v) {
 		c::events::setMasterOutVolume(v, Thread::MAIN);
@@ -86,6 +92,24 @@ geMainIO::geMainIO()
 	m_masterFxOut->onClick = [] { c::layout::openMasterOutPluginListWindow(); };
 
 	m_masterFxIn->onClick = [] { c::layout::openMasterInPluginListWindow(); };
+
+	m_dspMeter->onClick   = [] { c::main::toggleProfiler(); };
+	m_dspMeter->onTooltip = [this]() {
+		std::string out = g_ui.langMapper.get(LangMap::MAIN_IO_LABEL_DSPMETER);
+		if (!m_io.isProfilerEnabled())
+			return out;
+
+		/* Show the heaviest ones only, the full list goes to the log. */
+
+		constexpr std::size_t MAX_ENTRIES = 8;
+
+		const std::vector<c::main::DspLoad> loads = m_io.getDspLoads();
+		out += "\n";
+		for (std::size_t i = 0; i < std::min<std::size_t>(loads.size(), MAX_ENTRIES); i++)
+			out += fmt::format("\n{:.1f}% (peak {:.1f}%) - {}", loads[i].average * 100.0f,
+			    loads[i].peak * 100.0f, loads[i].name);
+		return out;
+	};
 }
 
 /* -------------------------------------------------------------------------- */
@@ -113,8 +137,12 @@ void geMainIO::refresh()
 	m_outMeter->ready = m_io.isKernelReady();
 	m_inMeter->peak   = m_io.getMasterInPeak();
 	m_inMeter->ready  = m_io.isKernelReady();
+	m_dspMeter->load    = m_io.getDspLoad();
+	m_dspMeter->enabled = m_io.isProfilerEnabled();
+	m_dspMeter->dropped = m_io.hasDroppedEvents();
 	m_outMeter->redraw();
 	m_inMeter->redraw();
+	m_dspMeter->redraw();
 }
 
 /* -------------------------------------------------------------------------- */
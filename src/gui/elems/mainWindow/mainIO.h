@@ -33,6 +33,7 @@
 namespace giada::v
 {
 class geDial;
+class geDspMeter;
 class geSoundMeter;
 class geTextButton;
 class geImageButton;
@@ -54,6 +55,7 @@ private:
 
 	geSoundMeter*  m_outMeter;
 	geSoundMeter*  m_inMeter;
+	geDspMeter*    m_dspMeter;
 	geDial*        m_outVol;
 	geDial*        m_inVol;
 	geTextButton*  m_inToOut;
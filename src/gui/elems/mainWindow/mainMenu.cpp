@@ -47,6 +47,7 @@ enum class FileMenu
 	OPEN_PROJECT = 0,
 	SAVE_PROJECT,
 	CLOSE_PROJECT,
+	RENDER_PROJECT,
 #ifdef G_DEBUG_MODE
 	DEBUG_STATS,
 #endif
@@ -93,6 +94,7 @@ void geMainMenu::cb_file()
 	menu.addItem((ID)FileMenu::OPEN_PROJECT, g_ui.langMapper.get(LangMap::MAIN_MENU_FILE_OPENPROJECT));
 	menu.addItem((ID)FileMenu::SAVE_PROJECT, g_ui.langMapper.get(LangMap::MAIN_MENU_FILE_SAVEPROJECT));
 	menu.addItem((ID)FileMenu::CLOSE_PROJECT, g_ui.langMapper.get(LangMap::MAIN_MENU_FILE_CLOSEPROJECT));
+	menu.addItem((ID)FileMenu::RENDER_PROJECT, g_ui.langMapper.get(LangMap::MAIN_MENU_FILE_RENDERPROJECT));
 #ifdef G_DEBUG_MODE
 	menu.addItem((ID)FileMenu::DEBUG_STATS, "Debug stats");
 #endif
@@ -110,6 +112,9 @@ void geMainMenu::cb_file()
 		case FileMenu::CLOSE_PROJECT:
 			c::main::closeProject();
 			break;
+		case FileMenu::RENDER_PROJECT:
+			c::layout::openBrowserForRender();
+			break;
 #ifdef G_DEBUG_MODE
 		case FileMenu::DEBUG_STATS:
 			c::main::printDebugInfo();
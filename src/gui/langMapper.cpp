@@ -91,11 +91,14 @@ LangMap::LangMap()
 	m_data[MESSAGE_STORAGE_CHOOSEFILENAME]     = "Please choose a file name.";
 	m_data[MESSAGE_STORAGE_FILEEXISTS]         = "File exists: overwrite?";
 	m_data[MESSAGE_STORAGE_SAVINGFILEERROR]    = "Unable to save this sample!";
+	m_data[MESSAGE_STORAGE_RENDERINGPROJECT]      = "Rendering project...";
+	m_data[MESSAGE_STORAGE_RENDERINGPROJECTERROR] = "Unable to render the project!";
 
 	m_data[MAIN_MENU_FILE]                 = "File";
 	m_data[MAIN_MENU_FILE_OPENPROJECT]     = "Open project...";
 	m_data[MAIN_MENU_FILE_SAVEPROJECT]     = "Save project...";
 	m_data[MAIN_MENU_FILE_CLOSEPROJECT]    = "Close project";
+	m_data[MAIN_MENU_FILE_RENDERPROJECT]   = "Render to audio file...";
 	m_data[MAIN_MENU_FILE_QUIT]            = "Quit Giada";
 	m_data[MAIN_MENU_EDIT]                 = "Edit";
 	m_data[MAIN_MENU_EDIT_FREEALLSAMPLES]  = "Free all Sample channels";
@@ -111,6 +114,7 @@ LangMap::LangMap()
 	m_data[MAIN_IO_LABEL_INTOOUT]  = "Stream linker\n\nConnects input to output to enable \"hear what you're playing\" mode.";
 	m_data[MAIN_IO_LABEL_FXOUT]    = "Main output plug-ins";
 	m_data[MAIN_IO_LABEL_FXIN]     = "Main input plug-ins";
+	m_data[MAIN_IO_LABEL_DSPMETER] = "DSP load\n\nClick to enable or disable the profiler. When enabled, the heaviest channels and plug-ins are listed here. A detailed report is written to the log when disabled. A highlighted outline means that some input events have been lost.";
 
 	m_data[MAIN_TIMER_LABEL_BPM]        = "Beats per minute (BPM)";
 	m_data[MAIN_TIMER_LABEL_METER]      = "Beats and bars";
@@ -234,6 +238,7 @@ LangMap::LangMap()
 	m_data[BROWSER_SAVEPROJECT]     = "Save project";
 	m_data[BROWSER_OPENSAMPLE]      = "Open sample";
 	m_data[BROWSER_SAVESAMPLE]      = "Save sample";
+	m_data[BROWSER_RENDERPROJECT]   = "Render project";
 	m_data[BROWSER_OPENPLUGINSDIR]  = "Open plug-ins directory";
 
 	m_data[MIDIINPUT_MASTER_TITLE]           = "MIDI Input Setup (global)";
@@ -300,6 +305,8 @@ LangMap::LangMap()
 	m_data[CONFIG_AUDIO_RESAMPLING_ZEROORDER]  = "Zero Order Hold (fast)";
 	m_data[CONFIG_AUDIO_RESAMPLING_LINEAR]     = "Linear (very fast)";
 	m_data[CONFIG_AUDIO_NODEVICESFOUND]        = "-- no devices found --";
+	m_data[CONFIG_AUDIO_RENDERTHREADS]         = "Render threads";
+	m_data[CONFIG_AUDIO_RENDERTHREADS_OFF]     = "Off (audio thread only)";
 
 	m_data[CONFIG_MIDI_TITLE]           = "MIDI";
 	m_data[CONFIG_MIDI_SYSTEM]          = "System";
@@ -95,11 +95,14 @@ public:
 	static constexpr auto MESSAGE_STORAGE_CHOOSEFILENAME     = "message_storage_chooseFileName";
 	static constexpr auto MESSAGE_STORAGE_FILEEXISTS         = "message_storage_fileExists";
 	static constexpr auto MESSAGE_STORAGE_SAVINGFILEERROR    = "message_storage_savingFileError";
+	static constexpr auto MESSAGE_STORAGE_RENDERINGPROJECT      = "message_storage_renderingProject";
+	static constexpr auto MESSAGE_STORAGE_RENDERINGPROJECTERROR = "message_storage_renderingProjectError";
 
 	static constexpr auto MAIN_MENU_FILE                 = "main_menu_file";
 	static constexpr auto MAIN_MENU_FILE_OPENPROJECT     = "main_menu_file_openProject";
 	static constexpr auto MAIN_MENU_FILE_SAVEPROJECT     = "main_menu_file_saveProject";
 	static constexpr auto MAIN_MENU_FILE_CLOSEPROJECT    = "main_menu_file_closeProject";
+	static constexpr auto MAIN_MENU_FILE_RENDERPROJECT   = "main_menu_file_renderProject";
 	static constexpr auto MAIN_MENU_FILE_QUIT            = "main_menu_file_quit";
 	static constexpr auto MAIN_MENU_EDIT                 = "main_menu_edit";
 	static constexpr auto MAIN_MENU_EDIT_FREEALLSAMPLES  = "main_menu_edit_freeAllSamples";
@@ -115,6 +118,7 @@ public:
 	static constexpr auto MAIN_IO_LABEL_INTOOUT  = "main_IO_label_inToOut";
 	static constexpr auto MAIN_IO_LABEL_FXOUT    = "main_IO_label_fxOut";
 	static constexpr auto MAIN_IO_LABEL_FXIN     = "main_IO_label_fxIn";
+	static constexpr auto MAIN_IO_LABEL_DSPMETER = "main_IO_label_dspMeter";
 
 	static constexpr auto MAIN_TIMER_LABEL_BPM        = "main_mainTimer_label_bpm";
 	static constexpr auto MAIN_TIMER_LABEL_METER      = "main_mainTimer_label_meter";
@@ -231,6 +235,7 @@ public:
 	static constexpr auto BROWSER_SAVEPROJECT     = "browser_saveProject";
 	static constexpr auto BROWSER_OPENSAMPLE      = "browser_openSample";
 	static constexpr auto BROWSER_SAVESAMPLE      = "browser_saveSample";
+	static constexpr auto BROWSER_RENDERPROJECT   = "browser_renderProject";
 	static constexpr auto BROWSER_OPENPLUGINSDIR  = "browser_openPluginsDir";
 
 	static constexpr auto MIDIINPUT_MASTER_TITLE           = "midiInput_master_title";
@@ -291,6 +296,8 @@ public:
 	static constexpr auto CONFIG_AUDIO_RESAMPLING_ZEROORDER  = "config_audio_reseampling_zeroOrder";
 	static constexpr auto CONFIG_AUDIO_RESAMPLING_LINEAR     = "config_audio_reseampling_linear";
 	static constexpr auto CONFIG_AUDIO_NODEVICESFOUND        = "config_audio_noDevicesFound";
+	static constexpr auto CONFIG_AUDIO_RENDERTHREADS         = "config_audio_renderThreads";
+	static constexpr auto CONFIG_AUDIO_RENDERTHREADS_OFF     = "config_audio_renderThreads_off";
 
 	static constexpr auto CONFIG_MIDI_TITLE           = "config_midi_title";
 	static constexpr auto CONFIG_MIDI_SYSTEM          = "config_midi_system";
@@ -34,6 +34,8 @@ int main(int argc, char** argv)
 {
 	if (int ret = giada::m::init::tests(argc, argv); ret != -1)
 		return ret;
+	if (int ret = giada::m::init::render(argc, argv); ret != -1)
+		return ret;
 	giada::m::init::startup(argc, argv);
 	return giada::m::init::run();
 }
\ No newline at end of file
@@ -61,6 +61,21 @@ TO map(TI x, TI b, TO z)
 {
 	return map(x, static_cast<TI>(0), b, static_cast<TO>(0), z);
 }
+
+/* -------------------------------------------------------------------------- */
+
+/* ceilToMultiple
+Returns the smallest multiple of 'step' greater than or equal to 'x'. Both 
+must be positive (or zero, for 'x'). */
+
+template <typename T>
+T ceilToMultiple(T x, T step)
+{
+	static_assert(std::is_integral_v<T>);
+	assert(x >= 0 && step > 0);
+
+	return ((x + step - 1) / step) * step;
+}
 } // namespace giada::u::math
 
 #endif
@@ -0,0 +1,87 @@
+#include "../src/core/actions/actionBuckets.h"
+#include <catch2/catch.hpp>
+#include <vector>
+
+namespace
+{
+giada::m::Action makeBucketAction(giada::ID id, giada::ID channelId, giada::Tick tick)
+{
+	using namespace giada::m;
+	Action a{id, channelId, 0, MidiEvent(MidiEvent::NOTE_ON, 0, 0)};
+	a.tick = tick;
+	return a;
+}
+
+/* countFired
+Returns how many actions of channel 'channelId' a channel would visit, given
+its buckets. */
+
+int countFired(const giada::m::ActionBuckets& buckets, giada::ID channelId)
+{
+	int        count         = 0;
+	const auto [first, last] = buckets.get(channelId);
+	for (auto it = first; it != last; ++it)
+		for (const giada::m::Action& a : it->actions)
+			if (a.channelId == channelId)
+				count++;
+	return count;
+}
+} // namespace
+
+/* -------------------------------------------------------------------------- */
+
+TEST_CASE("ActionBuckets")
+{
+	using namespace giada;
+	using namespace giada::m;
+
+	constexpr int  CHANNELS = 200;
+	constexpr Tick LOOP     = 1000;
+
+	/* Two actions per channel: one at the end of the loop, one at the 
+	beginning. */
+
+	ActionMap map;
+	ID        id = 1;
+	for (ID ch = 1; ch <= CHANNELS; ch++)
+	{
+		map.insert(makeBucketAction(id++, ch, LOOP - 10));
+		map.insert(makeBucketAction(id++, ch, 10));
+	}
+
+	for (std::size_t capacity : {1024, 256, 64})
+	{
+		ActionBuckets buckets(capacity);
+
+		SECTION("Single range, capacity " + std::to_string(capacity))
+		{
+			buckets.clear(map, 1);
+			buckets.add(0, LOOP, /*begin=*/0, /*delta=*/0);
+			buckets.sort();
+
+			REQUIRE(buckets.isFlat() == (capacity < CHANNELS));
+			for (ID ch = 1; ch <= CHANNELS; ch++)
+				REQUIRE(countFired(buckets, ch) == 2);
+		}
+
+		SECTION("Wrap around the loop, capacity " + std::to_string(capacity))
+		{
+			buckets.clear(map, 2);
+			buckets.add(LOOP - 20, LOOP, /*begin=*/LOOP - 20, /*delta=*/0);
+			buckets.add(0, 20, /*begin=*/0, /*delta=*/20);
+			buckets.sort();
+
+			REQUIRE(buckets.isFlat() == (capacity < CHANNELS * 2));
+			for (ID ch = 1; ch <= CHANNELS; ch++)
+			{
+				REQUIRE(countFired(buckets, ch) == 2);
+
+				/* Buckets come sorted by delta. */
+
+				const auto [first, last] = buckets.get(ch);
+				for (auto it = first; it + 1 < last; ++it)
+					REQUIRE(it->delta <= (it + 1)->delta);
+			}
+		}
+	}
+}
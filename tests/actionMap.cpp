@@ -0,0 +1,227 @@
+#include "../src/core/actions/actionMap.h"
+#include "../src/core/const.h"
+#include <catch2/catch.hpp>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace
+{
+giada::m::Action makeTestAction(giada::ID id, giada::ID channelId, giada::Tick tick)
+{
+	using namespace giada::m;
+	Action a{id, channelId, 0, MidiEvent(MidiEvent::NOTE_ON, 0, 0)};
+	a.tick = tick;
+	return a;
+}
+
+std::vector<giada::ID> getIds(const giada::m::ActionMap::View& view)
+{
+	std::vector<giada::ID> out;
+	for (const giada::m::Action& a : view)
+		out.push_back(a.id);
+	return out;
+}
+} // namespace
+
+/* -------------------------------------------------------------------------- */
+
+TEST_CASE("ActionMap")
+{
+	using namespace giada;
+	using namespace giada::m;
+
+	ActionMap map;
+
+	map.insert(makeTestAction(1, /*channelId=*/10, /*tick=*/300));
+	map.insert(makeTestAction(2, /*channelId=*/20, /*tick=*/100));
+	map.insert(makeTestAction(3, /*channelId=*/10, /*tick=*/100));
+	map.insert(makeTestAction(4, /*channelId=*/10, /*tick=*/200));
+
+	REQUIRE(map.size() == 4);
+
+	SECTION("Test sorting by tick, stable on same tick")
+	{
+		std::vector<ID> ids;
+		map.forEach([&ids](const Action& a) { ids.push_back(a.id); });
+		REQUIRE(ids == std::vector<ID>{2, 3, 4, 1});
+
+		REQUIRE(getIds(map.getActionsOnTick(100)) == std::vector<ID>{2, 3});
+		REQUIRE(map.getActionsOnTick(150).empty());
+	}
+
+	SECTION("Test lookup by ID")
+	{
+		REQUIRE(map.find(4) != nullptr);
+		REQUIRE(map.find(4)->tick == 200);
+		REQUIRE(map.find(5) == nullptr);
+		REQUIRE(map.find(0) == nullptr);
+	}
+
+	SECTION("Test per-channel index")
+	{
+		REQUIRE(getIds(map.getActionsOnChannel(10)) == std::vector<ID>{3, 4, 1});
+		REQUIRE(getIds(map.getActionsOnChannel(20)) == std::vector<ID>{2});
+		REQUIRE(map.getActionsOnChannel(30).empty());
+	}
+
+	SECTION("Test range")
+	{
+		auto it  = map.lowerBound(100);
+		auto end = map.lowerBound(300);
+
+		REQUIRE(it.getTick() == 100);
+		REQUIRE(it.getActions().size() == 2);
+		++it;
+		REQUIRE(it.getTick() == 200);
+		++it;
+		REQUIRE(it == end);
+		REQUIRE(map.lowerBound(301) == map.end());
+	}
+
+	SECTION("Test channel ranges")
+	{
+		std::vector<ID> channels;
+		map.forEachChannelInRange(100, 300, [&channels](ID channelId, ActionMap::View view) {
+			channels.push_back(channelId);
+			if (channelId == 10)
+			{
+				REQUIRE(getIds(view) == std::vector<ID>{3, 4});
+
+				const auto [first, rest] = view.splitFirstTick();
+				REQUIRE(getIds(first) == std::vector<ID>{3});
+				REQUIRE(getIds(rest) == std::vector<ID>{4});
+			}
+		});
+		REQUIRE(channels == std::vector<ID>{10, 20});
+	}
+
+	SECTION("Test erase")
+	{
+		const Action* a1 = map.find(1);
+
+		REQUIRE(map.erase(3));
+		REQUIRE_FALSE(map.erase(3));
+		REQUIRE(map.size() == 3);
+		REQUIRE(map.find(3) == nullptr);
+		REQUIRE(getIds(map.getActionsOnTick(100)) == std::vector<ID>{2});
+		REQUIRE(getIds(map.getActionsOnChannel(10)) == std::vector<ID>{4, 1});
+
+		/* Other actions stay where they are. */
+
+		REQUIRE(map.find(1) == a1);
+
+		SECTION("Test slot recycling")
+		{
+			map.insert(makeTestAction(5, /*channelId=*/30, /*tick=*/0));
+			REQUIRE(map.find(1) == a1);
+			REQUIRE(map.find(5)->tick == 0);
+			REQUIRE(getIds(map.getActionsOnChannel(30)) == std::vector<ID>{5});
+		}
+	}
+
+	SECTION("Test removeIf")
+	{
+		map.removeIf([](const Action& a) { return a.channelId == 10; });
+
+		REQUIRE(map.size() == 1);
+		REQUIRE(map.find(2) != nullptr);
+		REQUIRE(map.find(1) == nullptr);
+		REQUIRE(map.getActionsOnChannel(10).empty());
+	}
+
+	SECTION("Test copy")
+	{
+		ActionMap copy = map;
+		copy.erase(2);
+
+		REQUIRE(map.find(2) != nullptr);
+		REQUIRE(copy.find(2) == nullptr);
+		REQUIRE(copy.find(1)->tick == 300);
+	}
+
+	SECTION("Test big IDs")
+	{
+		map.insert(makeTestAction(1 << 20, /*channelId=*/10, /*tick=*/50));
+		REQUIRE(map.find(1 << 20) != nullptr);
+		REQUIRE(map.erase(1 << 20));
+		REQUIRE(map.find(1 << 20) == nullptr);
+
+		/* IDs are never reused, so a long session goes past 65536. */
+
+		for (ID id = 65530; id < 65550; id++)
+			map.insert(makeTestAction(id, /*channelId=*/20, /*tick=*/id));
+		REQUIRE(map.erase(65540));
+		map.removeIf([](const Action& a) { return a.id == 65545; });
+
+		REQUIRE(map.find(65540) == nullptr);
+		REQUIRE(map.find(65545) == nullptr);
+		for (ID id : {65530, 65536, 65537, 65549})
+		{
+			REQUIRE(map.find(id) != nullptr);
+			REQUIRE(map.find(id)->tick == id);
+		}
+	}
+}
+
+/* -------------------------------------------------------------------------- */
+
+/* ActionMap benchmark
+ActionMap vs the old std::map<Tick, std::vector<Action>> storage, on the 
+operations that matter: the copy each edit performs before publishing, and the
+range query the sequencer runs on every block. Run with: 
+giada --run-tests "[benchmark]" */
+
+TEST_CASE("ActionMap benchmark", "[.][benchmark]")
+{
+	using namespace giada;
+	using namespace giada::m;
+	using OldMap = std::map<Tick, std::vector<Action>>;
+
+	constexpr Tick TICKS_IN_LOOP = G_PPQ * 16;
+	constexpr Tick BLOCK         = G_PPQ / 128;
+
+	for (int size : {128, 1024, 8192})
+	{
+		ActionMap map;
+		OldMap    old;
+		for (int i = 0; i < size; i++)
+		{
+			const Action a = makeTestAction(i + 1, i % 16, (i * 7919) % TICKS_IN_LOOP);
+			map.insert(a);
+			old[a.tick].push_back(a);
+		}
+
+		BENCHMARK("std::map copy + insert, " + std::to_string(size) + " actions")
+		{
+			OldMap copy = old;
+			copy[TICKS_IN_LOOP / 2].push_back(makeTestAction(size + 1, 0, TICKS_IN_LOOP / 2));
+			return copy.size();
+		};
+
+		BENCHMARK("ActionMap copy + insert, " + std::to_string(size) + " actions")
+		{
+			ActionMap copy = map;
+			copy.insert(makeTestAction(size + 1, 0, TICKS_IN_LOOP / 2));
+			return copy.size();
+		};
+
+		BENCHMARK("std::map range queries, one loop, " + std::to_string(size) + " actions")
+		{
+			int found = 0;
+			for (Tick t = 0; t < TICKS_IN_LOOP; t += BLOCK)
+				for (auto it = old.lower_bound(t), end = old.lower_bound(t + BLOCK); it != end; ++it)
+					found += it->second.size();
+			return found;
+		};
+
+		BENCHMARK("ActionMap range queries, one loop, " + std::to_string(size) + " actions")
+		{
+			int found = 0;
+			for (Tick t = 0; t < TICKS_IN_LOOP; t += BLOCK)
+				for (auto it = map.lowerBound(t), end = map.lowerBound(t + BLOCK); it != end; ++it)
+					found += it.getActions().size();
+			return found;
+		};
+	}
+}
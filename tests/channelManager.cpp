@@ -0,0 +1,78 @@
+#include "../src/core/channels/channelFactory.h"
+#include "../src/core/channels/channelManager.h"
+#include "../src/core/channels/channelShared.h"
+#include "../src/core/conf.h"
+#include "../src/core/model/model.h"
+#include "../src/core/waveFactory.h"
+#include <atomic>
+#include <catch2/catch.hpp>
+#include <memory>
+#include <thread>
+
+TEST_CASE("ChannelManager")
+{
+	using namespace giada;
+	using namespace giada::m;
+
+	constexpr ID    CHANNEL_ID  = 10;
+	constexpr Frame BUFFER_SIZE = 64;
+
+	model::Model   model;
+	Conf::Data     conf;
+	ChannelFactory channelFactory(conf, model);
+	WaveFactory    waveFactory;
+	ChannelManager channelManager(model, channelFactory, waveFactory);
+
+	model.addShared(std::make_unique<ChannelShared>(CHANNEL_ID, BUFFER_SIZE));
+	ChannelShared& shared = model.backShared<ChannelShared>();
+
+	SECTION("setters write to the shared state")
+	{
+		channelManager.setVolume(CHANNEL_ID, 0.25f);
+		channelManager.setPan(CHANNEL_ID, 0.75f);
+		channelManager.setPitch(CHANNEL_ID, 2.0f);
+
+		REQUIRE(shared.volume.load() == 0.25f);
+		REQUIRE(shared.pan.load() == 0.75f);
+		REQUIRE(shared.pitch.load() == 2.0f);
+	}
+
+	SECTION("unknown and removed channels are ignored")
+	{
+		channelManager.setVolume(CHANNEL_ID + 1, 0.25f);
+		REQUIRE(shared.volume.load() == G_DEFAULT_VOL);
+
+		model.removeShared(shared);
+		REQUIRE(model.findChannelShared(CHANNEL_ID) == nullptr);
+
+		channelManager.setVolume(CHANNEL_ID, 0.25f);
+		channelManager.setPan(CHANNEL_ID, 0.25f);
+		channelManager.setPitch(CHANNEL_ID, 0.25f);
+	}
+
+	SECTION("setters are safe while the main thread edits channels")
+	{
+		/* Another thread keeps writing (e.g. the MIDI one) while channels are
+		added and removed, which reallocates the container of shared states. */
+
+		std::atomic<bool> running = true;
+		std::thread       writer([&channelManager, &running]() {
+			do
+				channelManager.setVolume(CHANNEL_ID, 0.5f);
+			while (running.load());
+		});
+
+		for (int i = 0; i < 1000; i++)
+		{
+			model.addShared(std::make_unique<ChannelShared>(CHANNEL_ID + 1 + i, BUFFER_SIZE));
+			if (i % 2 == 0)
+				model.removeShared(model.backShared<ChannelShared>());
+		}
+
+		running.store(false);
+		writer.join();
+
+		REQUIRE(model.findChannelShared(CHANNEL_ID) == &shared);
+		REQUIRE(shared.volume.load() == 0.5f);
+	}
+}
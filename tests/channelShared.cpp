@@ -0,0 +1,78 @@
+#include "../src/core/channels/channelShared.h"
+#include "../src/core/const.h"
+#include <catch2/catch.hpp>
+
+TEST_CASE("ChannelShared")
+{
+	using namespace giada;
+	using namespace giada::m;
+
+	constexpr Frame BUFFER_SIZE = 64;
+	constexpr Frame HOLD_FRAMES = BUFFER_SIZE * 4;
+
+	ChannelShared shared(/*channelId=*/1, BUFFER_SIZE);
+
+	/* Renders a block into the channel and updates the silence count, as
+	Channel::renderIsolated() does. */
+
+	const auto renderBlock = [&shared](float value) {
+		shared.audioBuffer.clear();
+		shared.audioBuffer[0][0] = value;
+		shared.updateSilence(HOLD_FRAMES);
+	};
+
+	SECTION("the hold is defined in seconds")
+	{
+		REQUIRE(ChannelShared::getIdleHoldFrames(44100) == static_cast<Frame>(G_IDLE_HOLD_SECONDS * 44100));
+		REQUIRE(ChannelShared::getIdleHoldFrames(192000) == static_cast<Frame>(G_IDLE_HOLD_SECONDS * 192000));
+	}
+
+	SECTION("silent after the hold period")
+	{
+		for (int i = 0; i < 3; i++)
+		{
+			renderBlock(0.0f);
+			REQUIRE_FALSE(shared.isSilent(HOLD_FRAMES));
+		}
+		renderBlock(0.0f);
+		REQUIRE(shared.isSilent(HOLD_FRAMES));
+
+		/* Sound starts the hold over. */
+
+		renderBlock(0.5f);
+		REQUIRE_FALSE(shared.isSilent(HOLD_FRAMES));
+	}
+
+	SECTION("idle entry")
+	{
+		for (int i = 0; i < 4; i++)
+			renderBlock(0.0f);
+
+		REQUIRE(shared.updateIdle(true) == false);
+		REQUIRE(shared.idle);
+		REQUIRE(shared.updateIdle(true) == true);
+		REQUIRE(shared.isSilent(HOLD_FRAMES));
+	}
+
+	SECTION("the whole hold applies after a wake")
+	{
+		for (int i = 0; i < 4; i++)
+			renderBlock(0.0f);
+		shared.updateIdle(true);
+
+		/* Woken up (e.g. by a pending MIDI event), but the first blocks are
+		still silent: slow attack, plug-in latency, note-on at the end of the
+		block. The channel must not go idle again right away. */
+
+		REQUIRE(shared.updateIdle(false) == true);
+		REQUIRE_FALSE(shared.idle);
+
+		for (int i = 0; i < 3; i++)
+		{
+			renderBlock(0.0f);
+			REQUIRE_FALSE(shared.isSilent(HOLD_FRAMES));
+		}
+		renderBlock(0.0f);
+		REQUIRE(shared.isSilent(HOLD_FRAMES));
+	}
+}
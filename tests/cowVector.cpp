@@ -0,0 +1,146 @@
+#include "../src/core/model/cowVector.h"
+#include <catch2/catch.hpp>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace
+{
+/* CowItem
+Stand-in for a Channel: some heap-allocated members, plus a counter of copies
+so that tests can tell when an item gets cloned. */
+
+struct CowItem
+{
+	CowItem(int id)
+	: id(id)
+	, name("item " + std::to_string(id))
+	, plugins(8, nullptr)
+	{
+	}
+
+	CowItem(const CowItem& o)
+	: id(o.id)
+	, value(o.value)
+	, name(o.name)
+	, plugins(o.plugins)
+	, extra(o.extra)
+	{
+		copies++;
+	}
+
+	static inline int copies = 0;
+
+	int                        id;
+	float                      value = 0.0f;
+	std::string                name;
+	std::vector<void*>         plugins;
+	std::optional<std::string> extra;
+};
+
+giada::m::model::CowVector<CowItem> makeCowVector(int size)
+{
+	giada::m::model::CowVector<CowItem> out;
+	for (int i = 0; i < size; i++)
+		out.push_back(CowItem(i));
+	return out;
+}
+} // namespace
+
+TEST_CASE("model::CowVector")
+{
+	using namespace giada::m::model;
+
+	CowVector<CowItem> a = makeCowVector(4);
+
+	SECTION("copies share items")
+	{
+		CowItem::copies      = 0;
+		CowVector<CowItem> b = a;
+
+		REQUIRE(CowItem::copies == 0);
+		REQUIRE(b.size() == a.size());
+		for (std::size_t i = 0; i < a.size(); i++)
+		{
+			REQUIRE(a.isShared(i));
+			REQUIRE(&a[i] == &b[i]);
+		}
+	}
+
+	SECTION("edit clones shared items only")
+	{
+		CowVector<CowItem> b = a;
+
+		CowItem::copies = 0;
+		b.edit(2).value = 1.0f;
+
+		REQUIRE(CowItem::copies == 1);
+		REQUIRE(a[2].value == 0.0f);
+		REQUIRE(b[2].value == 1.0f);
+		REQUIRE(&a[1] == &b[1]);
+		REQUIRE(!b.isShared(2));
+
+		b.edit(2).value = 2.0f; // Already unique: no clone
+
+		REQUIRE(CowItem::copies == 1);
+	}
+
+	SECTION("editIf clones matching items only")
+	{
+		CowVector<CowItem> b = a;
+
+		CowItem::copies = 0;
+		b.editIf([](const CowItem& item) { return item.id % 2 == 0; },
+		    [](CowItem& item) { item.value = 1.0f; });
+
+		REQUIRE(CowItem::copies == 2);
+		REQUIRE(b[0].value == 1.0f);
+		REQUIRE(b[1].value == 0.0f);
+		REQUIRE(a[0].value == 0.0f);
+	}
+
+	SECTION("removeIf doesn't touch other copies")
+	{
+		CowVector<CowItem> b = a;
+		b.removeIf([](const CowItem& item) { return item.id == 1; });
+
+		REQUIRE(a.size() == 4);
+		REQUIRE(b.size() == 3);
+		REQUIRE(b[1].id == 2);
+		REQUIRE(!a.isShared(1));
+	}
+}
+
+/* -------------------------------------------------------------------------- */
+
+/* model::CowVector benchmark
+Cost of the copy a Layout swap performs, for a growing number of channels: a
+plain vector deep-copies every item, a CowVector copies pointers and clones the
+edited item only. Run with: giada --run-tests "[benchmark]" */
+
+TEST_CASE("model::CowVector benchmark", "[.][benchmark]")
+{
+	using namespace giada::m::model;
+
+	for (int size : {16, 128, 1024})
+	{
+		std::vector<CowItem> plain;
+		for (int i = 0; i < size; i++)
+			plain.push_back(CowItem(i));
+		CowVector<CowItem> cow = makeCowVector(size);
+
+		BENCHMARK("std::vector copy, " + std::to_string(size) + " items")
+		{
+			std::vector<CowItem> copy = plain;
+			copy[0].value += 1.0f;
+			return copy.size();
+		};
+
+		BENCHMARK("CowVector copy + edit, " + std::to_string(size) + " items")
+		{
+			CowVector<CowItem> copy = cow;
+			copy.edit(0).value += 1.0f;
+			return copy.size();
+		};
+	}
+}
@@ -0,0 +1,208 @@
+#include "../src/core/dsp/kernels.h"
+#include "../src/deps/mcl-audio-buffer/src/audioBuffer.hpp"
+#include <algorithm>
+#include <catch2/catch.hpp>
+#include <cmath>
+#include <vector>
+
+namespace
+{
+constexpr int BENCH_FRAMES   = 512;
+constexpr int BENCH_CHANNELS = 2;
+
+std::vector<giada::m::dsp::Isa> getSupportedIsas()
+{
+	using namespace giada::m;
+
+	std::vector<dsp::Isa> out;
+	for (dsp::Isa isa : {dsp::Isa::SCALAR, dsp::Isa::SSE2, dsp::Isa::AVX2, dsp::Isa::NEON})
+		if (dsp::isSupported(isa))
+			out.push_back(isa);
+	return out;
+}
+
+/* makeSignal
+Deterministic pseudo-random signal in [-2.0, 2.0], so that clipping has 
+something to do. Odd sizes exercise the scalar tails of SIMD kernels. */
+
+std::vector<float> makeSignal(int samples, int seed)
+{
+	std::vector<float> out(samples);
+	for (int i = 0; i < samples; i++)
+		out[i] = std::sin(i * 0.37f + seed) * 2.0f;
+	return out;
+}
+
+void fillBuffer(mcl::AudioBuffer& b, int seed)
+{
+	b.forEachFrame([seed](float* f, int i) {
+		f[0] = std::sin(i * 0.37f + seed) * 2.0f;
+		f[1] = std::cos(i * 0.21f + seed) * 2.0f;
+	});
+}
+} // namespace
+
+/* -------------------------------------------------------------------------- */
+
+TEST_CASE("dsp::kernels")
+{
+	using namespace giada;
+	using namespace giada::m;
+
+	const dsp::Isa defaultIsa = dsp::getIsa();
+
+	for (dsp::Isa isa : getSupportedIsas())
+	{
+		REQUIRE(dsp::setIsa(isa));
+
+		for (int frames : {0, 1, 3, 4, 7, 8, 9, 33, 512})
+		{
+			const int samples = frames * 2;
+
+			SECTION(std::string("sumStereo, ") + dsp::getIsaName(isa) + ", " + std::to_string(frames) + " frames")
+			{
+				std::vector<float>       dst = makeSignal(samples, 1);
+				const std::vector<float> src = makeSignal(samples, 2);
+				std::vector<float>       ref = dst;
+				for (int i = 0; i < samples; i++)
+					ref[i] += src[i] * (i % 2 == 0 ? 0.7f : 0.3f);
+
+				dsp::sumStereo(dst.data(), src.data(), frames, 0.7f, 0.3f);
+
+				for (int i = 0; i < samples; i++)
+					REQUIRE(dst[i] == Approx(ref[i]));
+			}
+
+			SECTION(std::string("gain and clip, ") + dsp::getIsaName(isa) + ", " + std::to_string(frames) + " frames")
+			{
+				std::vector<float> buf = makeSignal(samples, 3);
+				std::vector<float> ref = buf;
+				for (float& f : ref)
+					f = std::clamp(f * 0.8f, -1.0f, 1.0f);
+
+				dsp::gain(buf.data(), samples, 0.8f);
+				dsp::clip(buf.data(), samples, -1.0f, 1.0f);
+
+				for (int i = 0; i < samples; i++)
+					REQUIRE(buf[i] == Approx(ref[i]));
+			}
+
+			SECTION(std::string("peak and rms, ") + dsp::getIsaName(isa) + ", " + std::to_string(frames) + " frames")
+			{
+				const std::vector<float> buf = makeSignal(samples, 4);
+
+				Peak   ref        = {0.0f, 0.0f};
+				double sumSquares = 0.0;
+				for (int i = 0; i < samples; i++)
+				{
+					float& p   = i % 2 == 0 ? ref.left : ref.right;
+					p          = std::max(p, std::fabs(buf[i]));
+					sumSquares = sumSquares + buf[i] * buf[i];
+				}
+
+				const Peak peak = dsp::peakStereo(buf.data(), frames);
+
+				REQUIRE(peak.left == ref.left);
+				REQUIRE(peak.right == ref.right);
+				REQUIRE(dsp::peak(buf.data(), samples) == std::max(ref.left, ref.right));
+				if (samples > 0)
+					REQUIRE(dsp::rms(buf.data(), samples) == Approx(std::sqrt(sumSquares / samples)).epsilon(0.0001));
+			}
+
+			SECTION(std::string("interleave, ") + dsp::getIsaName(isa) + ", " + std::to_string(frames) + " frames")
+			{
+				const std::vector<float> src = makeSignal(samples, 5);
+				std::vector<float>       left(frames), right(frames), dst(samples);
+				float*                   planar[]      = {left.data(), right.data()};
+				const float*             planarConst[] = {left.data(), right.data()};
+
+				dsp::deinterleave(planar, src.data(), frames, 2);
+				for (int i = 0; i < frames; i++)
+				{
+					REQUIRE(left[i] == src[i * 2]);
+					REQUIRE(right[i] == src[i * 2 + 1]);
+				}
+
+				dsp::interleave(dst.data(), planarConst, frames, 2);
+				REQUIRE(dst == src);
+			}
+		}
+	}
+
+	SECTION("ramp")
+	{
+		std::vector<float> buf(10 * 2, 1.0f);
+
+		dsp::ramp(buf.data(), 10, 2, 1.0f, 0.0f);
+
+		REQUIRE(buf[0] == 1.0f);
+		REQUIRE(buf[1] == 1.0f);
+		REQUIRE(buf[18] == 0.0f);
+		REQUIRE(buf[19] == 0.0f);
+	}
+
+	dsp::setIsa(defaultIsa);
+}
+
+/* -------------------------------------------------------------------------- */
+
+/* Microbenchmark, hidden by default. Run with: giada --run-tests "[benchmark]"
+Compares the previous per-frame loops against scalar and SIMD kernels. */
+
+TEST_CASE("dsp::kernels benchmark", "[.][benchmark]")
+{
+	using namespace giada;
+	using namespace giada::m;
+
+	const dsp::Isa bestIsa = dsp::getIsa();
+
+	mcl::AudioBuffer out(BENCH_FRAMES, BENCH_CHANNELS);
+	mcl::AudioBuffer in(BENCH_FRAMES, BENCH_CHANNELS);
+	fillBuffer(out, 1);
+	fillBuffer(in, 2);
+
+	BENCHMARK("sum with pan - legacy")
+	{
+		out.sum(in, 0.5f, {0.3f, 0.7f});
+		return out[0][0];
+	};
+
+	BENCHMARK("limit - legacy")
+	{
+		for (int i = 0; i < out.countFrames(); i++)
+			for (int j = 0; j < out.countChannels(); j++)
+				out[i][j] = std::max(-1.0f, std::min(out[i][j], 1.0f));
+		return out[0][0];
+	};
+
+	BENCHMARK("peak - legacy")
+	{
+		return out.getPeak(0) + out.getPeak(1);
+	};
+
+	for (dsp::Isa isa : {dsp::Isa::SCALAR, bestIsa})
+	{
+		dsp::setIsa(isa);
+		const std::string name = dsp::getIsaName(isa);
+
+		BENCHMARK("sum with pan - " + name)
+		{
+			dsp::sum(out, in, 0.5f, 0.3f, 0.7f);
+			return out[0][0];
+		};
+
+		BENCHMARK("limit - " + name)
+		{
+			dsp::clip(out, -1.0f, 1.0f);
+			return out[0][0];
+		};
+
+		BENCHMARK("peak - " + name)
+		{
+			const Peak p = dsp::getPeak(out);
+			return p.left + p.right;
+		};
+	}
+
+	dsp::setIsa(bestIsa);
+}
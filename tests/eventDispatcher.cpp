@@ -0,0 +1,46 @@
+#include "../src/core/eventDispatcher.h"
+#include <catch2/catch.hpp>
+#include <vector>
+
+TEST_CASE("EventDispatcher::EventRouter")
+{
+	using namespace giada;
+	using namespace giada::m;
+
+	using EventType = EventDispatcher::EventType;
+
+	EventDispatcher::EventBuffer events;
+	EventDispatcher::EventRouter router;
+
+	events.push_back({EventType::KEY_PRESS, 0, /*channelId=*/2, 0});
+	events.push_back({EventType::SEQUENCER_START, 0, /*channelId=*/0, 0});
+	events.push_back({EventType::KEY_PRESS, 0, /*channelId=*/1, 1});
+	events.push_back({EventType::KEY_RELEASE, 0, /*channelId=*/2, 2});
+
+	router.route(events);
+
+	auto getEvents = [&router](ID channelId) {
+		std::vector<EventType> out;
+		router.forEachEventFor(channelId, [&out](const EventDispatcher::Event& e) { out.push_back(e.type); });
+		return out;
+	};
+
+	SECTION("Test own events plus shared ones, in order")
+	{
+		REQUIRE(getEvents(1) == std::vector<EventType>{EventType::SEQUENCER_START, EventType::KEY_PRESS});
+		REQUIRE(getEvents(2) == std::vector<EventType>{EventType::KEY_PRESS, EventType::SEQUENCER_START, EventType::KEY_RELEASE});
+		REQUIRE(getEvents(3) == std::vector<EventType>{EventType::SEQUENCER_START});
+	}
+
+	SECTION("Test targets")
+	{
+		REQUIRE(router.hasEventsFor(3));
+
+		events.clear();
+		events.push_back({EventType::CHANNEL_MUTE, 0, /*channelId=*/1, 0});
+		router.route(events);
+
+		REQUIRE(router.hasEventsFor(1));
+		REQUIRE_FALSE(router.hasEventsFor(2));
+	}
+}
@@ -0,0 +1,52 @@
+#include "../src/core/model/idIndex.h"
+#include <catch2/catch.hpp>
+#include <vector>
+
+TEST_CASE("model::IdIndex")
+{
+	using namespace giada::m::model;
+
+	IdIndex                index;
+	const std::vector<int> ids = {1, 2, 3, 7};
+
+	index.rebuild(ids.size(), [&ids](std::size_t i) { return ids[i]; });
+
+	SECTION("known IDs")
+	{
+		REQUIRE(index.get(1) == 0);
+		REQUIRE(index.get(7) == 3);
+	}
+
+	SECTION("unknown IDs")
+	{
+		REQUIRE(index.get(0) == IdIndex::NONE);
+		REQUIRE(index.get(4) == IdIndex::NONE);
+		REQUIRE(index.get(1000) == IdIndex::NONE);
+		REQUIRE(index.get(-1) == IdIndex::NONE);
+	}
+
+	SECTION("IDs above 65536")
+	{
+		index.set(70000, 4);
+		index.set(1 << 30, 5);
+
+		REQUIRE(index.get(70000) == 4);
+		REQUIRE(index.get(1 << 30) == 5);
+		REQUIRE(index.get(70001) == IdIndex::NONE);
+
+		index.set(70000, IdIndex::NONE);
+
+		REQUIRE(index.get(70000) == IdIndex::NONE);
+		REQUIRE(index.get(1 << 30) == 5);
+	}
+
+	SECTION("rebuild forgets removed IDs")
+	{
+		index.set(70000, 4);
+		index.rebuild(1, [](std::size_t) { return 7; });
+
+		REQUIRE(index.get(1) == IdIndex::NONE);
+		REQUIRE(index.get(70000) == IdIndex::NONE);
+		REQUIRE(index.get(7) == 0);
+	}
+}
@@ -0,0 +1,166 @@
+#include "../src/core/inputRecBuffer.h"
+#include "../src/core/const.h"
+#include <catch2/catch.hpp>
+
+TEST_CASE("InputRecBuffer")
+{
+	using namespace giada;
+	using namespace giada::m;
+
+	/* Same as InputRecBuffer::CHUNK_FRAMES and InputRecBuffer::LOOKAHEAD. */
+
+	constexpr Frame CHUNK_FRAMES = 16384;
+	constexpr int   LOOKAHEAD    = 4;
+
+	InputRecBuffer buffer;
+
+	/* Makes a block of 'frames' frames, where each frame holds its own
+	position in the recording ('pos' + offset, wrapped at 'maxFrames'). */
+
+	const auto makeBlock = [](Frame frames, Frame pos, Frame maxFrames) {
+		mcl::AudioBuffer block(frames, G_MAX_IO_CHANS);
+		block.forEachFrame([pos, maxFrames](float* f, int i) {
+			for (int c = 0; c < G_MAX_IO_CHANS; c++)
+				f[c] = static_cast<float>((pos + i) % maxFrames);
+		});
+		return block;
+	};
+
+	/* Start and stop right away: only the chunks allocated by start() around
+	'startFrame' are available, since the write position doesn't move. */
+
+	const auto startStopped = [&buffer](Frame maxFrames, Frame startFrame) {
+		buffer.start(maxFrames, startFrame);
+		buffer.stop();
+	};
+
+	SECTION("sum wraps around at maxFrames")
+	{
+		/* Three chunks, the last one partial. Writing across the end of the
+		recording continues from the beginning. */
+
+		constexpr Frame MAX_FRAMES = CHUNK_FRAMES * 2 + 100;
+		constexpr Frame START      = MAX_FRAMES - 50;
+		constexpr Frame FRAMES     = 100;
+
+		startStopped(MAX_FRAMES, START);
+		buffer.sum(makeBlock(FRAMES, START, MAX_FRAMES), START, /*gain=*/1.0f);
+
+		REQUIRE(buffer.getDroppedFrames() == 0);
+
+		mcl::AudioBuffer out(MAX_FRAMES, G_MAX_IO_CHANS);
+		buffer.copyTo(out, MAX_FRAMES);
+
+		REQUIRE(out[START][0] == static_cast<float>(START));
+		REQUIRE(out[MAX_FRAMES - 1][1] == static_cast<float>(MAX_FRAMES - 1));
+		REQUIRE(out[0][0] == 0.0f);
+		REQUIRE(out[49][1] == 49.0f);
+		REQUIRE(out[50][0] == 0.0f); // Past the end of the block
+		REQUIRE(out[START - 1][0] == 0.0f);
+	}
+
+	SECTION("sum crosses chunk boundaries")
+	{
+		constexpr Frame MAX_FRAMES = CHUNK_FRAMES * 4;
+		constexpr Frame START      = CHUNK_FRAMES - 10;
+		constexpr Frame FRAMES     = 20;
+
+		startStopped(MAX_FRAMES, 0);
+		buffer.sum(makeBlock(FRAMES, START, MAX_FRAMES), START, /*gain=*/0.5f);
+
+		mcl::AudioBuffer out(MAX_FRAMES, G_MAX_IO_CHANS);
+		buffer.copyTo(out, MAX_FRAMES);
+
+		for (Frame i = START; i < START + FRAMES; i++)
+			REQUIRE(out[i][0] == static_cast<float>(i) * 0.5f);
+		REQUIRE(out[START + FRAMES][0] == 0.0f);
+	}
+
+	SECTION("frames written to missing chunks are dropped and counted")
+	{
+		/* Only the first LOOKAHEAD chunks are there. A block that straddles the
+		last available chunk and the first missing one is recorded only in
+		part. */
+
+		constexpr Frame MAX_FRAMES = CHUNK_FRAMES * (LOOKAHEAD + 2);
+		constexpr Frame BOUNDARY   = CHUNK_FRAMES * LOOKAHEAD;
+		constexpr Frame FRAMES     = 64;
+
+		startStopped(MAX_FRAMES, 0);
+
+		buffer.sum(makeBlock(FRAMES, BOUNDARY - 16, MAX_FRAMES), BOUNDARY - 16, /*gain=*/1.0f);
+		REQUIRE(buffer.getDroppedFrames() == FRAMES - 16);
+
+		buffer.sum(makeBlock(FRAMES, BOUNDARY + CHUNK_FRAMES, MAX_FRAMES), BOUNDARY + CHUNK_FRAMES, /*gain=*/1.0f);
+		REQUIRE(buffer.getDroppedFrames() == FRAMES * 2 - 16);
+
+		mcl::AudioBuffer out(MAX_FRAMES, G_MAX_IO_CHANS);
+		buffer.copyTo(out, MAX_FRAMES);
+
+		REQUIRE(out[BOUNDARY - 1][0] == static_cast<float>(BOUNDARY - 1));
+
+		/* A new session starts the count over. */
+
+		startStopped(MAX_FRAMES, 0);
+		REQUIRE(buffer.getDroppedFrames() == 0);
+	}
+
+	SECTION("missing chunks read as silence")
+	{
+		constexpr Frame MAX_FRAMES = CHUNK_FRAMES * (LOOKAHEAD + 2);
+		constexpr Frame MISSING    = CHUNK_FRAMES * LOOKAHEAD;
+
+		startStopped(MAX_FRAMES, 0);
+		buffer.sum(makeBlock(CHUNK_FRAMES * LOOKAHEAD, 0, MAX_FRAMES), 0, /*gain=*/1.0f);
+
+		SECTION("copyTo")
+		{
+			/* Whatever was in the destination before is cleared, also where
+			chunks are missing. */
+
+			mcl::AudioBuffer out(MAX_FRAMES, G_MAX_IO_CHANS);
+			out.forEachFrame([](float* f, int) { f[0] = f[1] = -1.0f; });
+
+			buffer.copyTo(out, MAX_FRAMES);
+
+			REQUIRE(out[MISSING - 1][0] == static_cast<float>(MISSING - 1));
+			REQUIRE(out[MISSING][0] == 0.0f);
+			REQUIRE(out[MAX_FRAMES - 1][1] == 0.0f);
+		}
+
+		SECTION("copyTo, fewer frames than recorded")
+		{
+			mcl::AudioBuffer out(MAX_FRAMES, G_MAX_IO_CHANS);
+			buffer.copyTo(out, 100);
+
+			REQUIRE(out[99][0] == 99.0f);
+			REQUIRE(out[100][0] == 0.0f);
+		}
+
+		SECTION("sumTo")
+		{
+			/* Missing chunks leave the destination untouched. */
+
+			mcl::AudioBuffer out(MAX_FRAMES, G_MAX_IO_CHANS);
+			out.forEachFrame([](float* f, int) { f[0] = f[1] = 1.0f; });
+
+			buffer.sumTo(out);
+
+			REQUIRE(out[0][0] == 1.0f);
+			REQUIRE(out[MISSING - 1][1] == static_cast<float>(MISSING));
+			REQUIRE(out[MISSING][0] == 1.0f);
+			REQUIRE(out[MAX_FRAMES - 1][1] == 1.0f);
+		}
+	}
+
+	SECTION("cleared buffer ignores writes")
+	{
+		startStopped(CHUNK_FRAMES, 0);
+		buffer.clear();
+
+		buffer.sum(makeBlock(64, 0, CHUNK_FRAMES), 0, /*gain=*/1.0f);
+
+		REQUIRE(buffer.getMaxFrames() == 0);
+		REQUIRE(buffer.getDroppedFrames() == 0);
+	}
+}
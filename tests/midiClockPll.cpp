@@ -0,0 +1,136 @@
+#include "../src/core/midiClockPll.h"
+#include <catch2/catch.hpp>
+#include <cmath>
+#include <random>
+
+TEST_CASE("MidiClockPll")
+{
+	using namespace giada::m;
+
+	constexpr double BANDWIDTH = 0.5;
+	constexpr double PERIOD    = 60.0 / (120.0 * 24); // 120 bpm
+
+	MidiClockPll pll;
+
+	std::minstd_rand                 rng(1234);
+	std::uniform_real_distribution<> jitter(-0.001, 0.001); // +/- 1 ms
+
+	SECTION("not locked until a beat has gone by")
+	{
+		REQUIRE(pll.getCount() == -1);
+		for (int i = 0; i < 24; i++)
+		{
+			REQUIRE_FALSE(pll.isLocked());
+			pll.tick(i * PERIOD, BANDWIDTH);
+		}
+		REQUIRE(pll.isLocked());
+		REQUIRE(pll.getCount() == 23);
+
+		pll.reset();
+		REQUIRE_FALSE(pll.isLocked());
+		REQUIRE(pll.getCount() == -1);
+	}
+
+	SECTION("jitter is filtered out")
+	{
+		/* Uniform jitter of +/- 1 ms has an RMS of about 0.58 ms. */
+
+		double squaredError = 0.0;
+		for (int i = 0; i < 2000; i++)
+		{
+			pll.tick(1.0 + i * PERIOD + jitter(rng), BANDWIDTH);
+			if (i >= 1000)
+				squaredError += std::pow(pll.getTime() - (1.0 + i * PERIOD), 2);
+		}
+		REQUIRE(pll.getBpm() == Approx(120.0f).margin(0.1f));
+		REQUIRE(std::sqrt(squaredError / 1000) < 0.0003);
+	}
+
+	SECTION("tempo changes are followed")
+	{
+		double t = 0.0;
+		for (int i = 0; i < 500; i++, t += PERIOD)
+			pll.tick(t + jitter(rng), BANDWIDTH);
+
+		const double newPeriod = 60.0 / (126.0 * 24);
+		for (int i = 0; i < 1000; i++, t += newPeriod)
+			pll.tick(t + jitter(rng), BANDWIDTH);
+
+		REQUIRE(pll.getBpm() == Approx(126.0f).margin(0.1f));
+	}
+
+	SECTION("dropouts don't break the loop")
+	{
+		double t = 0.0;
+		for (int i = 0; i < 100; i++, t += PERIOD)
+			pll.tick(t, BANDWIDTH);
+
+		t += 1.0; // One second of silence
+		for (int i = 0; i < 200; i++, t += PERIOD)
+			pll.tick(t, BANDWIDTH);
+
+		REQUIRE(pll.getBpm() == Approx(120.0f).margin(0.01f));
+	}
+}
+
+TEST_CASE("MidiClockFollower")
+{
+	using namespace giada;
+	using namespace giada::m;
+
+	constexpr double SAMPLE_RATE = 44100.0;
+	constexpr Frame  BUFFER_SIZE = 512;
+
+	MidiClockFollower follower;
+
+	/* Simulates a master clock and a sequencer that starts at a different 
+	tempo, and applies the tempo asked by the follower on each block. */
+
+	float  bpm          = 100.0f;
+	Frame  framesInBeat = static_cast<Frame>(SAMPLE_RATE * 60.0 / bpm);
+	double masterBeats  = 0.0;
+	double now          = 0.0;
+
+	auto run = [&](double masterBpm, int blocks) {
+		const double period = 60.0 / (masterBpm * 24);
+		for (int i = 0; i < blocks; i++)
+		{
+			const int64_t count = static_cast<int64_t>(masterBeats * 24);
+			const double  time  = now - (masterBeats * 24 - count) * period;
+
+			const float newBpm = follower.advance(BUFFER_SIZE, framesInBeat, now, MidiClockFollower::Master{count, time, period});
+			if (newBpm > 0.0f)
+			{
+				bpm          = newBpm;
+				framesInBeat = static_cast<Frame>(SAMPLE_RATE * 60.0 / bpm);
+			}
+
+			now += BUFFER_SIZE / SAMPLE_RATE;
+			masterBeats += BUFFER_SIZE / SAMPLE_RATE * masterBpm / 60.0;
+		}
+	};
+
+	SECTION("no master, no correction")
+	{
+		REQUIRE(follower.advance(BUFFER_SIZE, framesInBeat, 0.0, {}) == 0.0f);
+		REQUIRE(follower.getBeats() == Approx(BUFFER_SIZE / static_cast<double>(framesInBeat)));
+
+		follower.reset();
+		REQUIRE(follower.getBeats() == 0.0);
+	}
+
+	SECTION("tempo and phase follow the master, across tempo changes")
+	{
+		run(120.0, 5000); // About 58 seconds
+		REQUIRE(bpm == Approx(120.0f).margin(0.5f));
+		REQUIRE(std::abs(masterBeats - follower.getBeats()) < 0.05);
+
+		run(130.0, 5000);
+		REQUIRE(bpm == Approx(130.0f).margin(0.5f));
+		REQUIRE(std::abs(masterBeats - follower.getBeats()) < 0.05);
+
+		run(90.0, 5000);
+		REQUIRE(bpm == Approx(90.0f).margin(0.5f));
+		REQUIRE(std::abs(masterBeats - follower.getBeats()) < 0.05);
+	}
+}
@@ -0,0 +1,142 @@
+#include "../src/core/midiDispatcher.h"
+#include "../src/core/channels/midiLearner.h"
+#include "../src/core/plugins/plugin.h"
+#include <catch2/catch.hpp>
+#include <vector>
+
+TEST_CASE("MidiDispatcher::Bindings")
+{
+	using namespace giada;
+	using namespace giada::m;
+
+	using Binding = MidiDispatcher::Binding;
+	using Target  = Binding::Target;
+
+	constexpr uint32_t NOTE_C = 0x903C0000;
+	constexpr uint32_t NOTE_D = 0x903E0000;
+	constexpr uint32_t CC_1   = 0xB0010000;
+
+	MidiDispatcher::Bindings bindings;
+	model::MidiIn            midiIn;
+	MidiLearner              learner;
+
+	learner.enabled = true;
+
+	/* Targets of 'pure' as (target, channel ID) pairs, in dispatch order. */
+
+	const auto getTargets = [&bindings](uint32_t pure) {
+		std::vector<std::pair<Target, ID>> out;
+		for (const Binding& b : bindings.find(pure))
+			out.push_back({b.target, b.channelId});
+		return out;
+	};
+
+	SECTION("unbound messages only reach armed channels")
+	{
+		bindings.addMaster(midiIn);
+		bindings.addChannel(1, learner, {}, /*armed=*/false, /*direct=*/false);
+		bindings.addChannel(2, learner, {}, /*armed=*/true, /*direct=*/true);
+
+		const std::vector<Binding> found = bindings.find(NOTE_C);
+
+		REQUIRE(found.size() == 1);
+		REQUIRE(found[0].target == Target::ARMED_CHANNEL);
+		REQUIRE(found[0].channelId == 2);
+		REQUIRE(found[0].direct);
+	}
+
+	SECTION("master first, then channel by channel")
+	{
+		/* An armed channel takes the message right after its own learnt
+		parameters, before the channels that follow it in the model. */
+
+		midiIn.startStop = NOTE_C;
+		learner.keyPress.setValue(NOTE_C);
+
+		bindings.addMaster(midiIn);
+		bindings.addChannel(1, learner, {}, /*armed=*/true, /*direct=*/false);
+		bindings.addChannel(2, learner, {}, /*armed=*/false, /*direct=*/false);
+		bindings.addChannel(3, MidiLearner(), {}, /*armed=*/true, /*direct=*/false); // MIDI in disabled
+		bindings.addChannel(4, learner, {}, /*armed=*/true, /*direct=*/false);
+
+		REQUIRE(getTargets(NOTE_C) == std::vector<std::pair<Target, ID>>{
+		                                  {Target::MASTER, 0},
+		                                  {Target::CHANNEL, 1},
+		                                  {Target::ARMED_CHANNEL, 1},
+		                                  {Target::CHANNEL, 2},
+		                                  {Target::CHANNEL, 4},
+		                                  {Target::ARMED_CHANNEL, 4}});
+
+		REQUIRE(getTargets(NOTE_D) == std::vector<std::pair<Target, ID>>{
+		                                  {Target::ARMED_CHANNEL, 1},
+		                                  {Target::ARMED_CHANNEL, 4}});
+	}
+
+	SECTION("only the first parameter of an owner reacts")
+	{
+		midiIn.rewind    = NOTE_C;
+		midiIn.startStop = NOTE_C;
+		learner.keyPress.setValue(NOTE_D);
+		learner.mute.setValue(NOTE_D);
+
+		bindings.addMaster(midiIn);
+		bindings.addChannel(1, learner, {}, /*armed=*/false, /*direct=*/false);
+
+		const std::vector<Binding> master  = bindings.find(NOTE_C);
+		const std::vector<Binding> channel = bindings.find(NOTE_D);
+
+		REQUIRE(master.size() == 1);
+		REQUIRE(master[0].param == G_MIDI_IN_REWIND);
+		REQUIRE(channel.size() == 1);
+		REQUIRE(channel[0].param == G_MIDI_IN_KEYPRESS);
+	}
+
+	SECTION("all matching plug-in parameters react")
+	{
+		Plugin plugin1(/*id=*/10, "plugin1");
+		Plugin plugin2(/*id=*/20, "plugin2");
+
+		plugin1.midiInParams.emplace_back(CC_1, /*index=*/0);
+		plugin1.midiInParams.emplace_back(CC_1, /*index=*/1);
+		plugin2.midiInParams.emplace_back(CC_1, /*index=*/5);
+		plugin2.midiInParams.emplace_back(NOTE_C, /*index=*/6);
+
+		learner.volume.setValue(CC_1);
+
+		bindings.addMaster(midiIn);
+		bindings.addChannel(1, learner, {&plugin1, &plugin2}, /*armed=*/false, /*direct=*/false);
+
+		const std::vector<Binding> found = bindings.find(CC_1);
+
+		REQUIRE(found.size() == 4);
+		REQUIRE(found[0].target == Target::CHANNEL);
+		REQUIRE(found[0].param == G_MIDI_IN_VOLUME);
+		REQUIRE(found[1].target == Target::PLUGIN);
+		REQUIRE((found[1].pluginId == 10 && found[1].paramIndex == 0));
+		REQUIRE((found[2].pluginId == 10 && found[2].paramIndex == 1));
+		REQUIRE((found[3].pluginId == 20 && found[3].paramIndex == 5));
+	}
+
+	SECTION("bindings carry the filters of their channel")
+	{
+		learner.filter = 2;
+		learner.device = 1;
+		learner.keyPress.setValue(NOTE_C);
+
+		bindings.addMaster(midiIn);
+		bindings.addChannel(1, learner, {}, /*armed=*/true, /*direct=*/false);
+
+		const std::vector<Binding> found = bindings.find(NOTE_C);
+
+		REQUIRE(found.size() == 2);
+		for (const Binding& b : found)
+		{
+			REQUIRE(b.isAllowed(/*channel=*/2, /*device=*/1));
+			REQUIRE_FALSE(b.isAllowed(/*channel=*/3, /*device=*/1));
+			REQUIRE_FALSE(b.isAllowed(/*channel=*/2, /*device=*/0));
+		}
+
+		Binding any{Target::CHANNEL};
+		REQUIRE(any.isAllowed(/*channel=*/15, /*device=*/3));
+	}
+}
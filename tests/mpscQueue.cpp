@@ -0,0 +1,72 @@
+#include "../src/core/mpscQueue.h"
+#include <catch2/catch.hpp>
+#include <thread>
+#include <vector>
+
+TEST_CASE("MpscQueue")
+{
+	using namespace giada::m;
+
+	MpscQueue<int, 4> queue;
+	int               item = 0;
+
+	SECTION("FIFO order")
+	{
+		REQUIRE(queue.isEmpty());
+		REQUIRE(queue.push(1));
+		REQUIRE(queue.push(2));
+		REQUIRE(queue.pop(item));
+		REQUIRE(item == 1);
+		REQUIRE(queue.pop(item));
+		REQUIRE(item == 2);
+		REQUIRE_FALSE(queue.pop(item));
+	}
+
+	SECTION("overflow accounting")
+	{
+		for (int i = 0; i < 6; i++)
+			queue.push(i);
+
+		REQUIRE(queue.getDropped() == 2);
+		REQUIRE(queue.getHighWater() == 4);
+
+		REQUIRE(queue.pop(item));
+		REQUIRE(item == 0);
+		REQUIRE(queue.push(6)); // Room again after a pop
+	}
+
+	SECTION("multiple producers")
+	{
+		constexpr int PRODUCERS = 4;
+		constexpr int ITEMS     = 10000;
+
+		MpscQueue<int, 64>       big;
+		std::vector<int>         last(PRODUCERS, -1);
+		std::vector<std::thread> producers;
+
+		for (int p = 0; p < PRODUCERS; p++)
+			producers.emplace_back([&big, p]() {
+				for (int i = 0; i < ITEMS; i++)
+					while (!big.push(p * ITEMS + i))
+						std::this_thread::yield();
+			});
+
+		int  received = 0;
+		bool ordered  = true;
+		while (received < PRODUCERS * ITEMS)
+		{
+			if (!big.pop(item))
+				continue;
+			const int p = item / ITEMS;
+			ordered &= item % ITEMS > last[p]; // Per-producer order is kept
+			last[p] = item % ITEMS;
+			received++;
+		}
+
+		for (std::thread& t : producers)
+			t.join();
+
+		REQUIRE(ordered);
+		REQUIRE(big.isEmpty());
+	}
+}
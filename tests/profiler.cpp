@@ -0,0 +1,85 @@
+#include "../src/core/profiler.h"
+#include <catch2/catch.hpp>
+#include <chrono>
+
+TEST_CASE("Profiler::Histogram")
+{
+	using namespace giada::m;
+	using namespace std::chrono;
+
+	Profiler::Histogram histogram;
+
+	SECTION("empty")
+	{
+		REQUIRE(histogram.getCount() == 0);
+		REQUIRE(histogram.getPercentile(0.5f) == 0);
+	}
+
+	SECTION("buckets")
+	{
+		histogram.add(nanoseconds(500)); // < 1 us
+		histogram.add(microseconds(1));  // [1, 2) us
+		histogram.add(microseconds(3));  // [2, 4) us
+		histogram.add(microseconds(3));
+
+		REQUIRE(histogram.getCount() == 4);
+		REQUIRE(histogram.getCount(0) == 1);
+		REQUIRE(histogram.getCount(1) == 1);
+		REQUIRE(histogram.getCount(2) == 2);
+	}
+
+	SECTION("percentiles")
+	{
+		for (int i = 0; i < 99; i++)
+			histogram.add(microseconds(100)); // [64, 128) us
+		histogram.add(milliseconds(10));      // [8192, 16384) us
+
+		REQUIRE(histogram.getPercentile(0.5f) == 128);
+		REQUIRE(histogram.getPercentile(0.99f) == 128);
+		REQUIRE(histogram.getPercentile(1.0f) == 16384);
+	}
+
+	SECTION("overflow")
+	{
+		histogram.add(seconds(60));
+
+		REQUIRE(histogram.getCount(Profiler::Histogram::BUCKETS - 1) == 1);
+	}
+
+	SECTION("reset")
+	{
+		histogram.add(microseconds(10));
+		histogram.reset();
+
+		REQUIRE(histogram.getCount() == 0);
+	}
+}
+
+TEST_CASE("Profiler")
+{
+	using namespace giada::m;
+
+	Profiler        profiler;
+	Profiler::Stats external; // E.g. a channel's or a plug-in's statistics
+
+	profiler.onReset = [&external]() { external.reset(); };
+
+	SECTION("reset clears external statistics too")
+	{
+		external.add(0.5f);
+		profiler.getStage(Profiler::Stage::BLOCK).add(0.5f);
+		profiler.reset();
+
+		REQUIRE(external.getAverage() == 0.0f);
+		REQUIRE(external.getPeak() == 0.0f);
+		REQUIRE(profiler.getStage(Profiler::Stage::BLOCK).getAverage() == 0.0f);
+	}
+
+	SECTION("enabling resets")
+	{
+		external.add(0.5f);
+		profiler.setEnabled(true);
+
+		REQUIRE(external.getPeak() == 0.0f);
+	}
+}
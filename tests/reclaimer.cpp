@@ -0,0 +1,106 @@
+#include "../src/core/model/reclaimer.h"
+#include <atomic>
+#include <catch2/catch.hpp>
+#include <chrono>
+#include <memory>
+#include <thread>
+
+namespace
+{
+struct Tracked
+{
+	Tracked(int& deleted)
+	: deleted(deleted)
+	{
+	}
+
+	~Tracked() { deleted++; }
+
+	int& deleted;
+};
+} // namespace
+
+TEST_CASE("model::Reclaimer")
+{
+	using namespace giada::m::model;
+
+	Reclaimer reclaimer;
+	int       deleted = 0;
+
+	SECTION("no readers: delete right away")
+	{
+		reclaimer.retire(std::make_unique<Tracked>(deleted));
+
+		REQUIRE(deleted == 1);
+		REQUIRE(reclaimer.countRetired() == 0);
+	}
+
+	SECTION("keep alive while a reader is active")
+	{
+		{
+			Reclaimer::ReadScope scope(reclaimer);
+
+			reclaimer.retire(std::make_unique<Tracked>(deleted));
+			reclaimer.collect();
+
+			REQUIRE(deleted == 0);
+			REQUIRE(reclaimer.countRetired() == 1);
+		}
+
+		reclaimer.collect();
+
+		REQUIRE(deleted == 1);
+	}
+
+	SECTION("later readers don't hold back older retirees")
+	{
+		std::atomic<bool> entered = false;
+		std::atomic<bool> done    = false;
+
+		{
+			Reclaimer::ReadScope scope(reclaimer);
+			reclaimer.retire(std::make_unique<Tracked>(deleted));
+		}
+
+		/* A reader entering now can't see the object retired above. */
+
+		std::thread reader([&reclaimer, &entered, &done]() {
+			Reclaimer::ReadScope scope(reclaimer);
+			entered.store(true);
+			while (!done.load())
+				std::this_thread::yield();
+		});
+
+		while (!entered.load())
+			std::this_thread::yield();
+
+		reclaimer.collect();
+		done.store(true);
+		reader.join();
+
+		REQUIRE(deleted == 1);
+	}
+
+	SECTION("synchronize waits for active readers")
+	{
+		std::atomic<bool> entered        = false;
+		std::atomic<int>  deletedOnLeave = -1;
+
+		std::thread reader([&reclaimer, &entered, &deleted, &deletedOnLeave]() {
+			Reclaimer::ReadScope scope(reclaimer);
+			entered.store(true);
+			std::this_thread::sleep_for(std::chrono::milliseconds(20));
+			deletedOnLeave.store(deleted);
+		});
+
+		while (!entered.load())
+			std::this_thread::yield();
+
+		reclaimer.retire(std::make_unique<Tracked>(deleted));
+		reclaimer.synchronize();
+		reader.join();
+
+		REQUIRE(deletedOnLeave.load() == 0);
+		REQUIRE(deleted == 1);
+	}
+}
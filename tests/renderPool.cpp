@@ -0,0 +1,120 @@
+#include "../src/core/renderPool.h"
+#include <array>
+#include <atomic>
+#include <catch2/catch.hpp>
+#include <chrono>
+#include <thread>
+
+TEST_CASE("RenderPool")
+{
+	using namespace giada::m;
+
+	constexpr std::size_t NUM_JOBS = 64;
+
+	std::array<std::atomic<int>, NUM_JOBS> runs;
+	std::array<std::atomic<int>, NUM_JOBS> threads;
+
+	const auto clear = [&runs, &threads]() {
+		for (std::size_t i = 0; i < NUM_JOBS; i++)
+		{
+			runs[i].store(0);
+			threads[i].store(-1);
+		}
+	};
+
+	auto job = [&runs, &threads](std::size_t i) {
+		runs[i].fetch_add(1);
+		threads[i].store(RenderPool::getThreadIndex());
+	};
+
+	const auto allRunOnce = [&runs](std::size_t count) {
+		for (std::size_t i = 0; i < NUM_JOBS; i++)
+			if (runs[i].load() != (i < count ? 1 : 0))
+				return false;
+		return true;
+	};
+
+	clear();
+
+	RenderPool pool;
+
+	SECTION("disabled pool runs jobs on the calling thread")
+	{
+		pool.start(0);
+		REQUIRE_FALSE(pool.isEnabled());
+
+		pool.run(NUM_JOBS, job);
+
+		REQUIRE(allRunOnce(NUM_JOBS));
+		for (std::size_t i = 0; i < NUM_JOBS; i++)
+			REQUIRE(threads[i].load() == 0);
+	}
+
+	SECTION("count <= 1 runs inline")
+	{
+		pool.start(2);
+		REQUIRE(pool.isEnabled());
+
+		pool.run(0, job);
+		REQUIRE(allRunOnce(0));
+
+		pool.run(1, job);
+		REQUIRE(allRunOnce(1));
+		REQUIRE(threads[0].load() == 0);
+	}
+
+	SECTION("all jobs of a batch are done when run() returns")
+	{
+		pool.start(3);
+
+		pool.run(NUM_JOBS, job);
+
+		REQUIRE(allRunOnce(NUM_JOBS));
+		for (std::size_t i = 0; i < NUM_JOBS; i++)
+			REQUIRE((threads[i].load() >= 0 && threads[i].load() <= 3));
+	}
+
+	SECTION("consecutive batches don't mix up")
+	{
+		/* Each batch bumps the generation: workers must never claim a job twice 
+		or pick one from a stale batch, whatever its size. */
+
+		pool.start(3);
+
+		for (int i = 0; i < 1000; i++)
+		{
+			const std::size_t count = 2 + (i % (NUM_JOBS - 1));
+
+			clear();
+			pool.run(count, job);
+			REQUIRE(allRunOnce(count));
+		}
+	}
+
+	SECTION("parked workers are woken up by a new batch")
+	{
+		pool.start(3);
+
+		/* Give workers time to go past the spinning phase and sleep. */
+
+		std::this_thread::sleep_for(std::chrono::milliseconds(50));
+
+		pool.run(NUM_JOBS, job);
+		REQUIRE(allRunOnce(NUM_JOBS));
+
+		std::this_thread::sleep_for(std::chrono::milliseconds(50));
+
+		clear();
+		pool.run(NUM_JOBS, job);
+		REQUIRE(allRunOnce(NUM_JOBS));
+	}
+
+	SECTION("stop() joins parked workers")
+	{
+		pool.start(3);
+		std::this_thread::sleep_for(std::chrono::milliseconds(50));
+
+		pool.stop();
+		REQUIRE_FALSE(pool.isEnabled());
+	}
+}
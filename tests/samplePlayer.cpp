@@ -16,7 +16,7 @@ TEST_CASE("SamplePlayer")
 		f[1] = static_cast<float>(i + 1);
 	});
 
-	m::ChannelShared channelShared(BUFFER_SIZE);
+	m::ChannelShared channelShared(1, BUFFER_SIZE);
 	m::Resampler     resampler(m::Resampler::Quality::LINEAR, NUM_CHANNELS);
 
 	m::SamplePlayer samplePlayer(&resampler);
@@ -40,7 +40,7 @@ TEST_CASE("SamplePlayer")
 
 		for (const float pitch : {1.0f, 0.5f})
 		{
-			samplePlayer.pitch = pitch;
+			channelShared.pitch.store(pitch);
 
 			SECTION("Sub-range [M, N), pitch == " + std::to_string(pitch))
 			{
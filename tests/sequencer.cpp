@@ -0,0 +1,143 @@
+#include "../src/core/sequencer.h"
+#include "../src/core/actions/actionRecorder.h"
+#include "../src/core/conf.h"
+#include "../src/core/jackTransport.h"
+#include "../src/core/kernelAudio.h"
+#include "../src/core/kernelMidi.h"
+#include "../src/core/model/model.h"
+#include "../src/core/synchronizer.h"
+#include <catch2/catch.hpp>
+#include <utility>
+#include <vector>
+
+TEST_CASE("Sequencer")
+{
+	using namespace giada;
+	using namespace giada::m;
+
+	using EventType = Sequencer::EventType;
+
+	/* 120 bpm, 4 beats, 2 bars: a beat is 22050 frames, a bar 44100 frames,
+	the loop 88200 frames. */
+
+	constexpr int   SAMPLE_RATE    = 44100;
+	constexpr Frame FRAMES_IN_BEAT = 22050;
+	constexpr Frame FRAMES_IN_BAR  = FRAMES_IN_BEAT * 2;
+	constexpr Frame FRAMES_IN_LOOP = FRAMES_IN_BEAT * 4;
+	constexpr ID    CHANNEL_ID     = 1;
+
+	model::Model   model;
+	Conf::Data     conf;
+	KernelAudio    kernelAudio;
+	KernelMidi     kernelMidi(kernelAudio);
+	Synchronizer   synchronizer(conf, kernelMidi);
+	JackTransport  jackTransport;
+	ActionRecorder actionRecorder(model);
+	Sequencer      sequencer(model, synchronizer, jackTransport);
+
+	sequencer.reset(SAMPLE_RATE);
+	sequencer.setBpm(120.0f, SAMPLE_RATE);
+	sequencer.setBeats(/*beats=*/4, /*bars=*/2, SAMPLE_RATE);
+
+	REQUIRE(sequencer.getFramesInBeat() == FRAMES_IN_BEAT);
+	REQUIRE(sequencer.getFramesInBar() == FRAMES_IN_BAR);
+	REQUIRE(sequencer.getFramesInLoop() == FRAMES_IN_LOOP);
+
+	const auto recAction = [&actionRecorder](ID channelId, Frame frame) {
+		actionRecorder.rec(channelId, frame, MidiEvent(MidiEvent::NOTE_ON, 0x00, 0x00));
+	};
+
+	/* Moves the sequencer to 'frame', then parses a block of 'bufferSize'
+	frames from there. */
+
+	const auto advanceFrom = [&sequencer, &actionRecorder](Frame frame, Frame bufferSize) {
+		sequencer.rewind();
+		if (frame > 0)
+			sequencer.advance(frame, actionRecorder);
+		sequencer.advance(bufferSize, actionRecorder);
+	};
+
+	/* Events of the last block for channel 'channelId', as (type, delta)
+	pairs, in the order the channel gets them. */
+
+	const auto getEvents = [&sequencer](ID channelId) {
+		std::vector<std::pair<EventType, Frame>> out;
+		sequencer.getChannelEvents(channelId).forEach([&out](const Sequencer::Event& e) {
+			out.push_back({e.type, e.delta});
+		});
+		return out;
+	};
+
+	using Events = std::vector<std::pair<EventType, Frame>>;
+
+	SECTION("bar, beat and action on the same frame")
+	{
+		/* Shared events come first on the same frame. A beat on a bar boundary
+		only triggers the bar event. */
+
+		recAction(CHANNEL_ID, FRAMES_IN_BAR);
+
+		advanceFrom(FRAMES_IN_BAR - 100, 256);
+
+		REQUIRE(getEvents(CHANNEL_ID) == Events{{EventType::BAR, 100}, {EventType::ACTIONS, 100}});
+		REQUIRE(getEvents(CHANNEL_ID + 1) == Events{{EventType::BAR, 100}});
+	}
+
+	SECTION("first beat and action on the same frame")
+	{
+		recAction(CHANNEL_ID, 0);
+
+		advanceFrom(0, 256);
+
+		REQUIRE(getEvents(CHANNEL_ID) == Events{{EventType::FIRST_BEAT, 0}, {EventType::ACTIONS, 0}});
+	}
+
+	SECTION("beats off a bar don't produce events")
+	{
+		recAction(CHANNEL_ID, FRAMES_IN_BEAT);
+
+		advanceFrom(FRAMES_IN_BEAT - 10, 256);
+
+		REQUIRE(getEvents(CHANNEL_ID) == Events{{EventType::ACTIONS, 10}});
+	}
+
+	SECTION("loop wrap within a block")
+	{
+		/* The block is split in two ranges at the end of the loop: deltas keep
+		counting from the start of the block. */
+
+		recAction(CHANNEL_ID, FRAMES_IN_LOOP - 50);
+		recAction(CHANNEL_ID, 10);
+
+		advanceFrom(FRAMES_IN_LOOP - 100, 256);
+
+		REQUIRE(getEvents(CHANNEL_ID) == Events{
+		                                     {EventType::ACTIONS, 50},
+		                                     {EventType::FIRST_BEAT, 100},
+		                                     {EventType::ACTIONS, 110}});
+		REQUIRE(sequencer.getCurrentFrame() == 256 - 100);
+	}
+
+	SECTION("several loops within a block")
+	{
+		/* Very short loop: the same action is found once per loop. */
+
+		sequencer.setBpm(G_MAX_BPM, SAMPLE_RATE);
+		sequencer.setBeats(/*beats=*/1, /*bars=*/1, SAMPLE_RATE);
+
+		const Frame framesInLoop = sequencer.getFramesInLoop();
+		const Frame bufferSize   = framesInLoop * 3;
+
+		recAction(CHANNEL_ID, 5);
+
+		advanceFrom(0, bufferSize);
+
+		Events expected;
+		for (Frame loop = 0; loop < bufferSize; loop += framesInLoop)
+		{
+			expected.push_back({EventType::FIRST_BEAT, loop});
+			expected.push_back({EventType::ACTIONS, loop + 5});
+		}
+		REQUIRE(getEvents(CHANNEL_ID) == expected);
+	}
+}
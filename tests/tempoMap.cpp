@@ -0,0 +1,44 @@
+#include "../src/core/tempoMap.h"
+#include "../src/core/const.h"
+#include <catch2/catch.hpp>
+
+TEST_CASE("TempoMap")
+{
+	using namespace giada;
+	using namespace giada::m;
+
+	SECTION("beats fall on ticks multiple of G_PPQ")
+	{
+		const TempoMap tempoMap(22050); // 120 bpm @ 44100 Hz
+
+		REQUIRE(tempoMap.toTick(0) == 0);
+		REQUIRE(tempoMap.toTick(22050) == G_PPQ);
+		REQUIRE(tempoMap.toFrame(G_PPQ * 3) == 22050 * 3);
+		REQUIRE(tempoMap.toFrame(G_PPQ / 2) == 11025);
+	}
+
+	SECTION("frame -> tick -> frame round trip is exact")
+	{
+		for (Frame framesInBeat : {1, 2648, 22050, 44100, 576000})
+		{
+			const TempoMap tempoMap(framesInBeat);
+			for (Frame f = 0; f < framesInBeat * 4; f += 1 + framesInBeat / 997)
+				REQUIRE(tempoMap.toFrame(tempoMap.toTick(f)) == f);
+		}
+	}
+
+	SECTION("toTick returns the first tick on a frame")
+	{
+		const TempoMap tempoMap(2648);
+		for (Frame f = 1; f < 2648; f++)
+			REQUIRE(tempoMap.toFrame(tempoMap.toTick(f) - 1) == f - 1);
+	}
+
+	SECTION("tempo change moves frames, not ticks")
+	{
+		const Tick t = G_PPQ * 5 + G_PPQ / 4;
+
+		REQUIRE(TempoMap(22050).toFrame(t) == 22050 * 5 + 22050 / 4);
+		REQUIRE(TempoMap(11025).toFrame(t) == 11025 * 5 + 11025 / 4);
+	}
+}
@@ -61,4 +61,9 @@ TEST_CASE("::math")
 	REQUIRE(math::map(0.0f, 30.0f, 1.0f) == 0.0f);
 	REQUIRE(math::map(30.0f, 30.0f, 1.0f) == 1.0f);
 	REQUIRE(math::map(15.0f, 30.0f, 1.0f) == Approx(0.5f));
+
+	REQUIRE(math::ceilToMultiple(0, 4) == 0);
+	REQUIRE(math::ceilToMultiple(1, 4) == 4);
+	REQUIRE(math::ceilToMultiple(4, 4) == 4);
+	REQUIRE(math::ceilToMultiple(5, 4) == 8);
 }